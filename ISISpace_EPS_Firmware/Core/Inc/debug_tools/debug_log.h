@@ -0,0 +1,162 @@
+// debug_log.h
+// Deferred-format logging to the Debug UART. Call sites pass a format ID (see debug_log_formats.h)
+// and integer args, instead of a formatted string.
+// - DEBUG_LOG_MODE_TEXT: formatted on the target, and printed as plain text (for bench work).
+// - DEBUG_LOG_MODE_TOKENIZED: sent as a compact binary record; nothing is formatted on the target.
+//   Decode with Tools/debug_log_decode.c. Plain text from debug_uart_print_str() passes through the
+//   decoder unchanged, as records always start with a byte >= 0x80.
+//
+// Record layout (tokenized mode), all numbers as unsigned LEB128 varints:
+//   [sync] [format ID] [timestamp ms] then either [arg]... (as many as the format has conversions),
+//   or [len] [len raw bytes] for DEBUG_LOG_HEX().
+//   sync is 0xA4 | DEBUG_LOG_SYNC_FLAG_*. The timestamp is the ms since the previous record sent,
+//   or the uptime when DEBUG_LOG_SYNC_FLAG_ABS_TIME is set (on the first record, and every
+//   DEBUG_LOG_ABS_TIME_INTERVAL records so that a decoder can join mid-stream).
+
+#ifndef __INCLUDE_GUARD__DEBUG_LOG_H__
+#define __INCLUDE_GUARD__DEBUG_LOG_H__
+
+#include "debug_tools/debug_log_formats.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+typedef enum {
+	DEBUG_LOG_MODE_TEXT = 0,
+	DEBUG_LOG_MODE_TOKENIZED = 1,
+} debug_log_mode_t;
+
+#define DEBUG_LOG_DEFAULT_MODE DEBUG_LOG_MODE_TOKENIZED
+
+// How DEBUG_LOG_HEX() data is printed in text mode (and by the decoder, with -x for XXD).
+typedef enum {
+	DEBUG_LOG_HEX_STYLE_BYTES = 0, // "OBC->EPS: 0x1a 0x07 0x40 0x00 \n"
+	DEBUG_LOG_HEX_STYLE_XXD = 1, // "OBC->EPS: \n" then lines of "0000: 1a07 4000  ..@.\n"
+} debug_log_hex_style_t;
+
+#define DEBUG_LOG_SYNC_BASE 0xA4
+#define DEBUG_LOG_SYNC_MASK 0xFC
+#define DEBUG_LOG_SYNC_FLAG_ABS_TIME 0x01
+#define DEBUG_LOG_SYNC_FLAG_HEX 0x02
+
+#define DEBUG_LOG_ABS_TIME_INTERVAL 32
+#define DEBUG_LOG_MAX_ARGS 8
+#define DEBUG_LOG_MAX_TEXT_LEN 200
+#define DEBUG_LOG_MAX_HEX_LEN 300 // longer DEBUG_LOG_HEX() data is cut (largest response: 274 bytes)
+
+#define DEBUG_LOG_ID_ENUM_ENTRY(id, format) id,
+typedef enum {
+	DEBUG_LOG_FORMATS(DEBUG_LOG_ID_ENUM_ENTRY)
+	DEBUG_LOG_ID_COUNT
+} debug_log_id_t;
+
+void debug_log_set_mode(debug_log_mode_t mode);
+debug_log_mode_t debug_log_get_mode(void);
+void debug_log_set_hex_style(debug_log_hex_style_t hex_style);
+
+void debug_log_write(debug_log_id_t id, const uint32_t args[], uint8_t arg_count);
+void debug_log_write_hex(debug_log_id_t id, const uint8_t data[], uint16_t len);
+
+// DEBUG_LOG(DEBUG_LOG_ID_..., args...). Args are passed as uint32_t (signed values are sign-extended).
+#define DEBUG_LOG(id, ...) do { \
+		const uint32_t debug_log_args[] = { 0, ##__VA_ARGS__ }; /* [0] keeps the array non-empty */ \
+		const uint8_t debug_log_arg_count = sizeof(debug_log_args) / sizeof(uint32_t) - 1; \
+		debug_log_write((id), (debug_log_arg_count > 0) ? &debug_log_args[1] : NULL, debug_log_arg_count); \
+	} while (0)
+
+#define DEBUG_LOG_HEX(id, data, len) debug_log_write_hex((id), (data), (len))
+
+
+// #pragma region Levels
+
+// Logs above DEBUG_LOG_COMPILE_LEVEL are removed by the preprocessor (args aren't even evaluated).
+// The rest are filtered at runtime by each module's level (see debug_log_set_module_level).
+#define DEBUG_LOG_LEVEL_NONE 0
+#define DEBUG_LOG_LEVEL_ERROR 1
+#define DEBUG_LOG_LEVEL_WARN 2
+#define DEBUG_LOG_LEVEL_INFO 3
+#define DEBUG_LOG_LEVEL_TRACE 4 // e.g., TX/RX hex dumps of every command
+
+#ifndef DEBUG_LOG_COMPILE_LEVEL
+#define DEBUG_LOG_COMPILE_LEVEL DEBUG_LOG_LEVEL_TRACE
+#endif
+
+#define DEBUG_LOG_DEFAULT_MODULE_LEVEL DEBUG_LOG_LEVEL_INFO
+
+typedef enum {
+	DEBUG_LOG_MODULE_TRANSPORT = 0, // eps_internal_drivers.c transactions, eps_transport_*.c
+	DEBUG_LOG_MODULE_COMMANDS = 1, // eps_cmd_table.c, command queue, STAT errors
+	DEBUG_LOG_MODULE_PACKERS = 2, // response decoding into eps_result_* structs
+	DEBUG_LOG_MODULE_COUNT
+} debug_log_module_t;
+
+// Runtime level of each module; read directly by the macros below, so a disabled log costs one compare.
+extern uint8_t debug_log_module_levels[DEBUG_LOG_MODULE_COUNT];
+
+void debug_log_set_module_level(debug_log_module_t module, uint8_t level);
+uint8_t debug_log_get_module_level(debug_log_module_t module);
+
+// Trace logs about a command (DEBUG_LOG_TRACE_CC) can be limited to some command codes: a command
+// is traced if (CC & cc_mask) == cc_value. E.g., (0xF0, 0xA0) traces only the PIU commands.
+// Default (0, 0): all commands.
+extern uint8_t debug_log_trace_cc_mask;
+extern uint8_t debug_log_trace_cc_value;
+void debug_log_set_trace_cc_filter(uint8_t cc_mask, uint8_t cc_value);
+
+#define DEBUG_LOG_IS_ENABLED(module, level) \
+	((level) <= DEBUG_LOG_COMPILE_LEVEL && (level) <= debug_log_module_levels[(module)])
+
+#define DEBUG_LOG_TRACE_CC_MATCHES(cc) \
+	(((cc) & debug_log_trace_cc_mask) == debug_log_trace_cc_value)
+
+#define DEBUG_LOG_IF(condition, log_statement) do { \
+		if (condition) { \
+			log_statement; \
+		} \
+	} while (0)
+
+#if DEBUG_LOG_COMPILE_LEVEL >= DEBUG_LOG_LEVEL_ERROR
+#define DEBUG_LOG_ERROR(module, id, ...) \
+	DEBUG_LOG_IF(DEBUG_LOG_IS_ENABLED((module), DEBUG_LOG_LEVEL_ERROR), DEBUG_LOG((id), ##__VA_ARGS__))
+#else
+#define DEBUG_LOG_ERROR(module, id, ...) do {} while (0)
+#endif
+
+#if DEBUG_LOG_COMPILE_LEVEL >= DEBUG_LOG_LEVEL_WARN
+#define DEBUG_LOG_WARN(module, id, ...) \
+	DEBUG_LOG_IF(DEBUG_LOG_IS_ENABLED((module), DEBUG_LOG_LEVEL_WARN), DEBUG_LOG((id), ##__VA_ARGS__))
+#else
+#define DEBUG_LOG_WARN(module, id, ...) do {} while (0)
+#endif
+
+#if DEBUG_LOG_COMPILE_LEVEL >= DEBUG_LOG_LEVEL_INFO
+#define DEBUG_LOG_INFO(module, id, ...) \
+	DEBUG_LOG_IF(DEBUG_LOG_IS_ENABLED((module), DEBUG_LOG_LEVEL_INFO), DEBUG_LOG((id), ##__VA_ARGS__))
+#else
+#define DEBUG_LOG_INFO(module, id, ...) do {} while (0)
+#endif
+
+#if DEBUG_LOG_COMPILE_LEVEL >= DEBUG_LOG_LEVEL_TRACE
+#define DEBUG_LOG_TRACE(module, id, ...) \
+	DEBUG_LOG_IF(DEBUG_LOG_IS_ENABLED((module), DEBUG_LOG_LEVEL_TRACE), DEBUG_LOG((id), ##__VA_ARGS__))
+#define DEBUG_LOG_TRACE_CC(module, cc, id, ...) \
+	DEBUG_LOG_IF(DEBUG_LOG_IS_ENABLED((module), DEBUG_LOG_LEVEL_TRACE) && DEBUG_LOG_TRACE_CC_MATCHES(cc), \
+			DEBUG_LOG((id), ##__VA_ARGS__))
+#define DEBUG_LOG_TRACE_CC_HEX(module, cc, id, data, len) \
+	DEBUG_LOG_IF(DEBUG_LOG_IS_ENABLED((module), DEBUG_LOG_LEVEL_TRACE) && DEBUG_LOG_TRACE_CC_MATCHES(cc), \
+			DEBUG_LOG_HEX((id), (data), (len)))
+#else
+#define DEBUG_LOG_TRACE(module, id, ...) do {} while (0)
+#define DEBUG_LOG_TRACE_CC(module, cc, id, ...) do {} while (0)
+#define DEBUG_LOG_TRACE_CC_HEX(module, cc, id, data, len) do {} while (0)
+#endif
+
+// #pragma endregion Levels
+
+// Shared with the host decoder.
+const char* debug_log_get_format(uint16_t id); // NULL if unknown
+uint8_t debug_log_count_args(const char *format);
+uint16_t debug_log_format(char dest[], uint16_t dest_len, const char *format, const uint32_t args[], uint8_t arg_count);
+uint8_t debug_log_write_varint(uint8_t dest[], uint32_t value); // returns the number of bytes (1 to 5)
+
+#endif // __INCLUDE_GUARD__DEBUG_LOG_H__
@@ -0,0 +1,33 @@
+// debug_log_formats.h
+// Every format string logged with DEBUG_LOG() or DEBUG_LOG_HEX(). In tokenized mode, only the index
+// into this list is sent, and the host decoder (Tools/debug_log_decode.c) rebuilds the text from the
+// same list. Only append new entries (or rebuild the decoder along with the firmware): the IDs are
+// the positions in this list.
+// Conversions: %d %i %u %x %X %%, with optional '0' flag, width, and 'l' (ignored). No %s.
+// DEBUG_LOG_HEX() formats take no conversions; the bytes are printed after them, then "\n".
+
+#ifndef __INCLUDE_GUARD__DEBUG_LOG_FORMATS_H__
+#define __INCLUDE_GUARD__DEBUG_LOG_FORMATS_H__
+
+#define DEBUG_LOG_FORMATS(X) \
+	X(DEBUG_LOG_ID_EPS_NO_TRANSPORT, "OBC->EPS ERROR: no transport selected\n") \
+	X(DEBUG_LOG_ID_EPS_TX_HEX, "OBC->EPS: ") \
+	X(DEBUG_LOG_ID_EPS_RX_HEX, "EPS->OBC: ") \
+	X(DEBUG_LOG_ID_EPS_STAT_ERROR, "EPS returned an error in the STAT field: 0x%02x (see ESP_SICD Table 3-11)\n") \
+	X(DEBUG_LOG_ID_EPS_BLOCKING_CMD_IN_CALLBACK, "OBC->EPS ERROR: blocking command called from a command queue callback\n") \
+	X(DEBUG_LOG_ID_EPS_UART_TX_HEX, "OBC->EPS (with tags): ") \
+	X(DEBUG_LOG_ID_EPS_UART_TX_FAILED, "OBC->EPS ERROR: tx_status != HAL_OK (%d)\n") \
+	X(DEBUG_LOG_ID_EPS_UART_RX_TIMEOUT, "EPS->OBC: timeout waiting for </rsp> (state=%d, payload %d of %d bytes, %lu bytes dropped)\n") \
+	X(DEBUG_LOG_ID_EPS_UART_RX_DROPPED_BYTES, "EPS->OBC: dropped %lu bytes outside of <rsp></rsp>\n") \
+	X(DEBUG_LOG_ID_EPS_I2C_TX_START_FAILED, "OBC->EPS ERROR: failed to start I2C transmit\n") \
+	X(DEBUG_LOG_ID_EPS_I2C_TX_FAILED, "OBC->EPS ERROR: tx failed (HAL I2C error 0x%lx)\n") \
+	X(DEBUG_LOG_ID_EPS_I2C_RX_FAILED, "OBC->EPS ERROR: rx failed (HAL I2C error 0x%lx)\n") \
+	X(DEBUG_LOG_ID_EPS_I2C_RX_TIMEOUT, "EPS->OBC: failed rx after %d rx retries\n") \
+	X(DEBUG_LOG_ID_EPS_I2C_RX_SUCCESS, "EPS->OBC: success after %d rx retries...\n") \
+	X(DEBUG_LOG_ID_EPS_CMD_FAILED, "EPS cmd 0x%02x failed (%d)\n") \
+	X(DEBUG_LOG_ID_EPS_CMD_DONE, "EPS cmd 0x%02x done (STAT 0x%02x)\n") \
+	X(DEBUG_LOG_ID_EPS_CMD_DECODED, "EPS cmd 0x%02x: decoded %u field runs from %u response bytes\n") \
+	X(DEBUG_LOG_ID_EPS_CMD_DECODE_FAILED, "EPS cmd 0x%02x: response decoder failed (%d)\n") \
+	X(DEBUG_LOG_ID_EPS_HK_CACHE_HIT, "EPS cmd 0x%02x: response from the cache (fresh: %d)\n") \
+
+#endif // __INCLUDE_GUARD__DEBUG_LOG_FORMATS_H__
@@ -4,14 +4,43 @@
 #ifndef __INCLUDE_GUARD__DEBUG_UART_H__
 #define __INCLUDE_GUARD__DEBUG_UART_H__
 
+#ifndef EPS_HOST_BUILD
 #include "main.h"
+#endif
 #include <stdint.h>
 
+// Prints are queued in a ring buffer of this size and sent by DMA. Prints that don't fit are dropped.
+#define DEBUG_UART_TX_RING_LEN 4096
+
+#define DEBUG_UART_HEX_CHUNK_BYTES 32 // bytes encoded per write by debug_uart_print_array_hex (160 chars of stack)
+
+// Starts the DMA logger (call after MX_LPUART1_UART_Init). Until then, prints are blocking.
+// Returns 0 on success.
+uint8_t debug_uart_init(void);
+
 void debug_uart_print_str(const char *str);
+// Returns 0 if the bytes were queued/sent, or 1 if they were dropped (ring full).
+uint8_t debug_uart_print_bytes(const char *data, uint16_t len);
+
+// json_writer_sink_t that prints each chunk (context is unused)
+void debug_uart_json_sink(const char *data, uint16_t len, void *context);
 
+// "0x1a 0x07 0x40 ...", then end_str. Dropped as a whole if the ring can't fit it.
 void debug_uart_print_array_hex(
 		const uint8_t* arr, uint16_t len, const char* end_str);
 
+// Compact, like xxd: 16 bytes per line, with an offset column and an ASCII column.
+void debug_uart_print_hex_dump(const uint8_t* arr, uint16_t len);
+
+// 1 if nothing is queued or being sent (e.g., before entering Stop 2, which would halt the DMA).
+uint8_t debug_uart_is_tx_idle(void);
+
+// Number of prints dropped because the ring was full.
+uint32_t debug_uart_get_dropped_msg_count(void);
+
+// Sends everything still queued, by polling. Call from fault handlers, with interrupts disabled.
+void debug_uart_flush_on_fault(void);
+
 
 
 #endif // __INCLUDE_GUARD__DEBUG_UART_H__
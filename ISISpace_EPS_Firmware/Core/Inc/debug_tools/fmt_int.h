@@ -0,0 +1,34 @@
+// fmt_int.h
+// Integer formatting for telemetry text, without printf: no heap, a few bytes of stack, and much
+// less flash than newlib's printf.
+// The fmt_int_<type>() functions write the digits only (no null terminator) and return the number
+// of chars written. The fmt_int_append_<type>() functions also null-terminate, and return a pointer
+// to the terminator, so that calls can be chained to build a line.
+// No HAL dependencies.
+
+#ifndef __INCLUDE_GUARD__FMT_INT_H__
+#define __INCLUDE_GUARD__FMT_INT_H__
+
+#include <stdint.h>
+
+#define FMT_INT_U32_MAX_LEN 10 // "4294967295"
+#define FMT_INT_I32_MAX_LEN 11 // "-2147483648"
+
+uint8_t fmt_int_u32(char dest[], uint32_t value);
+uint8_t fmt_int_i32(char dest[], int32_t value);
+
+// Right-aligned in `width` chars, padded with pad_char (e.g., '0' or ' '). Wider values aren't cut.
+uint8_t fmt_int_u32_width(char dest[], uint32_t value, uint8_t width, char pad_char);
+
+// Lowercase hex, exactly digit_count digits (1 to 8), no "0x"
+uint8_t fmt_int_hex(char dest[], uint32_t value, uint8_t digit_count);
+
+// value / 10^decimal_places, e.g. (2345, 2) -> "23.45" and (-5, 2) -> "-0.05"
+uint8_t fmt_int_fixed(char dest[], int32_t value, uint8_t decimal_places);
+
+char* fmt_int_append_str(char dest[], const char *str);
+char* fmt_int_append_u32(char dest[], uint32_t value);
+char* fmt_int_append_i32(char dest[], int32_t value);
+char* fmt_int_append_hex(char dest[], uint32_t value, uint8_t digit_count);
+
+#endif // __INCLUDE_GUARD__FMT_INT_H__
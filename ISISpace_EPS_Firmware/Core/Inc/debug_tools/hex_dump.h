@@ -0,0 +1,24 @@
+// hex_dump.h
+// Bulk hex encoding of byte buffers for debug output, using a lookup table (no printf).
+// - hex_dump_encode_bytes(): "0x1a 0x07 0x40 " (the debug_uart_print_array_hex format)
+// - hex_dump_encode_line(): one xxd-style line, "0010: 1a07 4000 ...  ..@.\n"
+// No HAL dependencies.
+
+#ifndef __INCLUDE_GUARD__HEX_DUMP_H__
+#define __INCLUDE_GUARD__HEX_DUMP_H__
+
+#include <stdint.h>
+
+#define HEX_DUMP_BYTES_CHARS_PER_BYTE 5 // "0x1a "
+
+#define HEX_DUMP_LINE_BYTES 16
+#define HEX_DUMP_LINE_MAX_LEN 64 // "0000: " + 8 groups of "xxxx " + " " + 16 ASCII chars + "\n"
+
+// Writes len * HEX_DUMP_BYTES_CHARS_PER_BYTE chars (no null terminator). Returns the number of chars.
+uint16_t hex_dump_encode_bytes(char dest[], const uint8_t data[], uint16_t len);
+
+// Writes one line for up to HEX_DUMP_LINE_BYTES bytes, starting at `offset` in the dump (no null
+// terminator). Returns the number of chars (at most HEX_DUMP_LINE_MAX_LEN).
+uint8_t hex_dump_encode_line(char dest[], uint16_t offset, const uint8_t data[], uint8_t len);
+
+#endif // __INCLUDE_GUARD__HEX_DUMP_H__
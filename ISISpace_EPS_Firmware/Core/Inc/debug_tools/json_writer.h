@@ -0,0 +1,50 @@
+// json_writer.h
+// Cursor-based JSON writer. Values are formatted straight into one bounded buffer. When a sink is
+// given, the buffer is flushed to the sink whenever it fills up, so the output can be any length
+// (e.g., streamed to the debug UART through a 64-byte buffer).
+// No HAL dependencies.
+
+#ifndef __INCLUDE_GUARD__JSON_WRITER_H__
+#define __INCLUDE_GUARD__JSON_WRITER_H__
+
+#include <stdint.h>
+
+#define JSON_WRITER_MAX_DEPTH 16
+
+// Called with each chunk of output (not null-terminated).
+typedef void (*json_writer_sink_t)(const char *data, uint16_t len, void *context);
+
+typedef struct {
+	char *buf;
+	uint16_t buf_len;
+	uint16_t pos;
+
+	json_writer_sink_t sink; // NULL: the whole output must fit in buf
+	void *sink_context;
+
+	uint8_t depth;
+	uint16_t has_items_bitfield; // bit n: the object/array at depth n already has a value (so needs a ',')
+	uint8_t overflowed; // set if output was dropped (buf full and no sink, or too deep)
+	uint32_t total_len; // bytes of output so far, including flushed bytes
+} json_writer_t;
+
+
+void json_writer_init(json_writer_t *writer, char buf[], uint16_t buf_len, json_writer_sink_t sink, void *sink_context);
+
+// `key` is the member name inside an object, or NULL for array elements and the top-level value.
+void json_writer_begin_object(json_writer_t *writer, const char *key);
+void json_writer_end_object(json_writer_t *writer);
+void json_writer_begin_array(json_writer_t *writer, const char *key);
+void json_writer_end_array(json_writer_t *writer);
+
+void json_writer_int(json_writer_t *writer, const char *key, int32_t value);
+void json_writer_uint(json_writer_t *writer, const char *key, uint32_t value);
+void json_writer_str(json_writer_t *writer, const char *key, const char *value);
+void json_writer_int16_array(json_writer_t *writer, const char *key, const int16_t values[], uint16_t count);
+void json_writer_uint16_array(json_writer_t *writer, const char *key, const uint16_t values[], uint16_t count);
+
+// Flushes the rest of the output to the sink, or null-terminates it in buf if there's no sink.
+// Returns 0 on success, or 3 if output was dropped (same code as the eps_*_TO_json functions).
+uint8_t json_writer_finish(json_writer_t *writer);
+
+#endif // __INCLUDE_GUARD__JSON_WRITER_H__
@@ -0,0 +1,80 @@
+// timing_probe.h
+// Named timing probes: count, min, max and mean time of code regions, in core clock cycles (DWT
+// CYCCNT, see timing_helpers.h; call cycle_counter_init() first). On the host build, the clock is
+// clock_gettime(CLOCK_MONOTONIC) and one "cycle" is 1 ns.
+// With TIMING_PROBES_ENABLED set to 0, the macros below compile to nothing.
+
+#ifndef __INCLUDE_GUARD__TIMING_PROBE_H__
+#define __INCLUDE_GUARD__TIMING_PROBE_H__
+
+#include <stdint.h>
+
+#ifndef TIMING_PROBES_ENABLED
+#define TIMING_PROBES_ENABLED 1
+#endif
+
+// tx: transport->send(). poll: from the end of send() until poll() returns 1 (the EPS response
+// time, including sleep). rx: transport->receive() and the STAT check. unpack: eps_decode_fields().
+// json: the eps_*_TO_json() string wrappers.
+#define TIMING_PROBES(X) \
+	X(TIMING_PROBE_ID_TX, "tx") \
+	X(TIMING_PROBE_ID_POLL, "poll") \
+	X(TIMING_PROBE_ID_RX, "rx") \
+	X(TIMING_PROBE_ID_UNPACK, "unpack") \
+	X(TIMING_PROBE_ID_JSON, "json") \
+	X(TIMING_PROBE_ID_CONVERT, "convert")
+
+#define TIMING_PROBE_ID_ENUM_ENTRY(id, name) id,
+typedef enum {
+	TIMING_PROBES(TIMING_PROBE_ID_ENUM_ENTRY)
+	TIMING_PROBE_ID_COUNT
+} timing_probe_id_t;
+
+typedef struct {
+	uint32_t count;
+	uint32_t min_cycles;
+	uint32_t max_cycles;
+	uint64_t total_cycles;
+	uint32_t begin_cycles; // set by TIMING_PROBE_BEGIN()
+} timing_probe_stats_t;
+
+typedef struct {
+	timing_probe_id_t id;
+	uint32_t begin_cycles;
+} timing_probe_scope_t;
+
+#if TIMING_PROBES_ENABLED
+
+uint32_t timing_probe_now(void);
+void timing_probe_record(timing_probe_id_t id, uint32_t cycles);
+void timing_probe_begin(timing_probe_id_t id);
+void timing_probe_end(timing_probe_id_t id);
+void timing_probe_scope_end(const timing_probe_scope_t *scope);
+
+void timing_probe_reset_all(void);
+const timing_probe_stats_t* timing_probe_get(timing_probe_id_t id);
+// One line per probe that has run: "Probe unpack: count=5, min=1234, mean=1500, max=2000 cycles (mean 12 us)"
+void timing_probe_debug_print_all(void);
+
+// Times the rest of the enclosing block (recorded when it goes out of scope, including on return).
+// At most one per block.
+#define TIMING_PROBE_SCOPE(id) \
+	const timing_probe_scope_t timing_probe_scope __attribute__((cleanup(timing_probe_scope_end))) = \
+			{ (id), timing_probe_now() }
+// For regions that span functions. Only one region per probe at a time.
+#define TIMING_PROBE_BEGIN(id) timing_probe_begin(id)
+#define TIMING_PROBE_END(id) timing_probe_end(id)
+#define TIMING_PROBE_RESET_ALL() timing_probe_reset_all()
+#define TIMING_PROBE_PRINT_ALL() timing_probe_debug_print_all()
+
+#else
+
+#define TIMING_PROBE_SCOPE(id) do {} while (0)
+#define TIMING_PROBE_BEGIN(id) do {} while (0)
+#define TIMING_PROBE_END(id) do {} while (0)
+#define TIMING_PROBE_RESET_ALL() do {} while (0)
+#define TIMING_PROBE_PRINT_ALL() do {} while (0)
+
+#endif // TIMING_PROBES_ENABLED
+
+#endif // __INCLUDE_GUARD__TIMING_PROBE_H__
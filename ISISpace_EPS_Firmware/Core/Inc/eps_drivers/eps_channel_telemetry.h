@@ -0,0 +1,40 @@
+#ifndef __INCLUDE_GUARD__EPS_CHANNEL_TELEMETRY_H__
+#define __INCLUDE_GUARD__EPS_CHANNEL_TELEMETRY_H__
+
+#include "eps_drivers/eps_types.h"
+
+#include <stdint.h>
+
+// Channel telemetry in columns (eps_channel_telemetry_t), and kernels over one column of
+// EPS_CHANNEL_TELEMETRY_CHANNEL_COUNT int16 values (e.g., every channel's current).
+// On the target, the kernels work on two channels per instruction with the Cortex-M4 DSP (SIMD)
+// instructions. Other builds (e.g., the host build) use plain loops, which the compiler can
+// vectorise. Both give the same results.
+// Channel masks are bit i for channel i, like the on/overcurrent bitfields (see eps_channel_telemetry_on_mask()).
+
+typedef struct {
+	int16_t min;
+	int16_t max;
+	uint8_t min_channel; // lowest channel with the min value
+	uint8_t max_channel; // lowest channel with the max value
+} eps_channel_min_max_t;
+
+
+// Fetch the PDU/PIU housekeeping data (eng) straight into columns. Same return values as
+// eps_get_pdu/piu_housekeeping_data_eng() (and goes through the same housekeeping cache).
+uint8_t eps_get_pdu_channel_telemetry(eps_channel_telemetry_t *result_dest);
+uint8_t eps_get_piu_channel_telemetry(eps_channel_telemetry_t *result_dest);
+
+uint32_t eps_channel_telemetry_on_mask(const eps_channel_telemetry_t *telemetry);
+uint32_t eps_channel_telemetry_overcurrent_fault_mask(const eps_channel_telemetry_t *telemetry);
+
+int32_t eps_channel_sum(const int16_t column[]);
+void eps_channel_min_max(const int16_t column[], eps_channel_min_max_t *result_dest);
+
+// Bit i is set if column[i] > threshold
+uint32_t eps_channel_threshold_mask(const int16_t column[], int16_t threshold);
+
+// delta_dest[i] = column[i] - previous[i], saturated to the int16 range
+void eps_channel_delta(const int16_t column[], const int16_t previous[], int16_t delta_dest[]);
+
+#endif /* __INCLUDE_GUARD__EPS_CHANNEL_TELEMETRY_H__ */
@@ -0,0 +1,93 @@
+
+#ifndef __INCLUDE_GUARD__EPS_CMD_QUEUE_H__
+#define __INCLUDE_GUARD__EPS_CMD_QUEUE_H__
+
+#include <stdint.h>
+
+// Non-blocking EPS command queue.
+// eps_cmd_queue_submit() copies the command into a fixed-size queue and returns right away.
+// eps_cmd_queue_pump() advances the in-flight transaction on the selected transport, starts the
+// next one when it finishes, and calls each command's callback with the result.
+// Call the pump often (e.g., every main loop iteration). Callbacks run inside the pump, so they
+// must be short and must not call the blocking eps_* functions.
+// Submit from one context only (e.g., the main loop). The pump ignores nested calls, so it may
+// also be called from an interrupt (as long as the callbacks are interrupt-safe).
+//
+// Each priority class has its own queue. The pump always starts the oldest command of the highest
+// class that has one. A transaction already on the bus is never interrupted, so a safety command
+// waits at most for one transaction, plus any safety commands queued before it. Over I2C, one
+// transaction can take up to EPS_LATENCY_MODEL_MAX_TIMEOUT_MS (250 ms) for the response plus
+// EPS_I2C_TRANSFER_HUNG_MARGIN_MS (50 ms) before a hung transfer is aborted, so about 300 ms plus
+// the transfer time. Over UART, EPS_MAX_RESPONSE_POLL_TIME_MS plus the transfer time.
+
+#define EPS_CMD_QUEUE_LEN 8 // max number of queued commands per class, not counting the in-flight one; power of 2
+#define EPS_CMD_MAX_LEN 14 // largest command (eps_set_configuration_parameter)
+
+#define EPS_CMD_QUEUE_FULL 5 // eps_cmd_queue_submit() result; same meaning as "try again later"
+
+typedef enum {
+	EPS_CMD_PRIORITY_SAFETY = 0, // watchdog, mode changes, reset, cancel
+	EPS_CMD_PRIORITY_CONTROL = 1, // output bus switching, configuration, time
+	EPS_CMD_PRIORITY_TELEMETRY = 2, // status and housekeeping reads
+} EPS_CMD_PRIORITY_enum_t;
+
+#define EPS_CMD_PRIORITY_COUNT 3
+
+// result_code: same as eps_send_cmd_get_response (0=success, 1=bad args, 2=tx error,
+// 3=rx error, 4=no response in time). rx_buf is the one passed to eps_cmd_queue_submit().
+typedef void (*eps_cmd_callback_t)(uint8_t result_code, const uint8_t rx_buf[], uint16_t rx_buf_len, void *context);
+
+typedef struct {
+	uint8_t cmd_buf[EPS_CMD_MAX_LEN];
+	uint8_t cmd_buf_len;
+
+	uint8_t *rx_buf; // must stay valid until the callback is called
+	uint16_t rx_buf_len;
+
+	eps_cmd_callback_t callback; // may be NULL
+	void *context;
+
+	EPS_CMD_PRIORITY_enum_t priority;
+	uint32_t submit_time_ms;
+} eps_cmd_t;
+
+typedef struct {
+	uint32_t submitted_count;
+	uint32_t dispatched_count; // started on the transport (or failed to start)
+	uint32_t rejected_full_count; // eps_cmd_queue_submit() returned EPS_CMD_QUEUE_FULL
+	uint8_t max_depth; // high-water mark of queued commands
+
+	// time from submit to dispatch; mean = total_wait_ms / dispatched_count
+	uint32_t total_wait_ms;
+	uint32_t max_wait_ms;
+} eps_cmd_queue_class_stats_t;
+
+typedef struct {
+	uint32_t completed_count; // includes failed commands
+	uint32_t failed_count;
+	eps_cmd_queue_class_stats_t each_class[EPS_CMD_PRIORITY_COUNT];
+} eps_cmd_queue_stats_t;
+
+
+EPS_CMD_PRIORITY_enum_t eps_cmd_get_priority(uint8_t command_code);
+
+// Class chosen from the command code with eps_cmd_get_priority()
+uint8_t eps_cmd_queue_submit(
+		const uint8_t cmd_buf[], uint8_t cmd_buf_len,
+		uint8_t rx_buf[], uint16_t rx_buf_len,
+		eps_cmd_callback_t callback, void *context);
+
+uint8_t eps_cmd_queue_submit_with_priority(
+		EPS_CMD_PRIORITY_enum_t priority,
+		const uint8_t cmd_buf[], uint8_t cmd_buf_len,
+		uint8_t rx_buf[], uint16_t rx_buf_len,
+		eps_cmd_callback_t callback, void *context);
+
+void eps_cmd_queue_pump();
+
+uint8_t eps_cmd_queue_get_depth(EPS_CMD_PRIORITY_enum_t priority);
+uint8_t eps_cmd_queue_is_idle();
+uint8_t eps_cmd_queue_is_pumping();
+const eps_cmd_queue_stats_t* eps_cmd_queue_get_stats();
+
+#endif /* __INCLUDE_GUARD__EPS_CMD_QUEUE_H__ */
@@ -0,0 +1,84 @@
+
+#ifndef __INCLUDE_GUARD__EPS_CMD_TABLE_H__
+#define __INCLUDE_GUARD__EPS_CMD_TABLE_H__
+
+#include "eps_drivers/eps_field_decoder.h"
+
+#include <stdint.h>
+
+// Table of every EPS command (ESP_SICD Section 3), and one executor that runs any of them.
+// The eps_* functions in eps_commands.c are thin wrappers around eps_cmd_execute(). Anything that
+// should happen on every command (tracing, stats, caching) belongs in eps_cmd_execute().
+
+#define EPS_CMD_MAX_RX_LEN 274 // PIU housekeeping
+
+typedef enum {
+	EPS_CMD_ID_SYSTEM_RESET = 0,
+	EPS_CMD_ID_NO_OPERATION,
+	EPS_CMD_ID_CANCEL_OPER,
+	EPS_CMD_ID_WATCHDOG,
+	EPS_CMD_ID_OUTPUT_BUS_GROUP_ON,
+	EPS_CMD_ID_OUTPUT_BUS_GROUP_OFF,
+	EPS_CMD_ID_OUTPUT_BUS_GROUP_STATE,
+	EPS_CMD_ID_OUTPUT_BUS_CHANNEL_ON,
+	EPS_CMD_ID_OUTPUT_BUS_CHANNEL_OFF,
+	EPS_CMD_ID_SWITCH_TO_NOMINAL_MODE,
+	EPS_CMD_ID_SWITCH_TO_SAFETY_MODE,
+	EPS_CMD_ID_GET_SYSTEM_STATUS,
+	EPS_CMD_ID_GET_PDU_OVERCURRENT_FAULT_STATE,
+	EPS_CMD_ID_GET_PBU_ABF_PLACED_STATE,
+	EPS_CMD_ID_GET_PDU_HOUSEKEEPING_DATA_RAW,
+	EPS_CMD_ID_GET_PDU_HOUSEKEEPING_DATA_ENG,
+	EPS_CMD_ID_GET_PDU_HOUSEKEEPING_DATA_RUNNING_AVERAGE,
+	EPS_CMD_ID_GET_PBU_HOUSEKEEPING_DATA_RAW,
+	EPS_CMD_ID_GET_PBU_HOUSEKEEPING_DATA_ENG,
+	EPS_CMD_ID_GET_PBU_HOUSEKEEPING_DATA_RUNNING_AVERAGE,
+	EPS_CMD_ID_GET_PCU_HOUSEKEEPING_DATA_RAW,
+	EPS_CMD_ID_GET_PCU_HOUSEKEEPING_DATA_ENG,
+	EPS_CMD_ID_GET_PCU_HOUSEKEEPING_DATA_RUNNING_AVERAGE,
+	EPS_CMD_ID_GET_CONFIGURATION_PARAMETER,
+	EPS_CMD_ID_SET_CONFIGURATION_PARAMETER,
+	EPS_CMD_ID_RESET_CONFIGURATION_PARAMETER,
+	EPS_CMD_ID_RESET_CONFIGURATION,
+	EPS_CMD_ID_LOAD_CONFIGURATION,
+	EPS_CMD_ID_SAVE_CONFIGURATION,
+	EPS_CMD_ID_GET_PIU_HOUSEKEEPING_DATA_RAW,
+	EPS_CMD_ID_GET_PIU_HOUSEKEEPING_DATA_ENG,
+	EPS_CMD_ID_GET_PIU_HOUSEKEEPING_DATA_RUNNING_AVERAGE,
+	EPS_CMD_ID_CORRECT_TIME,
+	EPS_CMD_ID_ZERO_RESET_CAUSE_COUNTERS,
+	EPS_CMD_ID_COUNT,
+} EPS_CMD_ID_enum_t;
+
+// Decodes a successful response into result_dest. Returns 0, or an error code (e.g., 20/21 for
+// invalid ABF bytes).
+typedef uint8_t (*eps_cmd_decoder_t)(const uint8_t rx_buf[], void *result_dest);
+
+typedef struct {
+	uint8_t CC;
+
+	// Command arguments, after STID/IVID/CC/BID: the key byte (if has_key), then arg_len bytes of
+	// the caller's argument, little-endian. Any bytes after that, up to cmd_len, are 0.
+	uint8_t cmd_len;
+	uint8_t has_key;
+	uint8_t key;
+	uint8_t arg_len; // 0 to 4
+
+	uint16_t rx_len;
+	eps_cmd_decoder_t decoder; // for responses that need checks; NULL otherwise
+	const eps_field_table_t *fields; // for plain layouts; NULL otherwise. Used instead of decoder.
+} eps_cmd_descriptor_t;
+
+
+extern const eps_cmd_descriptor_t eps_cmd_table[EPS_CMD_ID_COUNT];
+
+uint8_t eps_cmd_execute(EPS_CMD_ID_enum_t cmd_id, uint32_t arg, void *result_dest);
+
+// Same as eps_cmd_execute(), but decodes the response with `fields` instead of the command's own
+// layout, e.g., into a differently shaped struct. Returns 1 if the table is for another rx_len.
+uint8_t eps_cmd_execute_with_fields(EPS_CMD_ID_enum_t cmd_id, uint32_t arg, const eps_field_table_t *fields, void *result_dest);
+
+// Index in eps_cmd_table of the command with this command code, or EPS_CMD_ID_COUNT if none.
+EPS_CMD_ID_enum_t eps_cmd_find_id(uint8_t CC);
+
+#endif /* __INCLUDE_GUARD__EPS_CMD_TABLE_H__ */
@@ -6,6 +6,10 @@
 
 #include <stdint.h>
 
+// Superseded by eps_hk_stats_get_*_running_average() (eps_hk_stats.h), which averages on the OBC
+// without another round trip. Kept for the EPS commands (0x54/0x64/0x74/0xA4).
+#define EPS_SUPERSEDED_BY_HK_STATS __attribute__((deprecated("use eps_hk_stats_get_*_running_average()")))
+
 uint8_t eps_system_reset();
 uint8_t eps_no_operation();
 uint8_t eps_cancel_oper();
@@ -22,13 +26,13 @@ uint8_t eps_get_pdu_overcurrent_fault_state(eps_result_pdu_overcurrent_fault_sta
 uint8_t eps_get_pbu_abf_placed_state(eps_result_pbu_abf_placed_state_t* result_dest);
 uint8_t eps_get_pdu_housekeeping_data_raw(eps_result_pdu_housekeeping_data_raw_t* result_dest);
 uint8_t eps_get_pdu_housekeeping_data_eng(eps_result_pdu_housekeeping_data_eng_t* result_dest);
-uint8_t eps_get_pdu_housekeeping_data_running_average(eps_result_pdu_housekeeping_data_eng_t* result_dest);
+uint8_t eps_get_pdu_housekeeping_data_running_average(eps_result_pdu_housekeeping_data_eng_t* result_dest) EPS_SUPERSEDED_BY_HK_STATS;
 uint8_t eps_get_pbu_housekeeping_data_raw(eps_result_pbu_housekeeping_data_raw_t* result_dest);
 uint8_t eps_get_pbu_housekeeping_data_eng(eps_result_pbu_housekeeping_data_eng_t* result_dest);
-uint8_t eps_get_pbu_housekeeping_data_running_average(eps_result_pbu_housekeeping_data_eng_t* result_dest);
+uint8_t eps_get_pbu_housekeeping_data_running_average(eps_result_pbu_housekeeping_data_eng_t* result_dest) EPS_SUPERSEDED_BY_HK_STATS;
 uint8_t eps_get_pcu_housekeeping_data_raw(eps_result_pcu_housekeeping_data_raw_t* result_dest);
 uint8_t eps_get_pcu_housekeeping_data_eng(eps_result_pcu_housekeeping_data_eng_t* result_dest);
-uint8_t eps_get_pcu_housekeeping_data_running_average(eps_result_pcu_housekeeping_data_eng_t* result_dest);
+uint8_t eps_get_pcu_housekeeping_data_running_average(eps_result_pcu_housekeeping_data_eng_t* result_dest) EPS_SUPERSEDED_BY_HK_STATS;
 uint8_t eps_get_configuration_parameter(uint16_t parameter_id, uint8_t parameter_value_dest[]);
 uint8_t eps_set_configuration_parameter(uint16_t parameter_id, uint8_t new_parameter_value);
 uint8_t eps_reset_configuration_parameter(uint16_t parameter_id);
@@ -37,7 +41,7 @@ uint8_t eps_load_configuration();
 uint8_t eps_save_configuration();
 uint8_t eps_get_piu_housekeeping_data_raw(eps_result_piu_housekeeping_data_raw_t* result_dest);
 uint8_t eps_get_piu_housekeeping_data_eng(eps_result_piu_housekeeping_data_eng_t* result_dest);
-uint8_t eps_get_piu_housekeeping_data_running_average(eps_result_piu_housekeeping_data_eng_t* result_dest);
+uint8_t eps_get_piu_housekeeping_data_running_average(eps_result_piu_housekeeping_data_eng_t* result_dest) EPS_SUPERSEDED_BY_HK_STATS;
 uint8_t eps_correct_time(int32_t time_correction);
 uint8_t eps_zero_reset_cause_counters();
 
@@ -5,7 +5,11 @@
 #include "eps_drivers/eps_types.h"
 
 void eps_debug_uart_print_system_status(eps_result_system_status_t* system_status);
+void eps_debug_uart_print_cmd_queue_stats();
+void eps_debug_uart_print_link_stats_json(); // see eps_link_stats.h
+void eps_debug_uart_print_hk_cache_stats(); // see eps_hk_cache.h
 
 void eps_result_pdu_housekeeping_data_eng_to_json(const eps_result_pdu_housekeeping_data_eng_t *data, char json_output_str[]);
+void eps_debug_uart_print_pdu_housekeeping_data_eng_json(const eps_result_pdu_housekeeping_data_eng_t *data);
 
 #endif /* __INCLUDE_GUARD__EPS_DEBUG_TOOLS_H__ */
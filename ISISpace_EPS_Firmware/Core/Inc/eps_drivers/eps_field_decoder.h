@@ -0,0 +1,64 @@
+
+#ifndef __INCLUDE_GUARD__EPS_FIELD_DECODER_H__
+#define __INCLUDE_GUARD__EPS_FIELD_DECODER_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Response layouts, as tables of fields, and one loop that decodes any of them into the matching
+// eps_result_*_t struct.
+// Each descriptor is a run of `repeat` little-endian values of `width` bytes, starting at
+// rx_buf[src_offset], copied to the struct starting at dest_offset. Most responses are a few long
+// runs of 16-bit values, as the result structs mirror the ICD field order.
+
+typedef struct {
+	uint16_t src_offset; // index in rx_buf of the first value
+	uint16_t dest_offset; // offsetof() the first value in the result struct
+	uint8_t width; // bytes per value in rx_buf: 1, 2 or 4
+	uint8_t dest_width; // bytes per value in the struct: 1, 2 or 4 (>= width)
+	uint8_t is_signed; // sign-extend when dest_width > width
+	uint8_t repeat; // number of values
+	uint8_t src_stride; // bytes between values in rx_buf
+	uint8_t dest_stride; // bytes between values in the struct
+} eps_field_descriptor_t;
+
+typedef struct {
+	const eps_field_descriptor_t *fields;
+	uint8_t field_count;
+	uint16_t rx_len; // response length this layout is for
+} eps_field_table_t;
+
+// A run of `count` contiguous values, same width in rx_buf and in the struct
+#define EPS_FIELD_RUN(src_offset, type, member, width, count) \
+	{ (src_offset), offsetof(type, member), (width), (width), 0, (count), (width), (width) }
+
+// A run of `count` 16-bit values, `src_stride` bytes apart in rx_buf (e.g., one member of an array
+// of VIPD), to a contiguous array in the struct
+#define EPS_FIELD_COLUMN(src_offset, type, member, count, src_stride) \
+	{ (src_offset), offsetof(type, member), 2, 2, 0, (count), (src_stride), 2 }
+
+extern const eps_field_table_t eps_field_table_system_status;
+extern const eps_field_table_t eps_field_table_pdu_overcurrent_fault_state;
+extern const eps_field_table_t eps_field_table_pdu_housekeeping_data_raw;
+extern const eps_field_table_t eps_field_table_pdu_housekeeping_data_eng;
+extern const eps_field_table_t eps_field_table_pbu_housekeeping_data_raw;
+extern const eps_field_table_t eps_field_table_pbu_housekeeping_data_eng;
+extern const eps_field_table_t eps_field_table_pcu_housekeeping_data_raw;
+extern const eps_field_table_t eps_field_table_pcu_housekeeping_data_eng;
+extern const eps_field_table_t eps_field_table_piu_housekeeping_data_raw;
+extern const eps_field_table_t eps_field_table_piu_housekeeping_data_eng;
+extern const eps_field_table_t eps_field_table_pdu_channel_telemetry; // 0x52 into eps_channel_telemetry_t
+extern const eps_field_table_t eps_field_table_piu_channel_telemetry; // 0xA2 into eps_channel_telemetry_t
+
+
+void eps_decode_fields(const eps_field_table_t *table, const uint8_t rx_buf[], void *result_dest);
+
+// Finds where the struct value at dest_offset comes from in rx_buf. Returns 0 on success, or 1 if
+// no field in the table covers dest_offset.
+uint8_t eps_field_locate(const eps_field_table_t *table, uint16_t dest_offset,
+		uint16_t *src_offset_dest, const eps_field_descriptor_t **field_dest);
+
+// Reads one value of a field, as eps_decode_fields() would store it (before the cast to the struct's type).
+uint32_t eps_field_read_value(const eps_field_descriptor_t *field, const uint8_t *src);
+
+#endif /* __INCLUDE_GUARD__EPS_FIELD_DECODER_H__ */
@@ -0,0 +1,62 @@
+#ifndef __INCLUDE_GUARD__EPS_HK_CACHE_H__
+#define __INCLUDE_GUARD__EPS_HK_CACHE_H__
+
+#include "eps_drivers/eps_cmd_table.h"
+#include "eps_drivers/eps_cmd_queue.h"
+
+#include <stdint.h>
+
+// Response cache for the housekeeping reads (and any other command without arguments), keyed by
+// command code. eps_cmd_execute() goes through it for every command with a max age > 0, so the
+// eps_get_*_housekeeping_data_* functions return the cached response when it's young enough.
+// - Max age: per command, set with eps_hk_cache_set_max_age_ms() (0 disables caching).
+//   Defaults to EPS_HK_CACHE_DEFAULT_MAX_AGE_MS for the PDU/PBU/PCU/PIU housekeeping commands.
+// - Single flight: requests for a command that's already on its way (in the command queue or on the
+//   bus) wait for that transaction, instead of queueing their own.
+// - Stale-while-revalidate (EPS_HK_CACHE_MODE_ALLOW_STALE): for readers that don't need the latest
+//   value. A too-old response is returned right away, and a refresh is queued in the background.
+// Only responses with a successful STAT are cached. Failed transactions are passed on to everyone
+// waiting for them, and leave the previous response in the cache.
+//
+// Each entry has two buffers, so the cached response stays readable while its refresh is on the bus.
+// Entries are assigned to command codes as needed; the least recently used one is reused.
+// Call from the same context as eps_cmd_queue_submit() (e.g., the main loop).
+
+#define EPS_HK_CACHE_ENTRY_COUNT 4 // one per board, for the usual case of one HK read per board
+#define EPS_HK_CACHE_MAX_WAITERS 4 // per entry, while its transaction is in flight
+#define EPS_HK_CACHE_DEFAULT_MAX_AGE_MS 200
+
+typedef enum {
+	EPS_HK_CACHE_MODE_FRESH = 0, // response no older than the max age (waits for the bus if needed)
+	EPS_HK_CACHE_MODE_ALLOW_STALE = 1, // any cached response; refreshed in the background if too old
+} EPS_HK_CACHE_MODE_enum_t;
+
+typedef struct {
+	uint32_t hit_count; // fresh response from the cache
+	uint32_t stale_count; // too-old response returned with EPS_HK_CACHE_MODE_ALLOW_STALE
+	uint32_t miss_count; // had to wait for the bus (including coalesced requests)
+	uint32_t coalesced_count; // misses that joined a transaction already in flight
+	uint32_t fetch_count; // transactions submitted to the command queue
+	uint32_t fetch_failed_count; // transactions that failed, or returned an error STAT
+	uint32_t rejected_count; // no free entry or waiter slot, or the command queue was full
+} eps_hk_cache_stats_t;
+
+
+uint8_t eps_hk_cache_set_max_age_ms(EPS_CMD_ID_enum_t cmd_id, uint32_t max_age_ms); // 1 if the command takes arguments
+uint32_t eps_hk_cache_get_max_age_ms(EPS_CMD_ID_enum_t cmd_id);
+
+// Non-blocking. The callback gets the response (rx_buf is only valid during the call), or the
+// error code of the transaction; it's called before this returns when the cache can answer.
+// Returns 0, 1 on invalid args or a command that isn't cached, or EPS_CMD_QUEUE_FULL (try again
+// later).
+uint8_t eps_hk_cache_request(
+		EPS_CMD_ID_enum_t cmd_id, EPS_HK_CACHE_MODE_enum_t mode,
+		eps_cmd_callback_t callback, void *context);
+
+// Blocking, like eps_send_cmd_get_response(). rx_buf must hold eps_cmd_table[cmd_id].rx_len bytes.
+uint8_t eps_hk_cache_read(EPS_CMD_ID_enum_t cmd_id, EPS_HK_CACHE_MODE_enum_t mode, uint8_t rx_buf[]);
+
+void eps_hk_cache_invalidate_all();
+const eps_hk_cache_stats_t* eps_hk_cache_get_stats();
+
+#endif /* __INCLUDE_GUARD__EPS_HK_CACHE_H__ */
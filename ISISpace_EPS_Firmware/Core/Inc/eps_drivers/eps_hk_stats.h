@@ -0,0 +1,60 @@
+#ifndef __INCLUDE_GUARD__EPS_HK_STATS_H__
+#define __INCLUDE_GUARD__EPS_HK_STATS_H__
+
+#include "eps_drivers/eps_cmd_queue.h"
+#include "eps_drivers/eps_raw_to_eng.h"
+#include "eps_drivers/eps_stats.h"
+#include "eps_drivers/eps_types.h"
+
+#include <stdint.h>
+
+// Running average of the housekeeping data, kept on the OBC from the eng snapshots, instead of the
+// EPS's running-average commands (0x54/0x64/0x74/0xA4): no extra round trip, and the window length
+// is ours to choose.
+// One eps_stats_t per board, with one series per 16-bit word of the board's *_eng_t struct (so the
+// 32 channels' voltages, currents and powers are each a series). Bitfield words aren't averaged:
+// the running average and EWMA report their latest value.
+//
+// Feed it once per fresh snapshot, with eps_hk_stats_request_sample() (non-blocking, through the
+// housekeeping cache; e.g., from a scheduler job), eps_hk_stats_sample() (blocking), or with
+// eps_hk_stats_update_*() for a snapshot fetched elsewhere. Sample no faster than the housekeeping
+// cache's max age, or the same response is counted more than once.
+
+#define EPS_HK_STATS_MAX_WINDOW_LEN 16
+#define EPS_HK_STATS_DEFAULT_WINDOW_LEN 8
+#define EPS_HK_STATS_DEFAULT_EWMA_SHIFT 3 // alpha = 1/8
+
+// Returns 0, or 1 if out of range (see eps_stats_init()). Resets the board's statistics.
+uint8_t eps_hk_stats_configure(EPS_BOARD_enum_t board, uint8_t window_len, uint8_t ewma_shift);
+void eps_hk_stats_reset_all(); // every board back to the defaults, no samples
+
+void eps_hk_stats_update_pdu(const eps_result_pdu_housekeeping_data_eng_t *data);
+void eps_hk_stats_update_pbu(const eps_result_pbu_housekeeping_data_eng_t *data);
+void eps_hk_stats_update_pcu(const eps_result_pcu_housekeeping_data_eng_t *data);
+void eps_hk_stats_update_piu(const eps_result_piu_housekeeping_data_eng_t *data);
+
+// Fetches the board's eng housekeeping data and adds it. Same return values as eps_get_*_housekeeping_data_eng().
+uint8_t eps_hk_stats_sample(EPS_BOARD_enum_t board);
+
+// Requests the board's eng housekeeping data from the cache, and adds it when the response comes
+// (in the command queue's pump; failed reads are counted and skipped). Returns 0, 1 for an invalid
+// board, or EPS_CMD_QUEUE_FULL (try again next time). Call from the eps_cmd_queue_submit() context.
+uint8_t eps_hk_stats_request_sample(EPS_BOARD_enum_t board);
+uint32_t eps_hk_stats_get_failed_sample_count();
+
+// Window mean (the replacement for eps_get_*_housekeeping_data_running_average()), or EWMA.
+// Return 0, or 1 if the board has no samples yet.
+uint8_t eps_hk_stats_get_pdu_running_average(eps_result_pdu_housekeeping_data_eng_t *result_dest);
+uint8_t eps_hk_stats_get_pbu_running_average(eps_result_pbu_housekeeping_data_eng_t *result_dest);
+uint8_t eps_hk_stats_get_pcu_running_average(eps_result_pcu_housekeeping_data_eng_t *result_dest);
+uint8_t eps_hk_stats_get_piu_running_average(eps_result_piu_housekeeping_data_eng_t *result_dest);
+uint8_t eps_hk_stats_get_pdu_ewma(eps_result_pdu_housekeeping_data_eng_t *result_dest);
+uint8_t eps_hk_stats_get_pbu_ewma(eps_result_pbu_housekeeping_data_eng_t *result_dest);
+uint8_t eps_hk_stats_get_pcu_ewma(eps_result_pcu_housekeeping_data_eng_t *result_dest);
+uint8_t eps_hk_stats_get_piu_ewma(eps_result_piu_housekeeping_data_eng_t *result_dest);
+
+// The board's statistics, for min/max and variance. Series `i` is the struct's 16-bit word at
+// offsetof(*_eng_t, field) / 2.
+const eps_stats_t* eps_hk_stats_get(EPS_BOARD_enum_t board);
+
+#endif /* __INCLUDE_GUARD__EPS_HK_STATS_H__ */
@@ -0,0 +1,72 @@
+
+#ifndef __INCLUDE_GUARD__EPS_I2C_POLL_ENGINE_H__
+#define __INCLUDE_GUARD__EPS_I2C_POLL_ENGINE_H__
+
+#include "main.h"
+#include "eps_drivers/eps_latency_model.h"
+
+#include <stdint.h>
+
+// Non-blocking I2C command/response state machine for the EPS.
+// 1. The command is sent with HAL_I2C_Master_Transmit_IT.
+// 2. The EPS is polled by reading only the first byte of the response, until it is not 0xFF
+//    (the "not ready" value). The first poll and the spacing of the rest come from an
+//    eps_poll_timing_t (see eps_latency_model.h).
+// 3. The full response is then read in a single DMA transfer.
+// Each step is kicked off from the HAL I2C callbacks, or from eps_i2c_poll_engine_service(), which
+// is called from the SysTick interrupt. The CPU is free (or in WFI) for the whole transaction.
+
+#define EPS_I2C_NOT_READY_BYTE 0xFF
+
+// Extra time allowed for a single I2C transfer to finish before it's considered hung and aborted.
+#define EPS_I2C_TRANSFER_HUNG_MARGIN_MS 50
+
+typedef enum {
+	EPS_I2C_POLL_ENGINE_STATE_IDLE = 0,
+	EPS_I2C_POLL_ENGINE_STATE_TX = 1, // command being transmitted
+	EPS_I2C_POLL_ENGINE_STATE_POLL_WAIT = 2, // waiting for the next poll
+	EPS_I2C_POLL_ENGINE_STATE_POLL_RX = 3, // reading the first byte of the response
+	EPS_I2C_POLL_ENGINE_STATE_RX = 4, // reading the full response via DMA
+	EPS_I2C_POLL_ENGINE_STATE_DONE = 5,
+	EPS_I2C_POLL_ENGINE_STATE_ERROR = 6,
+} EPS_I2C_POLL_ENGINE_STATE_enum_t;
+
+typedef struct {
+	I2C_HandleTypeDef *hi2c;
+	volatile EPS_I2C_POLL_ENGINE_STATE_enum_t state;
+
+	uint8_t *rx_buf;
+	uint16_t rx_buf_len;
+	uint8_t poll_byte; // first byte of the response, read on each poll
+
+	uint32_t start_rx_time_ms;
+	uint32_t next_poll_time_ms;
+	eps_poll_timing_t timing;
+	uint16_t rx_retry_count; // number of polls that returned "not ready"
+
+	// When the last "not ready" poll (0 if none) and the "ready" poll started, from start_rx_time_ms
+	uint32_t last_not_ready_ms;
+	uint32_t ready_ms;
+
+	// Result, once state is DONE or ERROR. Same codes as eps_send_cmd_get_response_i2c:
+	// 0=success, 2=tx error, 3=rx error, 4=no response within the poll time.
+	uint8_t result_code;
+	uint32_t hal_i2c_error; // hi2c->ErrorCode when the error happened
+} eps_i2c_poll_engine_t;
+
+
+uint8_t eps_i2c_poll_engine_start(
+		I2C_HandleTypeDef *hi2c,
+		const uint8_t cmd_buf[], uint8_t cmd_buf_len,
+		uint8_t rx_buf[], uint16_t rx_buf_len,
+		const eps_poll_timing_t *timing);
+
+uint8_t eps_i2c_poll_engine_is_busy();
+const eps_i2c_poll_engine_t* eps_i2c_poll_engine_get();
+
+void eps_i2c_poll_engine_service();
+// Next get_uptime_ms() time at which eps_i2c_poll_engine_service() has something to do (the next
+// poll, or the hung-transfer check). Until then, the CPU only needs waking for I2C/DMA interrupts.
+uint32_t eps_i2c_poll_engine_get_next_service_ms();
+
+#endif /* __INCLUDE_GUARD__EPS_I2C_POLL_ENGINE_H__ */
@@ -2,6 +2,9 @@
 #ifndef __INCLUDE_GUARD__EPS_INTERNAL_DRIVERS_H__
 #define __INCLUDE_GUARD__EPS_INTERNAL_DRIVERS_H__
 
+#include "eps_drivers/eps_types.h"
+#include "eps_drivers/eps_transport.h"
+
 #include <stdint.h>
 
 // #pragma region Constants
@@ -12,7 +15,6 @@
 // const uint8_t EPS_COMMAND_IVID = 0x07; // "Interface Version Identifier (IVID)" (Software ICD, page 18)
 // const uint8_t EPS_COMMAND_BID = 0x01; // "Board Identifier (BID)" (Software ICD, page 20)
 // const uint8_t EPS_DEFAULT_RX_LEN_MIN = 5; // for commands with no response params, 5 bytes are returned
-// const uint8_t EPS_ENABLE_DEBUG_PRINT = 1; // bool; 0 to disable
 // const uint32_t EPS_MAX_RESPONSE_POLL_TIME_MS = 100;
 
 #define EPS_I2C_ADDR (0x20 << 1) // EPS I2C address
@@ -23,10 +25,11 @@
 
 #define EPS_DEFAULT_RX_LEN_MIN 5 // for commands with no response params, 5 bytes are returned
 
-#define EPS_ENABLE_DEBUG_PRINT 1 // bool; 0 to disable
-
 #define EPS_MAX_RESPONSE_POLL_TIME_MS 100
 
+#define EPS_UART_RX_DMA_BUF_LEN 512 // circular DMA buffer for UART4; must fit the largest tagged response
+#define EPS_UART_CMD_BUF_WITH_TAGS_MAX_LEN 32 // largest command (14 bytes) + "<cmd></cmd>"
+
 
 // #pragma endregion Constants
 
@@ -39,6 +42,17 @@ uint8_t eps_send_cmd_get_response_uart(const uint8_t cmd_buf[], uint8_t cmd_buf_
         uint8_t rx_buf[], uint16_t rx_buf_len);
 uint8_t eps_send_cmd_get_response(const uint8_t cmd_buf[], uint8_t cmd_buf_len,
         uint8_t rx_buf[], uint16_t rx_buf_len);
+// Pumps the command queue (sleeping in between) until *is_done is set by a command callback
+void eps_wait_for_cmd_queue(const volatile uint8_t *is_done);
+uint8_t eps_send_cmd_get_response_via_transport(const eps_transport_t *transport,
+        const uint8_t cmd_buf[], uint8_t cmd_buf_len,
+        uint8_t rx_buf[], uint16_t rx_buf_len);
+
+uint8_t eps_transport_start_cmd(const eps_transport_t *transport,
+        const uint8_t cmd_buf[], uint8_t cmd_buf_len,
+        uint8_t rx_buf[], uint16_t rx_buf_len);
+uint8_t eps_transport_finish_cmd(const eps_transport_t *transport,
+        const uint8_t rx_buf[], uint16_t rx_buf_len);
 
 uint8_t eps_run_argumentless_cmd(uint8_t command_code);
 
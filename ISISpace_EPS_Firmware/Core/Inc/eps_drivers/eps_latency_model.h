@@ -0,0 +1,61 @@
+#ifndef __INCLUDE_GUARD__EPS_LATENCY_MODEL_H__
+#define __INCLUDE_GUARD__EPS_LATENCY_MODEL_H__
+
+#include "eps_drivers/eps_cmd_table.h"
+
+#include <stdint.h>
+
+// Learns each command code's turnaround time (end of the command to the response being ready), and
+// picks the I2C poll timing from it, like a TCP retransmission timer (RFC 6298):
+//   mean += (sample - mean) / 8,  deviation += (|sample - mean| - deviation) / 4
+// The deviation (mean absolute deviation) stands in for the variance; it needs no multiply or sqrt.
+// - First poll: at the mean plus the deviation (rounded up), so it's usually already ready. Earlier
+//   polls would mostly return "not ready".
+// - Poll interval after that: half the deviation, between 1 and EPS_LATENCY_MODEL_DEFAULT_POLL_INTERVAL_MS.
+// - Timeout: mean + 4 * deviation, plus a margin that grows with the response length, within
+//   EPS_LATENCY_MODEL_MIN/MAX_TIMEOUT_MS. After a timeout, the deviation is doubled (backoff).
+// Until a command code has EPS_LATENCY_MODEL_MIN_SAMPLES samples, the fixed defaults are used
+// (first poll right away, EPS_LATENCY_MODEL_DEFAULT_POLL_INTERVAL_MS, EPS_MAX_RESPONSE_POLL_TIME_MS).
+//
+// A sample is the midpoint between the last "not ready" poll (or the end of the command, when the
+// first poll is right away) and the first "ready" poll, so polling late doesn't bias the mean
+// upwards. When a delayed first poll is already ready, there's no lower bound, so it isn't a
+// sample: the deviation shrinks as for a sample at the mean, and the mean is lowered by
+// 1/2^EPS_LATENCY_MODEL_EARLIER_SHIFT. The first poll then creeps earlier until it's "not ready"
+// again, which gives a real sample (and finds a latency that got shorter).
+
+#define EPS_LATENCY_MODEL_DEFAULT_POLL_INTERVAL_MS 5
+#define EPS_LATENCY_MODEL_MIN_SAMPLES 4
+#define EPS_LATENCY_MODEL_MIN_TIMEOUT_MS 20
+#define EPS_LATENCY_MODEL_MAX_TIMEOUT_MS 250
+#define EPS_LATENCY_MODEL_TIMEOUT_MS_PER_100_BYTES 10 // response length margin
+#define EPS_LATENCY_MODEL_FRAC_BITS 3 // mean and deviation are in 1/8 ms
+#define EPS_LATENCY_MODEL_EARLIER_SHIFT 8 // mean 1/256 lower after each ready delayed first poll
+
+typedef struct {
+	uint32_t mean_q3; // ms << EPS_LATENCY_MODEL_FRAC_BITS
+	uint32_t deviation_q3;
+	uint16_t sample_count;
+	uint16_t timeout_count;
+	uint16_t early_count; // delayed first polls that were already ready (not samples)
+} eps_latency_model_t;
+
+typedef struct {
+	uint32_t first_poll_delay_ms; // from the end of the command
+	uint32_t poll_interval_ms;
+	uint32_t timeout_ms; // max time from the end of the command to the response being ready
+} eps_poll_timing_t;
+
+void eps_latency_model_get_timing(uint8_t CC, uint16_t rx_len, eps_poll_timing_t *timing_dest);
+
+// Response was ready: first_poll_delay_ms is the eps_poll_timing_t the transaction used,
+// last_not_ready_ms the time of the last "not ready" poll (0 if the first poll was ready), and
+// ready_ms the time of the ready poll, all from the end of the command.
+void eps_latency_model_record_ready(uint8_t CC, uint32_t first_poll_delay_ms, uint32_t last_not_ready_ms, uint32_t ready_ms);
+void eps_latency_model_record_timeout(uint8_t CC);
+
+// NULL if the command code isn't in eps_cmd_table
+const eps_latency_model_t* eps_latency_model_get(uint8_t CC);
+void eps_latency_model_reset();
+
+#endif /* __INCLUDE_GUARD__EPS_LATENCY_MODEL_H__ */
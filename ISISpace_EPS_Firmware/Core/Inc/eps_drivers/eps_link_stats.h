@@ -0,0 +1,63 @@
+#ifndef __INCLUDE_GUARD__EPS_LINK_STATS_H__
+#define __INCLUDE_GUARD__EPS_LINK_STATS_H__
+
+#include "debug_tools/json_writer.h"
+#include "eps_drivers/eps_cmd_table.h"
+
+#include <stdint.h>
+
+// Per-command link statistics, recorded for every transaction by eps_transport_start_cmd() and
+// eps_transport_finish_cmd() (so for the command queue and the blocking calls alike).
+// One slot per command code in eps_cmd_table, plus one for any other command code.
+//
+// Histograms use log2 buckets: bucket 0 counts 0, bucket 1 counts 1, bucket 2 counts 2-3,
+// bucket 3 counts 4-7, ..., and the last bucket counts everything from there up.
+// Latency is from sending the command to the end of the response (not counting queue wait), in ms.
+
+#define EPS_LINK_STATS_LATENCY_BUCKET_COUNT 12 // last bucket: >= 1024 ms
+#define EPS_LINK_STATS_RETRY_BUCKET_COUNT 7 // last bucket: >= 32 polls
+#define EPS_LINK_STATS_ERROR_CODE_COUNT 4 // result codes 1 to 4 (see eps_send_cmd_get_response)
+#define EPS_LINK_STATS_STAT_CODE_COUNT 8 // STAT 0x01 to 0x07; index 0 counts any other error STAT
+
+typedef struct {
+	uint8_t CC;
+	uint8_t last_stat_error; // last STAT value that wasn't 0x00/0x80 (0 if none)
+
+	uint32_t call_count;
+	uint32_t error_count[EPS_LINK_STATS_ERROR_CODE_COUNT]; // error_count[code - 1]
+
+	// Responses that arrived, but with an error in the STAT field (rx_buf[4], ESP_SICD Table 3-11)
+	uint32_t stat_error_count[EPS_LINK_STATS_STAT_CODE_COUNT];
+
+	// "Not ready" polls before the response (I2C only; always 0 on other transports)
+	uint32_t retry_histogram[EPS_LINK_STATS_RETRY_BUCKET_COUNT];
+
+	// Transactions that got a response (successful or with a STAT error)
+	uint32_t latency_histogram[EPS_LINK_STATS_LATENCY_BUCKET_COUNT];
+	uint32_t total_latency_ms; // mean = total_latency_ms / sum of latency_histogram
+	uint32_t max_latency_ms;
+} eps_cc_stats_t;
+
+#define EPS_LINK_STATS_SLOT_COUNT (EPS_CMD_ID_COUNT + 1)
+
+
+// result_code: 0 for a response (stat is then rx_buf[4]), or 1 to 4.
+void eps_link_stats_record(uint8_t CC, uint8_t result_code, uint8_t stat, uint16_t retry_count, uint32_t latency_ms);
+
+// NULL if the command code was never sent (or isn't in eps_cmd_table, and no other such code was).
+const eps_cc_stats_t* eps_link_stats_get(uint8_t CC);
+const eps_cc_stats_t* eps_link_stats_get_slot(uint8_t slot); // slot < EPS_LINK_STATS_SLOT_COUNT
+void eps_link_stats_reset();
+
+uint8_t eps_link_stats_get_bucket(uint32_t value, uint8_t bucket_count);
+
+// {"cc":64,"calls":12,"errors":[0,0,0,1],"stat_errors":[0,...],"retries":[...],
+//  "latency_ms":[...],"latency_mean_ms":5,"latency_max_ms":9}
+void eps_cc_stats_TO_json_writer(json_writer_t *writer, const char *key, const eps_cc_stats_t *stats);
+// Array of the objects above, for every command that was sent.
+void eps_link_stats_TO_json_writer(json_writer_t *writer, const char *key);
+// Same, into a null-terminated string. Returns 0 on success, 1 on invalid input, or 3 if
+// json_output_str is too short.
+uint8_t eps_link_stats_TO_json(char json_output_str[], uint16_t json_output_str_len);
+
+#endif /* __INCLUDE_GUARD__EPS_LINK_STATS_H__ */
@@ -0,0 +1,80 @@
+#ifndef __INCLUDE_GUARD__EPS_RAW_TO_ENG_H__
+#define __INCLUDE_GUARD__EPS_RAW_TO_ENG_H__
+
+#include "eps_drivers/eps_types.h"
+
+#include <stdint.h>
+
+// Raw-to-engineering conversion on the OBC, so one raw housekeeping fetch (e.g., 0x50) gives both
+// views, instead of fetching the same 258 bytes again as eng (0x52).
+// Each *_raw_t struct has the same layout as its *_eng_t counterpart (all 16-bit values, same
+// order), so a conversion is one pass over the struct's 16-bit words, with a per-board map of
+// which quantity each word is:
+//   eng = ((raw * gain_q16 + 0x8000) >> 16) + offset
+// Bitfields are copied as they are.
+//
+// Calibration (gain and offset for each quantity of each board) is unit-specific, so there's no
+// built-in default: a board's conversions return 1 until eps_raw_to_eng_set_calibration() (e.g.,
+// with the unit's ICD values) or eps_raw_to_eng_load_calibration() (from the EPS configuration
+// parameters) has given it one.
+
+typedef enum {
+	EPS_BOARD_PDU = 0,
+	EPS_BOARD_PBU = 1,
+	EPS_BOARD_PCU = 2,
+	EPS_BOARD_PIU = 3,
+} EPS_BOARD_enum_t;
+
+#define EPS_BOARD_COUNT 4
+
+typedef enum {
+	EPS_RAW_TO_ENG_QUANTITY_VOLTAGE = 0, // mV
+	EPS_RAW_TO_ENG_QUANTITY_CURRENT = 1, // mA
+	EPS_RAW_TO_ENG_QUANTITY_POWER = 2, // cW
+	EPS_RAW_TO_ENG_QUANTITY_TEMPERATURE = 3, // cC
+} EPS_RAW_TO_ENG_QUANTITY_enum_t;
+
+#define EPS_RAW_TO_ENG_QUANTITY_COUNT 4
+
+typedef struct {
+	int32_t gain_q16; // engineering units per raw count, << 16
+	int32_t offset; // engineering units
+} eps_raw_to_eng_coeff_t;
+
+typedef struct {
+	eps_raw_to_eng_coeff_t each_quantity[EPS_RAW_TO_ENG_QUANTITY_COUNT];
+} eps_raw_to_eng_calibration_t;
+
+
+// Return 0, or 1 if the board has no calibration yet (eng_dest is then unchanged)
+uint8_t eps_result_pdu_housekeeping_data_raw_TO_eng(const eps_result_pdu_housekeeping_data_raw_t *raw, eps_result_pdu_housekeeping_data_eng_t *eng_dest);
+uint8_t eps_result_pbu_housekeeping_data_raw_TO_eng(const eps_result_pbu_housekeeping_data_raw_t *raw, eps_result_pbu_housekeeping_data_eng_t *eng_dest);
+uint8_t eps_result_pcu_housekeeping_data_raw_TO_eng(const eps_result_pcu_housekeeping_data_raw_t *raw, eps_result_pcu_housekeeping_data_eng_t *eng_dest);
+uint8_t eps_result_piu_housekeeping_data_raw_TO_eng(const eps_result_piu_housekeeping_data_raw_t *raw, eps_result_piu_housekeeping_data_eng_t *eng_dest);
+
+// One raw fetch, both views. Same return values as eps_get_*_housekeeping_data_raw(), or 1 (without
+// fetching) if the board has no calibration yet.
+uint8_t eps_get_pdu_housekeeping_data_raw_and_eng(eps_result_pdu_housekeeping_data_raw_t *raw_dest, eps_result_pdu_housekeeping_data_eng_t *eng_dest);
+uint8_t eps_get_pbu_housekeeping_data_raw_and_eng(eps_result_pbu_housekeeping_data_raw_t *raw_dest, eps_result_pbu_housekeeping_data_eng_t *eng_dest);
+uint8_t eps_get_pcu_housekeeping_data_raw_and_eng(eps_result_pcu_housekeeping_data_raw_t *raw_dest, eps_result_pcu_housekeeping_data_eng_t *eng_dest);
+uint8_t eps_get_piu_housekeeping_data_raw_and_eng(eps_result_piu_housekeeping_data_raw_t *raw_dest, eps_result_piu_housekeeping_data_eng_t *eng_dest);
+
+// 1 if the struct's 16-bit word at `word` (offsetof() / 2) is a bitfield, copied as it is
+uint8_t eps_raw_to_eng_is_bitfield_word(EPS_BOARD_enum_t board, uint16_t word);
+
+// Rounding to the nearest eng unit: the result is within gain/2 of the exact value
+int32_t eps_raw_to_eng_convert_value(int32_t raw, const eps_raw_to_eng_coeff_t *coeff);
+
+uint8_t eps_raw_to_eng_is_calibrated(EPS_BOARD_enum_t board);
+const eps_raw_to_eng_calibration_t* eps_raw_to_eng_get_calibration(EPS_BOARD_enum_t board); // NULL if not calibrated
+void eps_raw_to_eng_set_calibration(EPS_BOARD_enum_t board, const eps_raw_to_eng_calibration_t *calibration);
+void eps_raw_to_eng_reset_calibration(); // every board back to no calibration
+
+// Reads each quantity's gain_q16 and offset (int32, little-endian, first 4 bytes of PAR_VAL) with
+// eps_get_configuration_parameter(). The parameter IDs depend on the EPS configuration.
+// Returns 0, or the first error (the board's calibration is then unchanged).
+uint8_t eps_raw_to_eng_load_calibration(EPS_BOARD_enum_t board,
+		const uint16_t gain_parameter_ids[EPS_RAW_TO_ENG_QUANTITY_COUNT],
+		const uint16_t offset_parameter_ids[EPS_RAW_TO_ENG_QUANTITY_COUNT]);
+
+#endif /* __INCLUDE_GUARD__EPS_RAW_TO_ENG_H__ */
@@ -0,0 +1,47 @@
+
+#ifndef __INCLUDE_GUARD__EPS_RSP_FRAMER_H__
+#define __INCLUDE_GUARD__EPS_RSP_FRAMER_H__
+
+#include <stdint.h>
+
+// Incremental parser for "<rsp>PAYLOAD</rsp>" frames received from the EPS over UART.
+// Bytes are pushed one at a time. Anything outside a frame is dropped, and a frame whose end tag
+// doesn't match is discarded and re-scanned for the next "<rsp>" start tag.
+// This file has no HAL dependencies, so it can be compiled and fed byte streams on a host PC.
+
+#define EPS_RSP_FRAMER_START_TAG "<rsp>"
+#define EPS_RSP_FRAMER_START_TAG_LEN 5
+#define EPS_RSP_FRAMER_END_TAG "</rsp>"
+#define EPS_RSP_FRAMER_END_TAG_LEN 6
+
+typedef enum {
+	EPS_RSP_FRAMER_STATE_HUNT_START_TAG = 0,
+	EPS_RSP_FRAMER_STATE_PAYLOAD = 1,
+	EPS_RSP_FRAMER_STATE_END_TAG = 2,
+	EPS_RSP_FRAMER_STATE_FRAME_COMPLETE = 3,
+} EPS_RSP_FRAMER_STATE_enum_t;
+
+typedef struct {
+	// Current frame
+	uint8_t *payload_buf;
+	uint16_t payload_len; // expected payload length (the EPS response length for the command)
+	uint16_t payload_received_len;
+	uint8_t tag_match_len; // number of bytes of the start/end tag matched so far
+	EPS_RSP_FRAMER_STATE_enum_t state;
+
+	// Counters (kept across frames; cleared by eps_rsp_framer_init)
+	uint32_t frame_count; // complete, well-formed frames
+	uint32_t dropped_byte_count; // bytes discarded while hunting for a start tag
+	uint32_t malformed_frame_count; // frames discarded because the end tag didn't match
+} eps_rsp_framer_t;
+
+
+void eps_rsp_framer_init(eps_rsp_framer_t *framer);
+void eps_rsp_framer_begin_frame(eps_rsp_framer_t *framer, uint8_t payload_buf[], uint16_t payload_len);
+
+uint8_t eps_rsp_framer_push_byte(eps_rsp_framer_t *framer, uint8_t byte);
+uint16_t eps_rsp_framer_push_bytes(eps_rsp_framer_t *framer, const uint8_t bytes[], uint16_t bytes_len);
+
+uint8_t eps_rsp_framer_is_frame_complete(const eps_rsp_framer_t *framer);
+
+#endif /* __INCLUDE_GUARD__EPS_RSP_FRAMER_H__ */
@@ -0,0 +1,63 @@
+
+#ifndef __INCLUDE_GUARD__EPS_RSP_VIEW_H__
+#define __INCLUDE_GUARD__EPS_RSP_VIEW_H__
+
+#include "eps_drivers/eps_field_decoder.h"
+#include "eps_drivers/eps_types.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Read-only views over a received response buffer. Each accessor decodes only the one value it
+// returns, so a caller that needs a few values doesn't need the full eps_result_*_t struct (about
+// 300 bytes for the PIU).
+// The PIU and PDU accessors read from response offsets fixed at compile time. eps_rsp_view_get()
+// takes any struct offset, and searches the field table for it on each call.
+// The view doesn't copy rx_buf: the buffer must not be reused while the view is in use. Get the
+// response with eps_hk_cache_read() (e.g., EPS_CMD_ID_GET_PIU_HOUSEKEEPING_DATA_ENG into a buffer of
+// eps_cmd_table[cmd_id].rx_len bytes), or view the rx_buf of an eps_hk_cache_request() callback
+// during the callback.
+
+typedef struct {
+	const uint8_t *rx_buf;
+	const eps_field_table_t *fields;
+} eps_rsp_view_t;
+
+// View of an 0xA2/0xA4 (PIU housekeeping, eng) response
+typedef struct {
+	eps_rsp_view_t rsp;
+} eps_piu_view_t;
+
+// View of an 0x52/0x54 (PDU housekeeping, eng) response
+typedef struct {
+	eps_rsp_view_t rsp;
+} eps_pdu_view_t;
+
+
+// Returns 0 on success, or 1 if rx_buf_len is shorter than the response layout.
+uint8_t eps_rsp_view_init(eps_rsp_view_t *view, const eps_field_table_t *fields, const uint8_t rx_buf[], uint16_t rx_buf_len);
+
+// Any value, by its offset in the matching result struct. Returns 0 if the offset isn't in the layout.
+uint32_t eps_rsp_view_get(const eps_rsp_view_t *view, uint16_t dest_offset);
+#define EPS_RSP_VIEW_GET(view, result_type, member) eps_rsp_view_get((view), offsetof(result_type, member))
+
+// Channel accessors return 0 if channel_num >= 32. Channels 16-31 are in the _ext bitfields.
+uint8_t eps_piu_view_init(eps_piu_view_t *view, const uint8_t rx_buf[], uint16_t rx_buf_len);
+int16_t eps_piu_view_channel_voltage_mV(const eps_piu_view_t *view, uint8_t channel_num);
+int16_t eps_piu_view_channel_current_mA(const eps_piu_view_t *view, uint8_t channel_num);
+int16_t eps_piu_view_channel_power_cW(const eps_piu_view_t *view, uint8_t channel_num);
+uint16_t eps_piu_view_stat_ch_on_bitfield(const eps_piu_view_t *view);
+uint16_t eps_piu_view_stat_ch_overcurrent_fault_bitfield(const eps_piu_view_t *view);
+uint16_t eps_piu_view_stat_ch_ext_on_bitfield(const eps_piu_view_t *view);
+uint16_t eps_piu_view_stat_ch_ext_overcurrent_fault_bitfield(const eps_piu_view_t *view);
+
+uint8_t eps_pdu_view_init(eps_pdu_view_t *view, const uint8_t rx_buf[], uint16_t rx_buf_len);
+int16_t eps_pdu_view_channel_voltage_mV(const eps_pdu_view_t *view, uint8_t channel_num);
+int16_t eps_pdu_view_channel_current_mA(const eps_pdu_view_t *view, uint8_t channel_num);
+int16_t eps_pdu_view_channel_power_cW(const eps_pdu_view_t *view, uint8_t channel_num);
+uint16_t eps_pdu_view_stat_ch_on_bitfield(const eps_pdu_view_t *view);
+uint16_t eps_pdu_view_stat_ch_overcurrent_fault_bitfield(const eps_pdu_view_t *view);
+uint16_t eps_pdu_view_stat_ch_ext_on_bitfield(const eps_pdu_view_t *view);
+uint16_t eps_pdu_view_stat_ch_ext_overcurrent_fault_bitfield(const eps_pdu_view_t *view);
+
+#endif /* __INCLUDE_GUARD__EPS_RSP_VIEW_H__ */
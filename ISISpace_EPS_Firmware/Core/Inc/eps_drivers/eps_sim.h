@@ -0,0 +1,109 @@
+
+#ifndef __INCLUDE_GUARD__EPS_SIM_H__
+#define __INCLUDE_GUARD__EPS_SIM_H__
+
+#include "eps_drivers/eps_raw_to_eng.h"
+
+#include <stdint.h>
+
+// Software model of the ISISpace EPS. Answers every command code in eps_commands.c (0x02 to 0xC6)
+// with a response laid out like the real one (same lengths and byte offsets as the pack_eps_result_*
+// functions expect), and keeps enough state (mode, channel on/off, reset counters, time,
+// configuration parameters) for commands to have visible effects.
+// Select it with eps_set_transport(&eps_transport_sim).
+//
+// eps_sim.c and eps_transport_sim.c have no HAL dependencies. To run the drivers on a host PC,
+// compile with -DEPS_HOST_BUILD:
+// - Src/eps_drivers: eps_commands.c, eps_cmd_table.c, eps_cmd_queue.c, eps_internal_drivers.c,
+//   eps_field_decoder.c, eps_link_stats.c, eps_hk_cache.c, eps_latency_model.c, eps_sim.c,
+//   eps_transport_sim.c, eps_raw_to_eng.c, eps_rsp_framer.c, eps_rsp_view.c, eps_types_to_json.c,
+//   eps_debug_tools.c, eps_telemetry_planner.c, eps_stats.c, eps_hk_stats.c, eps_channel_telemetry.c
+// - Src/debug_tools: debug_uart.c (prints to stdout), debug_log.c, fmt_int.c, hex_dump.c,
+//   json_writer.c, timing_probe.c
+// That is every file in those directories except the hardware ones (eps_transport_i2c.c,
+// eps_transport_uart.c, eps_i2c_poll_engine.c, debug_i2c.c).
+// Raw housekeeping responses (0x50/0x60/0x70/0xA0) hold the eng response's values as counts of the
+// sim's own fixed ADC scaling (eps_sim_get_adc_scale()), not the OBC's eps_raw_to_eng calibration,
+// so a check of the OBC's conversion against the sim isn't circular (see Tools/raw_to_eng_check.c).
+
+#define EPS_SIM_MAX_CONFIG_PARAMS 16
+
+// STAT values (ESP_SICD Table 3-11)
+#define EPS_SIM_STAT_ACCEPTED 0x00
+#define EPS_SIM_STAT_REJECTED 0x01
+#define EPS_SIM_STAT_INVALID_CC 0x02
+#define EPS_SIM_STAT_PARAM_MISSING 0x03
+#define EPS_SIM_STAT_PARAM_INVALID 0x04
+#define EPS_SIM_STAT_INVALID_SYSTEM 0x06 // wrong STID, IVID or BID
+#define EPS_SIM_STAT_INTERNAL_ERROR 0x07
+#define EPS_SIM_STAT_NEW_FLAG 0x80 // set on the first response after a reset
+
+typedef enum {
+	EPS_SIM_ERROR_NONE = 0,
+	EPS_SIM_ERROR_TX = 1, // send fails (transport returns 2)
+	EPS_SIM_ERROR_RX = 2, // response is lost mid-transfer (transport returns 3)
+	EPS_SIM_ERROR_TIMEOUT = 3, // EPS never answers (transport returns 4)
+	EPS_SIM_ERROR_STAT = 4, // EPS answers with STAT = internal error
+} EPS_SIM_ERROR_enum_t;
+
+typedef struct {
+	uint32_t response_latency_ms; // time from command to response
+	uint32_t per_byte_latency_us; // extra time per response byte (e.g., 87 for 115200 baud)
+
+	// Error injection: every Nth command fails with inject_error. 0 disables it.
+	EPS_SIM_ERROR_enum_t inject_error;
+	uint32_t inject_error_every_n_cmds;
+} eps_sim_config_t;
+
+typedef struct {
+	uint8_t mode; // same as eps_result_system_status_t.mode
+	uint8_t config_changed_since_boot;
+	uint8_t reset_cause;
+	uint8_t new_flag_pending; // next response gets EPS_SIM_STAT_NEW_FLAG
+
+	uint16_t stat_ch_on_bitfield;
+	uint16_t stat_ch_ext_on_bitfield;
+
+	uint16_t rst_cnt_pwron;
+	uint16_t rst_cnt_wdg;
+	uint16_t rst_cnt_cmd;
+	uint16_t rst_cnt_mcu;
+	uint16_t rst_cnt_emlopo;
+
+	uint32_t boot_time_ms; // now_ms at the last (simulated) reset
+	uint32_t prev_cmd_time_ms;
+	uint32_t unix_time_at_boot_sec;
+	int32_t time_correction_sec; // sum of all eps_correct_time() corrections
+
+	uint32_t watchdog_kick_count;
+	uint32_t cmd_count; // all commands received, including rejected ones
+	uint32_t injected_error_count;
+
+	uint8_t config_param_count;
+	uint16_t config_param_ids[EPS_SIM_MAX_CONFIG_PARAMS];
+	uint8_t config_param_values[EPS_SIM_MAX_CONFIG_PARAMS][8];
+} eps_sim_state_t;
+
+// eng = raw * eng_per_count_num / eng_per_count_den + eng_offset
+typedef struct {
+	int32_t eng_per_count_num;
+	int32_t eng_per_count_den;
+	int32_t eng_offset;
+} eps_sim_adc_scale_t;
+
+
+void eps_sim_reset(uint32_t now_ms);
+void eps_sim_configure(const eps_sim_config_t *config);
+const eps_sim_config_t* eps_sim_get_config();
+const eps_sim_state_t* eps_sim_get_state();
+const eps_sim_adc_scale_t* eps_sim_get_adc_scale(EPS_RAW_TO_ENG_QUANTITY_enum_t quantity); // NULL if out of range
+
+uint16_t eps_sim_get_response_len(uint8_t command_code);
+EPS_SIM_ERROR_enum_t eps_sim_next_injected_error();
+
+uint8_t eps_sim_process_cmd(
+		const uint8_t cmd_buf[], uint8_t cmd_buf_len,
+		uint8_t rx_buf[], uint16_t rx_buf_len,
+		uint32_t now_ms);
+
+#endif /* __INCLUDE_GUARD__EPS_SIM_H__ */
@@ -0,0 +1,58 @@
+#ifndef __INCLUDE_GUARD__EPS_STATS_H__
+#define __INCLUDE_GUARD__EPS_STATS_H__
+
+#include <stdint.h>
+
+// Streaming statistics over a set of int16 series (e.g., the 16-bit words of a housekeeping
+// struct), updated one sample of every series at a time. Integer math only.
+// - EWMA: ewma += (sample - ewma) / 2^ewma_shift, kept with 8 fractional bits.
+// - Window of the last window_len samples: mean, min/max and (population) variance.
+// State is struct-of-arrays, indexed by series, so each update is a few straight loops over
+// contiguous arrays (the window is a ring of rows, one row per sample). The update only maintains
+// the window sums and the EWMAs; min/max and variance scan the window when asked for.
+//
+// Storage is sized per use with EPS_STATS_DEFINE(); eps_stats_init() sets the window length (up to
+// the defined maximum) and resets the state.
+
+typedef struct {
+	uint16_t series_count;
+	uint8_t max_window_len;
+
+	uint8_t window_len;
+	uint8_t ewma_shift;
+	uint8_t head; // next row of the window to write
+	uint8_t fill; // rows of the window in use (up to window_len)
+	uint32_t sample_count; // since eps_stats_init()
+
+	int16_t *window; // max_window_len rows of series_count values
+	int32_t *window_sum;
+	int32_t *ewma_q8;
+} eps_stats_t;
+
+#define EPS_STATS_EWMA_FRAC_BITS 8
+
+// Declares `static eps_stats_t name` with its storage
+#define EPS_STATS_DEFINE(name, series_count_, max_window_len_) \
+	static int16_t name##_window[(max_window_len_) * (series_count_)]; \
+	static int32_t name##_window_sum[series_count_]; \
+	static int32_t name##_ewma_q8[series_count_]; \
+	static eps_stats_t name = { \
+		.series_count = (series_count_), .max_window_len = (max_window_len_), \
+		.window = name##_window, .window_sum = name##_window_sum, .ewma_q8 = name##_ewma_q8, \
+	}
+
+
+// Returns 0, or 1 if window_len is 0 or more than the storage holds, or ewma_shift is > 15.
+uint8_t eps_stats_init(eps_stats_t *stats, uint8_t window_len, uint8_t ewma_shift);
+
+void eps_stats_update(eps_stats_t *stats, const int16_t sample[]);
+
+// Each fills series_count values; all are 0 before the first sample.
+void eps_stats_get_mean(const eps_stats_t *stats, int16_t mean_dest[]); // window mean, rounded
+void eps_stats_get_ewma(const eps_stats_t *stats, int16_t ewma_dest[]); // rounded
+void eps_stats_get_min_max(const eps_stats_t *stats, int16_t min_dest[], int16_t max_dest[]); // over the window
+void eps_stats_get_variance(const eps_stats_t *stats, uint32_t variance_dest[]); // over the window, units^2
+
+const int16_t* eps_stats_get_latest(const eps_stats_t *stats); // NULL before the first sample
+
+#endif /* __INCLUDE_GUARD__EPS_STATS_H__ */
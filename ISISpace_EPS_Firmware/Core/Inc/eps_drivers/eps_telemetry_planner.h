@@ -0,0 +1,102 @@
+#ifndef __INCLUDE_GUARD__EPS_TELEMETRY_PLANNER_H__
+#define __INCLUDE_GUARD__EPS_TELEMETRY_PLANNER_H__
+
+#include "eps_drivers/eps_cmd_table.h"
+#include "eps_drivers/eps_types.h"
+
+#include <stdint.h>
+
+// Telemetry query planner.
+// Several commands return the same values: e.g., PIU housekeeping (0xA2, 274 bytes) holds the
+// per-channel VIPD and channel bitfields of PDU housekeeping (0x52), and the conditioning channel
+// MPPT data of PCU housekeeping (0x72). Given the fields a consumer needs, eps_telemetry_plan()
+// picks the set of commands with the fewest response bytes that covers all of them, and
+// eps_telemetry_execute() runs those commands and fills one eps_telemetry_snapshot_t.
+//
+// There are few candidate commands (EPS_TELEMETRY_MAX_PLAN_CMDS), so the planner tries every
+// subset of them; the result is the exact minimum, not a greedy approximation.
+
+// X(id, name)
+#define EPS_TELEMETRY_FIELDS(X) \
+	X(EPS_TELEMETRY_FIELD_SYSTEM_STATUS, "system_status") \
+	X(EPS_TELEMETRY_FIELD_CH_ON, "ch_on") \
+	X(EPS_TELEMETRY_FIELD_CH_OVERCURRENT_FAULT, "ch_overcurrent_fault") \
+	X(EPS_TELEMETRY_FIELD_CH_VIPD, "ch_vipd") \
+	X(EPS_TELEMETRY_FIELD_CC_MPPT, "cc_mppt") \
+	X(EPS_TELEMETRY_FIELD_CC_OUTPUT_VIPD, "cc_output_vipd") \
+	X(EPS_TELEMETRY_FIELD_BATTERY_STATUS, "battery_status") \
+	X(EPS_TELEMETRY_FIELD_BATTERY_PACKS, "battery_packs") \
+	X(EPS_TELEMETRY_FIELD_BATTERY_TEMPS, "battery_temps")
+
+#define EPS_TELEMETRY_FIELD_ENUM_ENTRY(id, name) id,
+typedef enum {
+	EPS_TELEMETRY_FIELDS(EPS_TELEMETRY_FIELD_ENUM_ENTRY)
+	EPS_TELEMETRY_FIELD_COUNT
+} EPS_TELEMETRY_FIELD_enum_t;
+
+#define EPS_TELEMETRY_FIELD_BIT(field) (1UL << (field))
+#define EPS_TELEMETRY_ALL_FIELDS ((1UL << EPS_TELEMETRY_FIELD_COUNT) - 1)
+
+#define EPS_TELEMETRY_MAX_PLAN_CMDS 8 // distinct commands in the source table
+
+typedef struct {
+	uint32_t field_mask; // fields the plan covers (the requested ones)
+	uint8_t cmd_count;
+	EPS_CMD_ID_enum_t cmd_ids[EPS_TELEMETRY_MAX_PLAN_CMDS];
+	uint16_t rx_bytes; // sum of the response lengths of cmd_ids
+
+	// Same fields, fetched with the smallest command that has each one (what a caller picking
+	// per field would do). rx_bytes <= naive_rx_bytes.
+	uint16_t naive_rx_bytes;
+} eps_telemetry_plan_t;
+
+// Values from any of the sources; which command filled each field depends on the plan.
+typedef struct {
+	uint32_t valid_field_mask; // fields filled in by the last eps_telemetry_execute()
+
+	// EPS_TELEMETRY_FIELD_SYSTEM_STATUS
+	eps_result_system_status_t system_status;
+
+	// EPS_TELEMETRY_FIELD_CH_ON / EPS_TELEMETRY_FIELD_CH_OVERCURRENT_FAULT
+	uint16_t stat_ch_on_bitfield;
+	uint16_t stat_ch_ext_on_bitfield;
+	uint16_t stat_ch_overcurrent_fault_bitfield;
+	uint16_t stat_ch_ext_overcurrent_fault_bitfield;
+
+	// EPS_TELEMETRY_FIELD_CH_VIPD
+	eps_vpid_eng_t vip_each_channel[32];
+
+	// EPS_TELEMETRY_FIELD_CC_MPPT: CC1 is at index 0. PCU housekeeping has 4, PIU housekeeping 5.
+	uint8_t cc_count;
+	eps_conditioning_channel_short_datatype_eng_t cc_mppt_each_channel[5];
+
+	// EPS_TELEMETRY_FIELD_CC_OUTPUT_VIPD (PCU only)
+	eps_vpid_eng_t vip_cc_output_each_channel[4];
+
+	// EPS_TELEMETRY_FIELD_BATTERY_STATUS: Table 3-18
+	uint16_t battery_status_bitfield;
+
+	// EPS_TELEMETRY_FIELD_BATTERY_PACKS (PBU only)
+	eps_battery_pack_datatype_eng_t battery_pack_info_each_pack[3];
+
+	// EPS_TELEMETRY_FIELD_BATTERY_TEMPS: centiCelsius. PBU housekeeping has 9 (3 sensors of pack 0,
+	// then pack 1, pack 2), PIU housekeeping 2 (battery_temp2_cC, battery_temp3_cC).
+	uint8_t battery_temp_count;
+	int16_t battery_temp_each_sensor_cC[9];
+} eps_telemetry_snapshot_t;
+
+
+// Returns 0, or 1 if field_mask is empty or has unknown fields.
+uint8_t eps_telemetry_plan(uint32_t field_mask, eps_telemetry_plan_t *plan_dest);
+
+// Runs the plan's commands (blocking, through eps_cmd_execute(), so cached responses are reused).
+// Returns 0, or the error code of the first command that failed; the fields of the commands that
+// succeeded are still filled in (see valid_field_mask).
+uint8_t eps_telemetry_execute(const eps_telemetry_plan_t *plan, eps_telemetry_snapshot_t *snapshot_dest);
+
+// eps_telemetry_plan() then eps_telemetry_execute()
+uint8_t eps_telemetry_get(uint32_t field_mask, eps_telemetry_snapshot_t *snapshot_dest);
+
+const char* eps_telemetry_field_name(EPS_TELEMETRY_FIELD_enum_t field);
+
+#endif /* __INCLUDE_GUARD__EPS_TELEMETRY_PLANNER_H__ */
@@ -0,0 +1,51 @@
+
+#ifndef __INCLUDE_GUARD__EPS_TRANSPORT_H__
+#define __INCLUDE_GUARD__EPS_TRANSPORT_H__
+
+#include "eps_drivers/eps_rsp_framer.h"
+
+#include <stdint.h>
+
+// A transport moves one command to the EPS and its response back. eps_send_cmd_get_response()
+// uses whichever transport was selected with eps_set_transport().
+// All functions are non-blocking: send() starts the transaction, poll() is called repeatedly
+// until it returns 1, then receive() gives the result.
+typedef struct {
+	const char *name;
+
+	// Start a transaction. The response will be written to rx_buf.
+	// Returns 0 on success, 2 if the command could not be sent.
+	uint8_t (*send)(const uint8_t cmd_buf[], uint8_t cmd_buf_len, uint8_t rx_buf[], uint16_t rx_buf_len);
+
+	// Advance the in-flight transaction. Returns 1 once it has finished (successfully or not).
+	uint8_t (*poll)();
+
+	// Result of the finished transaction: 0=response in rx_buf, 3=rx error, 4=no response in time.
+	uint8_t (*receive)();
+
+	// Time base used for timeouts and latency measurement.
+	uint32_t (*now_ms)();
+
+	// Optional (may be NULL). Called while poll() returns 0, e.g. to sleep until the next interrupt.
+	void (*wait_for_event)();
+
+	// Optional (may be NULL). "Not ready" polls during the finished transaction, for the link stats.
+	uint16_t (*get_retry_count)();
+} eps_transport_t;
+
+
+// Target transports (need the HAL)
+extern const eps_transport_t eps_transport_uart;
+extern const eps_transport_t eps_transport_i2c;
+
+// Software EPS emulator (see eps_sim.h); runs on the target or on a host PC
+extern const eps_transport_t eps_transport_sim;
+
+
+void eps_set_transport(const eps_transport_t *transport);
+const eps_transport_t* eps_get_transport();
+
+uint8_t eps_start_uart_rx_dma();
+const eps_rsp_framer_t* eps_get_uart_rsp_framer();
+
+#endif /* __INCLUDE_GUARD__EPS_TRANSPORT_H__ */
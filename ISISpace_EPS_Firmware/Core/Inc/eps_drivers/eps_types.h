@@ -263,4 +263,21 @@ typedef struct {
     uint16_t stat_ch_ext_overcurrent_fault_bitfield;
 } eps_result_piu_housekeeping_data_eng_t;
 
+#define EPS_CHANNEL_TELEMETRY_CHANNEL_COUNT 32
+
+// The output channels of the PDU or PIU housekeeping data (eng), column by column (struct of
+// arrays), decoded straight from the 0x52/0xA2 response. Each column is a contiguous int16 array,
+// word-aligned so the eps_channel_telemetry kernels can load two channels at a time.
+// Channel i is bit i of stat_ch_on_bitfield (0-15) or bit i-16 of stat_ch_ext_on_bitfield (16-31).
+typedef struct {
+	int16_t voltage_mV[EPS_CHANNEL_TELEMETRY_CHANNEL_COUNT];
+	int16_t current_mA[EPS_CHANNEL_TELEMETRY_CHANNEL_COUNT];
+	int16_t power_cW[EPS_CHANNEL_TELEMETRY_CHANNEL_COUNT];
+
+	uint16_t stat_ch_on_bitfield;
+	uint16_t stat_ch_ext_on_bitfield;
+	uint16_t stat_ch_overcurrent_fault_bitfield;
+	uint16_t stat_ch_ext_overcurrent_fault_bitfield;
+} __attribute__((aligned(4))) eps_channel_telemetry_t;
+
 #endif /* __INCLUDE_GUARD__EPS_TYPES_H__ */
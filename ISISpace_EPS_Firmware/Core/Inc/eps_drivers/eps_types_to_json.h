@@ -1,13 +1,52 @@
-
 #ifndef __INCLUDE_GUARD__EPS_TYPES_TO_JSON_H__
 #define __INCLUDE_GUARD__EPS_TYPES_TO_JSON_H__
 
 #include "eps_types.h"
+#include "debug_tools/json_writer.h"
+
+// Writes the struct as a JSON object, as member `key` of the current object (or NULL in an
+// array/at the top level). With a sink on the writer, any of these can stream straight to the UART.
+void eps_vpid_raw_TO_json_writer(json_writer_t *writer, const char *key, const eps_vpid_raw_t *data);
+void eps_vpid_eng_TO_json_writer(json_writer_t *writer, const char *key, const eps_vpid_eng_t *data);
+void eps_battery_pack_datatype_raw_TO_json_writer(json_writer_t *writer, const char *key, const eps_battery_pack_datatype_raw_t *data);
+void eps_battery_pack_datatype_eng_TO_json_writer(json_writer_t *writer, const char *key, const eps_battery_pack_datatype_eng_t *data);
+void eps_conditioning_channel_datatype_raw_TO_json_writer(json_writer_t *writer, const char *key, const eps_conditioning_channel_datatype_raw_t *data);
+void eps_conditioning_channel_datatype_eng_TO_json_writer(json_writer_t *writer, const char *key, const eps_conditioning_channel_datatype_eng_t *data);
+void eps_conditioning_channel_short_datatype_raw_TO_json_writer(json_writer_t *writer, const char *key, const eps_conditioning_channel_short_datatype_raw_t *data);
+void eps_conditioning_channel_short_datatype_eng_TO_json_writer(json_writer_t *writer, const char *key, const eps_conditioning_channel_short_datatype_eng_t *data);
+void eps_result_system_status_TO_json_writer(json_writer_t *writer, const char *key, const eps_result_system_status_t *data);
+void eps_result_pdu_overcurrent_fault_state_TO_json_writer(json_writer_t *writer, const char *key, const eps_result_pdu_overcurrent_fault_state_t *data);
+void eps_result_pbu_abf_placed_state_TO_json_writer(json_writer_t *writer, const char *key, const eps_result_pbu_abf_placed_state_t *data);
+void eps_result_pdu_housekeeping_data_raw_TO_json_writer(json_writer_t *writer, const char *key, const eps_result_pdu_housekeeping_data_raw_t *data);
+void eps_result_pdu_housekeeping_data_eng_TO_json_writer(json_writer_t *writer, const char *key, const eps_result_pdu_housekeeping_data_eng_t *data);
+void eps_result_pbu_housekeeping_data_raw_TO_json_writer(json_writer_t *writer, const char *key, const eps_result_pbu_housekeeping_data_raw_t *data);
+void eps_result_pbu_housekeeping_data_eng_TO_json_writer(json_writer_t *writer, const char *key, const eps_result_pbu_housekeeping_data_eng_t *data);
+void eps_result_pcu_housekeeping_data_raw_TO_json_writer(json_writer_t *writer, const char *key, const eps_result_pcu_housekeeping_data_raw_t *data);
+void eps_result_pcu_housekeeping_data_eng_TO_json_writer(json_writer_t *writer, const char *key, const eps_result_pcu_housekeeping_data_eng_t *data);
+void eps_result_piu_housekeeping_data_raw_TO_json_writer(json_writer_t *writer, const char *key, const eps_result_piu_housekeeping_data_raw_t *data);
+void eps_result_piu_housekeeping_data_eng_TO_json_writer(json_writer_t *writer, const char *key, const eps_result_piu_housekeeping_data_eng_t *data);
 
+// Same, into a null-terminated string. Returns 0 on success, 1 on invalid input, or 3 if
+// json_output_str is too short.
 uint8_t eps_vpid_raw_TO_json(const eps_vpid_raw_t *data, char json_output_str[], uint16_t json_output_str_len);
 uint8_t eps_vpid_eng_TO_json(const eps_vpid_eng_t *data, char json_output_str[], uint16_t json_output_str_len);
 uint8_t eps_battery_pack_datatype_raw_TO_json(const eps_battery_pack_datatype_raw_t *data, char json_output_str[], uint16_t json_output_str_len);
 uint8_t eps_battery_pack_datatype_eng_TO_json(const eps_battery_pack_datatype_eng_t *data, char json_output_str[], uint16_t json_output_str_len);
+uint8_t eps_conditioning_channel_datatype_raw_TO_json(const eps_conditioning_channel_datatype_raw_t *data, char json_output_str[], uint16_t json_output_str_len);
+uint8_t eps_conditioning_channel_datatype_eng_TO_json(const eps_conditioning_channel_datatype_eng_t *data, char json_output_str[], uint16_t json_output_str_len);
+uint8_t eps_conditioning_channel_short_datatype_raw_TO_json(const eps_conditioning_channel_short_datatype_raw_t *data, char json_output_str[], uint16_t json_output_str_len);
+uint8_t eps_conditioning_channel_short_datatype_eng_TO_json(const eps_conditioning_channel_short_datatype_eng_t *data, char json_output_str[], uint16_t json_output_str_len);
+uint8_t eps_result_system_status_TO_json(const eps_result_system_status_t *data, char json_output_str[], uint16_t json_output_str_len);
+uint8_t eps_result_pdu_overcurrent_fault_state_TO_json(const eps_result_pdu_overcurrent_fault_state_t *data, char json_output_str[], uint16_t json_output_str_len);
+uint8_t eps_result_pbu_abf_placed_state_TO_json(const eps_result_pbu_abf_placed_state_t *data, char json_output_str[], uint16_t json_output_str_len);
+uint8_t eps_result_pdu_housekeeping_data_raw_TO_json(const eps_result_pdu_housekeeping_data_raw_t *data, char json_output_str[], uint16_t json_output_str_len);
+uint8_t eps_result_pdu_housekeeping_data_eng_TO_json(const eps_result_pdu_housekeeping_data_eng_t *data, char json_output_str[], uint16_t json_output_str_len);
+uint8_t eps_result_pbu_housekeeping_data_raw_TO_json(const eps_result_pbu_housekeeping_data_raw_t *data, char json_output_str[], uint16_t json_output_str_len);
+uint8_t eps_result_pbu_housekeeping_data_eng_TO_json(const eps_result_pbu_housekeeping_data_eng_t *data, char json_output_str[], uint16_t json_output_str_len);
+uint8_t eps_result_pcu_housekeeping_data_raw_TO_json(const eps_result_pcu_housekeeping_data_raw_t *data, char json_output_str[], uint16_t json_output_str_len);
+uint8_t eps_result_pcu_housekeeping_data_eng_TO_json(const eps_result_pcu_housekeeping_data_eng_t *data, char json_output_str[], uint16_t json_output_str_len);
+uint8_t eps_result_piu_housekeeping_data_raw_TO_json(const eps_result_piu_housekeeping_data_raw_t *data, char json_output_str[], uint16_t json_output_str_len);
+uint8_t eps_result_piu_housekeeping_data_eng_TO_json(const eps_result_piu_housekeeping_data_eng_t *data, char json_output_str[], uint16_t json_output_str_len);
 
 
 #endif // __INCLUDE_GUARD__EPS_TYPES_TO_JSON_H__
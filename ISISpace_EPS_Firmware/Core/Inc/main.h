@@ -65,6 +65,7 @@ extern UART_HandleTypeDef huart4;
 void Error_Handler(void);
 
 /* USER CODE BEGIN EFP */
+void SystemClock_Config(void); // also called after waking up from Stop 2 (see timing_helpers.h)
 
 /* USER CODE END EFP */
 
@@ -0,0 +1,68 @@
+
+#ifndef __INCLUDE_GUARD__SCHEDULER_H__
+#define __INCLUDE_GUARD__SCHEDULER_H__
+
+#include <stdint.h>
+
+// Cooperative scheduler for periodic and one-shot jobs, run from the main loop.
+// scheduler_run_forever() runs each job when it's due (most overdue first), then sleeps until the
+// next one is due with low_power_wait_until_ms(). Jobs run to completion, so they should be short;
+// long EPS transactions belong in the command queue, pumped from the poll hook.
+//
+// Each run has a deadline: due time + deadline_ms. A run that finishes later counts as an overrun.
+// A periodic job that falls more than a whole period behind skips the missed runs (counted),
+// instead of running back-to-back to catch up.
+
+#define SCHEDULER_MAX_JOBS 8
+#define SCHEDULER_NO_JOB_DUE 0xFFFFFFFF // scheduler_run_due_jobs(): nothing scheduled
+
+typedef void (*scheduler_job_callback_t)(void *context);
+
+// Called on every loop iteration, before sleeping. Returns 1 while something is in progress that
+// needs the 1 ms tick (e.g., an EPS transaction); the scheduler then only sleeps until the next
+// interrupt.
+typedef uint8_t (*scheduler_poll_hook_t)(void);
+
+typedef struct {
+	const char *name;
+	scheduler_job_callback_t callback;
+	void *context;
+	uint32_t period_ms; // 0: one-shot (removed after it runs)
+	uint32_t deadline_ms;
+	uint32_t next_due_ms;
+	uint8_t is_active;
+
+	uint32_t run_count;
+	uint32_t overrun_count; // runs that finished after their deadline
+	uint32_t skipped_count; // periodic runs skipped because the job was more than a period late
+	uint32_t max_late_ms; // worst start time - due time
+	uint32_t max_run_ms; // worst run time
+} scheduler_job_t;
+
+// deadline_ms = 0: same as the period (one-shot: no deadline).
+// Returns 0 on success (the slot number is written to job_id_dest, if not NULL), 1 for bad
+// args, or 5 if all SCHEDULER_MAX_JOBS slots are in use.
+uint8_t scheduler_add_periodic(
+		const char *name, scheduler_job_callback_t callback, void *context,
+		uint32_t period_ms, uint32_t first_delay_ms, uint32_t deadline_ms, uint8_t *job_id_dest);
+uint8_t scheduler_add_one_shot(
+		const char *name, scheduler_job_callback_t callback, void *context,
+		uint32_t delay_ms, uint32_t deadline_ms, uint8_t *job_id_dest);
+uint8_t scheduler_cancel(uint8_t job_id);
+
+void scheduler_set_poll_hook(scheduler_poll_hook_t poll_hook);
+// Deepest LOW_POWER_MODE_enum_t (timing_helpers.h) used while no job is due and the poll hook is
+// idle. Default: LOW_POWER_MODE_SLEEP_TICKLESS.
+void scheduler_set_idle_low_power_mode(uint8_t low_power_mode);
+
+// Runs every job that is due. Returns the ms until the next job is due, or SCHEDULER_NO_JOB_DUE.
+uint32_t scheduler_run_due_jobs(void);
+
+void scheduler_run_forever(void);
+
+const scheduler_job_t* scheduler_get_job(uint8_t job_id); // NULL if the slot is unused
+uint32_t scheduler_get_slept_ms(void); // total time spent in low_power_wait_until_ms()
+
+void scheduler_debug_print_stats(void);
+
+#endif /* __INCLUDE_GUARD__SCHEDULER_H__ */
@@ -13,4 +13,78 @@ void delay_ms(uint32_t delay_time_ms);
 
 uint32_t get_uptime_ms();
 
+// Uptime in us, from the HAL tick and the SysTick counter. Wraps every ~71 minutes. With interrupts
+// masked for more than 1 ms, it can go back by up to 1 ms (the tick is only added by the ISR).
+uint32_t get_uptime_us();
+
+// Core clock cycle counter (DWT CYCCNT): 8.3 ns per count at 120 MHz, wraps every ~35 s. It may stop
+// while the core sleeps, so use it to time code, not waits. Start it with cycle_counter_init().
+void cycle_counter_init();
+static inline uint32_t get_cycle_count() {
+	return DWT->CYCCNT;
+}
+uint32_t cycles_to_us(uint32_t cycles);
+
+// Sleeps (WFI) until the next interrupt other than SysTick, or for max_sleep_ms (capped at about
+// 139 ms at 120 MHz), without waking up every 1 ms for SysTick. get_uptime_ms() stays correct.
+// Returns the number of whole ms slept. Anything driven by the 1 ms SysTick must bound the sleep:
+// e.g., while the I2C poll engine is busy, only sleep until eps_i2c_poll_engine_get_next_service_ms()
+// (as low_power_wait_until_ms() does when given that time), so its polls aren't delayed.
+uint32_t sleep_tickless_ms(uint32_t max_sleep_ms);
+
+
+// #pragma region Low-power waits
+
+// Deepest mode a low_power_wait_until_ms() call may use.
+typedef enum {
+	LOW_POWER_MODE_SLEEP = 0, // WFI; SysTick still wakes the CPU every 1 ms
+	LOW_POWER_MODE_SLEEP_TICKLESS = 1, // WFI with SysTick stretched up to the wake time (sleep_tickless_ms)
+	LOW_POWER_MODE_STOP2 = 2, // Stop 2: PLL/HSI off, peripherals stopped; LPTIM1 (on LSI) wakes the CPU
+} LOW_POWER_MODE_enum_t;
+
+// Shorter waits use tickless Sleep instead of Stop 2. Waking up from Stop 2 costs a PLL relock, and
+// the LSI-based time is only accurate to a few % (a few 10s of us per wait at this length).
+#define LOW_POWER_STOP2_MIN_MS 10
+#define LOW_POWER_STOP2_MAX_MS 0xFFFF // LPTIM1 is 16 bits, at 1 ms per count
+
+// Returns 1 if Stop 2 must not be used right now (e.g., a DMA transfer is running, which would
+// stop with the clocks). Called with interrupts disabled, just before entering Stop 2.
+typedef uint8_t (*low_power_stop_veto_t)(void);
+
+// Sets up LPTIM1 on the LSI for Stop 2 waits. Until it's called, LOW_POWER_MODE_STOP2 falls back
+// to tickless Sleep. Call after SystemClock_Config().
+void low_power_init(void);
+void low_power_set_stop_veto(low_power_stop_veto_t veto);
+
+// Sleeps until wake_time_ms (a get_uptime_ms() time) or the next interrupt, whichever comes first,
+// using the deepest mode up to max_mode that fits. Returns right away if wake_time_ms has passed.
+// Like __WFI(), callers loop on their own condition. May be called with interrupts masked
+// (__disable_irq()): an interrupt that became pending after the caller's last check then still
+// ends the wait right away, and is handled once the caller unmasks.
+void low_power_wait_until_ms(uint32_t wake_time_ms, LOW_POWER_MODE_enum_t max_mode);
+
+// Called from LPTIM1_IRQHandler
+void low_power_lptim_irq_handler(void);
+
+// Measurement mode: while on, every wait adds the core clock cycles it slept for (measured with
+// SysTick, or LPTIM1 for Stop 2). Active cycles are the elapsed cycles minus the slept cycles.
+typedef struct {
+	uint8_t is_measuring;
+	uint32_t start_ms;
+	uint32_t wait_count; // waits that slept
+	uint32_t stop2_count; // of which in Stop 2
+	uint64_t sleep_cycles;
+} low_power_stats_t;
+
+// Resets the stats and starts measuring.
+void low_power_measure_start(void);
+void low_power_measure_stop(void);
+const low_power_stats_t* low_power_get_stats(void);
+// Core clock cycles spent awake since low_power_measure_start()
+uint64_t low_power_get_active_cycles(void);
+// "Low-power: active 151234 kcycles (2.1%), asleep 58765 of 60000 ms, 1234 waits (56 in Stop 2)"
+void low_power_debug_print_stats(void);
+
+// #pragma endregion Low-power waits
+
 #endif /* __INCLUDE_GUARD__TIMING_HELPERS_H_ */
@@ -0,0 +1,31 @@
+
+#ifndef __INCLUDE_GUARD__UART_RX_DMA_H__
+#define __INCLUDE_GUARD__UART_RX_DMA_H__
+
+#include "main.h"
+
+#include <stdint.h>
+
+// Continuous UART reception into a circular DMA buffer.
+// The DMA channel linked to the UART (huart->hdmarx) must be configured in DMA_CIRCULAR mode.
+// The write index is advanced from HAL_UARTEx_RxEventCallback, which the HAL calls on
+// idle-line, half-transfer and transfer-complete events.
+typedef struct {
+	UART_HandleTypeDef *huart;
+	uint8_t *buf;
+	uint16_t buf_len;
+	volatile uint16_t write_idx; // next index the DMA will write to; updated from the ISR
+	uint16_t read_idx; // next index to be consumed by uart_rx_dma_read()
+	volatile uint32_t rx_event_count; // number of RxEvent callbacks (idle-line, HT, TC)
+	volatile uint32_t restart_count; // number of times reception was restarted after a UART error
+} uart_rx_dma_t;
+
+#define UART_RX_DMA_MAX_INSTANCES 2
+
+uint8_t uart_rx_dma_start(uart_rx_dma_t *rx, UART_HandleTypeDef *huart, uint8_t buf[], uint16_t buf_len);
+
+uint16_t uart_rx_dma_available(const uart_rx_dma_t *rx);
+uint16_t uart_rx_dma_read(uart_rx_dma_t *rx, uint8_t dest[], uint16_t dest_len);
+void uart_rx_dma_flush(uart_rx_dma_t *rx);
+
+#endif /* __INCLUDE_GUARD__UART_RX_DMA_H__ */
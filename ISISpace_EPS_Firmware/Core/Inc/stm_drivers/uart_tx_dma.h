@@ -0,0 +1,49 @@
+
+#ifndef __INCLUDE_GUARD__UART_TX_DMA_H__
+#define __INCLUDE_GUARD__UART_TX_DMA_H__
+
+#include "main.h"
+
+#include <stdint.h>
+
+// Non-blocking UART transmission from a ring buffer, drained by DMA.
+// The DMA channel linked to the UART (huart->hdmatx) must be configured in DMA_NORMAL mode.
+// Single producer: uart_tx_dma_write() must only be called from one context (the main loop).
+// The only other writer is HAL_UART_TxCpltCallback, which only advances read_idx.
+// When the ring is full, the new message is dropped (drop-newest) and counted.
+typedef struct {
+	UART_HandleTypeDef *huart;
+	uint8_t *buf;
+	uint16_t buf_len;
+	volatile uint16_t write_idx; // next index the producer will write to; only updated by the producer
+	volatile uint16_t read_idx; // first byte not yet sent; only updated from the TxCplt ISR
+	volatile uint16_t in_flight_len; // length of the running DMA transfer (0: DMA is idle)
+	volatile uint32_t dropped_msg_count; // messages that didn't fit in the ring
+	volatile uint32_t dropped_byte_count;
+} uart_tx_dma_t;
+
+#define UART_TX_DMA_MAX_INSTANCES 1
+
+uint8_t uart_tx_dma_init(uart_tx_dma_t *tx, UART_HandleTypeDef *huart, uint8_t buf[], uint16_t buf_len);
+
+// Queues the whole message, or drops it if it doesn't fit. Returns 0 if queued, 1 if dropped.
+uint8_t uart_tx_dma_write(uart_tx_dma_t *tx, const uint8_t data[], uint16_t len);
+
+// Bytes queued, including the running DMA transfer.
+uint16_t uart_tx_dma_pending(const uart_tx_dma_t *tx);
+
+// Largest message that uart_tx_dma_write() would queue right now. Only grows until the next write.
+uint16_t uart_tx_dma_free(const uart_tx_dma_t *tx);
+
+// Counts a message that the caller dropped itself (e.g., because it was split in several writes
+// and wouldn't have fit in total), so that it shows in dropped_msg_count.
+void uart_tx_dma_count_drop(uart_tx_dma_t *tx, uint32_t len);
+
+// Stops the DMA and sends everything still queued by polling the UART.
+// For fault handlers (interrupts disabled, the TxCplt callback will never run).
+void uart_tx_dma_flush_blocking(uart_tx_dma_t *tx);
+
+// Sends bytes by polling the UART, bypassing the ring. Only safe while the DMA is stopped (after a flush).
+void uart_tx_dma_transmit_polling(uart_tx_dma_t *tx, const uint8_t data[], uint16_t len);
+
+#endif /* __INCLUDE_GUARD__UART_TX_DMA_H__ */
@@ -0,0 +1,282 @@
+#include "debug_tools/debug_log.h"
+#include "debug_tools/debug_uart.h"
+#include "debug_tools/fmt_int.h"
+
+#ifdef EPS_HOST_BUILD
+#include <time.h>
+#else
+#include "stm_drivers/timing_helpers.h"
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#define DEBUG_LOG_FORMAT_ENTRY(id, format) format,
+static const char *const debug_log_formats[DEBUG_LOG_ID_COUNT] = {
+	DEBUG_LOG_FORMATS(DEBUG_LOG_FORMAT_ENTRY)
+};
+
+static debug_log_mode_t debug_log_mode = DEBUG_LOG_DEFAULT_MODE;
+static debug_log_hex_style_t debug_log_hex_style = DEBUG_LOG_HEX_STYLE_BYTES;
+
+uint8_t debug_log_module_levels[DEBUG_LOG_MODULE_COUNT] = {
+	[DEBUG_LOG_MODULE_TRANSPORT] = DEBUG_LOG_DEFAULT_MODULE_LEVEL,
+	[DEBUG_LOG_MODULE_COMMANDS] = DEBUG_LOG_DEFAULT_MODULE_LEVEL,
+	[DEBUG_LOG_MODULE_PACKERS] = DEBUG_LOG_DEFAULT_MODULE_LEVEL,
+};
+uint8_t debug_log_trace_cc_mask = 0;
+uint8_t debug_log_trace_cc_value = 0;
+
+// Time of the last record that was queued (not dropped), for the timestamp deltas.
+static uint32_t debug_log_last_time_ms = 0;
+static uint8_t debug_log_records_since_abs_time = DEBUG_LOG_ABS_TIME_INTERVAL; // first record: absolute
+
+
+static uint32_t debug_log_now_ms() {
+#ifdef EPS_HOST_BUILD
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint32_t)(ts.tv_sec * 1000) + (uint32_t)(ts.tv_nsec / 1000000);
+#else
+	return get_uptime_ms();
+#endif
+}
+
+void debug_log_set_mode(debug_log_mode_t mode) {
+	debug_log_mode = mode;
+	debug_log_records_since_abs_time = DEBUG_LOG_ABS_TIME_INTERVAL;
+}
+
+debug_log_mode_t debug_log_get_mode(void) {
+	return debug_log_mode;
+}
+
+void debug_log_set_hex_style(debug_log_hex_style_t hex_style) {
+	debug_log_hex_style = hex_style;
+}
+
+void debug_log_set_module_level(debug_log_module_t module, uint8_t level) {
+	if (module < DEBUG_LOG_MODULE_COUNT) {
+		debug_log_module_levels[module] = level;
+	}
+}
+
+uint8_t debug_log_get_module_level(debug_log_module_t module) {
+	if (module >= DEBUG_LOG_MODULE_COUNT) {
+		return DEBUG_LOG_LEVEL_NONE;
+	}
+	return debug_log_module_levels[module];
+}
+
+void debug_log_set_trace_cc_filter(uint8_t cc_mask, uint8_t cc_value) {
+	debug_log_trace_cc_mask = cc_mask;
+	debug_log_trace_cc_value = cc_value & cc_mask;
+}
+
+const char* debug_log_get_format(uint16_t id) {
+	if (id >= DEBUG_LOG_ID_COUNT) {
+		return NULL;
+	}
+	return debug_log_formats[id];
+}
+
+uint8_t debug_log_write_varint(uint8_t dest[], uint32_t value) {
+	uint8_t len = 0;
+	while (value >= 0x80) {
+		dest[len++] = (uint8_t)(value | 0x80);
+		value >>= 7;
+	}
+	dest[len++] = (uint8_t)value;
+	return len;
+}
+
+// Parses one conversion, starting after the '%'. Returns the conversion char ('d', 'x', '%', ...),
+// or 0 if the format ends first.
+static char debug_log_parse_conversion(const char **format, char *pad_char, uint8_t *width) {
+	const char *p = *format;
+	*pad_char = ' ';
+	*width = 0;
+	if (*p == '0') {
+		*pad_char = '0';
+		p++;
+	}
+	while (*p >= '0' && *p <= '9') {
+		*width = (*width * 10) + (*p - '0');
+		p++;
+	}
+	while (*p == 'l') {
+		p++;
+	}
+	*format = (*p != '\0') ? (p + 1) : p;
+	return *p;
+}
+
+uint8_t debug_log_count_args(const char *format) {
+	uint8_t arg_count = 0;
+	while (*format != '\0') {
+		if (*format++ != '%') {
+			continue;
+		}
+		char pad_char;
+		uint8_t width;
+		const char conversion = debug_log_parse_conversion(&format, &pad_char, &width);
+		if (conversion != '%' && conversion != '\0') {
+			arg_count++;
+		}
+	}
+	return arg_count;
+}
+
+// Formats one value into dest (at least FMT_INT_I32_MAX_LEN chars), without padding. Returns the length.
+static uint8_t debug_log_format_value(char dest[], char conversion, uint32_t value) {
+	switch (conversion) {
+		case 'd':
+		case 'i':
+			return fmt_int_i32(dest, (int32_t)value);
+		case 'x':
+		case 'X': {
+			uint8_t digit_count = 1;
+			while (digit_count < 8 && (value >> (digit_count * 4)) != 0) {
+				digit_count++;
+			}
+			fmt_int_hex(dest, value, digit_count);
+			if (conversion == 'X') {
+				for (uint8_t i = 0; i < digit_count; i++) {
+					if (dest[i] >= 'a') {
+						dest[i] -= 'a' - 'A';
+					}
+				}
+			}
+			return digit_count;
+		}
+		default: // 'u'
+			return fmt_int_u32(dest, value);
+	}
+}
+
+uint16_t debug_log_format(char dest[], uint16_t dest_len, const char *format, const uint32_t args[], uint8_t arg_count) {
+	if (dest_len == 0) {
+		return 0;
+	}
+	uint16_t pos = 0;
+	uint8_t arg_num = 0;
+	const uint16_t max_pos = dest_len - 1; // room for the null terminator
+
+	while (*format != '\0' && pos < max_pos) {
+		if (*format != '%') {
+			dest[pos++] = *format++;
+			continue;
+		}
+		format++;
+
+		char pad_char;
+		uint8_t width;
+		const char conversion = debug_log_parse_conversion(&format, &pad_char, &width);
+		if (conversion == '%') {
+			dest[pos++] = '%';
+			continue;
+		}
+		if (conversion == '\0') {
+			break;
+		}
+
+		const uint32_t value = (arg_num < arg_count) ? args[arg_num] : 0;
+		arg_num++;
+		char digits[FMT_INT_I32_MAX_LEN];
+		const uint8_t digit_count = debug_log_format_value(digits, conversion, value);
+
+		uint8_t digit_start = 0;
+		if (pad_char == '0' && digits[0] == '-' && pos < max_pos) {
+			dest[pos++] = '-'; // "-0005", not "000-5"
+			digit_start = 1;
+		}
+		for (uint8_t i = digit_count; i < width && pos < max_pos; i++) {
+			dest[pos++] = pad_char;
+		}
+		for (uint8_t i = digit_start; i < digit_count && pos < max_pos; i++) {
+			dest[pos++] = digits[i];
+		}
+	}
+	dest[pos] = '\0';
+	return pos;
+}
+
+// Writes the sync byte, format ID and timestamp. Returns the length (at most 11 bytes).
+static uint8_t debug_log_write_header(uint8_t dest[], debug_log_id_t id, uint8_t sync_flags, uint32_t now_ms) {
+	uint32_t timestamp = now_ms - debug_log_last_time_ms;
+	if (debug_log_records_since_abs_time >= DEBUG_LOG_ABS_TIME_INTERVAL) {
+		sync_flags |= DEBUG_LOG_SYNC_FLAG_ABS_TIME;
+		timestamp = now_ms;
+	}
+	uint8_t len = 0;
+	dest[len++] = DEBUG_LOG_SYNC_BASE | sync_flags;
+	len += debug_log_write_varint(&dest[len], id);
+	len += debug_log_write_varint(&dest[len], timestamp);
+	return len;
+}
+
+// Sends a whole record; if it's dropped, the next record's timestamp delta is still from the last one sent.
+static void debug_log_send_record(const uint8_t record[], uint16_t len, uint32_t now_ms) {
+	if (debug_uart_print_bytes((const char *)record, len) != 0) {
+		return;
+	}
+	debug_log_last_time_ms = now_ms;
+	if (record[0] & DEBUG_LOG_SYNC_FLAG_ABS_TIME) {
+		debug_log_records_since_abs_time = 0;
+	}
+	debug_log_records_since_abs_time++;
+}
+
+void debug_log_write(debug_log_id_t id, const uint32_t args[], uint8_t arg_count) {
+	if (id >= DEBUG_LOG_ID_COUNT) {
+		return;
+	}
+
+	if (debug_log_mode == DEBUG_LOG_MODE_TEXT) {
+		char msg[DEBUG_LOG_MAX_TEXT_LEN];
+		const uint16_t len = debug_log_format(msg, sizeof(msg), debug_log_formats[id], args, arg_count);
+		debug_uart_print_bytes(msg, len);
+		return;
+	}
+
+	if (arg_count > DEBUG_LOG_MAX_ARGS) {
+		arg_count = DEBUG_LOG_MAX_ARGS;
+	}
+	const uint32_t now_ms = debug_log_now_ms();
+	uint8_t record[11 + (DEBUG_LOG_MAX_ARGS * 5)];
+	uint16_t len = debug_log_write_header(record, id, 0, now_ms);
+	for (uint8_t i = 0; i < arg_count; i++) {
+		len += debug_log_write_varint(&record[len], args[i]);
+	}
+	debug_log_send_record(record, len, now_ms);
+}
+
+void debug_log_write_hex(debug_log_id_t id, const uint8_t data[], uint16_t len) {
+	if (id >= DEBUG_LOG_ID_COUNT) {
+		return;
+	}
+
+	if (debug_log_mode == DEBUG_LOG_MODE_TEXT) {
+		debug_uart_print_str(debug_log_formats[id]);
+		if (debug_log_hex_style == DEBUG_LOG_HEX_STYLE_XXD) {
+			debug_uart_print_str("\n");
+			debug_uart_print_hex_dump(data, len);
+		}
+		else {
+			debug_uart_print_array_hex(data, len, "\n");
+		}
+		return;
+	}
+
+	if (len > DEBUG_LOG_MAX_HEX_LEN) {
+		len = DEBUG_LOG_MAX_HEX_LEN;
+	}
+	const uint32_t now_ms = debug_log_now_ms();
+	uint8_t record[11 + 3 + DEBUG_LOG_MAX_HEX_LEN];
+	uint16_t record_len = debug_log_write_header(record, id, DEBUG_LOG_SYNC_FLAG_HEX, now_ms);
+	record_len += debug_log_write_varint(&record[record_len], len);
+	memcpy(&record[record_len], data, len);
+	record_len += len;
+	debug_log_send_record(record, record_len, now_ms);
+}
@@ -1,21 +1,129 @@
-
-#include "main.h"
-#include "debug_tools/debug_i2c.h"
 #include "debug_tools/debug_uart.h"
+#include "debug_tools/fmt_int.h"
+#include "debug_tools/hex_dump.h"
+
+#ifndef EPS_HOST_BUILD
+#include "stm_drivers/uart_tx_dma.h"
+#endif
 
+#include <stddef.h>
+#include <stdio.h>
 #include <stdint.h>
 #include <string.h>
 
+#ifndef EPS_HOST_BUILD
+// Prints are queued here and sent by DMA, so printing doesn't stall the EPS transport.
+static uint8_t debug_uart_tx_ring[DEBUG_UART_TX_RING_LEN];
+static uart_tx_dma_t debug_uart_tx;
+static uint8_t debug_uart_tx_ready = 0;
+#endif
+
+uint8_t debug_uart_init(void) {
+#ifdef EPS_HOST_BUILD
+	return 0;
+#else
+	const uint8_t result = uart_tx_dma_init(&debug_uart_tx, &hlpuart1, debug_uart_tx_ring, DEBUG_UART_TX_RING_LEN);
+	debug_uart_tx_ready = (result == 0);
+	return result;
+#endif
+}
+
 void debug_uart_print_str(const char *str) {
-    HAL_UART_Transmit(&hlpuart1, (uint8_t *)str, strlen(str), 100);
+#ifdef EPS_HOST_BUILD
+	fputs(str, stdout);
+#else
+	debug_uart_print_bytes(str, strlen(str));
+#endif
+}
+
+uint8_t debug_uart_print_bytes(const char *data, uint16_t len) {
+#ifdef EPS_HOST_BUILD
+	fwrite(data, 1, len, stdout);
+	return 0;
+#else
+	if (debug_uart_tx_ready) {
+		return uart_tx_dma_write(&debug_uart_tx, (const uint8_t *)data, len);
+	}
+	// before debug_uart_init(): blocking
+	return (HAL_UART_Transmit(&hlpuart1, (uint8_t *)data, len, 100) == HAL_OK) ? 0 : 1;
+#endif
+}
+
+uint8_t debug_uart_is_tx_idle(void) {
+#ifdef EPS_HOST_BUILD
+	return 1;
+#else
+	return !debug_uart_tx_ready || (uart_tx_dma_pending(&debug_uart_tx) == 0);
+#endif
+}
+
+uint32_t debug_uart_get_dropped_msg_count(void) {
+#ifdef EPS_HOST_BUILD
+	return 0;
+#else
+	return debug_uart_tx.dropped_msg_count;
+#endif
+}
+
+void debug_uart_flush_on_fault(void) {
+#ifndef EPS_HOST_BUILD
+	if (!debug_uart_tx_ready) {
+		return;
+	}
+	debug_uart_tx_ready = 0; // anything printed after the fault is sent blocking
+	uart_tx_dma_flush_blocking(&debug_uart_tx);
+
+	if (debug_uart_tx.dropped_msg_count > 0) {
+		char msg[48];
+		char *end = fmt_int_append_str(msg, "\nDEBUG UART: dropped messages: ");
+		end = fmt_int_append_u32(end, debug_uart_tx.dropped_msg_count);
+		end = fmt_int_append_str(end, "\n");
+		uart_tx_dma_transmit_polling(&debug_uart_tx, (const uint8_t *)msg, end - msg);
+	}
+#endif
+}
+
+void debug_uart_json_sink(const char *data, uint16_t len, void *context) {
+	debug_uart_print_bytes(data, len);
+}
+
+// Returns 1 if a message of total_len bytes, sent in several writes, must be dropped as a whole,
+// instead of having its middle cut out when the ring fills up.
+static uint8_t debug_uart_drop_whole_message(uint32_t total_len) {
+#ifndef EPS_HOST_BUILD
+	if (debug_uart_tx_ready && total_len > uart_tx_dma_free(&debug_uart_tx)) {
+		uart_tx_dma_count_drop(&debug_uart_tx, total_len);
+		return 1;
+	}
+#endif
+	return 0;
 }
 
 void debug_uart_print_array_hex(const uint8_t* arr, uint16_t len, const char* end_str) {
-	char msg[10];
-	for (uint16_t i = 0; i < len; i++) {
-		sprintf(msg, "0x%02x ", arr[i]);
-		debug_uart_print_str(msg);
+	const size_t end_str_len = strlen(end_str);
+	if (debug_uart_drop_whole_message((uint32_t)len * HEX_DUMP_BYTES_CHARS_PER_BYTE + end_str_len)) {
+		return;
 	}
 
-	debug_uart_print_str(end_str);
+	// Encoded in chunks, so a 274-byte response is a few writes instead of 274.
+	char msg[DEBUG_UART_HEX_CHUNK_BYTES * HEX_DUMP_BYTES_CHARS_PER_BYTE];
+	for (uint16_t i = 0; i < len; i += DEBUG_UART_HEX_CHUNK_BYTES) {
+		const uint16_t chunk_len = (len - i < DEBUG_UART_HEX_CHUNK_BYTES) ? (len - i) : DEBUG_UART_HEX_CHUNK_BYTES;
+		debug_uart_print_bytes(msg, hex_dump_encode_bytes(msg, &arr[i], chunk_len));
+	}
+
+	debug_uart_print_bytes(end_str, end_str_len);
+}
+
+void debug_uart_print_hex_dump(const uint8_t* arr, uint16_t len) {
+	const uint16_t line_count = (len + HEX_DUMP_LINE_BYTES - 1) / HEX_DUMP_LINE_BYTES;
+	if (debug_uart_drop_whole_message((uint32_t)line_count * HEX_DUMP_LINE_MAX_LEN)) {
+		return;
+	}
+
+	char line[HEX_DUMP_LINE_MAX_LEN];
+	for (uint32_t offset = 0; offset < len; offset += HEX_DUMP_LINE_BYTES) {
+		const uint8_t line_len = (len - offset < HEX_DUMP_LINE_BYTES) ? (len - offset) : HEX_DUMP_LINE_BYTES;
+		debug_uart_print_bytes(line, hex_dump_encode_line(line, offset, &arr[offset], line_len));
+	}
 }
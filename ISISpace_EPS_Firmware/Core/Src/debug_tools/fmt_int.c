@@ -0,0 +1,122 @@
+#include "debug_tools/fmt_int.h"
+
+#include <stdint.h>
+#include <string.h>
+
+// "00" to "99": two digits per division by 100
+static const char fmt_int_digit_pairs[200] = {
+	'0','0','0','1','0','2','0','3','0','4','0','5','0','6','0','7','0','8','0','9',
+	'1','0','1','1','1','2','1','3','1','4','1','5','1','6','1','7','1','8','1','9',
+	'2','0','2','1','2','2','2','3','2','4','2','5','2','6','2','7','2','8','2','9',
+	'3','0','3','1','3','2','3','3','3','4','3','5','3','6','3','7','3','8','3','9',
+	'4','0','4','1','4','2','4','3','4','4','4','5','4','6','4','7','4','8','4','9',
+	'5','0','5','1','5','2','5','3','5','4','5','5','5','6','5','7','5','8','5','9',
+	'6','0','6','1','6','2','6','3','6','4','6','5','6','6','6','7','6','8','6','9',
+	'7','0','7','1','7','2','7','3','7','4','7','5','7','6','7','7','7','8','7','9',
+	'8','0','8','1','8','2','8','3','8','4','8','5','8','6','8','7','8','8','8','9',
+	'9','0','9','1','9','2','9','3','9','4','9','5','9','6','9','7','9','8','9','9',
+};
+
+static const char fmt_int_hex_digits[16] = {
+	'0','1','2','3','4','5','6','7','8','9','a','b','c','d','e','f'
+};
+
+
+uint8_t fmt_int_u32(char dest[], uint32_t value) {
+	// Digits are written backwards into a scratch buffer, then copied out in one go
+	char digits[FMT_INT_U32_MAX_LEN];
+	char *p = &digits[FMT_INT_U32_MAX_LEN];
+
+	while (value >= 100) {
+		const uint32_t pair_idx = (value % 100) * 2;
+		value /= 100;
+		*--p = fmt_int_digit_pairs[pair_idx + 1];
+		*--p = fmt_int_digit_pairs[pair_idx];
+	}
+	if (value >= 10) {
+		*--p = fmt_int_digit_pairs[value * 2 + 1];
+		*--p = fmt_int_digit_pairs[value * 2];
+	}
+	else {
+		*--p = '0' + value;
+	}
+
+	const uint8_t len = &digits[FMT_INT_U32_MAX_LEN] - p;
+	memcpy(dest, p, len);
+	return len;
+}
+
+uint8_t fmt_int_i32(char dest[], int32_t value) {
+	if (value < 0) {
+		dest[0] = '-';
+		// negate as unsigned, so that INT32_MIN works
+		return 1 + fmt_int_u32(&dest[1], 0 - (uint32_t) value);
+	}
+	return fmt_int_u32(dest, value);
+}
+
+uint8_t fmt_int_u32_width(char dest[], uint32_t value, uint8_t width, char pad_char) {
+	char digits[FMT_INT_U32_MAX_LEN];
+	const uint8_t len = fmt_int_u32(digits, value);
+	uint8_t pad_len = 0;
+	if (width > len) {
+		pad_len = width - len;
+		memset(dest, pad_char, pad_len);
+	}
+	memcpy(&dest[pad_len], digits, len);
+	return pad_len + len;
+}
+
+uint8_t fmt_int_hex(char dest[], uint32_t value, uint8_t digit_count) {
+	for (int8_t i = digit_count - 1; i >= 0; i--) {
+		dest[i] = fmt_int_hex_digits[value & 0xF];
+		value >>= 4;
+	}
+	return digit_count;
+}
+
+uint8_t fmt_int_fixed(char dest[], int32_t value, uint8_t decimal_places) {
+	uint8_t len = 0;
+	uint32_t magnitude = (uint32_t) value;
+	if (value < 0) {
+		dest[len++] = '-';
+		magnitude = 0 - (uint32_t) value;
+	}
+	if (decimal_places == 0) {
+		return len + fmt_int_u32(&dest[len], magnitude);
+	}
+
+	uint32_t divisor = 1;
+	for (uint8_t i = 0; i < decimal_places; i++) {
+		divisor *= 10;
+	}
+	len += fmt_int_u32(&dest[len], magnitude / divisor);
+	dest[len++] = '.';
+	len += fmt_int_u32_width(&dest[len], magnitude % divisor, decimal_places, '0');
+	return len;
+}
+
+
+char* fmt_int_append_str(char dest[], const char *str) {
+	const size_t len = strlen(str);
+	memcpy(dest, str, len + 1);
+	return &dest[len];
+}
+
+char* fmt_int_append_u32(char dest[], uint32_t value) {
+	const uint8_t len = fmt_int_u32(dest, value);
+	dest[len] = '\0';
+	return &dest[len];
+}
+
+char* fmt_int_append_i32(char dest[], int32_t value) {
+	const uint8_t len = fmt_int_i32(dest, value);
+	dest[len] = '\0';
+	return &dest[len];
+}
+
+char* fmt_int_append_hex(char dest[], uint32_t value, uint8_t digit_count) {
+	const uint8_t len = fmt_int_hex(dest, value, digit_count);
+	dest[len] = '\0';
+	return &dest[len];
+}
@@ -0,0 +1,73 @@
+#include "debug_tools/hex_dump.h"
+
+#include <stdint.h>
+#include <string.h>
+
+// Two lowercase hex chars for each byte value: byte b is at [2 * b].
+static const char hex_dump_byte_chars[256 * 2 + 1] =
+	"000102030405060708090a0b0c0d0e0f"
+	"101112131415161718191a1b1c1d1e1f"
+	"202122232425262728292a2b2c2d2e2f"
+	"303132333435363738393a3b3c3d3e3f"
+	"404142434445464748494a4b4c4d4e4f"
+	"505152535455565758595a5b5c5d5e5f"
+	"606162636465666768696a6b6c6d6e6f"
+	"707172737475767778797a7b7c7d7e7f"
+	"808182838485868788898a8b8c8d8e8f"
+	"909192939495969798999a9b9c9d9e9f"
+	"a0a1a2a3a4a5a6a7a8a9aaabacadaeaf"
+	"b0b1b2b3b4b5b6b7b8b9babbbcbdbebf"
+	"c0c1c2c3c4c5c6c7c8c9cacbcccdcecf"
+	"d0d1d2d3d4d5d6d7d8d9dadbdcdddedf"
+	"e0e1e2e3e4e5e6e7e8e9eaebecedeeef"
+	"f0f1f2f3f4f5f6f7f8f9fafbfcfdfeff";
+
+
+uint16_t hex_dump_encode_bytes(char dest[], const uint8_t data[], uint16_t len) {
+	char *p = dest;
+	for (uint16_t i = 0; i < len; i++) {
+		p[0] = '0';
+		p[1] = 'x';
+		memcpy(&p[2], &hex_dump_byte_chars[2 * data[i]], 2);
+		p[4] = ' ';
+		p += HEX_DUMP_BYTES_CHARS_PER_BYTE;
+	}
+	return p - dest;
+}
+
+uint8_t hex_dump_encode_line(char dest[], uint16_t offset, const uint8_t data[], uint8_t len) {
+	if (len > HEX_DUMP_LINE_BYTES) {
+		len = HEX_DUMP_LINE_BYTES;
+	}
+	char *p = dest;
+
+	// offset column
+	memcpy(&p[0], &hex_dump_byte_chars[2 * (offset >> 8)], 2);
+	memcpy(&p[2], &hex_dump_byte_chars[2 * (offset & 0xFF)], 2);
+	p[4] = ':';
+	p[5] = ' ';
+	p += 6;
+
+	// hex column, in groups of 2 bytes; padded on the last line so the ASCII column lines up
+	for (uint8_t i = 0; i < HEX_DUMP_LINE_BYTES; i++) {
+		if (i < len) {
+			memcpy(p, &hex_dump_byte_chars[2 * data[i]], 2);
+		}
+		else {
+			p[0] = ' ';
+			p[1] = ' ';
+		}
+		p += 2;
+		if (i & 1) {
+			*p++ = ' ';
+		}
+	}
+	*p++ = ' ';
+
+	// ASCII column
+	for (uint8_t i = 0; i < len; i++) {
+		*p++ = (data[i] >= 0x20 && data[i] < 0x7F) ? (char)data[i] : '.';
+	}
+	*p++ = '\n';
+	return p - dest;
+}
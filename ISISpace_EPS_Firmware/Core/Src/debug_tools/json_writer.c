@@ -0,0 +1,192 @@
+#include "debug_tools/json_writer.h"
+#include "debug_tools/fmt_int.h"
+
+#include <stdint.h>
+#include <string.h>
+
+
+void json_writer_init(json_writer_t *writer, char buf[], uint16_t buf_len, json_writer_sink_t sink, void *sink_context) {
+	writer->buf = buf;
+	writer->buf_len = buf_len;
+	writer->pos = 0;
+	writer->sink = sink;
+	writer->sink_context = sink_context;
+	writer->depth = 0;
+	writer->has_items_bitfield = 0;
+	writer->overflowed = (buf_len < 2); // need room for at least 1 char and the null terminator
+	writer->total_len = 0;
+}
+
+static void json_writer_flush(json_writer_t *writer) {
+	if (writer->pos > 0) {
+		writer->sink(writer->buf, writer->pos, writer->sink_context);
+		writer->pos = 0;
+	}
+}
+
+// Bytes free in buf, keeping 1 for the null terminator
+static uint16_t json_writer_space(const json_writer_t *writer) {
+	return writer->buf_len - 1 - writer->pos;
+}
+
+// Makes `len` bytes free in buf if possible. Returns 1 if they are free.
+static uint8_t json_writer_reserve(json_writer_t *writer, uint16_t len) {
+	if (json_writer_space(writer) >= len) {
+		return 1;
+	}
+	if (writer->sink != NULL) {
+		json_writer_flush(writer);
+		return json_writer_space(writer) >= len;
+	}
+	return 0;
+}
+
+static void json_writer_put(json_writer_t *writer, const char *str, uint16_t len) {
+	while (len > 0 && !writer->overflowed) {
+		if (!json_writer_reserve(writer, 1)) {
+			writer->overflowed = 1;
+			return;
+		}
+		uint16_t chunk_len = json_writer_space(writer);
+		if (chunk_len > len) {
+			chunk_len = len;
+		}
+		memcpy(&writer->buf[writer->pos], str, chunk_len);
+		writer->pos += chunk_len;
+		writer->total_len += chunk_len;
+		str += chunk_len;
+		len -= chunk_len;
+	}
+}
+
+static void json_writer_put_char(json_writer_t *writer, char c) {
+	if (writer->overflowed || !json_writer_reserve(writer, 1)) {
+		writer->overflowed = 1;
+		return;
+	}
+	writer->buf[writer->pos++] = c;
+	writer->total_len++;
+}
+
+static void json_writer_put_quoted(json_writer_t *writer, const char *str) {
+	// Escapes '"' and '\'. Keys and values here are plain identifiers/labels, so nothing else.
+	json_writer_put_char(writer, '"');
+	const char *run_start = str;
+	for (; *str != '\0'; str++) {
+		if (*str == '"' || *str == '\\') {
+			json_writer_put(writer, run_start, str - run_start);
+			json_writer_put_char(writer, '\\');
+			run_start = str;
+		}
+	}
+	json_writer_put(writer, run_start, str - run_start);
+	json_writer_put_char(writer, '"');
+}
+
+// Writes the ',' before a value (if it isn't the first in its object/array), and its key.
+static void json_writer_begin_value(json_writer_t *writer, const char *key) {
+	const uint16_t depth_bit = (1 << writer->depth);
+	if (writer->has_items_bitfield & depth_bit) {
+		json_writer_put_char(writer, ',');
+	}
+	writer->has_items_bitfield |= depth_bit;
+
+	if (key != NULL) {
+		json_writer_put_quoted(writer, key);
+		json_writer_put_char(writer, ':');
+	}
+}
+
+static void json_writer_put_number(json_writer_t *writer, uint32_t value, uint8_t is_signed) {
+	if (writer->overflowed) {
+		return;
+	}
+	if (json_writer_reserve(writer, FMT_INT_I32_MAX_LEN)) {
+		// Formatted in place: no intermediate buffer
+		const uint8_t len = is_signed ?
+				fmt_int_i32(&writer->buf[writer->pos], (int32_t) value) : fmt_int_u32(&writer->buf[writer->pos], value);
+		writer->pos += len;
+		writer->total_len += len;
+		return;
+	}
+
+	// No sink and almost full: the number may still fit
+	char digits[FMT_INT_I32_MAX_LEN];
+	const uint8_t len = is_signed ? fmt_int_i32(digits, (int32_t) value) : fmt_int_u32(digits, value);
+	json_writer_put(writer, digits, len);
+}
+
+static void json_writer_begin_container(json_writer_t *writer, const char *key, char open_char) {
+	json_writer_begin_value(writer, key);
+	json_writer_put_char(writer, open_char);
+	if (writer->depth + 1 >= JSON_WRITER_MAX_DEPTH) {
+		writer->overflowed = 1;
+		return;
+	}
+	writer->depth++;
+	writer->has_items_bitfield &= ~(1 << writer->depth);
+}
+
+static void json_writer_end_container(json_writer_t *writer, char close_char) {
+	if (writer->depth > 0) {
+		writer->depth--;
+	}
+	json_writer_put_char(writer, close_char);
+}
+
+void json_writer_begin_object(json_writer_t *writer, const char *key) {
+	json_writer_begin_container(writer, key, '{');
+}
+
+void json_writer_end_object(json_writer_t *writer) {
+	json_writer_end_container(writer, '}');
+}
+
+void json_writer_begin_array(json_writer_t *writer, const char *key) {
+	json_writer_begin_container(writer, key, '[');
+}
+
+void json_writer_end_array(json_writer_t *writer) {
+	json_writer_end_container(writer, ']');
+}
+
+void json_writer_int(json_writer_t *writer, const char *key, int32_t value) {
+	json_writer_begin_value(writer, key);
+	json_writer_put_number(writer, (uint32_t) value, 1);
+}
+
+void json_writer_uint(json_writer_t *writer, const char *key, uint32_t value) {
+	json_writer_begin_value(writer, key);
+	json_writer_put_number(writer, value, 0);
+}
+
+void json_writer_str(json_writer_t *writer, const char *key, const char *value) {
+	json_writer_begin_value(writer, key);
+	json_writer_put_quoted(writer, value);
+}
+
+void json_writer_int16_array(json_writer_t *writer, const char *key, const int16_t values[], uint16_t count) {
+	json_writer_begin_array(writer, key);
+	for (uint16_t i = 0; i < count; i++) {
+		json_writer_int(writer, NULL, values[i]);
+	}
+	json_writer_end_array(writer);
+}
+
+void json_writer_uint16_array(json_writer_t *writer, const char *key, const uint16_t values[], uint16_t count) {
+	json_writer_begin_array(writer, key);
+	for (uint16_t i = 0; i < count; i++) {
+		json_writer_uint(writer, NULL, values[i]);
+	}
+	json_writer_end_array(writer);
+}
+
+uint8_t json_writer_finish(json_writer_t *writer) {
+	if (writer->sink != NULL) {
+		json_writer_flush(writer);
+	}
+	else if (writer->buf_len > 0) {
+		writer->buf[writer->pos] = '\0';
+	}
+	return writer->overflowed ? 3 : 0;
+}
@@ -0,0 +1,103 @@
+#include "debug_tools/timing_probe.h"
+
+#if TIMING_PROBES_ENABLED
+
+#include "debug_tools/debug_uart.h"
+#include "debug_tools/fmt_int.h"
+
+#ifdef EPS_HOST_BUILD
+#include <time.h>
+#else
+#include "stm_drivers/timing_helpers.h"
+#endif
+
+#include <stdint.h>
+
+#define TIMING_PROBE_NAME_ENTRY(id, name) name,
+static const char *const timing_probe_names[TIMING_PROBE_ID_COUNT] = {
+	TIMING_PROBES(TIMING_PROBE_NAME_ENTRY)
+};
+
+static timing_probe_stats_t timing_probe_stats[TIMING_PROBE_ID_COUNT];
+
+
+uint32_t timing_probe_now(void) {
+#ifdef EPS_HOST_BUILD
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint32_t)(ts.tv_sec * 1000000000) + (uint32_t) ts.tv_nsec;
+#else
+	return get_cycle_count();
+#endif
+}
+
+static uint32_t timing_probe_cycles_per_us() {
+#ifdef EPS_HOST_BUILD
+	return 1000;
+#else
+	return SystemCoreClock / 1000000;
+#endif
+}
+
+void timing_probe_record(timing_probe_id_t id, uint32_t cycles) {
+	timing_probe_stats_t *stats = &timing_probe_stats[id];
+	if (stats->count == 0 || cycles < stats->min_cycles) {
+		stats->min_cycles = cycles;
+	}
+	if (cycles > stats->max_cycles) {
+		stats->max_cycles = cycles;
+	}
+	stats->total_cycles += cycles;
+	stats->count++;
+}
+
+void timing_probe_begin(timing_probe_id_t id) {
+	timing_probe_stats[id].begin_cycles = timing_probe_now();
+}
+
+void timing_probe_end(timing_probe_id_t id) {
+	// unsigned subtraction: correct across one wrap of the counter
+	timing_probe_record(id, timing_probe_now() - timing_probe_stats[id].begin_cycles);
+}
+
+void timing_probe_scope_end(const timing_probe_scope_t *scope) {
+	timing_probe_record(scope->id, timing_probe_now() - scope->begin_cycles);
+}
+
+void timing_probe_reset_all(void) {
+	for (uint8_t id = 0; id < TIMING_PROBE_ID_COUNT; id++) {
+		timing_probe_stats[id] = (timing_probe_stats_t) { 0 };
+	}
+}
+
+const timing_probe_stats_t* timing_probe_get(timing_probe_id_t id) {
+	return &timing_probe_stats[id];
+}
+
+void timing_probe_debug_print_all(void) {
+	char msg[120];
+	for (uint8_t id = 0; id < TIMING_PROBE_ID_COUNT; id++) {
+		const timing_probe_stats_t *stats = &timing_probe_stats[id];
+		if (stats->count == 0) {
+			continue;
+		}
+		const uint32_t mean_cycles = (uint32_t)(stats->total_cycles / stats->count);
+
+		char *end = fmt_int_append_str(msg, "Probe ");
+		end = fmt_int_append_str(end, timing_probe_names[id]);
+		end = fmt_int_append_str(end, ": count=");
+		end = fmt_int_append_u32(end, stats->count);
+		end = fmt_int_append_str(end, ", min=");
+		end = fmt_int_append_u32(end, stats->min_cycles);
+		end = fmt_int_append_str(end, ", mean=");
+		end = fmt_int_append_u32(end, mean_cycles);
+		end = fmt_int_append_str(end, ", max=");
+		end = fmt_int_append_u32(end, stats->max_cycles);
+		end = fmt_int_append_str(end, " cycles (mean ");
+		end = fmt_int_append_u32(end, mean_cycles / timing_probe_cycles_per_us());
+		fmt_int_append_str(end, " us)\n");
+		debug_uart_print_str(msg);
+	}
+}
+
+#endif // TIMING_PROBES_ENABLED
@@ -0,0 +1,162 @@
+#include "eps_drivers/eps_channel_telemetry.h"
+#include "eps_drivers/eps_cmd_table.h"
+#include "eps_drivers/eps_field_decoder.h"
+#include "eps_drivers/eps_types.h"
+
+#ifndef EPS_HOST_BUILD
+#include "main.h" // CMSIS SIMD intrinsics (__SMLAD, __SSUB16, __SEL, __QSUB16)
+#endif
+
+// The CMSIS SIMD intrinsics only exist for cores with the DSP extension (e.g., -mcpu=cortex-m4).
+// Can be set from outside to build the SIMD kernels against emulated intrinsics (see Tools/channel_telemetry_check.c).
+#ifndef EPS_CHANNEL_TELEMETRY_USE_SIMD
+#if !defined(EPS_HOST_BUILD) && defined(__ARM_FEATURE_DSP) && (__ARM_FEATURE_DSP == 1)
+#define EPS_CHANNEL_TELEMETRY_USE_SIMD 1
+#else
+#define EPS_CHANNEL_TELEMETRY_USE_SIMD 0
+#endif
+#endif
+
+#include <stdint.h>
+#include <string.h>
+
+#define EPS_CHANNEL_COUNT EPS_CHANNEL_TELEMETRY_CHANNEL_COUNT
+
+// The SIMD kernels take channels in pairs, and masks are 32 bits
+_Static_assert(EPS_CHANNEL_COUNT % 2 == 0 && EPS_CHANNEL_COUNT <= 32, "channel count must be even and <= 32");
+
+
+uint8_t eps_get_pdu_channel_telemetry(eps_channel_telemetry_t *result_dest) {
+	return eps_cmd_execute_with_fields(EPS_CMD_ID_GET_PDU_HOUSEKEEPING_DATA_ENG, 0, &eps_field_table_pdu_channel_telemetry, result_dest);
+}
+
+uint8_t eps_get_piu_channel_telemetry(eps_channel_telemetry_t *result_dest) {
+	return eps_cmd_execute_with_fields(EPS_CMD_ID_GET_PIU_HOUSEKEEPING_DATA_ENG, 0, &eps_field_table_piu_channel_telemetry, result_dest);
+}
+
+uint32_t eps_channel_telemetry_on_mask(const eps_channel_telemetry_t *telemetry) {
+	return telemetry->stat_ch_on_bitfield | ((uint32_t) telemetry->stat_ch_ext_on_bitfield << 16);
+}
+
+uint32_t eps_channel_telemetry_overcurrent_fault_mask(const eps_channel_telemetry_t *telemetry) {
+	return telemetry->stat_ch_overcurrent_fault_bitfield | ((uint32_t) telemetry->stat_ch_ext_overcurrent_fault_bitfield << 16);
+}
+
+static uint8_t eps_channel_find(const int16_t column[], int16_t value) {
+	uint8_t channel = 0;
+	while (column[channel] != value) {
+		channel++;
+	}
+	return channel;
+}
+
+
+#if EPS_CHANNEL_TELEMETRY_USE_SIMD
+
+// #pragma region Kernels (Cortex-M4 SIMD)
+// Each 32-bit word holds two channels: channel i in the low halfword, channel i+1 in the high one.
+
+static inline uint32_t eps_channel_load_pair(const int16_t column[]) {
+	uint32_t pair;
+	memcpy(&pair, column, sizeof(pair)); // a single LDR (unaligned access is fine for LDR on the M4)
+	return pair;
+}
+
+int32_t eps_channel_sum(const int16_t column[]) {
+	// SMLAD multiplies both halfwords by 1 and adds them to the 32-bit accumulator (no 16-bit overflow)
+	uint32_t sum = 0;
+	for (uint8_t i = 0; i < EPS_CHANNEL_COUNT; i += 2) {
+		sum = __SMLAD(eps_channel_load_pair(&column[i]), 0x00010001, sum);
+	}
+	return (int32_t) sum;
+}
+
+void eps_channel_min_max(const int16_t column[], eps_channel_min_max_t *result_dest) {
+	// SSUB16 sets the GE flags of each halfword where a >= b; SEL then picks a's halfwords there.
+	uint32_t min_pair = eps_channel_load_pair(&column[0]);
+	uint32_t max_pair = min_pair;
+	for (uint8_t i = 2; i < EPS_CHANNEL_COUNT; i += 2) {
+		const uint32_t pair = eps_channel_load_pair(&column[i]);
+		(void) __SSUB16(pair, max_pair);
+		max_pair = __SEL(pair, max_pair);
+		(void) __SSUB16(pair, min_pair);
+		min_pair = __SEL(min_pair, pair);
+	}
+	const int16_t min_low = (int16_t) min_pair, min_high = (int16_t)(min_pair >> 16);
+	const int16_t max_low = (int16_t) max_pair, max_high = (int16_t)(max_pair >> 16);
+	result_dest->min = (min_low < min_high) ? min_low : min_high;
+	result_dest->max = (max_low > max_high) ? max_low : max_high;
+	result_dest->min_channel = eps_channel_find(column, result_dest->min);
+	result_dest->max_channel = eps_channel_find(column, result_dest->max);
+}
+
+uint32_t eps_channel_threshold_mask(const int16_t column[], int16_t threshold) {
+	if (threshold == INT16_MAX) {
+		return 0;
+	}
+	// column[i] > threshold is column[i] >= threshold + 1: the GE flags of SSUB16
+	const uint32_t limit_pair = (uint16_t)(threshold + 1) * 0x00010001u;
+	uint32_t mask = 0;
+	for (uint8_t i = 0; i < EPS_CHANNEL_COUNT; i += 2) {
+		(void) __SSUB16(eps_channel_load_pair(&column[i]), limit_pair);
+		const uint32_t bits = __SEL(0x00020001, 0); // 1 in the low halfword, 2 in the high one
+		mask |= ((bits | (bits >> 16)) & 0x3) << i;
+	}
+	return mask;
+}
+
+void eps_channel_delta(const int16_t column[], const int16_t previous[], int16_t delta_dest[]) {
+	for (uint8_t i = 0; i < EPS_CHANNEL_COUNT; i += 2) {
+		const uint32_t delta_pair = __QSUB16(eps_channel_load_pair(&column[i]), eps_channel_load_pair(&previous[i]));
+		memcpy(&delta_dest[i], &delta_pair, sizeof(delta_pair));
+	}
+}
+
+// #pragma endregion Kernels (Cortex-M4 SIMD)
+
+#else
+
+// #pragma region Kernels (portable)
+// Plain loops over the columns, with no early exits or branches, so the compiler can vectorise them.
+
+int32_t eps_channel_sum(const int16_t column[]) {
+	int32_t sum = 0;
+	for (uint8_t i = 0; i < EPS_CHANNEL_COUNT; i++) {
+		sum += column[i];
+	}
+	return sum;
+}
+
+void eps_channel_min_max(const int16_t column[], eps_channel_min_max_t *result_dest) {
+	int16_t min = column[0];
+	int16_t max = column[0];
+	for (uint8_t i = 1; i < EPS_CHANNEL_COUNT; i++) {
+		min = (column[i] < min) ? column[i] : min;
+		max = (column[i] > max) ? column[i] : max;
+	}
+	result_dest->min = min;
+	result_dest->max = max;
+	result_dest->min_channel = eps_channel_find(column, min);
+	result_dest->max_channel = eps_channel_find(column, max);
+}
+
+uint32_t eps_channel_threshold_mask(const int16_t column[], int16_t threshold) {
+	uint32_t mask = 0;
+	for (uint8_t i = 0; i < EPS_CHANNEL_COUNT; i++) {
+		mask |= (uint32_t)(column[i] > threshold) << i;
+	}
+	return mask;
+}
+
+void eps_channel_delta(const int16_t column[], const int16_t previous[], int16_t delta_dest[]) {
+	for (uint8_t i = 0; i < EPS_CHANNEL_COUNT; i++) {
+		int32_t delta = (int32_t) column[i] - previous[i];
+		delta = (delta > INT16_MAX) ? INT16_MAX : delta;
+		delta = (delta < INT16_MIN) ? INT16_MIN : delta;
+		delta_dest[i] = (int16_t) delta;
+	}
+}
+
+// #pragma endregion Kernels (portable)
+
+#endif
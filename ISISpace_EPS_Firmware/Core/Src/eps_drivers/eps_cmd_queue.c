@@ -0,0 +1,185 @@
+#include "eps_drivers/eps_cmd_queue.h"
+#include "eps_drivers/eps_internal_drivers.h"
+#include "eps_drivers/eps_transport.h"
+
+#include <stdint.h>
+#include <string.h>
+
+// One circular queue per priority class; the in-flight command is moved out into eps_cmd_in_flight.
+// Free-running indices: only submit writes a tail and only the pump writes a head, so the pump
+// can preempt a submit (or the other way around) without a lock.
+static eps_cmd_t eps_cmd_queue[EPS_CMD_PRIORITY_COUNT][EPS_CMD_QUEUE_LEN];
+static volatile uint8_t eps_cmd_queue_head[EPS_CMD_PRIORITY_COUNT]; // next to send
+static volatile uint8_t eps_cmd_queue_tail[EPS_CMD_PRIORITY_COUNT]; // next free slot
+
+static eps_cmd_t eps_cmd_in_flight;
+static const eps_transport_t *eps_cmd_in_flight_transport = NULL;
+static volatile uint8_t eps_cmd_is_in_flight = 0;
+
+static volatile uint8_t eps_cmd_queue_pumping = 0;
+static eps_cmd_queue_stats_t eps_cmd_queue_stats;
+
+
+static uint32_t eps_cmd_queue_now_ms() {
+	const eps_transport_t *transport = eps_get_transport();
+	return (transport != NULL) ? transport->now_ms() : 0;
+}
+
+EPS_CMD_PRIORITY_enum_t eps_cmd_get_priority(uint8_t command_code) {
+	switch (command_code) {
+		case 0x04: // cancel operation
+		case 0x06: // watchdog
+		case 0x30: // nominal mode
+		case 0x32: // safety mode
+		case 0xAA: // system reset
+			return EPS_CMD_PRIORITY_SAFETY;
+
+		case 0x10: case 0x12: case 0x14: case 0x16: case 0x18: // output bus
+		case 0x84: case 0x86: case 0x90: case 0x92: case 0x94: // configuration changes
+		case 0xC4: case 0xC6:
+			return EPS_CMD_PRIORITY_CONTROL;
+
+		default:
+			return EPS_CMD_PRIORITY_TELEMETRY;
+	}
+}
+
+uint8_t eps_cmd_queue_submit(
+		const uint8_t cmd_buf[], uint8_t cmd_buf_len,
+		uint8_t rx_buf[], uint16_t rx_buf_len,
+		eps_cmd_callback_t callback, void *context) {
+	if (cmd_buf_len < 3) {
+		return 1;
+	}
+	return eps_cmd_queue_submit_with_priority(
+			eps_cmd_get_priority(cmd_buf[2]), cmd_buf, cmd_buf_len, rx_buf, rx_buf_len, callback, context);
+}
+
+uint8_t eps_cmd_queue_submit_with_priority(
+		EPS_CMD_PRIORITY_enum_t priority,
+		const uint8_t cmd_buf[], uint8_t cmd_buf_len,
+		uint8_t rx_buf[], uint16_t rx_buf_len,
+		eps_cmd_callback_t callback, void *context) {
+
+	if (priority >= EPS_CMD_PRIORITY_COUNT || cmd_buf_len > EPS_CMD_MAX_LEN || rx_buf_len < EPS_DEFAULT_RX_LEN_MIN) {
+		return 1;
+	}
+	eps_cmd_queue_class_stats_t *class_stats = &eps_cmd_queue_stats.each_class[priority];
+	if (eps_cmd_queue_get_depth(priority) >= EPS_CMD_QUEUE_LEN) {
+		class_stats->rejected_full_count++;
+		return EPS_CMD_QUEUE_FULL;
+	}
+
+	eps_cmd_t *cmd = &eps_cmd_queue[priority][eps_cmd_queue_tail[priority] % EPS_CMD_QUEUE_LEN];
+	memcpy(cmd->cmd_buf, cmd_buf, cmd_buf_len);
+	cmd->cmd_buf_len = cmd_buf_len;
+	cmd->rx_buf = rx_buf;
+	cmd->rx_buf_len = rx_buf_len;
+	cmd->callback = callback;
+	cmd->context = context;
+	cmd->priority = priority;
+	cmd->submit_time_ms = eps_cmd_queue_now_ms();
+
+	// publish the entry only once it's complete
+	eps_cmd_queue_tail[priority]++;
+
+	class_stats->submitted_count++;
+	const uint8_t depth = eps_cmd_queue_get_depth(priority);
+	if (depth > class_stats->max_depth) {
+		class_stats->max_depth = depth;
+	}
+	return 0;
+}
+
+static void eps_cmd_complete(const eps_cmd_t *cmd, uint8_t result_code) {
+	eps_cmd_queue_stats.completed_count++;
+	if (result_code != 0) {
+		eps_cmd_queue_stats.failed_count++;
+	}
+	if (cmd->callback != NULL) {
+		cmd->callback(result_code, cmd->rx_buf, cmd->rx_buf_len, cmd->context);
+	}
+}
+
+static uint8_t eps_cmd_queue_pop_highest_priority(eps_cmd_t *cmd_dest) {
+	// Returns 0 if all queues are empty.
+	for (uint8_t priority = 0; priority < EPS_CMD_PRIORITY_COUNT; priority++) {
+		if (eps_cmd_queue_get_depth(priority) == 0) {
+			continue;
+		}
+
+		// move the command out of the queue, so that its slot can be reused right away
+		*cmd_dest = eps_cmd_queue[priority][eps_cmd_queue_head[priority] % EPS_CMD_QUEUE_LEN];
+		eps_cmd_queue_head[priority]++;
+
+		eps_cmd_queue_class_stats_t *class_stats = &eps_cmd_queue_stats.each_class[priority];
+		const uint32_t wait_ms = eps_cmd_queue_now_ms() - cmd_dest->submit_time_ms;
+		class_stats->dispatched_count++;
+		class_stats->total_wait_ms += wait_ms;
+		if (wait_ms > class_stats->max_wait_ms) {
+			class_stats->max_wait_ms = wait_ms;
+		}
+		return 1;
+	}
+	return 0;
+}
+
+void eps_cmd_queue_pump() {
+	if (eps_cmd_queue_pumping) {
+		return;
+	}
+	eps_cmd_queue_pumping = 1;
+
+	while (1) {
+		if (eps_cmd_is_in_flight) {
+			if (!eps_cmd_in_flight_transport->poll()) {
+				break;
+			}
+			const uint8_t result_code = eps_transport_finish_cmd(
+					eps_cmd_in_flight_transport, eps_cmd_in_flight.rx_buf, eps_cmd_in_flight.rx_buf_len);
+			eps_cmd_is_in_flight = 0;
+			eps_cmd_complete(&eps_cmd_in_flight, result_code);
+		}
+
+		if (!eps_cmd_queue_pop_highest_priority(&eps_cmd_in_flight)) {
+			break;
+		}
+
+		eps_cmd_in_flight_transport = eps_get_transport();
+		const uint8_t start_result = eps_transport_start_cmd(
+				eps_cmd_in_flight_transport,
+				eps_cmd_in_flight.cmd_buf, eps_cmd_in_flight.cmd_buf_len,
+				eps_cmd_in_flight.rx_buf, eps_cmd_in_flight.rx_buf_len);
+		if (start_result != 0) {
+			eps_cmd_complete(&eps_cmd_in_flight, start_result);
+			continue;
+		}
+		eps_cmd_is_in_flight = 1;
+	}
+
+	eps_cmd_queue_pumping = 0;
+}
+
+uint8_t eps_cmd_queue_get_depth(EPS_CMD_PRIORITY_enum_t priority) {
+	return (uint8_t)(eps_cmd_queue_tail[priority] - eps_cmd_queue_head[priority]);
+}
+
+uint8_t eps_cmd_queue_is_idle() {
+	if (eps_cmd_is_in_flight) {
+		return 0;
+	}
+	for (uint8_t priority = 0; priority < EPS_CMD_PRIORITY_COUNT; priority++) {
+		if (eps_cmd_queue_get_depth(priority) != 0) {
+			return 0;
+		}
+	}
+	return 1;
+}
+
+uint8_t eps_cmd_queue_is_pumping() {
+	return eps_cmd_queue_pumping;
+}
+
+const eps_cmd_queue_stats_t* eps_cmd_queue_get_stats() {
+	return &eps_cmd_queue_stats;
+}
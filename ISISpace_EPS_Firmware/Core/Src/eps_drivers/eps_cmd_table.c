@@ -0,0 +1,149 @@
+#include "debug_tools/debug_log.h"
+#include "eps_drivers/eps_cmd_table.h"
+#include "eps_drivers/eps_cmd_queue.h"
+#include "eps_drivers/eps_field_decoder.h"
+#include "eps_drivers/eps_hk_cache.h"
+#include "eps_drivers/eps_internal_drivers.h"
+#include "eps_drivers/eps_types.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#define RX_MIN EPS_DEFAULT_RX_LEN_MIN
+
+
+static uint8_t eps_decode_pbu_abf_placed_state(const uint8_t rx_buf[], void *result_dest) {
+	// check that the response bytes are valid
+	if (rx_buf[6] != EPS_ABF_PIN_APPLIED && rx_buf[6] != EPS_ABF_PIN_NOT_APPLIED) {
+		return 20;
+	}
+	if (rx_buf[7] != EPS_ABF_PIN_APPLIED && rx_buf[7] != EPS_ABF_PIN_NOT_APPLIED) {
+		return 21;
+	}
+
+	eps_result_pbu_abf_placed_state_t *result = result_dest;
+	result->abf_placed_0 = (EPS_ABF_PIN_PLACED_enum_t) (rx_buf[6]);
+	result->abf_placed_1 = (EPS_ABF_PIN_PLACED_enum_t) (rx_buf[7]);
+	return 0;
+}
+
+static uint8_t eps_decode_configuration_parameter(const uint8_t rx_buf[], void *result_dest) {
+	// result_dest must be 8 bytes. PAR_ID is at rx_buf[6], PAR_VAL at rx_buf[8].
+	// TODO: check that the parameter value that came back is the right value
+	memcpy(result_dest, &rx_buf[8], 8);
+	return 0;
+}
+
+
+const eps_cmd_descriptor_t eps_cmd_table[EPS_CMD_ID_COUNT] = {
+	// { CC, cmd_len, has_key, key, arg_len, rx_len, decoder, fields }
+	[EPS_CMD_ID_SYSTEM_RESET] = { 0xAA, 5, 1, 0xA6, 0, RX_MIN, NULL, NULL },
+	[EPS_CMD_ID_NO_OPERATION] = { 0x02, 4, 0, 0, 0, RX_MIN, NULL, NULL },
+	[EPS_CMD_ID_CANCEL_OPER] = { 0x04, 4, 0, 0, 0, RX_MIN, NULL, NULL },
+	[EPS_CMD_ID_WATCHDOG] = { 0x06, 4, 0, 0, 0, RX_MIN, NULL, NULL },
+	[EPS_CMD_ID_OUTPUT_BUS_GROUP_ON] = { 0x10, 8, 0, 0, 4, RX_MIN, NULL, NULL }, // CH_BF, CH_EXT_BF
+	[EPS_CMD_ID_OUTPUT_BUS_GROUP_OFF] = { 0x12, 8, 0, 0, 4, RX_MIN, NULL, NULL },
+	[EPS_CMD_ID_OUTPUT_BUS_GROUP_STATE] = { 0x14, 8, 0, 0, 4, RX_MIN, NULL, NULL },
+	[EPS_CMD_ID_OUTPUT_BUS_CHANNEL_ON] = { 0x16, 5, 0, 0, 1, RX_MIN, NULL, NULL }, // CH_IDX
+	[EPS_CMD_ID_OUTPUT_BUS_CHANNEL_OFF] = { 0x18, 5, 0, 0, 1, RX_MIN, NULL, NULL },
+	[EPS_CMD_ID_SWITCH_TO_NOMINAL_MODE] = { 0x30, 4, 0, 0, 0, RX_MIN, NULL, NULL },
+	[EPS_CMD_ID_SWITCH_TO_SAFETY_MODE] = { 0x32, 4, 0, 0, 0, RX_MIN, NULL, NULL },
+	[EPS_CMD_ID_GET_SYSTEM_STATUS] = { 0x40, 4, 0, 0, 0, 36, NULL, &eps_field_table_system_status },
+	[EPS_CMD_ID_GET_PDU_OVERCURRENT_FAULT_STATE] = { 0x42, 4, 0, 0, 0, 78, NULL, &eps_field_table_pdu_overcurrent_fault_state },
+	[EPS_CMD_ID_GET_PBU_ABF_PLACED_STATE] = { 0x44, 4, 0, 0, 0, 8, eps_decode_pbu_abf_placed_state, NULL },
+	[EPS_CMD_ID_GET_PDU_HOUSEKEEPING_DATA_RAW] = { 0x50, 4, 0, 0, 0, 258, NULL, &eps_field_table_pdu_housekeeping_data_raw },
+	[EPS_CMD_ID_GET_PDU_HOUSEKEEPING_DATA_ENG] = { 0x52, 4, 0, 0, 0, 258, NULL, &eps_field_table_pdu_housekeeping_data_eng },
+	[EPS_CMD_ID_GET_PDU_HOUSEKEEPING_DATA_RUNNING_AVERAGE] = { 0x54, 4, 0, 0, 0, 258, NULL, &eps_field_table_pdu_housekeeping_data_eng },
+	[EPS_CMD_ID_GET_PBU_HOUSEKEEPING_DATA_RAW] = { 0x60, 4, 0, 0, 0, 84, NULL, &eps_field_table_pbu_housekeeping_data_raw },
+	[EPS_CMD_ID_GET_PBU_HOUSEKEEPING_DATA_ENG] = { 0x62, 4, 0, 0, 0, 84, NULL, &eps_field_table_pbu_housekeeping_data_eng },
+	[EPS_CMD_ID_GET_PBU_HOUSEKEEPING_DATA_RUNNING_AVERAGE] = { 0x64, 4, 0, 0, 0, 84, NULL, &eps_field_table_pbu_housekeeping_data_eng },
+	[EPS_CMD_ID_GET_PCU_HOUSEKEEPING_DATA_RAW] = { 0x70, 4, 0, 0, 0, 72, NULL, &eps_field_table_pcu_housekeeping_data_raw },
+	[EPS_CMD_ID_GET_PCU_HOUSEKEEPING_DATA_ENG] = { 0x72, 4, 0, 0, 0, 72, NULL, &eps_field_table_pcu_housekeeping_data_eng },
+	[EPS_CMD_ID_GET_PCU_HOUSEKEEPING_DATA_RUNNING_AVERAGE] = { 0x74, 4, 0, 0, 0, 72, NULL, &eps_field_table_pcu_housekeeping_data_eng },
+	[EPS_CMD_ID_GET_CONFIGURATION_PARAMETER] = { 0x82, 6, 0, 0, 2, 16, eps_decode_configuration_parameter, NULL }, // PAR_ID
+	[EPS_CMD_ID_SET_CONFIGURATION_PARAMETER] = { 0x84, 14, 0, 0, 2, 16, NULL, NULL }, // PAR_ID, PAR_VAL (not sent yet)
+	[EPS_CMD_ID_RESET_CONFIGURATION_PARAMETER] = { 0x86, 6, 0, 0, 2, 16, NULL, NULL }, // PAR_ID
+	[EPS_CMD_ID_RESET_CONFIGURATION] = { 0x90, 5, 1, 0x87, 0, RX_MIN, NULL, NULL },
+	[EPS_CMD_ID_LOAD_CONFIGURATION] = { 0x92, 5, 1, 0xA7, 0, RX_MIN, NULL, NULL },
+	[EPS_CMD_ID_SAVE_CONFIGURATION] = { 0x94, 7, 1, 0xA7, 2, RX_MIN, NULL, NULL }, // CHECKSUM
+	[EPS_CMD_ID_GET_PIU_HOUSEKEEPING_DATA_RAW] = { 0xA0, 4, 0, 0, 0, 274, NULL, &eps_field_table_piu_housekeeping_data_raw },
+	[EPS_CMD_ID_GET_PIU_HOUSEKEEPING_DATA_ENG] = { 0xA2, 4, 0, 0, 0, 274, NULL, &eps_field_table_piu_housekeeping_data_eng },
+	[EPS_CMD_ID_GET_PIU_HOUSEKEEPING_DATA_RUNNING_AVERAGE] = { 0xA4, 4, 0, 0, 0, 274, NULL, &eps_field_table_piu_housekeeping_data_eng },
+	[EPS_CMD_ID_CORRECT_TIME] = { 0xC4, 8, 0, 0, 4, RX_MIN, NULL, NULL }, // int32 correction
+	[EPS_CMD_ID_ZERO_RESET_CAUSE_COUNTERS] = { 0xC6, 5, 1, 0xA7, 0, RX_MIN, NULL, NULL },
+};
+
+
+EPS_CMD_ID_enum_t eps_cmd_find_id(uint8_t CC) {
+	for (uint8_t cmd_id = 0; cmd_id < EPS_CMD_ID_COUNT; cmd_id++) {
+		if (eps_cmd_table[cmd_id].CC == CC) {
+			return (EPS_CMD_ID_enum_t) cmd_id;
+		}
+	}
+	return EPS_CMD_ID_COUNT;
+}
+
+// fields overrides cmd->fields; cmd->decoder is used only when both are NULL
+static uint8_t eps_cmd_execute_decode(EPS_CMD_ID_enum_t cmd_id, uint32_t arg, const eps_field_table_t *fields, void *result_dest) {
+	const eps_cmd_descriptor_t *cmd = &eps_cmd_table[cmd_id];
+
+	uint8_t cmd_buf[EPS_CMD_MAX_LEN];
+	uint8_t rx_buf[EPS_CMD_MAX_RX_LEN];
+	memset(cmd_buf, 0, cmd->cmd_len);
+
+	cmd_buf[0] = EPS_COMMAND_STID;
+	cmd_buf[1] = EPS_COMMAND_IVID;
+	cmd_buf[2] = cmd->CC;
+	cmd_buf[3] = EPS_COMMAND_BID;
+
+	uint8_t idx = 4;
+	if (cmd->has_key) {
+		cmd_buf[idx++] = cmd->key;
+	}
+	for (uint8_t i = 0; i < cmd->arg_len; i++) {
+		cmd_buf[idx++] = (arg >> (8 * i)) & 0xFF;
+	}
+
+	// eps_hk_cache_set_max_age_ms() only accepts commands without arguments, so arg is always 0 here
+	const uint8_t comms_err = (eps_hk_cache_get_max_age_ms(cmd_id) > 0) ?
+			eps_hk_cache_read(cmd_id, EPS_HK_CACHE_MODE_FRESH, rx_buf) :
+			eps_send_cmd_get_response(cmd_buf, cmd->cmd_len, rx_buf, cmd->rx_len);
+	if (comms_err != 0) {
+		DEBUG_LOG_WARN(DEBUG_LOG_MODULE_COMMANDS, DEBUG_LOG_ID_EPS_CMD_FAILED, cmd->CC, comms_err);
+		return comms_err;
+	}
+	DEBUG_LOG_TRACE_CC(DEBUG_LOG_MODULE_COMMANDS, cmd->CC, DEBUG_LOG_ID_EPS_CMD_DONE, cmd->CC, rx_buf[4]);
+
+	if (result_dest == NULL) {
+		return 0;
+	}
+	if (fields != NULL) {
+		eps_decode_fields(fields, rx_buf, result_dest);
+		DEBUG_LOG_TRACE_CC(DEBUG_LOG_MODULE_PACKERS, cmd->CC,
+				DEBUG_LOG_ID_EPS_CMD_DECODED, cmd->CC, fields->field_count, cmd->rx_len);
+		return 0;
+	}
+	if (cmd->decoder != NULL) {
+		const uint8_t decode_result = cmd->decoder(rx_buf, result_dest);
+		if (decode_result != 0) {
+			DEBUG_LOG_WARN(DEBUG_LOG_MODULE_PACKERS, DEBUG_LOG_ID_EPS_CMD_DECODE_FAILED, cmd->CC, decode_result);
+		}
+		return decode_result;
+	}
+	return 0;
+}
+
+uint8_t eps_cmd_execute(EPS_CMD_ID_enum_t cmd_id, uint32_t arg, void *result_dest) {
+	if (cmd_id >= EPS_CMD_ID_COUNT) {
+		return 1;
+	}
+	return eps_cmd_execute_decode(cmd_id, arg, eps_cmd_table[cmd_id].fields, result_dest);
+}
+
+uint8_t eps_cmd_execute_with_fields(EPS_CMD_ID_enum_t cmd_id, uint32_t arg, const eps_field_table_t *fields, void *result_dest) {
+	if (cmd_id >= EPS_CMD_ID_COUNT || fields == NULL || fields->rx_len != eps_cmd_table[cmd_id].rx_len) {
+		return 1;
+	}
+	return eps_cmd_execute_decode(cmd_id, arg, fields, result_dest);
+}
@@ -1,57 +1,143 @@
 
 #include "debug_tools/debug_uart.h"
+#include "debug_tools/fmt_int.h"
+#include "debug_tools/json_writer.h"
+#include "eps_drivers/eps_cmd_queue.h"
 #include "eps_drivers/eps_debug_tools.h"
 #include "eps_drivers/eps_commands.h"
+#include "eps_drivers/eps_hk_cache.h"
+#include "eps_drivers/eps_link_stats.h"
+#include "eps_drivers/eps_types_to_json.h"
+
+#include <stddef.h>
+#include <stdint.h>
 
 
 void eps_debug_uart_print_system_status(eps_result_system_status_t* system_status) {
 	char msg1[365];
-	sprintf(
-	    msg1,
-	    "Mode: %d, Configuration Changed?: %d, Reset cause: %d, Uptime: %lu sec, Error Code: %d, rst_cnt_pwron: %u, rst_cnt_wdg: %d, rst_cnt_cmd: %d, rst_cnt_mcu: %d, rst_cnt_emlopo: %d, time_since_prev_cmd: %d sec, Unix time: %lu sec, Unix year: %d, Unix month: %d, Unix day: %d, Unix hour: %d, Unix minute: %d, Unix second: %d\n",
-	    system_status->mode, system_status->config_changed_since_boot, system_status->reset_cause,
-        system_status->uptime_sec, system_status->error_code,
-        system_status->rst_cnt_pwron, system_status->rst_cnt_wdg, system_status->rst_cnt_cmd,
-        system_status->rst_cnt_mcu, system_status->rst_cnt_emlopo,
-        
-        system_status->time_since_prev_cmd_sec, system_status->unix_time_sec,
-        (system_status->calendar_years_since_2000 + 2000), system_status->calendar_month, system_status->calendar_day,
-        system_status->calendar_hour, system_status->calendar_minute, system_status->calendar_second
-	);
+	char *p = msg1;
+	p = fmt_int_append_str(p, "Mode: ");
+	p = fmt_int_append_u32(p, system_status->mode);
+	p = fmt_int_append_str(p, ", Configuration Changed?: ");
+	p = fmt_int_append_u32(p, system_status->config_changed_since_boot);
+	p = fmt_int_append_str(p, ", Reset cause: ");
+	p = fmt_int_append_u32(p, system_status->reset_cause);
+	p = fmt_int_append_str(p, ", Uptime: ");
+	p = fmt_int_append_u32(p, system_status->uptime_sec);
+	p = fmt_int_append_str(p, " sec, Error Code: ");
+	p = fmt_int_append_u32(p, system_status->error_code);
+	p = fmt_int_append_str(p, ", rst_cnt_pwron: ");
+	p = fmt_int_append_u32(p, system_status->rst_cnt_pwron);
+	p = fmt_int_append_str(p, ", rst_cnt_wdg: ");
+	p = fmt_int_append_u32(p, system_status->rst_cnt_wdg);
+	p = fmt_int_append_str(p, ", rst_cnt_cmd: ");
+	p = fmt_int_append_u32(p, system_status->rst_cnt_cmd);
+	p = fmt_int_append_str(p, ", rst_cnt_mcu: ");
+	p = fmt_int_append_u32(p, system_status->rst_cnt_mcu);
+	p = fmt_int_append_str(p, ", rst_cnt_emlopo: ");
+	p = fmt_int_append_u32(p, system_status->rst_cnt_emlopo);
+	p = fmt_int_append_str(p, ", time_since_prev_cmd: ");
+	p = fmt_int_append_u32(p, system_status->time_since_prev_cmd_sec);
+	p = fmt_int_append_str(p, " sec, Unix time: ");
+	p = fmt_int_append_u32(p, system_status->unix_time_sec);
+	p = fmt_int_append_str(p, " sec, Unix year: ");
+	p = fmt_int_append_u32(p, system_status->calendar_years_since_2000 + 2000);
+	p = fmt_int_append_str(p, ", Unix month: ");
+	p = fmt_int_append_u32(p, system_status->calendar_month);
+	p = fmt_int_append_str(p, ", Unix day: ");
+	p = fmt_int_append_u32(p, system_status->calendar_day);
+	p = fmt_int_append_str(p, ", Unix hour: ");
+	p = fmt_int_append_u32(p, system_status->calendar_hour);
+	p = fmt_int_append_str(p, ", Unix minute: ");
+	p = fmt_int_append_u32(p, system_status->calendar_minute);
+	p = fmt_int_append_str(p, ", Unix second: ");
+	p = fmt_int_append_u32(p, system_status->calendar_second);
+	fmt_int_append_str(p, "\n");
 
 	debug_uart_print_str(msg1);
 }
 
+void eps_debug_uart_print_cmd_queue_stats() {
+	const eps_cmd_queue_stats_t *stats = eps_cmd_queue_get_stats();
+	const char *class_names[EPS_CMD_PRIORITY_COUNT] = {"safety", "control", "telemetry"};
+	char msg[200];
+	char *p = msg;
+
+	p = fmt_int_append_str(p, "EPS command queue: completed: ");
+	p = fmt_int_append_u32(p, stats->completed_count);
+	p = fmt_int_append_str(p, ", failed: ");
+	p = fmt_int_append_u32(p, stats->failed_count);
+	fmt_int_append_str(p, "\n");
+	debug_uart_print_str(msg);
+
+	for (uint8_t priority = 0; priority < EPS_CMD_PRIORITY_COUNT; priority++) {
+		const eps_cmd_queue_class_stats_t *class_stats = &stats->each_class[priority];
+		const uint32_t mean_wait_ms = (class_stats->dispatched_count > 0) ?
+				(class_stats->total_wait_ms / class_stats->dispatched_count) : 0;
+
+		p = msg;
+		p = fmt_int_append_str(p, "  ");
+		p = fmt_int_append_str(p, class_names[priority]);
+		p = fmt_int_append_str(p, ": depth: ");
+		p = fmt_int_append_u32(p, eps_cmd_queue_get_depth(priority));
+		p = fmt_int_append_str(p, " (max ");
+		p = fmt_int_append_u32(p, class_stats->max_depth);
+		p = fmt_int_append_str(p, "), submitted: ");
+		p = fmt_int_append_u32(p, class_stats->submitted_count);
+		p = fmt_int_append_str(p, ", rejected (full): ");
+		p = fmt_int_append_u32(p, class_stats->rejected_full_count);
+		p = fmt_int_append_str(p, ", wait: mean ");
+		p = fmt_int_append_u32(p, mean_wait_ms);
+		p = fmt_int_append_str(p, " ms, max ");
+		p = fmt_int_append_u32(p, class_stats->max_wait_ms);
+		fmt_int_append_str(p, " ms\n");
+		debug_uart_print_str(msg);
+	}
+}
+
+void eps_debug_uart_print_hk_cache_stats() {
+	const eps_hk_cache_stats_t *stats = eps_hk_cache_get_stats();
+	char msg[200];
+	char *p = msg;
+
+	p = fmt_int_append_str(p, "EPS HK cache: hits: ");
+	p = fmt_int_append_u32(p, stats->hit_count);
+	p = fmt_int_append_str(p, ", stale: ");
+	p = fmt_int_append_u32(p, stats->stale_count);
+	p = fmt_int_append_str(p, ", misses: ");
+	p = fmt_int_append_u32(p, stats->miss_count);
+	p = fmt_int_append_str(p, " (coalesced: ");
+	p = fmt_int_append_u32(p, stats->coalesced_count);
+	p = fmt_int_append_str(p, "), fetches: ");
+	p = fmt_int_append_u32(p, stats->fetch_count);
+	p = fmt_int_append_str(p, " (failed: ");
+	p = fmt_int_append_u32(p, stats->fetch_failed_count);
+	p = fmt_int_append_str(p, "), rejected: ");
+	p = fmt_int_append_u32(p, stats->rejected_count);
+	fmt_int_append_str(p, "\n");
+	debug_uart_print_str(msg);
+}
+
 void eps_result_pdu_housekeeping_data_eng_to_json(const eps_result_pdu_housekeeping_data_eng_t *data, char json_output_str[]) {
     // json_output_str must be >= 4096 bytes
+    eps_result_pdu_housekeeping_data_eng_TO_json(data, json_output_str, 4096);
+}
+
+void eps_debug_uart_print_pdu_housekeeping_data_eng_json(const eps_result_pdu_housekeeping_data_eng_t *data) {
+	// Streamed to the UART in chunks, instead of building the ~2 KB string first
+	char chunk_buf[64];
+	json_writer_t writer;
+	json_writer_init(&writer, chunk_buf, sizeof(chunk_buf), debug_uart_json_sink, NULL);
+	eps_result_pdu_housekeeping_data_eng_TO_json_writer(&writer, NULL, data);
+	json_writer_finish(&writer);
+	debug_uart_print_str("\n");
+}
 
-    sprintf(json_output_str, "{\n");
-    sprintf(json_output_str + strlen(json_output_str), "    voltage_internal_board_supply_mV: %u,\n", data->voltage_internal_board_supply_mV);
-    sprintf(json_output_str + strlen(json_output_str), "    temperature_mcu_cC: %u,\n", data->temperature_mcu_cC);
-    sprintf(json_output_str + strlen(json_output_str), "    vip_total_input: { voltage_mV: %d, current_mA: %d, power_cW: %d },\n", 
-            data->vip_total_input.voltage_mV, data->vip_total_input.current_mA, data->vip_total_input.power_cW);
-    sprintf(json_output_str + strlen(json_output_str), "    stat_ch_on_bitfield: %u,\n", data->stat_ch_on_bitfield);
-    sprintf(json_output_str + strlen(json_output_str), "    stat_ch_ext_on_bitfield: %u,\n", data->stat_ch_ext_on_bitfield);
-    sprintf(json_output_str + strlen(json_output_str), "    stat_ch_overcurrent_fault_bitfield: %u,\n", data->stat_ch_overcurrent_fault_bitfield);
-    sprintf(json_output_str + strlen(json_output_str), "    stat_ch_ext_overcurrent_fault_bitfield: %u,\n", data->stat_ch_ext_overcurrent_fault_bitfield);
-
-    sprintf(json_output_str + strlen(json_output_str), "    vip_each_voltage_domain: [\n");
-    for (int i = 0; i < 7; i++) {
-        sprintf(json_output_str + strlen(json_output_str), "        { voltage_mV: %d, current_mA: %d, power_cW: %d },\n", 
-                data->vip_each_voltage_domain[i].voltage_mV,
-                data->vip_each_voltage_domain[i].current_mA, 
-                data->vip_each_voltage_domain[i].power_cW);
-    }
-    sprintf(json_output_str + strlen(json_output_str), "    ],\n");
-
-    sprintf(json_output_str + strlen(json_output_str), "    vip_each_channel: [\n");
-    for (int i = 0; i < 32; i++) {
-        sprintf(json_output_str + strlen(json_output_str), "        { voltage_mV: %d, current_mA: %d, power_cW: %d },\n", 
-                data->vip_each_channel[i].voltage_mV,
-                data->vip_each_channel[i].current_mA, 
-                data->vip_each_channel[i].power_cW);
-    }
-    sprintf(json_output_str + strlen(json_output_str), "    ],\n");
-    sprintf(json_output_str + strlen(json_output_str), "    json_output_str_length_approx: %d\n", strlen(json_output_str)+40);
-    sprintf(json_output_str + strlen(json_output_str), "}\n");
+void eps_debug_uart_print_link_stats_json() {
+	char chunk_buf[64];
+	json_writer_t writer;
+	json_writer_init(&writer, chunk_buf, sizeof(chunk_buf), debug_uart_json_sink, NULL);
+	eps_link_stats_TO_json_writer(&writer, NULL);
+	json_writer_finish(&writer);
+	debug_uart_print_str("\n");
 }
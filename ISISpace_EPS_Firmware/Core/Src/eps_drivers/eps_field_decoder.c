@@ -0,0 +1,186 @@
+#include "eps_drivers/eps_field_decoder.h"
+#include "debug_tools/timing_probe.h"
+#include "eps_drivers/eps_types.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+// #pragma region Layouts
+
+// Command Response: 0x40: Get System Status
+static const eps_field_descriptor_t eps_fields_system_status[] = {
+	EPS_FIELD_RUN(5, eps_result_system_status_t, mode, 1, 3), // mode, config_changed, reset_cause
+	EPS_FIELD_RUN(8, eps_result_system_status_t, uptime_sec, 4, 1),
+	EPS_FIELD_RUN(12, eps_result_system_status_t, error_code, 2, 7), // error_code to time_since_prev_cmd_sec
+	EPS_FIELD_RUN(26, eps_result_system_status_t, unix_time_sec, 4, 1),
+	EPS_FIELD_RUN(30, eps_result_system_status_t, calendar_years_since_2000, 1, 6),
+};
+
+// Command Response: 0x42: Get Overcurrent Fault State
+// Note: rx_buf[5] is a reserved/ignored value
+static const eps_field_descriptor_t eps_fields_pdu_overcurrent_fault_state[] = {
+	EPS_FIELD_RUN(6, eps_result_pdu_overcurrent_fault_state_t, stat_ch_on_bitfield, 2, 4 + 32),
+};
+
+// Command Response: 0x50/0x52/0x54: PDU housekeeping. Same order as the struct, from rx_buf[6] to rx_buf[257].
+static const eps_field_descriptor_t eps_fields_pdu_housekeeping_data_raw[] = {
+	EPS_FIELD_RUN(6, eps_result_pdu_housekeeping_data_raw_t, voltage_internal_board_supply_raw, 2, 126),
+};
+static const eps_field_descriptor_t eps_fields_pdu_housekeeping_data_eng[] = {
+	EPS_FIELD_RUN(6, eps_result_pdu_housekeeping_data_eng_t, voltage_internal_board_supply_mV, 2, 126),
+};
+
+// Command Response: 0x60/0x62/0x64: PBU housekeeping. VIP_INPUT comes first in the response.
+static const eps_field_descriptor_t eps_fields_pbu_housekeeping_data_raw[] = {
+	EPS_FIELD_RUN(6, eps_result_pbu_housekeeping_data_raw_t, vip_total_input_raw, 2, 3),
+	EPS_FIELD_RUN(12, eps_result_pbu_housekeeping_data_raw_t, voltage_internal_board_supply_raw, 2, 2),
+	EPS_FIELD_RUN(16, eps_result_pbu_housekeeping_data_raw_t, battery_pack_status_bitfield, 2, 1 + 3*11),
+};
+static const eps_field_descriptor_t eps_fields_pbu_housekeeping_data_eng[] = {
+	EPS_FIELD_RUN(6, eps_result_pbu_housekeeping_data_eng_t, vip_total_input, 2, 3),
+	EPS_FIELD_RUN(12, eps_result_pbu_housekeeping_data_eng_t, voltage_internal_board_supply_mV, 2, 2),
+	EPS_FIELD_RUN(16, eps_result_pbu_housekeeping_data_eng_t, battery_pack_status_bitfield, 2, 1 + 3*11),
+};
+
+// Command Response: 0x70/0x72/0x74: PCU housekeeping. Same order as the struct, from rx_buf[6] to rx_buf[71].
+static const eps_field_descriptor_t eps_fields_pcu_housekeeping_data_raw[] = {
+	EPS_FIELD_RUN(6, eps_result_pcu_housekeeping_data_raw_t, voltage_internal_board_supply_raw, 2, 5 + 4*7),
+};
+static const eps_field_descriptor_t eps_fields_pcu_housekeeping_data_eng[] = {
+	EPS_FIELD_RUN(6, eps_result_pcu_housekeeping_data_eng_t, voltage_internal_board_supply_mV, 2, 5 + 4*7),
+};
+
+// Command Response: 0xA0/0xA2/0xA4: PIU housekeeping.
+// The channels and conditioning channels (CCs) are interleaved in the response:
+// VIP_CH[0..8], CCSD[CC1..CC3], VIP_CH[9..15], CCSD[CC4..CC5], STAT_CH_EXT_ON, STAT_CH_EXT_OCF, VIP_CH[16..31]
+// CC1 is at conditioning_channel_info_each_channel[0].
+static const eps_field_descriptor_t eps_fields_piu_housekeeping_data_raw[] = {
+	EPS_FIELD_RUN(6, eps_result_piu_housekeeping_data_raw_t, voltage_internal_board_supply_raw, 2, 16), // to vd2
+	EPS_FIELD_RUN(38, eps_result_piu_housekeeping_data_raw_t, vip_each_channel_raw[0], 2, 9*3),
+	EPS_FIELD_RUN(92, eps_result_piu_housekeeping_data_raw_t, conditioning_channel_info_each_channel_raw[0], 2, 3*4),
+	EPS_FIELD_RUN(116, eps_result_piu_housekeeping_data_raw_t, vip_each_channel_raw[9], 2, 7*3),
+	EPS_FIELD_RUN(158, eps_result_piu_housekeeping_data_raw_t, conditioning_channel_info_each_channel_raw[3], 2, 2*4),
+	EPS_FIELD_RUN(174, eps_result_piu_housekeeping_data_raw_t, stat_ch_ext_on_bitfield, 2, 2),
+	EPS_FIELD_RUN(178, eps_result_piu_housekeeping_data_raw_t, vip_each_channel_raw[16], 2, 16*3),
+};
+static const eps_field_descriptor_t eps_fields_piu_housekeeping_data_eng[] = {
+	EPS_FIELD_RUN(6, eps_result_piu_housekeeping_data_eng_t, voltage_internal_board_supply_mV, 2, 16), // to vd2
+	EPS_FIELD_RUN(38, eps_result_piu_housekeeping_data_eng_t, vip_each_channel[0], 2, 9*3),
+	EPS_FIELD_RUN(92, eps_result_piu_housekeeping_data_eng_t, conditioning_channel_info_each_channel[0], 2, 3*4),
+	EPS_FIELD_RUN(116, eps_result_piu_housekeeping_data_eng_t, vip_each_channel[9], 2, 7*3),
+	EPS_FIELD_RUN(158, eps_result_piu_housekeeping_data_eng_t, conditioning_channel_info_each_channel[3], 2, 2*4),
+	EPS_FIELD_RUN(174, eps_result_piu_housekeeping_data_eng_t, stat_ch_ext_on_bitfield, 2, 2),
+	EPS_FIELD_RUN(178, eps_result_piu_housekeeping_data_eng_t, vip_each_channel[16], 2, 16*3),
+};
+
+// The same responses' channels, column by column into eps_channel_telemetry_t. Each VIPD is 6 bytes:
+// the voltages are every 6th value from the first channel's voltage, and so on.
+#define EPS_FIELD_CHANNEL_COLUMNS(src_offset, first_channel, count) \
+	EPS_FIELD_COLUMN((src_offset), eps_channel_telemetry_t, voltage_mV[first_channel], (count), 6), \
+	EPS_FIELD_COLUMN((src_offset) + 2, eps_channel_telemetry_t, current_mA[first_channel], (count), 6), \
+	EPS_FIELD_COLUMN((src_offset) + 4, eps_channel_telemetry_t, power_cW[first_channel], (count), 6)
+
+static const eps_field_descriptor_t eps_fields_pdu_channel_telemetry[] = {
+	EPS_FIELD_RUN(16, eps_channel_telemetry_t, stat_ch_on_bitfield, 2, 4), // to stat_ch_ext_overcurrent_fault_bitfield
+	EPS_FIELD_CHANNEL_COLUMNS(66, 0, 32),
+};
+static const eps_field_descriptor_t eps_fields_piu_channel_telemetry[] = {
+	EPS_FIELD_RUN(22, eps_channel_telemetry_t, stat_ch_on_bitfield, 2, 1),
+	EPS_FIELD_RUN(24, eps_channel_telemetry_t, stat_ch_overcurrent_fault_bitfield, 2, 1),
+	EPS_FIELD_RUN(174, eps_channel_telemetry_t, stat_ch_ext_on_bitfield, 2, 1),
+	EPS_FIELD_RUN(176, eps_channel_telemetry_t, stat_ch_ext_overcurrent_fault_bitfield, 2, 1),
+	EPS_FIELD_CHANNEL_COLUMNS(38, 0, 9),
+	EPS_FIELD_CHANNEL_COLUMNS(116, 9, 7),
+	EPS_FIELD_CHANNEL_COLUMNS(178, 16, 16),
+};
+
+#define EPS_FIELD_TABLE(fields, rx_len) { (fields), sizeof(fields) / sizeof(eps_field_descriptor_t), (rx_len) }
+
+const eps_field_table_t eps_field_table_system_status = EPS_FIELD_TABLE(eps_fields_system_status, 36);
+const eps_field_table_t eps_field_table_pdu_overcurrent_fault_state = EPS_FIELD_TABLE(eps_fields_pdu_overcurrent_fault_state, 78);
+const eps_field_table_t eps_field_table_pdu_housekeeping_data_raw = EPS_FIELD_TABLE(eps_fields_pdu_housekeeping_data_raw, 258);
+const eps_field_table_t eps_field_table_pdu_housekeeping_data_eng = EPS_FIELD_TABLE(eps_fields_pdu_housekeeping_data_eng, 258);
+const eps_field_table_t eps_field_table_pbu_housekeeping_data_raw = EPS_FIELD_TABLE(eps_fields_pbu_housekeeping_data_raw, 84);
+const eps_field_table_t eps_field_table_pbu_housekeeping_data_eng = EPS_FIELD_TABLE(eps_fields_pbu_housekeeping_data_eng, 84);
+const eps_field_table_t eps_field_table_pcu_housekeeping_data_raw = EPS_FIELD_TABLE(eps_fields_pcu_housekeeping_data_raw, 72);
+const eps_field_table_t eps_field_table_pcu_housekeeping_data_eng = EPS_FIELD_TABLE(eps_fields_pcu_housekeeping_data_eng, 72);
+const eps_field_table_t eps_field_table_piu_housekeeping_data_raw = EPS_FIELD_TABLE(eps_fields_piu_housekeeping_data_raw, 274);
+const eps_field_table_t eps_field_table_piu_housekeeping_data_eng = EPS_FIELD_TABLE(eps_fields_piu_housekeeping_data_eng, 274);
+const eps_field_table_t eps_field_table_pdu_channel_telemetry = EPS_FIELD_TABLE(eps_fields_pdu_channel_telemetry, 258);
+const eps_field_table_t eps_field_table_piu_channel_telemetry = EPS_FIELD_TABLE(eps_fields_piu_channel_telemetry, 274);
+
+// #pragma endregion Layouts
+
+
+static uint32_t eps_read_le(const uint8_t *src, uint8_t width, uint8_t is_signed) {
+	switch (width) {
+		case 1:
+			return is_signed ? (uint32_t)(int8_t)src[0] : src[0];
+		case 2: {
+			const uint16_t value = src[0] | (src[1] << 8);
+			return is_signed ? (uint32_t)(int16_t)value : value;
+		}
+		default:
+			return src[0] | (src[1] << 8) | (src[2] << 16) | ((uint32_t)src[3] << 24);
+	}
+}
+
+uint32_t eps_field_read_value(const eps_field_descriptor_t *field, const uint8_t *src) {
+	return eps_read_le(src, field->width, field->is_signed);
+}
+
+static void eps_write_native(uint8_t *dest, uint8_t width, uint32_t value) {
+	// dest may not be aligned (e.g., a run starting inside a packed struct)
+	switch (width) {
+		case 1: { const uint8_t v = value; memcpy(dest, &v, 1); break; }
+		case 2: { const uint16_t v = value; memcpy(dest, &v, 2); break; }
+		default: memcpy(dest, &value, 4); break;
+	}
+}
+
+void eps_decode_fields(const eps_field_table_t *table, const uint8_t rx_buf[], void *result_dest) {
+	TIMING_PROBE_SCOPE(TIMING_PROBE_ID_UNPACK);
+	uint8_t *dest_bytes = (uint8_t*) result_dest;
+
+	for (uint8_t field_num = 0; field_num < table->field_count; field_num++) {
+		const eps_field_descriptor_t *field = &table->fields[field_num];
+		const uint8_t *src = &rx_buf[field->src_offset];
+		uint8_t *dest = &dest_bytes[field->dest_offset];
+
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+		// Contiguous run with the same width on both sides: the struct bytes are the response bytes.
+		if (field->dest_width == field->width
+				&& field->src_stride == field->width && field->dest_stride == field->width) {
+			memcpy(dest, src, field->repeat * field->width);
+			continue;
+		}
+#endif
+
+		for (uint8_t i = 0; i < field->repeat; i++) {
+			eps_write_native(dest, field->dest_width, eps_read_le(src, field->width, field->is_signed));
+			src += field->src_stride;
+			dest += field->dest_stride;
+		}
+	}
+}
+
+uint8_t eps_field_locate(const eps_field_table_t *table, uint16_t dest_offset,
+		uint16_t *src_offset_dest, const eps_field_descriptor_t **field_dest) {
+	for (uint8_t field_num = 0; field_num < table->field_count; field_num++) {
+		const eps_field_descriptor_t *field = &table->fields[field_num];
+		if (dest_offset < field->dest_offset) {
+			continue;
+		}
+		const uint16_t offset_in_run = dest_offset - field->dest_offset;
+		const uint16_t value_num = offset_in_run / field->dest_stride;
+		if (value_num >= field->repeat || (offset_in_run % field->dest_stride) != 0) {
+			continue;
+		}
+
+		*src_offset_dest = field->src_offset + value_num * field->src_stride;
+		*field_dest = field;
+		return 0;
+	}
+	return 1;
+}
@@ -0,0 +1,243 @@
+#include "eps_drivers/eps_hk_cache.h"
+#include "debug_tools/debug_log.h"
+#include "eps_drivers/eps_cmd_queue.h"
+#include "eps_drivers/eps_cmd_table.h"
+#include "eps_drivers/eps_internal_drivers.h"
+#include "eps_drivers/eps_transport.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+typedef struct {
+	eps_cmd_callback_t callback;
+	void *context;
+} eps_hk_cache_waiter_t;
+
+typedef struct {
+	uint8_t CC; // 0 if the entry is unused
+	uint8_t is_valid; // rx_bufs[current_buf] holds a response
+	uint8_t is_in_flight; // the other buffer is being filled
+	uint8_t current_buf;
+	uint32_t fill_time_ms;
+	uint32_t last_used_ms;
+
+	uint8_t cmd_buf[4];
+	uint8_t rx_bufs[2][EPS_CMD_MAX_RX_LEN];
+	uint16_t rx_len;
+
+	eps_hk_cache_waiter_t waiters[EPS_HK_CACHE_MAX_WAITERS];
+	uint8_t waiter_count;
+} eps_hk_cache_entry_t;
+
+static eps_hk_cache_entry_t eps_hk_cache_entries[EPS_HK_CACHE_ENTRY_COUNT];
+static eps_hk_cache_stats_t eps_hk_cache_stats;
+
+static uint32_t eps_hk_cache_max_age_ms[EPS_CMD_ID_COUNT] = {
+	[EPS_CMD_ID_GET_PDU_HOUSEKEEPING_DATA_RAW] = EPS_HK_CACHE_DEFAULT_MAX_AGE_MS,
+	[EPS_CMD_ID_GET_PDU_HOUSEKEEPING_DATA_ENG] = EPS_HK_CACHE_DEFAULT_MAX_AGE_MS,
+	[EPS_CMD_ID_GET_PDU_HOUSEKEEPING_DATA_RUNNING_AVERAGE] = EPS_HK_CACHE_DEFAULT_MAX_AGE_MS,
+	[EPS_CMD_ID_GET_PBU_HOUSEKEEPING_DATA_RAW] = EPS_HK_CACHE_DEFAULT_MAX_AGE_MS,
+	[EPS_CMD_ID_GET_PBU_HOUSEKEEPING_DATA_ENG] = EPS_HK_CACHE_DEFAULT_MAX_AGE_MS,
+	[EPS_CMD_ID_GET_PBU_HOUSEKEEPING_DATA_RUNNING_AVERAGE] = EPS_HK_CACHE_DEFAULT_MAX_AGE_MS,
+	[EPS_CMD_ID_GET_PCU_HOUSEKEEPING_DATA_RAW] = EPS_HK_CACHE_DEFAULT_MAX_AGE_MS,
+	[EPS_CMD_ID_GET_PCU_HOUSEKEEPING_DATA_ENG] = EPS_HK_CACHE_DEFAULT_MAX_AGE_MS,
+	[EPS_CMD_ID_GET_PCU_HOUSEKEEPING_DATA_RUNNING_AVERAGE] = EPS_HK_CACHE_DEFAULT_MAX_AGE_MS,
+	[EPS_CMD_ID_GET_PIU_HOUSEKEEPING_DATA_RAW] = EPS_HK_CACHE_DEFAULT_MAX_AGE_MS,
+	[EPS_CMD_ID_GET_PIU_HOUSEKEEPING_DATA_ENG] = EPS_HK_CACHE_DEFAULT_MAX_AGE_MS,
+	[EPS_CMD_ID_GET_PIU_HOUSEKEEPING_DATA_RUNNING_AVERAGE] = EPS_HK_CACHE_DEFAULT_MAX_AGE_MS,
+};
+
+
+static uint32_t eps_hk_cache_now_ms() {
+	const eps_transport_t *transport = eps_get_transport();
+	return (transport != NULL) ? transport->now_ms() : 0;
+}
+
+static uint8_t eps_hk_cache_is_cacheable(EPS_CMD_ID_enum_t cmd_id) {
+	// The cache builds the command from the command code alone
+	const eps_cmd_descriptor_t *cmd = &eps_cmd_table[cmd_id];
+	return (cmd->cmd_len == 4) && !cmd->has_key && (cmd->arg_len == 0);
+}
+
+uint8_t eps_hk_cache_set_max_age_ms(EPS_CMD_ID_enum_t cmd_id, uint32_t max_age_ms) {
+	if (cmd_id >= EPS_CMD_ID_COUNT || !eps_hk_cache_is_cacheable(cmd_id)) {
+		return 1;
+	}
+	eps_hk_cache_max_age_ms[cmd_id] = max_age_ms;
+	return 0;
+}
+
+uint32_t eps_hk_cache_get_max_age_ms(EPS_CMD_ID_enum_t cmd_id) {
+	return (cmd_id < EPS_CMD_ID_COUNT) ? eps_hk_cache_max_age_ms[cmd_id] : 0;
+}
+
+static eps_hk_cache_entry_t* eps_hk_cache_find_entry(uint8_t CC, uint32_t now_ms) {
+	// The entry for this command code, or the least recently used one (not in flight) to reuse.
+	// NULL if every entry is in flight for another command code.
+	eps_hk_cache_entry_t *lru_entry = NULL;
+	for (uint8_t i = 0; i < EPS_HK_CACHE_ENTRY_COUNT; i++) {
+		eps_hk_cache_entry_t *entry = &eps_hk_cache_entries[i];
+		if (entry->CC == CC) {
+			return entry;
+		}
+		if (entry->is_in_flight) {
+			continue;
+		}
+		if (lru_entry == NULL || entry->CC == 0
+				|| (lru_entry->CC != 0 && (now_ms - entry->last_used_ms) > (now_ms - lru_entry->last_used_ms))) {
+			lru_entry = entry;
+		}
+	}
+	if (lru_entry != NULL) {
+		lru_entry->CC = 0;
+		lru_entry->is_valid = 0;
+	}
+	return lru_entry;
+}
+
+static void eps_hk_cache_fetch_callback(uint8_t result_code, const uint8_t rx_buf[], uint16_t rx_buf_len, void *context) {
+	eps_hk_cache_entry_t *entry = (eps_hk_cache_entry_t*) context;
+	entry->is_in_flight = 0;
+
+	// Check STAT field (Table 3-11) - 0x00 and 0x80 mean success
+	if (result_code == 0 && (rx_buf[4] == 0x00 || rx_buf[4] == 0x80)) {
+		entry->current_buf = 1 - entry->current_buf;
+		entry->is_valid = 1;
+		entry->fill_time_ms = eps_hk_cache_now_ms();
+	}
+	else {
+		eps_hk_cache_stats.fetch_failed_count++;
+	}
+
+	// Waiters may submit new requests (even for this command), so take the list first
+	eps_hk_cache_waiter_t waiters[EPS_HK_CACHE_MAX_WAITERS];
+	const uint8_t waiter_count = entry->waiter_count;
+	memcpy(waiters, entry->waiters, sizeof(waiters));
+	entry->waiter_count = 0;
+	for (uint8_t i = 0; i < waiter_count; i++) {
+		waiters[i].callback(result_code, rx_buf, rx_buf_len, waiters[i].context);
+	}
+}
+
+static uint8_t eps_hk_cache_fetch(eps_hk_cache_entry_t *entry) {
+	const uint8_t submit_result = eps_cmd_queue_submit(
+			entry->cmd_buf, sizeof(entry->cmd_buf),
+			entry->rx_bufs[1 - entry->current_buf], entry->rx_len,
+			eps_hk_cache_fetch_callback, entry);
+	if (submit_result != 0) {
+		return submit_result;
+	}
+	entry->is_in_flight = 1;
+	eps_hk_cache_stats.fetch_count++;
+	return 0;
+}
+
+uint8_t eps_hk_cache_request(
+		EPS_CMD_ID_enum_t cmd_id, EPS_HK_CACHE_MODE_enum_t mode,
+		eps_cmd_callback_t callback, void *context) {
+	if (cmd_id >= EPS_CMD_ID_COUNT || callback == NULL || eps_hk_cache_max_age_ms[cmd_id] == 0) {
+		return 1;
+	}
+	const eps_cmd_descriptor_t *cmd = &eps_cmd_table[cmd_id];
+	const uint32_t now_ms = eps_hk_cache_now_ms();
+
+	eps_hk_cache_entry_t *entry = eps_hk_cache_find_entry(cmd->CC, now_ms);
+	if (entry == NULL) {
+		eps_hk_cache_stats.rejected_count++;
+		return EPS_CMD_QUEUE_FULL;
+	}
+	if (entry->CC == 0) {
+		entry->CC = cmd->CC;
+		entry->rx_len = cmd->rx_len;
+		entry->cmd_buf[0] = EPS_COMMAND_STID;
+		entry->cmd_buf[1] = EPS_COMMAND_IVID;
+		entry->cmd_buf[2] = cmd->CC;
+		entry->cmd_buf[3] = EPS_COMMAND_BID;
+	}
+	entry->last_used_ms = now_ms;
+
+	if (entry->is_valid) {
+		const uint8_t is_fresh = (now_ms - entry->fill_time_ms) <= eps_hk_cache_max_age_ms[cmd_id];
+		if (is_fresh || mode == EPS_HK_CACHE_MODE_ALLOW_STALE) {
+			if (is_fresh) {
+				eps_hk_cache_stats.hit_count++;
+			}
+			else {
+				eps_hk_cache_stats.stale_count++;
+				if (!entry->is_in_flight) {
+					// revalidate; nobody waits for it, so a full queue just means trying next time
+					eps_hk_cache_fetch(entry);
+				}
+			}
+			DEBUG_LOG_TRACE_CC(DEBUG_LOG_MODULE_COMMANDS, cmd->CC, DEBUG_LOG_ID_EPS_HK_CACHE_HIT, cmd->CC, is_fresh);
+			callback(0, entry->rx_bufs[entry->current_buf], entry->rx_len, context);
+			return 0;
+		}
+	}
+
+	if (entry->waiter_count >= EPS_HK_CACHE_MAX_WAITERS) {
+		eps_hk_cache_stats.rejected_count++;
+		return EPS_CMD_QUEUE_FULL;
+	}
+	if (entry->is_in_flight) {
+		eps_hk_cache_stats.coalesced_count++;
+	}
+	else {
+		const uint8_t fetch_result = eps_hk_cache_fetch(entry);
+		if (fetch_result != 0) {
+			eps_hk_cache_stats.rejected_count++;
+			return fetch_result;
+		}
+	}
+	eps_hk_cache_stats.miss_count++;
+	entry->waiters[entry->waiter_count].callback = callback;
+	entry->waiters[entry->waiter_count].context = context;
+	entry->waiter_count++;
+	return 0;
+}
+
+
+typedef struct {
+	uint8_t *rx_buf_dest;
+	volatile uint8_t is_done;
+	uint8_t result_code;
+} eps_hk_cache_blocking_read_t;
+
+static void eps_hk_cache_blocking_callback(uint8_t result_code, const uint8_t rx_buf[], uint16_t rx_buf_len, void *context) {
+	eps_hk_cache_blocking_read_t *read = (eps_hk_cache_blocking_read_t*) context;
+	memcpy(read->rx_buf_dest, rx_buf, rx_buf_len);
+	read->result_code = result_code;
+	read->is_done = 1;
+}
+
+uint8_t eps_hk_cache_read(EPS_CMD_ID_enum_t cmd_id, EPS_HK_CACHE_MODE_enum_t mode, uint8_t rx_buf[]) {
+	if (eps_cmd_queue_is_pumping()) {
+		// called from a completion callback; waiting here would never finish
+		DEBUG_LOG_ERROR(DEBUG_LOG_MODULE_COMMANDS, DEBUG_LOG_ID_EPS_BLOCKING_CMD_IN_CALLBACK);
+		return 2;
+	}
+
+	eps_hk_cache_blocking_read_t read = { .rx_buf_dest = rx_buf, .is_done = 0, .result_code = 0 };
+	uint8_t request_result;
+	while ((request_result = eps_hk_cache_request(
+			cmd_id, mode, eps_hk_cache_blocking_callback, &read)) == EPS_CMD_QUEUE_FULL) {
+		eps_cmd_queue_pump();
+	}
+	if (request_result != 0) {
+		return request_result;
+	}
+
+	eps_wait_for_cmd_queue(&read.is_done);
+	return read.result_code;
+}
+
+void eps_hk_cache_invalidate_all() {
+	for (uint8_t i = 0; i < EPS_HK_CACHE_ENTRY_COUNT; i++) {
+		eps_hk_cache_entries[i].is_valid = 0;
+	}
+}
+
+const eps_hk_cache_stats_t* eps_hk_cache_get_stats() {
+	return &eps_hk_cache_stats;
+}
@@ -0,0 +1,222 @@
+#include "eps_drivers/eps_hk_stats.h"
+#include "eps_drivers/eps_cmd_table.h"
+#include "eps_drivers/eps_commands.h"
+#include "eps_drivers/eps_field_decoder.h"
+#include "eps_drivers/eps_hk_cache.h"
+#include "eps_drivers/eps_raw_to_eng.h"
+#include "eps_drivers/eps_stats.h"
+#include "eps_drivers/eps_types.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+
+#define EPS_HK_STATS_WORD_COUNT(type) (sizeof(type) / sizeof(int16_t))
+
+EPS_STATS_DEFINE(eps_hk_stats_pdu, EPS_HK_STATS_WORD_COUNT(eps_result_pdu_housekeeping_data_eng_t), EPS_HK_STATS_MAX_WINDOW_LEN);
+EPS_STATS_DEFINE(eps_hk_stats_pbu, EPS_HK_STATS_WORD_COUNT(eps_result_pbu_housekeeping_data_eng_t), EPS_HK_STATS_MAX_WINDOW_LEN);
+EPS_STATS_DEFINE(eps_hk_stats_pcu, EPS_HK_STATS_WORD_COUNT(eps_result_pcu_housekeeping_data_eng_t), EPS_HK_STATS_MAX_WINDOW_LEN);
+EPS_STATS_DEFINE(eps_hk_stats_piu, EPS_HK_STATS_WORD_COUNT(eps_result_piu_housekeeping_data_eng_t), EPS_HK_STATS_MAX_WINDOW_LEN);
+
+static eps_stats_t *const eps_hk_stats_each_board[EPS_BOARD_COUNT] = {
+	[EPS_BOARD_PDU] = &eps_hk_stats_pdu,
+	[EPS_BOARD_PBU] = &eps_hk_stats_pbu,
+	[EPS_BOARD_PCU] = &eps_hk_stats_pcu,
+	[EPS_BOARD_PIU] = &eps_hk_stats_piu,
+};
+
+static const EPS_CMD_ID_enum_t eps_hk_stats_cmd_id_each_board[EPS_BOARD_COUNT] = {
+	[EPS_BOARD_PDU] = EPS_CMD_ID_GET_PDU_HOUSEKEEPING_DATA_ENG,
+	[EPS_BOARD_PBU] = EPS_CMD_ID_GET_PBU_HOUSEKEEPING_DATA_ENG,
+	[EPS_BOARD_PCU] = EPS_CMD_ID_GET_PCU_HOUSEKEEPING_DATA_ENG,
+	[EPS_BOARD_PIU] = EPS_CMD_ID_GET_PIU_HOUSEKEEPING_DATA_ENG,
+};
+
+static uint8_t eps_hk_stats_is_initialized = 0;
+static uint32_t eps_hk_stats_failed_sample_count = 0;
+
+
+void eps_hk_stats_reset_all() {
+	for (uint8_t board = 0; board < EPS_BOARD_COUNT; board++) {
+		eps_stats_init(eps_hk_stats_each_board[board], EPS_HK_STATS_DEFAULT_WINDOW_LEN, EPS_HK_STATS_DEFAULT_EWMA_SHIFT);
+	}
+	eps_hk_stats_failed_sample_count = 0;
+	eps_hk_stats_is_initialized = 1;
+}
+
+static eps_stats_t* eps_hk_stats_get_board(EPS_BOARD_enum_t board) {
+	if (!eps_hk_stats_is_initialized) {
+		eps_hk_stats_reset_all();
+	}
+	return eps_hk_stats_each_board[board];
+}
+
+uint8_t eps_hk_stats_configure(EPS_BOARD_enum_t board, uint8_t window_len, uint8_t ewma_shift) {
+	if (board >= EPS_BOARD_COUNT) {
+		return 1;
+	}
+	return eps_stats_init(eps_hk_stats_get_board(board), window_len, ewma_shift);
+}
+
+const eps_stats_t* eps_hk_stats_get(EPS_BOARD_enum_t board) {
+	return eps_hk_stats_get_board(board);
+}
+
+
+// #pragma region Update
+
+void eps_hk_stats_update_pdu(const eps_result_pdu_housekeeping_data_eng_t *data) {
+	eps_stats_update(eps_hk_stats_get_board(EPS_BOARD_PDU), (const int16_t*) data);
+}
+
+void eps_hk_stats_update_pbu(const eps_result_pbu_housekeeping_data_eng_t *data) {
+	eps_stats_update(eps_hk_stats_get_board(EPS_BOARD_PBU), (const int16_t*) data);
+}
+
+void eps_hk_stats_update_pcu(const eps_result_pcu_housekeeping_data_eng_t *data) {
+	eps_stats_update(eps_hk_stats_get_board(EPS_BOARD_PCU), (const int16_t*) data);
+}
+
+void eps_hk_stats_update_piu(const eps_result_piu_housekeeping_data_eng_t *data) {
+	eps_stats_update(eps_hk_stats_get_board(EPS_BOARD_PIU), (const int16_t*) data);
+}
+
+uint8_t eps_hk_stats_sample(EPS_BOARD_enum_t board) {
+	uint8_t result;
+	switch (board) {
+		case EPS_BOARD_PDU: {
+			eps_result_pdu_housekeeping_data_eng_t data;
+			result = eps_get_pdu_housekeeping_data_eng(&data);
+			if (result == 0) {
+				eps_hk_stats_update_pdu(&data);
+			}
+			return result;
+		}
+		case EPS_BOARD_PBU: {
+			eps_result_pbu_housekeeping_data_eng_t data;
+			result = eps_get_pbu_housekeeping_data_eng(&data);
+			if (result == 0) {
+				eps_hk_stats_update_pbu(&data);
+			}
+			return result;
+		}
+		case EPS_BOARD_PCU: {
+			eps_result_pcu_housekeeping_data_eng_t data;
+			result = eps_get_pcu_housekeeping_data_eng(&data);
+			if (result == 0) {
+				eps_hk_stats_update_pcu(&data);
+			}
+			return result;
+		}
+		case EPS_BOARD_PIU: {
+			eps_result_piu_housekeeping_data_eng_t data;
+			result = eps_get_piu_housekeeping_data_eng(&data);
+			if (result == 0) {
+				eps_hk_stats_update_piu(&data);
+			}
+			return result;
+		}
+		default:
+			return 1;
+	}
+}
+
+// Decoded in the pump, one response at a time
+static union {
+	eps_result_pdu_housekeeping_data_eng_t pdu;
+	eps_result_pbu_housekeeping_data_eng_t pbu;
+	eps_result_pcu_housekeeping_data_eng_t pcu;
+	eps_result_piu_housekeeping_data_eng_t piu;
+} eps_hk_stats_request_data;
+
+static void eps_hk_stats_request_callback(uint8_t result_code, const uint8_t rx_buf[], uint16_t rx_buf_len, void *context) {
+	const EPS_BOARD_enum_t board = (EPS_BOARD_enum_t)(uintptr_t) context;
+	// Check STAT field (Table 3-11) - 0x00 and 0x80 mean success
+	if (result_code != 0 || (rx_buf[4] != 0x00 && rx_buf[4] != 0x80)) {
+		eps_hk_stats_failed_sample_count++;
+		return;
+	}
+	eps_decode_fields(eps_cmd_table[eps_hk_stats_cmd_id_each_board[board]].fields, rx_buf, &eps_hk_stats_request_data);
+	eps_stats_update(eps_hk_stats_get_board(board), (const int16_t*) &eps_hk_stats_request_data);
+}
+
+uint8_t eps_hk_stats_request_sample(EPS_BOARD_enum_t board) {
+	if (board >= EPS_BOARD_COUNT) {
+		return 1;
+	}
+	return eps_hk_cache_request(eps_hk_stats_cmd_id_each_board[board], EPS_HK_CACHE_MODE_FRESH,
+			eps_hk_stats_request_callback, (void*)(uintptr_t) board);
+}
+
+uint32_t eps_hk_stats_get_failed_sample_count() {
+	return eps_hk_stats_failed_sample_count;
+}
+
+// #pragma endregion Update
+
+
+// #pragma region Results
+
+// Bitfields aren't numbers; they take the latest sample's value
+static void eps_hk_stats_copy_latest_bitfields(EPS_BOARD_enum_t board, const eps_stats_t *stats, int16_t words_dest[]) {
+	const int16_t *latest = eps_stats_get_latest(stats);
+	for (uint16_t word = 0; word < stats->series_count; word++) {
+		if (eps_raw_to_eng_is_bitfield_word(board, word)) {
+			words_dest[word] = latest[word];
+		}
+	}
+}
+
+static uint8_t eps_hk_stats_get_mean_words(EPS_BOARD_enum_t board, int16_t words_dest[]) {
+	const eps_stats_t *stats = eps_hk_stats_get_board(board);
+	if (stats->sample_count == 0) {
+		return 1;
+	}
+	eps_stats_get_mean(stats, words_dest);
+	eps_hk_stats_copy_latest_bitfields(board, stats, words_dest);
+	return 0;
+}
+
+static uint8_t eps_hk_stats_get_ewma_words(EPS_BOARD_enum_t board, int16_t words_dest[]) {
+	const eps_stats_t *stats = eps_hk_stats_get_board(board);
+	if (stats->sample_count == 0) {
+		return 1;
+	}
+	eps_stats_get_ewma(stats, words_dest);
+	eps_hk_stats_copy_latest_bitfields(board, stats, words_dest);
+	return 0;
+}
+
+uint8_t eps_hk_stats_get_pdu_running_average(eps_result_pdu_housekeeping_data_eng_t *result_dest) {
+	return eps_hk_stats_get_mean_words(EPS_BOARD_PDU, (int16_t*) result_dest);
+}
+
+uint8_t eps_hk_stats_get_pbu_running_average(eps_result_pbu_housekeeping_data_eng_t *result_dest) {
+	return eps_hk_stats_get_mean_words(EPS_BOARD_PBU, (int16_t*) result_dest);
+}
+
+uint8_t eps_hk_stats_get_pcu_running_average(eps_result_pcu_housekeeping_data_eng_t *result_dest) {
+	return eps_hk_stats_get_mean_words(EPS_BOARD_PCU, (int16_t*) result_dest);
+}
+
+uint8_t eps_hk_stats_get_piu_running_average(eps_result_piu_housekeeping_data_eng_t *result_dest) {
+	return eps_hk_stats_get_mean_words(EPS_BOARD_PIU, (int16_t*) result_dest);
+}
+
+uint8_t eps_hk_stats_get_pdu_ewma(eps_result_pdu_housekeeping_data_eng_t *result_dest) {
+	return eps_hk_stats_get_ewma_words(EPS_BOARD_PDU, (int16_t*) result_dest);
+}
+
+uint8_t eps_hk_stats_get_pbu_ewma(eps_result_pbu_housekeeping_data_eng_t *result_dest) {
+	return eps_hk_stats_get_ewma_words(EPS_BOARD_PBU, (int16_t*) result_dest);
+}
+
+uint8_t eps_hk_stats_get_pcu_ewma(eps_result_pcu_housekeeping_data_eng_t *result_dest) {
+	return eps_hk_stats_get_ewma_words(EPS_BOARD_PCU, (int16_t*) result_dest);
+}
+
+uint8_t eps_hk_stats_get_piu_ewma(eps_result_piu_housekeeping_data_eng_t *result_dest) {
+	return eps_hk_stats_get_ewma_words(EPS_BOARD_PIU, (int16_t*) result_dest);
+}
+
+// #pragma endregion Results
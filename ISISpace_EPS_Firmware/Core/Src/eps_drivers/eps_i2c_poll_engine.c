@@ -0,0 +1,166 @@
+#include "main.h"
+
+#include "eps_drivers/eps_i2c_poll_engine.h"
+#include "eps_drivers/eps_internal_drivers.h"
+#include "stm_drivers/timing_helpers.h"
+
+#include <stdint.h>
+
+static eps_i2c_poll_engine_t eps_i2c_poll_engine = {
+	.hi2c = NULL,
+	.state = EPS_I2C_POLL_ENGINE_STATE_IDLE,
+};
+static uint32_t eps_i2c_transfer_start_time_ms = 0;
+
+
+static void eps_i2c_poll_engine_fail(uint8_t result_code) {
+	eps_i2c_poll_engine.result_code = result_code;
+	eps_i2c_poll_engine.hal_i2c_error = HAL_I2C_GetError(eps_i2c_poll_engine.hi2c);
+	eps_i2c_poll_engine.state = EPS_I2C_POLL_ENGINE_STATE_ERROR;
+}
+
+static void eps_i2c_poll_engine_start_poll() {
+	// Only read the first byte; it's 0xFF until the response is ready.
+	eps_i2c_poll_engine.state = EPS_I2C_POLL_ENGINE_STATE_POLL_RX;
+	eps_i2c_transfer_start_time_ms = get_uptime_ms();
+	if (HAL_I2C_Master_Receive_IT(
+			eps_i2c_poll_engine.hi2c, EPS_I2C_ADDR, &eps_i2c_poll_engine.poll_byte, 1) != HAL_OK) {
+		eps_i2c_poll_engine_fail(3);
+	}
+}
+
+uint8_t eps_i2c_poll_engine_start(
+		I2C_HandleTypeDef *hi2c,
+		const uint8_t cmd_buf[], uint8_t cmd_buf_len,
+		uint8_t rx_buf[], uint16_t rx_buf_len,
+		const eps_poll_timing_t *timing) {
+
+	if (eps_i2c_poll_engine_is_busy()) {
+		return 1;
+	}
+
+	eps_i2c_poll_engine.hi2c = hi2c;
+	eps_i2c_poll_engine.rx_buf = rx_buf;
+	eps_i2c_poll_engine.rx_buf_len = rx_buf_len;
+	eps_i2c_poll_engine.timing = *timing;
+	eps_i2c_poll_engine.rx_retry_count = 0;
+	eps_i2c_poll_engine.last_not_ready_ms = 0;
+	eps_i2c_poll_engine.ready_ms = 0;
+	eps_i2c_poll_engine.result_code = 0;
+	eps_i2c_poll_engine.hal_i2c_error = HAL_I2C_ERROR_NONE;
+
+	eps_i2c_poll_engine.state = EPS_I2C_POLL_ENGINE_STATE_TX;
+	eps_i2c_transfer_start_time_ms = get_uptime_ms();
+	if (HAL_I2C_Master_Transmit_IT(hi2c, EPS_I2C_ADDR, (uint8_t*) cmd_buf, cmd_buf_len) != HAL_OK) {
+		eps_i2c_poll_engine_fail(2);
+		return 2;
+	}
+	return 0;
+}
+
+uint8_t eps_i2c_poll_engine_is_busy() {
+	const EPS_I2C_POLL_ENGINE_STATE_enum_t state = eps_i2c_poll_engine.state;
+	return (state != EPS_I2C_POLL_ENGINE_STATE_IDLE)
+			&& (state != EPS_I2C_POLL_ENGINE_STATE_DONE)
+			&& (state != EPS_I2C_POLL_ENGINE_STATE_ERROR);
+}
+
+const eps_i2c_poll_engine_t* eps_i2c_poll_engine_get() {
+	return &eps_i2c_poll_engine;
+}
+
+void eps_i2c_poll_engine_service() {
+	// Called from SysTick_Handler (every 1 ms). Starts the next poll when it's due, and catches
+	// transfers that never complete.
+	const EPS_I2C_POLL_ENGINE_STATE_enum_t state = eps_i2c_poll_engine.state;
+	const uint32_t now_ms = get_uptime_ms();
+
+	if (state == EPS_I2C_POLL_ENGINE_STATE_POLL_WAIT) {
+		if ((int32_t)(now_ms - eps_i2c_poll_engine.next_poll_time_ms) >= 0) {
+			eps_i2c_poll_engine_start_poll();
+		}
+	}
+	else if ((state == EPS_I2C_POLL_ENGINE_STATE_TX)
+			|| (state == EPS_I2C_POLL_ENGINE_STATE_POLL_RX)
+			|| (state == EPS_I2C_POLL_ENGINE_STATE_RX)) {
+		if (now_ms - eps_i2c_transfer_start_time_ms
+				> eps_i2c_poll_engine.timing.timeout_ms + EPS_I2C_TRANSFER_HUNG_MARGIN_MS) {
+			HAL_I2C_Master_Abort_IT(eps_i2c_poll_engine.hi2c, EPS_I2C_ADDR);
+			eps_i2c_poll_engine_fail((state == EPS_I2C_POLL_ENGINE_STATE_TX) ? 2 : 3);
+		}
+	}
+}
+
+uint32_t eps_i2c_poll_engine_get_next_service_ms() {
+	const EPS_I2C_POLL_ENGINE_STATE_enum_t state = eps_i2c_poll_engine.state;
+	if (state == EPS_I2C_POLL_ENGINE_STATE_POLL_WAIT) {
+		return eps_i2c_poll_engine.next_poll_time_ms;
+	}
+	if ((state == EPS_I2C_POLL_ENGINE_STATE_TX)
+			|| (state == EPS_I2C_POLL_ENGINE_STATE_POLL_RX)
+			|| (state == EPS_I2C_POLL_ENGINE_STATE_RX)) {
+		return eps_i2c_transfer_start_time_ms
+				+ eps_i2c_poll_engine.timing.timeout_ms + EPS_I2C_TRANSFER_HUNG_MARGIN_MS + 1;
+	}
+	return get_uptime_ms();
+}
+
+
+void HAL_I2C_MasterTxCpltCallback(I2C_HandleTypeDef *hi2c) {
+	if (hi2c != eps_i2c_poll_engine.hi2c || eps_i2c_poll_engine.state != EPS_I2C_POLL_ENGINE_STATE_TX) {
+		return;
+	}
+
+	// First poll at the expected ready time (right away if there's no estimate yet)
+	eps_i2c_poll_engine.start_rx_time_ms = get_uptime_ms();
+	if (eps_i2c_poll_engine.timing.first_poll_delay_ms > 0) {
+		eps_i2c_poll_engine.next_poll_time_ms = eps_i2c_poll_engine.start_rx_time_ms + eps_i2c_poll_engine.timing.first_poll_delay_ms;
+		eps_i2c_poll_engine.state = EPS_I2C_POLL_ENGINE_STATE_POLL_WAIT;
+		return;
+	}
+	eps_i2c_poll_engine_start_poll();
+}
+
+void HAL_I2C_MasterRxCpltCallback(I2C_HandleTypeDef *hi2c) {
+	if (hi2c != eps_i2c_poll_engine.hi2c) {
+		return;
+	}
+
+	if (eps_i2c_poll_engine.state == EPS_I2C_POLL_ENGINE_STATE_POLL_RX) {
+		if (eps_i2c_poll_engine.poll_byte == EPS_I2C_NOT_READY_BYTE) {
+			// quintessential "not ready" response; try again later
+			eps_i2c_poll_engine.rx_retry_count++;
+			eps_i2c_poll_engine.last_not_ready_ms = eps_i2c_transfer_start_time_ms - eps_i2c_poll_engine.start_rx_time_ms;
+			const uint32_t now_ms = get_uptime_ms();
+			if (now_ms - eps_i2c_poll_engine.start_rx_time_ms >= eps_i2c_poll_engine.timing.timeout_ms) {
+				eps_i2c_poll_engine_fail(4);
+				return;
+			}
+			eps_i2c_poll_engine.next_poll_time_ms = now_ms + eps_i2c_poll_engine.timing.poll_interval_ms;
+			eps_i2c_poll_engine.state = EPS_I2C_POLL_ENGINE_STATE_POLL_WAIT;
+			return;
+		}
+
+		// Response is ready. Each read transaction starts from the first response byte, so read
+		// the whole thing in one go.
+		eps_i2c_poll_engine.ready_ms = eps_i2c_transfer_start_time_ms - eps_i2c_poll_engine.start_rx_time_ms;
+		eps_i2c_poll_engine.state = EPS_I2C_POLL_ENGINE_STATE_RX;
+		eps_i2c_transfer_start_time_ms = get_uptime_ms();
+		if (HAL_I2C_Master_Receive_DMA(
+				hi2c, EPS_I2C_ADDR, eps_i2c_poll_engine.rx_buf, eps_i2c_poll_engine.rx_buf_len) != HAL_OK) {
+			eps_i2c_poll_engine_fail(3);
+		}
+	}
+	else if (eps_i2c_poll_engine.state == EPS_I2C_POLL_ENGINE_STATE_RX) {
+		eps_i2c_poll_engine.result_code = 0;
+		eps_i2c_poll_engine.state = EPS_I2C_POLL_ENGINE_STATE_DONE;
+	}
+}
+
+void HAL_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c) {
+	if (hi2c != eps_i2c_poll_engine.hi2c || !eps_i2c_poll_engine_is_busy()) {
+		return;
+	}
+
+	eps_i2c_poll_engine_fail((eps_i2c_poll_engine.state == EPS_I2C_POLL_ENGINE_STATE_TX) ? 2 : 3);
+}
@@ -0,0 +1,103 @@
+#include "eps_drivers/eps_latency_model.h"
+#include "eps_drivers/eps_cmd_table.h"
+#include "eps_drivers/eps_internal_drivers.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+// One per command in eps_cmd_table. Other command codes always get the defaults.
+static eps_latency_model_t eps_latency_models[EPS_CMD_ID_COUNT];
+
+
+static eps_latency_model_t* eps_latency_model_find(uint8_t CC) {
+	const EPS_CMD_ID_enum_t cmd_id = eps_cmd_find_id(CC);
+	return (cmd_id < EPS_CMD_ID_COUNT) ? &eps_latency_models[cmd_id] : NULL;
+}
+
+void eps_latency_model_get_timing(uint8_t CC, uint16_t rx_len, eps_poll_timing_t *timing_dest) {
+	const eps_latency_model_t *model = eps_latency_model_find(CC);
+	if (model == NULL || model->sample_count < EPS_LATENCY_MODEL_MIN_SAMPLES) {
+		timing_dest->first_poll_delay_ms = 0;
+		timing_dest->poll_interval_ms = EPS_LATENCY_MODEL_DEFAULT_POLL_INTERVAL_MS;
+		timing_dest->timeout_ms = EPS_MAX_RESPONSE_POLL_TIME_MS;
+		return;
+	}
+
+	const uint32_t mean_ms = model->mean_q3 >> EPS_LATENCY_MODEL_FRAC_BITS;
+	const uint32_t deviation_ms = (model->deviation_q3 + (1 << EPS_LATENCY_MODEL_FRAC_BITS) - 1) >> EPS_LATENCY_MODEL_FRAC_BITS;
+	timing_dest->first_poll_delay_ms = (model->mean_q3 + model->deviation_q3 + (1 << EPS_LATENCY_MODEL_FRAC_BITS) - 1) >> EPS_LATENCY_MODEL_FRAC_BITS;
+
+	uint32_t poll_interval_ms = deviation_ms / 2;
+	if (poll_interval_ms < 1) {
+		poll_interval_ms = 1;
+	}
+	else if (poll_interval_ms > EPS_LATENCY_MODEL_DEFAULT_POLL_INTERVAL_MS) {
+		poll_interval_ms = EPS_LATENCY_MODEL_DEFAULT_POLL_INTERVAL_MS;
+	}
+	timing_dest->poll_interval_ms = poll_interval_ms;
+
+	uint32_t timeout_ms = mean_ms + (4 * deviation_ms) + EPS_LATENCY_MODEL_MIN_TIMEOUT_MS
+			+ ((uint32_t) rx_len * EPS_LATENCY_MODEL_TIMEOUT_MS_PER_100_BYTES) / 100;
+	if (timeout_ms > EPS_LATENCY_MODEL_MAX_TIMEOUT_MS) {
+		timeout_ms = EPS_LATENCY_MODEL_MAX_TIMEOUT_MS;
+	}
+	timing_dest->timeout_ms = timeout_ms;
+}
+
+void eps_latency_model_record_ready(uint8_t CC, uint32_t first_poll_delay_ms, uint32_t last_not_ready_ms, uint32_t ready_ms) {
+	eps_latency_model_t *model = eps_latency_model_find(CC);
+	if (model == NULL) {
+		return;
+	}
+
+	if (first_poll_delay_ms > 0 && last_not_ready_ms < first_poll_delay_ms) {
+		// The delayed first poll was already ready: the response could have been ready any time
+		// before it, so there's no sample. The deviation was enough, so it shrinks as for a
+		// sample at the mean, and the mean moves a little earlier, so that a shorter latency is
+		// eventually found (a "not ready" first poll gives a real sample).
+		model->deviation_q3 -= model->deviation_q3 / 4;
+		model->mean_q3 -= (model->mean_q3 + (1 << EPS_LATENCY_MODEL_EARLIER_SHIFT) - 1) >> EPS_LATENCY_MODEL_EARLIER_SHIFT;
+		model->early_count++;
+		return;
+	}
+
+	// ready somewhere between the two polls
+	const uint32_t sample_q3 = (last_not_ready_ms + ready_ms) << (EPS_LATENCY_MODEL_FRAC_BITS - 1);
+
+	if (model->sample_count == 0) {
+		model->mean_q3 = sample_q3;
+		model->deviation_q3 = sample_q3 / 2;
+	}
+	else {
+		const int32_t error_q3 = (int32_t) sample_q3 - (int32_t) model->mean_q3;
+		const uint32_t abs_error_q3 = (error_q3 < 0) ? -error_q3 : error_q3;
+		model->mean_q3 += error_q3 / 8;
+		model->deviation_q3 += ((int32_t) abs_error_q3 - (int32_t) model->deviation_q3) / 4;
+	}
+	if (model->sample_count < UINT16_MAX) {
+		model->sample_count++;
+	}
+}
+
+void eps_latency_model_record_timeout(uint8_t CC) {
+	eps_latency_model_t *model = eps_latency_model_find(CC);
+	if (model == NULL) {
+		return;
+	}
+	model->timeout_count++;
+	if (model->sample_count >= EPS_LATENCY_MODEL_MIN_SAMPLES) {
+		// back off: the next timeout is longer (capped by EPS_LATENCY_MODEL_MAX_TIMEOUT_MS)
+		const uint32_t max_deviation_q3 = EPS_LATENCY_MODEL_MAX_TIMEOUT_MS << EPS_LATENCY_MODEL_FRAC_BITS;
+		model->deviation_q3 = (model->deviation_q3 * 2 < max_deviation_q3) ?
+				(model->deviation_q3 * 2 + (1 << EPS_LATENCY_MODEL_FRAC_BITS)) : max_deviation_q3;
+	}
+}
+
+const eps_latency_model_t* eps_latency_model_get(uint8_t CC) {
+	return eps_latency_model_find(CC);
+}
+
+void eps_latency_model_reset() {
+	memset(eps_latency_models, 0, sizeof(eps_latency_models));
+}
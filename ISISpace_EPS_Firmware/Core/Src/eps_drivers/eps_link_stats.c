@@ -0,0 +1,125 @@
+#include "eps_drivers/eps_link_stats.h"
+#include "debug_tools/json_writer.h"
+#include "eps_drivers/eps_cmd_table.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+// Slot n is eps_cmd_table[n]; the last slot is shared by command codes that aren't in the table.
+static eps_cc_stats_t eps_link_stats[EPS_LINK_STATS_SLOT_COUNT];
+
+#define EPS_LINK_STATS_OTHER_SLOT EPS_CMD_ID_COUNT
+
+
+static uint8_t eps_link_stats_find_slot(uint8_t CC) {
+	// EPS_CMD_ID_COUNT (not in the table) is EPS_LINK_STATS_OTHER_SLOT
+	return eps_cmd_find_id(CC);
+}
+
+uint8_t eps_link_stats_get_bucket(uint32_t value, uint8_t bucket_count) {
+	// 0 -> 0, 1 -> 1, 2..3 -> 2, 4..7 -> 3, ...
+	uint8_t bucket = 0;
+	while (value > 0 && bucket < bucket_count - 1) {
+		value >>= 1;
+		bucket++;
+	}
+	return bucket;
+}
+
+void eps_link_stats_record(uint8_t CC, uint8_t result_code, uint8_t stat, uint16_t retry_count, uint32_t latency_ms) {
+	eps_cc_stats_t *stats = &eps_link_stats[eps_link_stats_find_slot(CC)];
+	stats->CC = CC;
+	stats->call_count++;
+
+	if (result_code >= 1 && result_code <= EPS_LINK_STATS_ERROR_CODE_COUNT) {
+		stats->error_count[result_code - 1]++;
+	}
+	if (result_code != 0) {
+		return;
+	}
+
+	// Check STAT field (Table 3-11) - 0x00 and 0x80 mean success
+	if ((stat != 0x00) && (stat != 0x80)) {
+		const uint8_t stat_code = stat & 0x7F;
+		stats->stat_error_count[(stat_code < EPS_LINK_STATS_STAT_CODE_COUNT) ? stat_code : 0]++;
+		stats->last_stat_error = stat;
+	}
+
+	stats->retry_histogram[eps_link_stats_get_bucket(retry_count, EPS_LINK_STATS_RETRY_BUCKET_COUNT)]++;
+	stats->latency_histogram[eps_link_stats_get_bucket(latency_ms, EPS_LINK_STATS_LATENCY_BUCKET_COUNT)]++;
+	stats->total_latency_ms += latency_ms;
+	if (latency_ms > stats->max_latency_ms) {
+		stats->max_latency_ms = latency_ms;
+	}
+}
+
+const eps_cc_stats_t* eps_link_stats_get_slot(uint8_t slot) {
+	if (slot >= EPS_LINK_STATS_SLOT_COUNT || eps_link_stats[slot].call_count == 0) {
+		return NULL;
+	}
+	return &eps_link_stats[slot];
+}
+
+const eps_cc_stats_t* eps_link_stats_get(uint8_t CC) {
+	const eps_cc_stats_t *stats = eps_link_stats_get_slot(eps_link_stats_find_slot(CC));
+	if (stats == NULL || stats->CC != CC) {
+		// the shared slot, last used by another command code
+		return NULL;
+	}
+	return stats;
+}
+
+void eps_link_stats_reset() {
+	memset(eps_link_stats, 0, sizeof(eps_link_stats));
+}
+
+
+static void eps_link_stats_uint32_array_TO_json_writer(
+		json_writer_t *writer, const char *key, const uint32_t values[], uint16_t count) {
+	json_writer_begin_array(writer, key);
+	for (uint16_t i = 0; i < count; i++) {
+		json_writer_uint(writer, NULL, values[i]);
+	}
+	json_writer_end_array(writer);
+}
+
+void eps_cc_stats_TO_json_writer(json_writer_t *writer, const char *key, const eps_cc_stats_t *stats) {
+	uint32_t response_count = 0;
+	for (uint8_t bucket = 0; bucket < EPS_LINK_STATS_LATENCY_BUCKET_COUNT; bucket++) {
+		response_count += stats->latency_histogram[bucket];
+	}
+
+	json_writer_begin_object(writer, key);
+	json_writer_uint(writer, "cc", stats->CC);
+	json_writer_uint(writer, "calls", stats->call_count);
+	eps_link_stats_uint32_array_TO_json_writer(writer, "errors", stats->error_count, EPS_LINK_STATS_ERROR_CODE_COUNT);
+	eps_link_stats_uint32_array_TO_json_writer(writer, "stat_errors", stats->stat_error_count, EPS_LINK_STATS_STAT_CODE_COUNT);
+	json_writer_uint(writer, "last_stat_error", stats->last_stat_error);
+	eps_link_stats_uint32_array_TO_json_writer(writer, "retries", stats->retry_histogram, EPS_LINK_STATS_RETRY_BUCKET_COUNT);
+	eps_link_stats_uint32_array_TO_json_writer(writer, "latency_ms", stats->latency_histogram, EPS_LINK_STATS_LATENCY_BUCKET_COUNT);
+	json_writer_uint(writer, "latency_mean_ms", (response_count > 0) ? (stats->total_latency_ms / response_count) : 0);
+	json_writer_uint(writer, "latency_max_ms", stats->max_latency_ms);
+	json_writer_end_object(writer);
+}
+
+void eps_link_stats_TO_json_writer(json_writer_t *writer, const char *key) {
+	json_writer_begin_array(writer, key);
+	for (uint8_t slot = 0; slot < EPS_LINK_STATS_SLOT_COUNT; slot++) {
+		const eps_cc_stats_t *stats = eps_link_stats_get_slot(slot);
+		if (stats != NULL) {
+			eps_cc_stats_TO_json_writer(writer, NULL, stats);
+		}
+	}
+	json_writer_end_array(writer);
+}
+
+uint8_t eps_link_stats_TO_json(char json_output_str[], uint16_t json_output_str_len) {
+	if (json_output_str == NULL || json_output_str_len < 10) {
+		return 1;
+	}
+	json_writer_t writer;
+	json_writer_init(&writer, json_output_str, json_output_str_len, NULL, NULL);
+	eps_link_stats_TO_json_writer(&writer, NULL);
+	return json_writer_finish(&writer);
+}
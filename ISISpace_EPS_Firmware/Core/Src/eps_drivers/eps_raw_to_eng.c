@@ -0,0 +1,264 @@
+#include "eps_drivers/eps_raw_to_eng.h"
+#include "debug_tools/timing_probe.h"
+#include "eps_drivers/eps_commands.h"
+#include "eps_drivers/eps_types.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+// #pragma region Calibration
+
+static eps_raw_to_eng_calibration_t eps_raw_to_eng_calibration[EPS_BOARD_COUNT];
+static uint8_t eps_raw_to_eng_calibrated[EPS_BOARD_COUNT] = { 0 }; // 1 once set or loaded
+
+// #pragma endregion Calibration
+
+
+// #pragma region Layouts
+
+// What each 16-bit word of a raw struct is: a quantity (with EPS_RAW_TO_ENG_SIGNED if the raw
+// value is an int16_t), or EPS_RAW_TO_ENG_COPY for bitfields.
+#define EPS_RAW_TO_ENG_SIGNED 0x80
+#define EPS_RAW_TO_ENG_COPY 0x0F
+
+#define V EPS_RAW_TO_ENG_QUANTITY_VOLTAGE
+#define I EPS_RAW_TO_ENG_QUANTITY_CURRENT
+#define T EPS_RAW_TO_ENG_QUANTITY_TEMPERATURE
+#define COPY EPS_RAW_TO_ENG_COPY
+#define VIP_S (EPS_RAW_TO_ENG_QUANTITY_VOLTAGE | EPS_RAW_TO_ENG_SIGNED), \
+		(EPS_RAW_TO_ENG_QUANTITY_CURRENT | EPS_RAW_TO_ENG_SIGNED), \
+		(EPS_RAW_TO_ENG_QUANTITY_POWER | EPS_RAW_TO_ENG_SIGNED)
+
+#define EPS_RAW_TO_ENG_MAX_PATTERN_LEN 11 // PBU battery pack
+
+// `repeat` times the same pattern of `pattern_len` words, starting at member
+typedef struct {
+	uint8_t first_word;
+	uint8_t repeat;
+	uint8_t pattern_len;
+	uint8_t pattern[EPS_RAW_TO_ENG_MAX_PATTERN_LEN];
+} eps_raw_to_eng_run_t;
+
+typedef struct {
+	const eps_raw_to_eng_run_t *runs;
+	uint8_t run_count; // the runs cover every word of the struct
+} eps_raw_to_eng_layout_t;
+
+#define EPS_RAW_TO_ENG_RUN(type, member, repeat, pattern_len, ...) \
+	{ offsetof(type, member) / 2, (repeat), (pattern_len), { __VA_ARGS__ } }
+
+static const eps_raw_to_eng_run_t eps_raw_to_eng_runs_pdu[] = {
+	EPS_RAW_TO_ENG_RUN(eps_result_pdu_housekeeping_data_raw_t, voltage_internal_board_supply_raw, 1, 2, V, T),
+	EPS_RAW_TO_ENG_RUN(eps_result_pdu_housekeeping_data_raw_t, vip_total_input_raw, 1, 3, VIP_S),
+	EPS_RAW_TO_ENG_RUN(eps_result_pdu_housekeeping_data_raw_t, stat_ch_on_bitfield, 4, 1, COPY),
+	EPS_RAW_TO_ENG_RUN(eps_result_pdu_housekeeping_data_raw_t, vip_each_voltage_domain_raw, 7 + 32, 3, VIP_S), // and channels
+};
+
+static const eps_raw_to_eng_run_t eps_raw_to_eng_runs_pbu[] = {
+	EPS_RAW_TO_ENG_RUN(eps_result_pbu_housekeeping_data_raw_t, voltage_internal_board_supply_raw, 1, 2, V, T),
+	EPS_RAW_TO_ENG_RUN(eps_result_pbu_housekeeping_data_raw_t, vip_total_input_raw, 1, 3, VIP_S),
+	EPS_RAW_TO_ENG_RUN(eps_result_pbu_housekeeping_data_raw_t, battery_pack_status_bitfield, 1, 1, COPY),
+	EPS_RAW_TO_ENG_RUN(eps_result_pbu_housekeeping_data_raw_t, battery_pack_info_each_pack_raw, 3, 11,
+			VIP_S, COPY, V, V, V, V, T, T, T),
+};
+
+static const eps_raw_to_eng_run_t eps_raw_to_eng_runs_pcu[] = {
+	EPS_RAW_TO_ENG_RUN(eps_result_pcu_housekeeping_data_raw_t, voltage_internal_board_supply_raw, 1, 2, V, T),
+	EPS_RAW_TO_ENG_RUN(eps_result_pcu_housekeeping_data_raw_t, vip_total_input_raw, 1, 3, VIP_S),
+	EPS_RAW_TO_ENG_RUN(eps_result_pcu_housekeeping_data_raw_t, conditioning_channel_info_each_channel_raw, 4, 7,
+			VIP_S, V, I, V, I),
+};
+
+static const eps_raw_to_eng_run_t eps_raw_to_eng_runs_piu[] = {
+	EPS_RAW_TO_ENG_RUN(eps_result_piu_housekeeping_data_raw_t, voltage_internal_board_supply_raw, 1, 2, V, T),
+	EPS_RAW_TO_ENG_RUN(eps_result_piu_housekeeping_data_raw_t, vip_dist_input_raw, 2, 3, VIP_S), // and vip_batt_input_raw
+	EPS_RAW_TO_ENG_RUN(eps_result_piu_housekeeping_data_raw_t, stat_ch_on_bitfield, 1, 3, COPY, COPY, COPY), // to battery_status
+	EPS_RAW_TO_ENG_RUN(eps_result_piu_housekeeping_data_raw_t, battery_temp2_raw, 1, 5, T, T, V, V, V), // to vd2
+	EPS_RAW_TO_ENG_RUN(eps_result_piu_housekeeping_data_raw_t, vip_each_channel_raw, 32, 3, VIP_S),
+	EPS_RAW_TO_ENG_RUN(eps_result_piu_housekeeping_data_raw_t, conditioning_channel_info_each_channel_raw, 5, 4, V, I, V, I),
+	EPS_RAW_TO_ENG_RUN(eps_result_piu_housekeeping_data_raw_t, stat_ch_ext_on_bitfield, 2, 1, COPY),
+};
+
+#undef V
+#undef I
+#undef T
+#undef COPY
+#undef VIP_S
+
+_Static_assert(sizeof(eps_result_pdu_housekeeping_data_raw_t) == sizeof(eps_result_pdu_housekeeping_data_eng_t), "layouts must match");
+_Static_assert(sizeof(eps_result_pbu_housekeeping_data_raw_t) == sizeof(eps_result_pbu_housekeeping_data_eng_t), "layouts must match");
+_Static_assert(sizeof(eps_result_pcu_housekeeping_data_raw_t) == sizeof(eps_result_pcu_housekeeping_data_eng_t), "layouts must match");
+_Static_assert(sizeof(eps_result_piu_housekeeping_data_raw_t) == sizeof(eps_result_piu_housekeeping_data_eng_t), "layouts must match");
+
+#define EPS_RAW_TO_ENG_LAYOUT(runs) { (runs), sizeof(runs) / sizeof(eps_raw_to_eng_run_t) }
+
+static const eps_raw_to_eng_layout_t eps_raw_to_eng_layout_pdu = EPS_RAW_TO_ENG_LAYOUT(eps_raw_to_eng_runs_pdu);
+static const eps_raw_to_eng_layout_t eps_raw_to_eng_layout_pbu = EPS_RAW_TO_ENG_LAYOUT(eps_raw_to_eng_runs_pbu);
+static const eps_raw_to_eng_layout_t eps_raw_to_eng_layout_pcu = EPS_RAW_TO_ENG_LAYOUT(eps_raw_to_eng_runs_pcu);
+static const eps_raw_to_eng_layout_t eps_raw_to_eng_layout_piu = EPS_RAW_TO_ENG_LAYOUT(eps_raw_to_eng_runs_piu);
+
+static const eps_raw_to_eng_layout_t *const eps_raw_to_eng_layouts[EPS_BOARD_COUNT] = {
+	[EPS_BOARD_PDU] = &eps_raw_to_eng_layout_pdu,
+	[EPS_BOARD_PBU] = &eps_raw_to_eng_layout_pbu,
+	[EPS_BOARD_PCU] = &eps_raw_to_eng_layout_pcu,
+	[EPS_BOARD_PIU] = &eps_raw_to_eng_layout_piu,
+};
+
+// #pragma endregion Layouts
+
+
+int32_t eps_raw_to_eng_convert_value(int32_t raw, const eps_raw_to_eng_coeff_t *coeff) {
+	return (int32_t)(((int64_t) raw * coeff->gain_q16 + 0x8000) >> 16) + coeff->offset;
+}
+
+uint8_t eps_raw_to_eng_is_bitfield_word(EPS_BOARD_enum_t board, uint16_t word) {
+	const eps_raw_to_eng_layout_t *layout = eps_raw_to_eng_layouts[board];
+	for (uint8_t run_idx = 0; run_idx < layout->run_count; run_idx++) {
+		const eps_raw_to_eng_run_t *run = &layout->runs[run_idx];
+		if (word >= run->first_word && word < run->first_word + run->repeat * run->pattern_len) {
+			return run->pattern[(word - run->first_word) % run->pattern_len] == EPS_RAW_TO_ENG_COPY;
+		}
+	}
+	return 0;
+}
+
+static uint8_t eps_raw_to_eng_convert(EPS_BOARD_enum_t board, const uint16_t raw_words[], uint16_t eng_words[]) {
+	if (!eps_raw_to_eng_calibrated[board]) {
+		return 1;
+	}
+	TIMING_PROBE_SCOPE(TIMING_PROBE_ID_CONVERT);
+	const eps_raw_to_eng_layout_t *layout = eps_raw_to_eng_layouts[board];
+	const eps_raw_to_eng_calibration_t *calibration = &eps_raw_to_eng_calibration[board];
+	for (uint8_t run_idx = 0; run_idx < layout->run_count; run_idx++) {
+		const eps_raw_to_eng_run_t *run = &layout->runs[run_idx];
+		uint16_t word = run->first_word;
+		for (uint8_t repeat = 0; repeat < run->repeat; repeat++) {
+			for (uint8_t k = 0; k < run->pattern_len; k++, word++) {
+				const uint8_t code = run->pattern[k];
+				if (code == EPS_RAW_TO_ENG_COPY) {
+					eng_words[word] = raw_words[word];
+					continue;
+				}
+				const int32_t raw = (code & EPS_RAW_TO_ENG_SIGNED) ? (int16_t) raw_words[word] : raw_words[word];
+				eng_words[word] = (uint16_t) eps_raw_to_eng_convert_value(
+						raw, &calibration->each_quantity[code & ~EPS_RAW_TO_ENG_SIGNED]);
+			}
+		}
+	}
+	return 0;
+}
+
+uint8_t eps_result_pdu_housekeeping_data_raw_TO_eng(const eps_result_pdu_housekeeping_data_raw_t *raw, eps_result_pdu_housekeeping_data_eng_t *eng_dest) {
+	return eps_raw_to_eng_convert(EPS_BOARD_PDU, (const uint16_t*) raw, (uint16_t*) eng_dest);
+}
+
+uint8_t eps_result_pbu_housekeeping_data_raw_TO_eng(const eps_result_pbu_housekeeping_data_raw_t *raw, eps_result_pbu_housekeeping_data_eng_t *eng_dest) {
+	return eps_raw_to_eng_convert(EPS_BOARD_PBU, (const uint16_t*) raw, (uint16_t*) eng_dest);
+}
+
+uint8_t eps_result_pcu_housekeeping_data_raw_TO_eng(const eps_result_pcu_housekeeping_data_raw_t *raw, eps_result_pcu_housekeeping_data_eng_t *eng_dest) {
+	return eps_raw_to_eng_convert(EPS_BOARD_PCU, (const uint16_t*) raw, (uint16_t*) eng_dest);
+}
+
+uint8_t eps_result_piu_housekeeping_data_raw_TO_eng(const eps_result_piu_housekeeping_data_raw_t *raw, eps_result_piu_housekeeping_data_eng_t *eng_dest) {
+	return eps_raw_to_eng_convert(EPS_BOARD_PIU, (const uint16_t*) raw, (uint16_t*) eng_dest);
+}
+
+
+uint8_t eps_get_pdu_housekeeping_data_raw_and_eng(eps_result_pdu_housekeeping_data_raw_t *raw_dest, eps_result_pdu_housekeeping_data_eng_t *eng_dest) {
+	if (!eps_raw_to_eng_calibrated[EPS_BOARD_PDU]) {
+		return 1;
+	}
+	const uint8_t result = eps_get_pdu_housekeeping_data_raw(raw_dest);
+	if (result == 0) {
+		eps_result_pdu_housekeeping_data_raw_TO_eng(raw_dest, eng_dest);
+	}
+	return result;
+}
+
+uint8_t eps_get_pbu_housekeeping_data_raw_and_eng(eps_result_pbu_housekeeping_data_raw_t *raw_dest, eps_result_pbu_housekeeping_data_eng_t *eng_dest) {
+	if (!eps_raw_to_eng_calibrated[EPS_BOARD_PBU]) {
+		return 1;
+	}
+	const uint8_t result = eps_get_pbu_housekeeping_data_raw(raw_dest);
+	if (result == 0) {
+		eps_result_pbu_housekeeping_data_raw_TO_eng(raw_dest, eng_dest);
+	}
+	return result;
+}
+
+uint8_t eps_get_pcu_housekeeping_data_raw_and_eng(eps_result_pcu_housekeeping_data_raw_t *raw_dest, eps_result_pcu_housekeeping_data_eng_t *eng_dest) {
+	if (!eps_raw_to_eng_calibrated[EPS_BOARD_PCU]) {
+		return 1;
+	}
+	const uint8_t result = eps_get_pcu_housekeeping_data_raw(raw_dest);
+	if (result == 0) {
+		eps_result_pcu_housekeeping_data_raw_TO_eng(raw_dest, eng_dest);
+	}
+	return result;
+}
+
+uint8_t eps_get_piu_housekeeping_data_raw_and_eng(eps_result_piu_housekeeping_data_raw_t *raw_dest, eps_result_piu_housekeeping_data_eng_t *eng_dest) {
+	if (!eps_raw_to_eng_calibrated[EPS_BOARD_PIU]) {
+		return 1;
+	}
+	const uint8_t result = eps_get_piu_housekeeping_data_raw(raw_dest);
+	if (result == 0) {
+		eps_result_piu_housekeeping_data_raw_TO_eng(raw_dest, eng_dest);
+	}
+	return result;
+}
+
+
+uint8_t eps_raw_to_eng_is_calibrated(EPS_BOARD_enum_t board) {
+	return (board < EPS_BOARD_COUNT) && eps_raw_to_eng_calibrated[board];
+}
+
+const eps_raw_to_eng_calibration_t* eps_raw_to_eng_get_calibration(EPS_BOARD_enum_t board) {
+	return eps_raw_to_eng_is_calibrated(board) ? &eps_raw_to_eng_calibration[board] : NULL;
+}
+
+void eps_raw_to_eng_set_calibration(EPS_BOARD_enum_t board, const eps_raw_to_eng_calibration_t *calibration) {
+	if (board < EPS_BOARD_COUNT && calibration != NULL) {
+		eps_raw_to_eng_calibration[board] = *calibration;
+		eps_raw_to_eng_calibrated[board] = 1;
+	}
+}
+
+void eps_raw_to_eng_reset_calibration() {
+	memset(eps_raw_to_eng_calibration, 0, sizeof(eps_raw_to_eng_calibration));
+	memset(eps_raw_to_eng_calibrated, 0, sizeof(eps_raw_to_eng_calibrated));
+}
+
+static uint8_t eps_raw_to_eng_read_int32_parameter(uint16_t parameter_id, int32_t *value_dest) {
+	uint8_t parameter_value[8];
+	const uint8_t result = eps_get_configuration_parameter(parameter_id, parameter_value);
+	if (result != 0) {
+		return result;
+	}
+	*value_dest = (int32_t)(parameter_value[0] | (parameter_value[1] << 8) | (parameter_value[2] << 16)
+			| ((uint32_t) parameter_value[3] << 24));
+	return 0;
+}
+
+uint8_t eps_raw_to_eng_load_calibration(EPS_BOARD_enum_t board,
+		const uint16_t gain_parameter_ids[EPS_RAW_TO_ENG_QUANTITY_COUNT],
+		const uint16_t offset_parameter_ids[EPS_RAW_TO_ENG_QUANTITY_COUNT]) {
+	if (board >= EPS_BOARD_COUNT) {
+		return 1;
+	}
+	eps_raw_to_eng_calibration_t calibration;
+	for (uint8_t quantity = 0; quantity < EPS_RAW_TO_ENG_QUANTITY_COUNT; quantity++) {
+		eps_raw_to_eng_coeff_t *coeff = &calibration.each_quantity[quantity];
+		uint8_t result = eps_raw_to_eng_read_int32_parameter(gain_parameter_ids[quantity], &coeff->gain_q16);
+		if (result == 0) {
+			result = eps_raw_to_eng_read_int32_parameter(offset_parameter_ids[quantity], &coeff->offset);
+		}
+		if (result != 0) {
+			return result;
+		}
+	}
+	eps_raw_to_eng_set_calibration(board, &calibration);
+	return 0;
+}
@@ -0,0 +1,132 @@
+#include "eps_drivers/eps_rsp_framer.h"
+
+#include <stdint.h>
+#include <string.h>
+
+static const uint8_t eps_rsp_start_tag[EPS_RSP_FRAMER_START_TAG_LEN] = EPS_RSP_FRAMER_START_TAG;
+static const uint8_t eps_rsp_end_tag[EPS_RSP_FRAMER_END_TAG_LEN] = EPS_RSP_FRAMER_END_TAG;
+
+static uint8_t eps_rsp_framer_process_byte(eps_rsp_framer_t *framer, uint8_t byte, uint8_t allow_rescan);
+
+
+void eps_rsp_framer_init(eps_rsp_framer_t *framer) {
+	memset(framer, 0, sizeof(eps_rsp_framer_t));
+	framer->state = EPS_RSP_FRAMER_STATE_HUNT_START_TAG;
+}
+
+void eps_rsp_framer_begin_frame(eps_rsp_framer_t *framer, uint8_t payload_buf[], uint16_t payload_len) {
+	// Resets the framing state for a new response, but keeps the counters.
+	framer->payload_buf = payload_buf;
+	framer->payload_len = payload_len;
+	framer->payload_received_len = 0;
+	framer->tag_match_len = 0;
+	framer->state = EPS_RSP_FRAMER_STATE_HUNT_START_TAG;
+}
+
+uint8_t eps_rsp_framer_is_frame_complete(const eps_rsp_framer_t *framer) {
+	return framer->state == EPS_RSP_FRAMER_STATE_FRAME_COMPLETE;
+}
+
+static void eps_rsp_framer_discard_frame(eps_rsp_framer_t *framer, uint8_t failing_byte, uint8_t allow_rescan) {
+	// The end tag didn't match, so the "<rsp>" we locked onto was either garbage, or the frame was
+	// truncated. Either way, the next real start tag may be inside the bytes we already consumed,
+	// so re-scan them (payload, partial end tag, failing byte).
+	const uint8_t end_tag_matched_len = framer->tag_match_len;
+	framer->malformed_frame_count++;
+	framer->dropped_byte_count += EPS_RSP_FRAMER_START_TAG_LEN;
+	framer->state = EPS_RSP_FRAMER_STATE_HUNT_START_TAG;
+	framer->tag_match_len = 0;
+
+	if (!allow_rescan) {
+		// Only one level of re-scanning. A re-scanned stream is at most (payload_len + 6) bytes
+		// long, so it can never contain a complete frame anyway.
+		// Nor can the dropped bytes end in part of a start tag that later bytes would complete: a
+		// frame only fails inside a re-scan if it started at the re-scanned payload's first byte
+		// and the outer end tag had matched "</rsp". Its payload then ends in "</rsp", so the
+		// dropped tail is "/rsp" and a failing byte that isn't "<".
+		framer->dropped_byte_count += framer->payload_len + end_tag_matched_len + 1;
+		return;
+	}
+
+	// Re-scanning in place is safe: any new payload byte is written at a lower index than the one
+	// being read, as the start tag takes up at least 5 bytes.
+	for (uint16_t i = 0; i < framer->payload_len; i++) {
+		eps_rsp_framer_process_byte(framer, framer->payload_buf[i], 0);
+	}
+	for (uint8_t i = 0; i < end_tag_matched_len; i++) {
+		eps_rsp_framer_process_byte(framer, eps_rsp_end_tag[i], 0);
+	}
+	eps_rsp_framer_process_byte(framer, failing_byte, 0);
+}
+
+static uint8_t eps_rsp_framer_process_byte(eps_rsp_framer_t *framer, uint8_t byte, uint8_t allow_rescan) {
+	switch (framer->state) {
+		case EPS_RSP_FRAMER_STATE_HUNT_START_TAG:
+			if (byte == eps_rsp_start_tag[framer->tag_match_len]) {
+				framer->tag_match_len++;
+				if (framer->tag_match_len == EPS_RSP_FRAMER_START_TAG_LEN) {
+					framer->tag_match_len = 0;
+					framer->payload_received_len = 0;
+					framer->state = (framer->payload_len > 0) ?
+							EPS_RSP_FRAMER_STATE_PAYLOAD : EPS_RSP_FRAMER_STATE_END_TAG;
+				}
+			}
+			else {
+				// "<" can't appear later in "<rsp>", so a mismatch can only restart at this byte
+				framer->dropped_byte_count += framer->tag_match_len;
+				if (byte == eps_rsp_start_tag[0]) {
+					framer->tag_match_len = 1;
+				}
+				else {
+					framer->tag_match_len = 0;
+					framer->dropped_byte_count++;
+				}
+			}
+			break;
+
+		case EPS_RSP_FRAMER_STATE_PAYLOAD:
+			framer->payload_buf[framer->payload_received_len++] = byte;
+			if (framer->payload_received_len >= framer->payload_len) {
+				framer->tag_match_len = 0;
+				framer->state = EPS_RSP_FRAMER_STATE_END_TAG;
+			}
+			break;
+
+		case EPS_RSP_FRAMER_STATE_END_TAG:
+			if (byte == eps_rsp_end_tag[framer->tag_match_len]) {
+				framer->tag_match_len++;
+				if (framer->tag_match_len == EPS_RSP_FRAMER_END_TAG_LEN) {
+					framer->tag_match_len = 0;
+					framer->frame_count++;
+					framer->state = EPS_RSP_FRAMER_STATE_FRAME_COMPLETE;
+				}
+			}
+			else {
+				eps_rsp_framer_discard_frame(framer, byte, allow_rescan);
+			}
+			break;
+
+		case EPS_RSP_FRAMER_STATE_FRAME_COMPLETE:
+			// Already have a frame; extra bytes are ignored until the next eps_rsp_framer_begin_frame()
+			framer->dropped_byte_count++;
+			break;
+	}
+
+	return eps_rsp_framer_is_frame_complete(framer);
+}
+
+uint8_t eps_rsp_framer_push_byte(eps_rsp_framer_t *framer, uint8_t byte) {
+	// Returns 1 once a complete frame is in payload_buf.
+	return eps_rsp_framer_process_byte(framer, byte, 1);
+}
+
+uint16_t eps_rsp_framer_push_bytes(eps_rsp_framer_t *framer, const uint8_t bytes[], uint16_t bytes_len) {
+	// Returns the number of bytes consumed. Stops right after the end of a complete frame, so that
+	// the caller can keep any remaining bytes.
+	uint16_t consumed_len = 0;
+	while (consumed_len < bytes_len && !eps_rsp_framer_is_frame_complete(framer)) {
+		eps_rsp_framer_process_byte(framer, bytes[consumed_len], 1);
+		consumed_len++;
+	}
+	return consumed_len;
+}
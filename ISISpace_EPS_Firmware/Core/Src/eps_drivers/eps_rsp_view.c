@@ -0,0 +1,141 @@
+#include "eps_drivers/eps_rsp_view.h"
+#include "eps_drivers/eps_field_decoder.h"
+#include "eps_drivers/eps_types.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define EPS_VIEW_CHANNEL_COUNT 32
+
+// Response offsets (ESP_SICD), the same as in the field tables
+#define EPS_VIEW_VIPD_VOLTAGE 0 // within a 6-byte VIPD
+#define EPS_VIEW_VIPD_CURRENT 2
+#define EPS_VIEW_VIPD_POWER 4
+
+#define EPS_PDU_VIEW_STAT_CH_ON 16
+#define EPS_PDU_VIEW_STAT_CH_EXT_ON 18
+#define EPS_PDU_VIEW_STAT_CH_OCF 20
+#define EPS_PDU_VIEW_STAT_CH_EXT_OCF 22
+#define EPS_PDU_VIEW_CHANNEL_VIPD(channel_num) (66 + (channel_num) * 6)
+
+#define EPS_PIU_VIEW_STAT_CH_ON 22
+#define EPS_PIU_VIEW_STAT_CH_OCF 24
+#define EPS_PIU_VIEW_STAT_CH_EXT_ON 174
+#define EPS_PIU_VIEW_STAT_CH_EXT_OCF 176
+
+// The PIU's channels are split in three runs around the conditioning channels (see eps_field_decoder.c)
+static const uint16_t eps_piu_view_channel_vipd[EPS_VIEW_CHANNEL_COUNT] = {
+	38, 44, 50, 56, 62, 68, 74, 80, 86, // VIP_CH[0..8]
+	116, 122, 128, 134, 140, 146, 152, // VIP_CH[9..15]
+	178, 184, 190, 196, 202, 208, 214, 220, 226, 232, 238, 244, 250, 256, 262, 268, // VIP_CH[16..31]
+};
+
+uint8_t eps_rsp_view_init(eps_rsp_view_t *view, const eps_field_table_t *fields, const uint8_t rx_buf[], uint16_t rx_buf_len) {
+	if (rx_buf_len < fields->rx_len) {
+		return 1;
+	}
+	view->rx_buf = rx_buf;
+	view->fields = fields;
+	return 0;
+}
+
+uint32_t eps_rsp_view_get(const eps_rsp_view_t *view, uint16_t dest_offset) {
+	uint16_t src_offset;
+	const eps_field_descriptor_t *field;
+	if (eps_field_locate(view->fields, dest_offset, &src_offset, &field) != 0) {
+		return 0;
+	}
+	return eps_field_read_value(field, &view->rx_buf[src_offset]);
+}
+
+static uint16_t eps_rsp_view_read_u16(const eps_rsp_view_t *view, uint16_t src_offset) {
+	return view->rx_buf[src_offset] | (view->rx_buf[src_offset + 1] << 8);
+}
+
+
+// #pragma region PIU
+
+uint8_t eps_piu_view_init(eps_piu_view_t *view, const uint8_t rx_buf[], uint16_t rx_buf_len) {
+	return eps_rsp_view_init(&view->rsp, &eps_field_table_piu_housekeeping_data_eng, rx_buf, rx_buf_len);
+}
+
+static int16_t eps_piu_view_channel_value(const eps_piu_view_t *view, uint8_t channel_num, uint8_t vipd_offset) {
+	if (channel_num >= EPS_VIEW_CHANNEL_COUNT) {
+		return 0;
+	}
+	return (int16_t) eps_rsp_view_read_u16(&view->rsp, eps_piu_view_channel_vipd[channel_num] + vipd_offset);
+}
+
+int16_t eps_piu_view_channel_voltage_mV(const eps_piu_view_t *view, uint8_t channel_num) {
+	return eps_piu_view_channel_value(view, channel_num, EPS_VIEW_VIPD_VOLTAGE);
+}
+
+int16_t eps_piu_view_channel_current_mA(const eps_piu_view_t *view, uint8_t channel_num) {
+	return eps_piu_view_channel_value(view, channel_num, EPS_VIEW_VIPD_CURRENT);
+}
+
+int16_t eps_piu_view_channel_power_cW(const eps_piu_view_t *view, uint8_t channel_num) {
+	return eps_piu_view_channel_value(view, channel_num, EPS_VIEW_VIPD_POWER);
+}
+
+uint16_t eps_piu_view_stat_ch_on_bitfield(const eps_piu_view_t *view) {
+	return eps_rsp_view_read_u16(&view->rsp, EPS_PIU_VIEW_STAT_CH_ON);
+}
+
+uint16_t eps_piu_view_stat_ch_overcurrent_fault_bitfield(const eps_piu_view_t *view) {
+	return eps_rsp_view_read_u16(&view->rsp, EPS_PIU_VIEW_STAT_CH_OCF);
+}
+
+uint16_t eps_piu_view_stat_ch_ext_on_bitfield(const eps_piu_view_t *view) {
+	return eps_rsp_view_read_u16(&view->rsp, EPS_PIU_VIEW_STAT_CH_EXT_ON);
+}
+
+uint16_t eps_piu_view_stat_ch_ext_overcurrent_fault_bitfield(const eps_piu_view_t *view) {
+	return eps_rsp_view_read_u16(&view->rsp, EPS_PIU_VIEW_STAT_CH_EXT_OCF);
+}
+
+// #pragma endregion PIU
+
+
+// #pragma region PDU
+
+uint8_t eps_pdu_view_init(eps_pdu_view_t *view, const uint8_t rx_buf[], uint16_t rx_buf_len) {
+	return eps_rsp_view_init(&view->rsp, &eps_field_table_pdu_housekeeping_data_eng, rx_buf, rx_buf_len);
+}
+
+static int16_t eps_pdu_view_channel_value(const eps_pdu_view_t *view, uint8_t channel_num, uint8_t vipd_offset) {
+	if (channel_num >= EPS_VIEW_CHANNEL_COUNT) {
+		return 0;
+	}
+	return (int16_t) eps_rsp_view_read_u16(&view->rsp, EPS_PDU_VIEW_CHANNEL_VIPD(channel_num) + vipd_offset);
+}
+
+int16_t eps_pdu_view_channel_voltage_mV(const eps_pdu_view_t *view, uint8_t channel_num) {
+	return eps_pdu_view_channel_value(view, channel_num, EPS_VIEW_VIPD_VOLTAGE);
+}
+
+int16_t eps_pdu_view_channel_current_mA(const eps_pdu_view_t *view, uint8_t channel_num) {
+	return eps_pdu_view_channel_value(view, channel_num, EPS_VIEW_VIPD_CURRENT);
+}
+
+int16_t eps_pdu_view_channel_power_cW(const eps_pdu_view_t *view, uint8_t channel_num) {
+	return eps_pdu_view_channel_value(view, channel_num, EPS_VIEW_VIPD_POWER);
+}
+
+uint16_t eps_pdu_view_stat_ch_on_bitfield(const eps_pdu_view_t *view) {
+	return eps_rsp_view_read_u16(&view->rsp, EPS_PDU_VIEW_STAT_CH_ON);
+}
+
+uint16_t eps_pdu_view_stat_ch_overcurrent_fault_bitfield(const eps_pdu_view_t *view) {
+	return eps_rsp_view_read_u16(&view->rsp, EPS_PDU_VIEW_STAT_CH_OCF);
+}
+
+uint16_t eps_pdu_view_stat_ch_ext_on_bitfield(const eps_pdu_view_t *view) {
+	return eps_rsp_view_read_u16(&view->rsp, EPS_PDU_VIEW_STAT_CH_EXT_ON);
+}
+
+uint16_t eps_pdu_view_stat_ch_ext_overcurrent_fault_bitfield(const eps_pdu_view_t *view) {
+	return eps_rsp_view_read_u16(&view->rsp, EPS_PDU_VIEW_STAT_CH_EXT_OCF);
+}
+
+// #pragma endregion PDU
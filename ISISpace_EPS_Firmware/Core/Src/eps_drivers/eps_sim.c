@@ -0,0 +1,508 @@
+#include "eps_drivers/eps_sim.h"
+#include "eps_drivers/eps_internal_drivers.h"
+#include "eps_drivers/eps_raw_to_eng.h"
+
+#include <stdint.h>
+#include <string.h>
+
+// Arbitrary fixed date for the simulated RTC: 2024-01-01 00:00:00 UTC
+#define EPS_SIM_UNIX_TIME_AT_POWER_ON_SEC 1704067200
+
+static eps_sim_config_t eps_sim_config = {
+	.response_latency_ms = 2,
+	.per_byte_latency_us = 0,
+	.inject_error = EPS_SIM_ERROR_NONE,
+	.inject_error_every_n_cmds = 0,
+};
+static eps_sim_state_t eps_sim_state;
+static uint8_t eps_sim_is_initialized = 0;
+
+// The simulated EPS's own ADC scaling, fixed and independent of the OBC's calibration
+// (eps_raw_to_eng), the same for every board:
+//   eng = raw * eng_per_count_num / eng_per_count_den + eng_offset
+static const eps_sim_adc_scale_t eps_sim_adc_scale[EPS_RAW_TO_ENG_QUANTITY_COUNT] = {
+	[EPS_RAW_TO_ENG_QUANTITY_VOLTAGE] = { 5000, 4096, 0 }, // 12-bit over 5 V, in mV
+	[EPS_RAW_TO_ENG_QUANTITY_CURRENT] = { 1, 2, 0 }, // 0.5 mA
+	[EPS_RAW_TO_ENG_QUANTITY_POWER] = { 1, 1, 0 }, // 1 cW
+	[EPS_RAW_TO_ENG_QUANTITY_TEMPERATURE] = { 10, 1, -27315 }, // 0.1 K, in cC
+};
+
+// Set while filling a raw housekeeping response (0x50/0x60/0x70/0xA0): values are then written
+// as raw counts with eps_sim_adc_scale.
+static uint8_t eps_sim_is_raw_response = 0;
+
+
+static void eps_sim_write_u16(uint8_t rx_buf[], uint16_t idx, uint16_t value) {
+	rx_buf[idx] = value & 0xFF;
+	rx_buf[idx + 1] = value >> 8;
+}
+
+static void eps_sim_write_u32(uint8_t rx_buf[], uint16_t idx, uint32_t value) {
+	eps_sim_write_u16(rx_buf, idx, value & 0xFFFF);
+	eps_sim_write_u16(rx_buf, idx + 2, value >> 16);
+}
+
+static void eps_sim_write_value(uint8_t rx_buf[], uint16_t idx, int32_t eng_value, EPS_RAW_TO_ENG_QUANTITY_enum_t quantity) {
+	// eng_value in mV, mA, cW or cC
+	if (!eps_sim_is_raw_response) {
+		eps_sim_write_u16(rx_buf, idx, (uint16_t) eng_value);
+		return;
+	}
+	// raw = (eng - offset) * den / num, rounded to the nearest count
+	const eps_sim_adc_scale_t *scale = &eps_sim_adc_scale[quantity];
+	const int64_t scaled = (int64_t)(eng_value - scale->eng_offset) * scale->eng_per_count_den;
+	const int64_t half = scale->eng_per_count_num / 2;
+	const int64_t raw = (scaled + ((scaled >= 0) ? half : -half)) / scale->eng_per_count_num;
+	eps_sim_write_u16(rx_buf, idx, (uint16_t) raw);
+}
+
+static void eps_sim_write_vip(uint8_t rx_buf[], uint16_t idx, uint16_t voltage_mV, uint16_t current_mA) {
+	// VIP = voltage, current, power (cW)
+	eps_sim_write_value(rx_buf, idx, voltage_mV, EPS_RAW_TO_ENG_QUANTITY_VOLTAGE);
+	eps_sim_write_value(rx_buf, idx + 2, current_mA, EPS_RAW_TO_ENG_QUANTITY_CURRENT);
+	eps_sim_write_value(rx_buf, idx + 4, ((uint32_t)voltage_mV * current_mA) / 10000, EPS_RAW_TO_ENG_QUANTITY_POWER);
+}
+
+static void eps_sim_write_mppt(uint8_t rx_buf[], uint16_t idx) {
+	// conditioning channel MPPT: volt_in, curr_in, volt_ou, curr_ou
+	eps_sim_write_value(rx_buf, idx, 20000, EPS_RAW_TO_ENG_QUANTITY_VOLTAGE);
+	eps_sim_write_value(rx_buf, idx + 2, 160, EPS_RAW_TO_ENG_QUANTITY_CURRENT);
+	eps_sim_write_value(rx_buf, idx + 4, 16000, EPS_RAW_TO_ENG_QUANTITY_VOLTAGE);
+	eps_sim_write_value(rx_buf, idx + 6, 200, EPS_RAW_TO_ENG_QUANTITY_CURRENT);
+}
+
+static uint8_t eps_sim_is_channel_on(uint8_t ch_num) {
+	if (ch_num < 16) {
+		return (eps_sim_state.stat_ch_on_bitfield >> ch_num) & 1;
+	}
+	return (eps_sim_state.stat_ch_ext_on_bitfield >> (ch_num - 16)) & 1;
+}
+
+static void eps_sim_write_channel_vip(uint8_t rx_buf[], uint16_t idx, uint8_t ch_num) {
+	// channels that are on draw a small, channel-dependent current
+	if (eps_sim_is_channel_on(ch_num)) {
+		eps_sim_write_vip(rx_buf, idx, 5000, 100 + (10 * ch_num));
+	}
+	else {
+		eps_sim_write_vip(rx_buf, idx, 0, 0);
+	}
+}
+
+static uint16_t eps_sim_total_channel_current_mA() {
+	uint16_t total_current_mA = 0;
+	for (uint8_t ch_num = 0; ch_num < 32; ch_num++) {
+		if (eps_sim_is_channel_on(ch_num)) {
+			total_current_mA += 100 + (10 * ch_num);
+		}
+	}
+	return total_current_mA;
+}
+
+static void eps_sim_boot(uint32_t now_ms, uint8_t reset_cause) {
+	// state lost on any reset; counters and time survive
+	eps_sim_state.mode = 1; // nominal
+	eps_sim_state.config_changed_since_boot = 0;
+	eps_sim_state.reset_cause = reset_cause;
+	eps_sim_state.new_flag_pending = 1;
+	eps_sim_state.stat_ch_on_bitfield = 0;
+	eps_sim_state.stat_ch_ext_on_bitfield = 0;
+	eps_sim_state.unix_time_at_boot_sec += (now_ms - eps_sim_state.boot_time_ms) / 1000;
+	eps_sim_state.boot_time_ms = now_ms;
+	eps_sim_state.prev_cmd_time_ms = now_ms;
+}
+
+void eps_sim_reset(uint32_t now_ms) {
+	// power-on reset
+	memset(&eps_sim_state, 0, sizeof(eps_sim_state_t));
+	eps_sim_state.unix_time_at_boot_sec = EPS_SIM_UNIX_TIME_AT_POWER_ON_SEC;
+	eps_sim_state.boot_time_ms = now_ms;
+	eps_sim_state.rst_cnt_pwron = 1;
+	eps_sim_boot(now_ms, 0);
+	eps_sim_is_initialized = 1;
+}
+
+void eps_sim_configure(const eps_sim_config_t *config) {
+	eps_sim_config = *config;
+}
+
+const eps_sim_config_t* eps_sim_get_config() {
+	return &eps_sim_config;
+}
+
+const eps_sim_state_t* eps_sim_get_state() {
+	return &eps_sim_state;
+}
+
+const eps_sim_adc_scale_t* eps_sim_get_adc_scale(EPS_RAW_TO_ENG_QUANTITY_enum_t quantity) {
+	return (quantity < EPS_RAW_TO_ENG_QUANTITY_COUNT) ? &eps_sim_adc_scale[quantity] : NULL;
+}
+
+uint16_t eps_sim_get_response_len(uint8_t command_code) {
+	switch (command_code) {
+		case 0x40: return 36;
+		case 0x42: return 78;
+		case 0x44: return 8;
+		case 0x50: case 0x52: case 0x54: return 258;
+		case 0x60: case 0x62: case 0x64: return 84;
+		case 0x70: case 0x72: case 0x74: return 72;
+		case 0x82: case 0x84: case 0x86: return 16;
+		case 0xA0: case 0xA2: case 0xA4: return 274;
+		default: return EPS_DEFAULT_RX_LEN_MIN;
+	}
+}
+
+EPS_SIM_ERROR_enum_t eps_sim_next_injected_error() {
+	// Called once per command by the transport. Counts commands and decides whether this one fails.
+	eps_sim_state.cmd_count++;
+	if (eps_sim_config.inject_error == EPS_SIM_ERROR_NONE || eps_sim_config.inject_error_every_n_cmds == 0) {
+		return EPS_SIM_ERROR_NONE;
+	}
+	if (eps_sim_state.cmd_count % eps_sim_config.inject_error_every_n_cmds != 0) {
+		return EPS_SIM_ERROR_NONE;
+	}
+	eps_sim_state.injected_error_count++;
+	return eps_sim_config.inject_error;
+}
+
+
+static uint8_t* eps_sim_find_config_param(uint16_t parameter_id, uint8_t create) {
+	for (uint8_t i = 0; i < eps_sim_state.config_param_count; i++) {
+		if (eps_sim_state.config_param_ids[i] == parameter_id) {
+			return eps_sim_state.config_param_values[i];
+		}
+	}
+	if (!create || eps_sim_state.config_param_count >= EPS_SIM_MAX_CONFIG_PARAMS) {
+		return NULL;
+	}
+	const uint8_t i = eps_sim_state.config_param_count++;
+	eps_sim_state.config_param_ids[i] = parameter_id;
+	memset(eps_sim_state.config_param_values[i], 0, 8);
+	return eps_sim_state.config_param_values[i];
+}
+
+static uint8_t eps_sim_config_param_cmd(const uint8_t cmd_buf[], uint8_t cmd_buf_len, uint8_t rx_buf[]) {
+	// 0x82 get, 0x84 set, 0x86 reset. Response: reserved, PAR_ID, PAR_VAL (8 bytes).
+	const uint8_t CC = cmd_buf[2];
+	if (cmd_buf_len < ((CC == 0x84) ? 14 : 6)) {
+		return EPS_SIM_STAT_PARAM_MISSING;
+	}
+	const uint16_t parameter_id = cmd_buf[4] | (cmd_buf[5] << 8);
+
+	uint8_t *value = eps_sim_find_config_param(parameter_id, 1);
+	if (value == NULL) {
+		return EPS_SIM_STAT_PARAM_INVALID;
+	}
+	if (CC == 0x84) {
+		memcpy(value, &cmd_buf[6], 8);
+		eps_sim_state.config_changed_since_boot = 1;
+	}
+	else if (CC == 0x86) {
+		memset(value, 0, 8);
+		eps_sim_state.config_changed_since_boot = 1;
+	}
+
+	eps_sim_write_u16(rx_buf, 6, parameter_id);
+	memcpy(&rx_buf[8], value, 8);
+	return EPS_SIM_STAT_ACCEPTED;
+}
+
+static void eps_sim_fill_system_status(uint8_t rx_buf[], uint32_t now_ms) {
+	const uint32_t uptime_sec = (now_ms - eps_sim_state.boot_time_ms) / 1000;
+	rx_buf[5] = eps_sim_state.mode;
+	rx_buf[6] = eps_sim_state.config_changed_since_boot;
+	rx_buf[7] = eps_sim_state.reset_cause;
+	eps_sim_write_u32(rx_buf, 8, uptime_sec);
+	eps_sim_write_u16(rx_buf, 12, 0); // error_code
+	eps_sim_write_u16(rx_buf, 14, eps_sim_state.rst_cnt_pwron);
+	eps_sim_write_u16(rx_buf, 16, eps_sim_state.rst_cnt_wdg);
+	eps_sim_write_u16(rx_buf, 18, eps_sim_state.rst_cnt_cmd);
+	eps_sim_write_u16(rx_buf, 20, eps_sim_state.rst_cnt_mcu);
+	eps_sim_write_u16(rx_buf, 22, eps_sim_state.rst_cnt_emlopo);
+	eps_sim_write_u16(rx_buf, 24, (now_ms - eps_sim_state.prev_cmd_time_ms) / 1000);
+	eps_sim_write_u32(rx_buf, 26,
+			eps_sim_state.unix_time_at_boot_sec + uptime_sec + eps_sim_state.time_correction_sec);
+	// calendar fields (30..35) are left as zero
+}
+
+static void eps_sim_fill_pdu_overcurrent_fault_state(uint8_t rx_buf[]) {
+	eps_sim_write_u16(rx_buf, 6, eps_sim_state.stat_ch_on_bitfield);
+	eps_sim_write_u16(rx_buf, 8, eps_sim_state.stat_ch_ext_on_bitfield);
+	// no faults (10..77 stay zero)
+}
+
+static void eps_sim_fill_pdu_housekeeping(uint8_t rx_buf[]) {
+	eps_sim_write_value(rx_buf, 6, 3300, EPS_RAW_TO_ENG_QUANTITY_VOLTAGE); // board supply
+	eps_sim_write_value(rx_buf, 8, 2500, EPS_RAW_TO_ENG_QUANTITY_TEMPERATURE); // MCU temperature
+	eps_sim_write_vip(rx_buf, 10, 8000, eps_sim_total_channel_current_mA());
+	eps_sim_write_u16(rx_buf, 16, eps_sim_state.stat_ch_on_bitfield);
+	eps_sim_write_u16(rx_buf, 18, eps_sim_state.stat_ch_ext_on_bitfield);
+	for (uint8_t domain_num = 0; domain_num < 7; domain_num++) {
+		eps_sim_write_vip(rx_buf, 24 + domain_num * 6, 3300, 50);
+	}
+	for (uint8_t ch_num = 0; ch_num < 32; ch_num++) {
+		eps_sim_write_channel_vip(rx_buf, 66 + ch_num * 6, ch_num);
+	}
+}
+
+static void eps_sim_fill_pbu_housekeeping(uint8_t rx_buf[]) {
+	eps_sim_write_vip(rx_buf, 6, 8000, 500);
+	eps_sim_write_value(rx_buf, 12, 3300, EPS_RAW_TO_ENG_QUANTITY_VOLTAGE); // board supply
+	eps_sim_write_value(rx_buf, 14, 2500, EPS_RAW_TO_ENG_QUANTITY_TEMPERATURE); // MCU temperature
+	for (uint8_t bp_num = 0; bp_num < 3; bp_num++) {
+		eps_sim_write_vip(rx_buf, 18 + (bp_num * 22), 16000, 150);
+		for (uint8_t cell_num = 0; cell_num < 4; cell_num++) {
+			eps_sim_write_value(rx_buf, 26 + (cell_num * 2) + (bp_num * 22), 4000, EPS_RAW_TO_ENG_QUANTITY_VOLTAGE);
+		}
+		for (uint8_t sensor_num = 0; sensor_num < 3; sensor_num++) {
+			eps_sim_write_value(rx_buf, 34 + (sensor_num * 2) + (bp_num * 22), 2000, EPS_RAW_TO_ENG_QUANTITY_TEMPERATURE);
+		}
+	}
+}
+
+static void eps_sim_fill_pcu_housekeeping(uint8_t rx_buf[]) {
+	eps_sim_write_value(rx_buf, 6, 3300, EPS_RAW_TO_ENG_QUANTITY_VOLTAGE); // board supply
+	eps_sim_write_value(rx_buf, 8, 2500, EPS_RAW_TO_ENG_QUANTITY_TEMPERATURE); // MCU temperature
+	eps_sim_write_vip(rx_buf, 10, 16000, 800);
+	for (uint8_t ch_num = 0; ch_num < 4; ch_num++) {
+		eps_sim_write_vip(rx_buf, 16 + ch_num * 14, 16000, 200);
+		eps_sim_write_mppt(rx_buf, 22 + ch_num * 14);
+	}
+}
+
+static void eps_sim_fill_piu_housekeeping(uint8_t rx_buf[]) {
+	// Same byte map as pack_eps_result_piu_housekeeping_data_raw
+	eps_sim_write_value(rx_buf, 6, 3300, EPS_RAW_TO_ENG_QUANTITY_VOLTAGE); // board supply
+	eps_sim_write_value(rx_buf, 8, 2500, EPS_RAW_TO_ENG_QUANTITY_TEMPERATURE); // MCU temperature
+	eps_sim_write_vip(rx_buf, 10, 8000, eps_sim_total_channel_current_mA());
+	eps_sim_write_vip(rx_buf, 16, 16000, 300);
+	eps_sim_write_u16(rx_buf, 22, eps_sim_state.stat_ch_on_bitfield);
+	eps_sim_write_value(rx_buf, 28, 2000, EPS_RAW_TO_ENG_QUANTITY_TEMPERATURE); // battery_temp2
+	eps_sim_write_value(rx_buf, 30, 2000, EPS_RAW_TO_ENG_QUANTITY_TEMPERATURE); // battery_temp3
+	eps_sim_write_value(rx_buf, 32, 3300, EPS_RAW_TO_ENG_QUANTITY_VOLTAGE); // vd0
+	eps_sim_write_value(rx_buf, 34, 5000, EPS_RAW_TO_ENG_QUANTITY_VOLTAGE); // vd1
+	eps_sim_write_value(rx_buf, 36, 12000, EPS_RAW_TO_ENG_QUANTITY_VOLTAGE); // vd2
+
+	for (uint8_t ch_num = 0; ch_num <= 8; ch_num++) {
+		eps_sim_write_channel_vip(rx_buf, 38 + ch_num * 6, ch_num);
+	}
+	for (uint8_t cc_num = 0; cc_num < 3; cc_num++) {
+		eps_sim_write_mppt(rx_buf, 92 + cc_num * 8);
+	}
+	for (uint8_t ch_num = 9; ch_num <= 15; ch_num++) {
+		eps_sim_write_channel_vip(rx_buf, 116 + (ch_num - 9) * 6, ch_num);
+	}
+	for (uint8_t cc_num = 3; cc_num < 5; cc_num++) {
+		eps_sim_write_mppt(rx_buf, 158 + (cc_num - 3) * 8);
+	}
+	eps_sim_write_u16(rx_buf, 174, eps_sim_state.stat_ch_ext_on_bitfield);
+	for (uint8_t ch_num = 16; ch_num <= 31; ch_num++) {
+		eps_sim_write_channel_vip(rx_buf, 178 + (ch_num - 16) * 6, ch_num);
+	}
+}
+
+static uint8_t eps_sim_check_key(const uint8_t cmd_buf[], uint8_t cmd_buf_len, uint8_t key) {
+	if (cmd_buf_len < 5) {
+		return EPS_SIM_STAT_PARAM_MISSING;
+	}
+	return (cmd_buf[4] == key) ? EPS_SIM_STAT_ACCEPTED : EPS_SIM_STAT_PARAM_INVALID;
+}
+
+static uint8_t eps_sim_is_raw_housekeeping(uint8_t CC) {
+	return (CC == 0x50) || (CC == 0x60) || (CC == 0x70) || (CC == 0xA0);
+}
+
+static uint8_t eps_sim_run_cmd(const uint8_t cmd_buf[], uint8_t cmd_buf_len, uint8_t rx_buf[], uint32_t now_ms) {
+	// Returns the STAT value. rx_buf[5..] is already zeroed and large enough for the response.
+	const uint8_t CC = cmd_buf[2];
+	uint8_t stat;
+
+	eps_sim_is_raw_response = eps_sim_is_raw_housekeeping(CC);
+
+	switch (CC) {
+		case 0x02: // no-op
+		case 0x04: // cancel operation
+			return EPS_SIM_STAT_ACCEPTED;
+
+		case 0x06: // watchdog
+			eps_sim_state.watchdog_kick_count++;
+			return EPS_SIM_STAT_ACCEPTED;
+
+		case 0x10: // output bus group on/off/state
+		case 0x12:
+		case 0x14: {
+			if (cmd_buf_len < 8) {
+				return EPS_SIM_STAT_PARAM_MISSING;
+			}
+			const uint16_t CH_BF = cmd_buf[4] | (cmd_buf[5] << 8);
+			const uint16_t CH_EXT_BF = cmd_buf[6] | (cmd_buf[7] << 8);
+			if (CC == 0x10) {
+				eps_sim_state.stat_ch_on_bitfield |= CH_BF;
+				eps_sim_state.stat_ch_ext_on_bitfield |= CH_EXT_BF;
+			}
+			else if (CC == 0x12) {
+				eps_sim_state.stat_ch_on_bitfield &= ~CH_BF;
+				eps_sim_state.stat_ch_ext_on_bitfield &= ~CH_EXT_BF;
+			}
+			else {
+				eps_sim_state.stat_ch_on_bitfield = CH_BF;
+				eps_sim_state.stat_ch_ext_on_bitfield = CH_EXT_BF;
+			}
+			return EPS_SIM_STAT_ACCEPTED;
+		}
+
+		case 0x16: // output bus channel on/off
+		case 0x18: {
+			if (cmd_buf_len < 5) {
+				return EPS_SIM_STAT_PARAM_MISSING;
+			}
+			const uint8_t CH_IDX = cmd_buf[4];
+			if (CH_IDX > 31) {
+				return EPS_SIM_STAT_PARAM_INVALID;
+			}
+			uint16_t *bitfield = (CH_IDX < 16) ?
+					&eps_sim_state.stat_ch_on_bitfield : &eps_sim_state.stat_ch_ext_on_bitfield;
+			const uint16_t mask = 1 << (CH_IDX % 16);
+			if (CC == 0x16) {
+				*bitfield |= mask;
+			}
+			else {
+				*bitfield &= ~mask;
+			}
+			return EPS_SIM_STAT_ACCEPTED;
+		}
+
+		case 0x30: // nominal mode
+			eps_sim_state.mode = 1;
+			return EPS_SIM_STAT_ACCEPTED;
+
+		case 0x32: // safety mode
+			eps_sim_state.mode = 2;
+			return EPS_SIM_STAT_ACCEPTED;
+
+		case 0x40:
+			eps_sim_fill_system_status(rx_buf, now_ms);
+			return EPS_SIM_STAT_ACCEPTED;
+
+		case 0x42:
+			eps_sim_fill_pdu_overcurrent_fault_state(rx_buf);
+			return EPS_SIM_STAT_ACCEPTED;
+
+		case 0x44: // ABF placed state; both pins applied
+			rx_buf[6] = EPS_ABF_PIN_APPLIED;
+			rx_buf[7] = EPS_ABF_PIN_APPLIED;
+			return EPS_SIM_STAT_ACCEPTED;
+
+		case 0x50: case 0x52: case 0x54:
+			eps_sim_fill_pdu_housekeeping(rx_buf);
+			return EPS_SIM_STAT_ACCEPTED;
+
+		case 0x60: case 0x62: case 0x64:
+			eps_sim_fill_pbu_housekeeping(rx_buf);
+			return EPS_SIM_STAT_ACCEPTED;
+
+		case 0x70: case 0x72: case 0x74:
+			eps_sim_fill_pcu_housekeeping(rx_buf);
+			return EPS_SIM_STAT_ACCEPTED;
+
+		case 0x82: case 0x84: case 0x86:
+			return eps_sim_config_param_cmd(cmd_buf, cmd_buf_len, rx_buf);
+
+		case 0x90: // reset configuration
+			stat = eps_sim_check_key(cmd_buf, cmd_buf_len, 0x87);
+			if (stat == EPS_SIM_STAT_ACCEPTED) {
+				eps_sim_state.config_param_count = 0;
+				eps_sim_state.config_changed_since_boot = 1;
+			}
+			return stat;
+
+		case 0x92: // load configuration
+			stat = eps_sim_check_key(cmd_buf, cmd_buf_len, 0xA7);
+			if (stat == EPS_SIM_STAT_ACCEPTED) {
+				eps_sim_state.config_changed_since_boot = 0;
+			}
+			return stat;
+
+		case 0x94: // save configuration
+			return eps_sim_check_key(cmd_buf, cmd_buf_len, 0xA7);
+
+		case 0xA0: case 0xA2: case 0xA4:
+			eps_sim_fill_piu_housekeeping(rx_buf);
+			return EPS_SIM_STAT_ACCEPTED;
+
+		case 0xAA: // system reset; the response is sent before the reset
+			stat = eps_sim_check_key(cmd_buf, cmd_buf_len, 0xA6);
+			if (stat == EPS_SIM_STAT_ACCEPTED) {
+				eps_sim_state.rst_cnt_cmd++;
+				eps_sim_boot(now_ms, 2);
+			}
+			return stat;
+
+		case 0xC4: // correct time
+			if (cmd_buf_len < 8) {
+				return EPS_SIM_STAT_PARAM_MISSING;
+			}
+			eps_sim_state.time_correction_sec += (int32_t)(
+					cmd_buf[4] | (cmd_buf[5] << 8) | (cmd_buf[6] << 16) | ((uint32_t)cmd_buf[7] << 24));
+			return EPS_SIM_STAT_ACCEPTED;
+
+		case 0xC6: // zero reset cause counters
+			stat = eps_sim_check_key(cmd_buf, cmd_buf_len, 0xA7);
+			if (stat == EPS_SIM_STAT_ACCEPTED) {
+				eps_sim_state.rst_cnt_pwron = 0;
+				eps_sim_state.rst_cnt_wdg = 0;
+				eps_sim_state.rst_cnt_cmd = 0;
+				eps_sim_state.rst_cnt_mcu = 0;
+				eps_sim_state.rst_cnt_emlopo = 0;
+			}
+			return stat;
+
+		default:
+			return EPS_SIM_STAT_INVALID_CC;
+	}
+}
+
+uint8_t eps_sim_process_cmd(
+		const uint8_t cmd_buf[], uint8_t cmd_buf_len,
+		uint8_t rx_buf[], uint16_t rx_buf_len,
+		uint32_t now_ms) {
+	// Writes the response to rx_buf (rx_buf_len bytes; extra bytes are zero, missing ones are cut).
+	// Returns the STAT value that was written.
+	if (!eps_sim_is_initialized) {
+		eps_sim_reset(now_ms);
+	}
+
+	uint8_t response[274]; // largest response
+	memset(response, 0, sizeof(response));
+
+	uint8_t stat;
+	if (cmd_buf_len < 4) {
+		stat = EPS_SIM_STAT_PARAM_MISSING;
+	}
+	else if (cmd_buf[0] != EPS_COMMAND_STID || cmd_buf[1] != EPS_COMMAND_IVID || cmd_buf[3] != EPS_COMMAND_BID) {
+		stat = EPS_SIM_STAT_INVALID_SYSTEM;
+	}
+	else {
+		stat = eps_sim_run_cmd(cmd_buf, cmd_buf_len, response, now_ms);
+	}
+
+	if (stat == EPS_SIM_STAT_ACCEPTED && eps_sim_state.new_flag_pending) {
+		stat = EPS_SIM_STAT_NEW_FLAG;
+		eps_sim_state.new_flag_pending = 0;
+	}
+
+	response[0] = EPS_COMMAND_STID;
+	response[1] = EPS_COMMAND_IVID;
+	response[2] = (cmd_buf_len >= 3) ? cmd_buf[2] + 1 : 0; // RC = CC + 1
+	response[3] = EPS_COMMAND_BID;
+	response[4] = stat;
+
+	if (rx_buf_len <= sizeof(response)) {
+		memcpy(rx_buf, response, rx_buf_len);
+	}
+	else {
+		memcpy(rx_buf, response, sizeof(response));
+		memset(&rx_buf[sizeof(response)], 0, rx_buf_len - sizeof(response));
+	}
+	eps_sim_state.prev_cmd_time_ms = now_ms;
+	return stat;
+}
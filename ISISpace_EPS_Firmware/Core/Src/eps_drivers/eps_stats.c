@@ -0,0 +1,117 @@
+#include "eps_drivers/eps_stats.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+
+uint8_t eps_stats_init(eps_stats_t *stats, uint8_t window_len, uint8_t ewma_shift) {
+	if (window_len == 0 || window_len > stats->max_window_len || ewma_shift > 15) {
+		return 1;
+	}
+	stats->window_len = window_len;
+	stats->ewma_shift = ewma_shift;
+	stats->head = 0;
+	stats->fill = 0;
+	stats->sample_count = 0;
+	memset(stats->window_sum, 0, stats->series_count * sizeof(int32_t));
+	memset(stats->ewma_q8, 0, stats->series_count * sizeof(int32_t));
+	return 0;
+}
+
+void eps_stats_update(eps_stats_t *stats, const int16_t sample[]) {
+	const uint16_t series_count = stats->series_count;
+	int16_t *row = &stats->window[stats->head * series_count];
+	int32_t *window_sum = stats->window_sum;
+	int32_t *ewma_q8 = stats->ewma_q8;
+
+	// Window: the new sample replaces the oldest one (once the window is full)
+	if (stats->fill == stats->window_len) {
+		for (uint16_t i = 0; i < series_count; i++) {
+			window_sum[i] += sample[i] - row[i];
+		}
+	}
+	else {
+		for (uint16_t i = 0; i < series_count; i++) {
+			window_sum[i] += sample[i];
+		}
+		stats->fill++;
+	}
+	memcpy(row, sample, series_count * sizeof(int16_t));
+	stats->head = (stats->head + 1 == stats->window_len) ? 0 : stats->head + 1;
+
+	// EWMA, starting from the first sample
+	if (stats->sample_count == 0) {
+		for (uint16_t i = 0; i < series_count; i++) {
+			ewma_q8[i] = (int32_t) sample[i] * (1 << EPS_STATS_EWMA_FRAC_BITS);
+		}
+	}
+	else {
+		const uint8_t shift = stats->ewma_shift;
+		for (uint16_t i = 0; i < series_count; i++) {
+			ewma_q8[i] += ((int32_t) sample[i] * (1 << EPS_STATS_EWMA_FRAC_BITS) - ewma_q8[i]) >> shift;
+		}
+	}
+	stats->sample_count++;
+}
+
+static int32_t eps_stats_div_round(int32_t numerator, int32_t denominator) {
+	return (numerator >= 0) ? (numerator + denominator / 2) / denominator : (numerator - denominator / 2) / denominator;
+}
+
+void eps_stats_get_mean(const eps_stats_t *stats, int16_t mean_dest[]) {
+	if (stats->fill == 0) {
+		memset(mean_dest, 0, stats->series_count * sizeof(int16_t));
+		return;
+	}
+	for (uint16_t i = 0; i < stats->series_count; i++) {
+		mean_dest[i] = (int16_t) eps_stats_div_round(stats->window_sum[i], stats->fill);
+	}
+}
+
+void eps_stats_get_ewma(const eps_stats_t *stats, int16_t ewma_dest[]) {
+	for (uint16_t i = 0; i < stats->series_count; i++) {
+		ewma_dest[i] = (int16_t)((stats->ewma_q8[i] + (1 << (EPS_STATS_EWMA_FRAC_BITS - 1))) >> EPS_STATS_EWMA_FRAC_BITS);
+	}
+}
+
+void eps_stats_get_min_max(const eps_stats_t *stats, int16_t min_dest[], int16_t max_dest[]) {
+	const uint16_t series_count = stats->series_count;
+	if (stats->fill == 0) {
+		memset(min_dest, 0, series_count * sizeof(int16_t));
+		memset(max_dest, 0, series_count * sizeof(int16_t));
+		return;
+	}
+	memcpy(min_dest, stats->window, series_count * sizeof(int16_t));
+	memcpy(max_dest, stats->window, series_count * sizeof(int16_t));
+	for (uint8_t row_idx = 1; row_idx < stats->fill; row_idx++) {
+		const int16_t *row = &stats->window[row_idx * series_count];
+		for (uint16_t i = 0; i < series_count; i++) {
+			min_dest[i] = (row[i] < min_dest[i]) ? row[i] : min_dest[i];
+			max_dest[i] = (row[i] > max_dest[i]) ? row[i] : max_dest[i];
+		}
+	}
+}
+
+void eps_stats_get_variance(const eps_stats_t *stats, uint32_t variance_dest[]) {
+	// n * sum(x^2) - sum(x)^2, over n^2. Squares are at most 2^30, so 16 of them fit in an int64.
+	const uint16_t series_count = stats->series_count;
+	const int64_t n = stats->fill;
+	for (uint16_t i = 0; i < series_count; i++) {
+		int64_t sum_squares = 0;
+		for (uint8_t row_idx = 0; row_idx < stats->fill; row_idx++) {
+			const int32_t value = stats->window[row_idx * series_count + i];
+			sum_squares += value * value;
+		}
+		const int64_t sum = stats->window_sum[i];
+		variance_dest[i] = (n == 0) ? 0 : (uint32_t)((n * sum_squares - sum * sum) / (n * n));
+	}
+}
+
+const int16_t* eps_stats_get_latest(const eps_stats_t *stats) {
+	if (stats->fill == 0) {
+		return NULL;
+	}
+	const uint8_t latest_row = (stats->head == 0) ? stats->window_len - 1 : stats->head - 1;
+	return &stats->window[latest_row * stats->series_count];
+}
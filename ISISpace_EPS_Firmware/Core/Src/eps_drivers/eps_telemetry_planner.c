@@ -0,0 +1,286 @@
+#include "eps_drivers/eps_telemetry_planner.h"
+#include "eps_drivers/eps_cmd_table.h"
+#include "eps_drivers/eps_types.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#define FIELD(name) EPS_TELEMETRY_FIELD_BIT(EPS_TELEMETRY_FIELD_##name)
+
+typedef union {
+	eps_result_system_status_t system_status;
+	eps_result_pdu_overcurrent_fault_state_t pdu_overcurrent_fault_state;
+	eps_result_pdu_housekeeping_data_eng_t pdu_hk;
+	eps_result_pbu_housekeeping_data_eng_t pbu_hk;
+	eps_result_pcu_housekeeping_data_eng_t pcu_hk;
+	eps_result_piu_housekeeping_data_eng_t piu_hk;
+} eps_telemetry_result_t;
+
+// Copies the fields in field_mask (all provided by the command) from its result into the snapshot
+typedef void (*eps_telemetry_fill_t)(const eps_telemetry_result_t *result, uint32_t field_mask, eps_telemetry_snapshot_t *snapshot);
+
+typedef struct {
+	EPS_CMD_ID_enum_t cmd_id;
+	uint32_t field_mask; // fields this command provides
+	eps_telemetry_fill_t fill;
+} eps_telemetry_source_t;
+
+
+static void eps_telemetry_fill_system_status(const eps_telemetry_result_t *result, uint32_t field_mask, eps_telemetry_snapshot_t *snapshot) {
+	(void) field_mask; // the only field
+	snapshot->system_status = result->system_status;
+}
+
+static void eps_telemetry_fill_pdu_overcurrent_fault_state(const eps_telemetry_result_t *result, uint32_t field_mask, eps_telemetry_snapshot_t *snapshot) {
+	const eps_result_pdu_overcurrent_fault_state_t *ocf = &result->pdu_overcurrent_fault_state;
+	if (field_mask & FIELD(CH_ON)) {
+		snapshot->stat_ch_on_bitfield = ocf->stat_ch_on_bitfield;
+		snapshot->stat_ch_ext_on_bitfield = ocf->stat_ch_ext_on_bitfield;
+	}
+	if (field_mask & FIELD(CH_OVERCURRENT_FAULT)) {
+		snapshot->stat_ch_overcurrent_fault_bitfield = ocf->stat_ch_overcurrent_fault_bitfield;
+		snapshot->stat_ch_ext_overcurrent_fault_bitfield = ocf->stat_ch_ext_overcurrent_fault_bitfield;
+	}
+}
+
+static void eps_telemetry_fill_pdu_hk(const eps_telemetry_result_t *result, uint32_t field_mask, eps_telemetry_snapshot_t *snapshot) {
+	const eps_result_pdu_housekeeping_data_eng_t *hk = &result->pdu_hk;
+	if (field_mask & FIELD(CH_ON)) {
+		snapshot->stat_ch_on_bitfield = hk->stat_ch_on_bitfield;
+		snapshot->stat_ch_ext_on_bitfield = hk->stat_ch_ext_on_bitfield;
+	}
+	if (field_mask & FIELD(CH_OVERCURRENT_FAULT)) {
+		snapshot->stat_ch_overcurrent_fault_bitfield = hk->stat_ch_overcurrent_fault_bitfield;
+		snapshot->stat_ch_ext_overcurrent_fault_bitfield = hk->stat_ch_ext_overcurrent_fault_bitfield;
+	}
+	if (field_mask & FIELD(CH_VIPD)) {
+		memcpy(snapshot->vip_each_channel, hk->vip_each_channel, sizeof(snapshot->vip_each_channel));
+	}
+}
+
+static void eps_telemetry_fill_pbu_hk(const eps_telemetry_result_t *result, uint32_t field_mask, eps_telemetry_snapshot_t *snapshot) {
+	const eps_result_pbu_housekeeping_data_eng_t *hk = &result->pbu_hk;
+	if (field_mask & FIELD(BATTERY_STATUS)) {
+		snapshot->battery_status_bitfield = hk->battery_pack_status_bitfield;
+	}
+	if (field_mask & FIELD(BATTERY_PACKS)) {
+		memcpy(snapshot->battery_pack_info_each_pack, hk->battery_pack_info_each_pack, sizeof(snapshot->battery_pack_info_each_pack));
+	}
+	if (field_mask & FIELD(BATTERY_TEMPS)) {
+		snapshot->battery_temp_count = 9;
+		for (uint8_t bp = 0; bp < 3; bp++) {
+			memcpy(&snapshot->battery_temp_each_sensor_cC[bp * 3], hk->battery_pack_info_each_pack[bp].battery_temperature_each_sensor_cC,
+					sizeof(hk->battery_pack_info_each_pack[bp].battery_temperature_each_sensor_cC));
+		}
+	}
+}
+
+static void eps_telemetry_fill_pcu_hk(const eps_telemetry_result_t *result, uint32_t field_mask, eps_telemetry_snapshot_t *snapshot) {
+	const eps_result_pcu_housekeeping_data_eng_t *hk = &result->pcu_hk;
+	for (uint8_t cc = 0; cc < 4; cc++) {
+		const eps_conditioning_channel_datatype_eng_t *src = &hk->conditioning_channel_info_each_channel[cc];
+		if (field_mask & FIELD(CC_MPPT)) {
+			eps_conditioning_channel_short_datatype_eng_t *dest = &snapshot->cc_mppt_each_channel[cc];
+			dest->volt_in_mppt_mV = src->volt_in_mppt_mV;
+			dest->curr_in_mppt_mA = src->curr_in_mppt_mA;
+			dest->volt_ou_mppt_mV = src->volt_ou_mppt_mV;
+			dest->curr_ou_mppt_mA = src->curr_ou_mppt_mA;
+		}
+		if (field_mask & FIELD(CC_OUTPUT_VIPD)) {
+			snapshot->vip_cc_output_each_channel[cc] = src->vip_cc_output;
+		}
+	}
+	if (field_mask & FIELD(CC_MPPT)) {
+		snapshot->cc_count = 4;
+		memset(&snapshot->cc_mppt_each_channel[4], 0, sizeof(snapshot->cc_mppt_each_channel[4]));
+	}
+}
+
+static void eps_telemetry_fill_piu_hk(const eps_telemetry_result_t *result, uint32_t field_mask, eps_telemetry_snapshot_t *snapshot) {
+	const eps_result_piu_housekeeping_data_eng_t *hk = &result->piu_hk;
+	if (field_mask & FIELD(CH_ON)) {
+		snapshot->stat_ch_on_bitfield = hk->stat_ch_on_bitfield;
+		snapshot->stat_ch_ext_on_bitfield = hk->stat_ch_ext_on_bitfield;
+	}
+	if (field_mask & FIELD(CH_OVERCURRENT_FAULT)) {
+		snapshot->stat_ch_overcurrent_fault_bitfield = hk->stat_ch_overcurrent_fault_bitfield;
+		snapshot->stat_ch_ext_overcurrent_fault_bitfield = hk->stat_ch_ext_overcurrent_fault_bitfield;
+	}
+	if (field_mask & FIELD(CH_VIPD)) {
+		memcpy(snapshot->vip_each_channel, hk->vip_each_channel, sizeof(snapshot->vip_each_channel));
+	}
+	if (field_mask & FIELD(CC_MPPT)) {
+		snapshot->cc_count = 5;
+		memcpy(snapshot->cc_mppt_each_channel, hk->conditioning_channel_info_each_channel, sizeof(snapshot->cc_mppt_each_channel));
+	}
+	if (field_mask & FIELD(BATTERY_STATUS)) {
+		snapshot->battery_status_bitfield = hk->battery_status_bitfield;
+	}
+	if (field_mask & FIELD(BATTERY_TEMPS)) {
+		snapshot->battery_temp_count = 2;
+		memset(snapshot->battery_temp_each_sensor_cC, 0, sizeof(snapshot->battery_temp_each_sensor_cC));
+		snapshot->battery_temp_each_sensor_cC[0] = (int16_t) hk->battery_temp2_cC;
+		snapshot->battery_temp_each_sensor_cC[1] = (int16_t) hk->battery_temp3_cC;
+	}
+}
+
+// Where each field can come from. When a plan has several commands with the same field, the
+// first one in this table fills it.
+static const eps_telemetry_source_t eps_telemetry_sources[] = {
+	{ EPS_CMD_ID_GET_SYSTEM_STATUS, FIELD(SYSTEM_STATUS), eps_telemetry_fill_system_status },
+	{ EPS_CMD_ID_GET_PDU_OVERCURRENT_FAULT_STATE, FIELD(CH_ON) | FIELD(CH_OVERCURRENT_FAULT),
+			eps_telemetry_fill_pdu_overcurrent_fault_state },
+	{ EPS_CMD_ID_GET_PDU_HOUSEKEEPING_DATA_ENG, FIELD(CH_ON) | FIELD(CH_OVERCURRENT_FAULT) | FIELD(CH_VIPD),
+			eps_telemetry_fill_pdu_hk },
+	{ EPS_CMD_ID_GET_PBU_HOUSEKEEPING_DATA_ENG, FIELD(BATTERY_STATUS) | FIELD(BATTERY_PACKS) | FIELD(BATTERY_TEMPS),
+			eps_telemetry_fill_pbu_hk },
+	{ EPS_CMD_ID_GET_PCU_HOUSEKEEPING_DATA_ENG, FIELD(CC_MPPT) | FIELD(CC_OUTPUT_VIPD), eps_telemetry_fill_pcu_hk },
+	{ EPS_CMD_ID_GET_PIU_HOUSEKEEPING_DATA_ENG,
+			FIELD(CH_ON) | FIELD(CH_OVERCURRENT_FAULT) | FIELD(CH_VIPD) | FIELD(CC_MPPT) | FIELD(BATTERY_STATUS)
+					| FIELD(BATTERY_TEMPS),
+			eps_telemetry_fill_piu_hk },
+};
+
+#define EPS_TELEMETRY_SOURCE_COUNT (sizeof(eps_telemetry_sources) / sizeof(eps_telemetry_source_t))
+
+_Static_assert(EPS_TELEMETRY_SOURCE_COUNT <= EPS_TELEMETRY_MAX_PLAN_CMDS, "raise EPS_TELEMETRY_MAX_PLAN_CMDS");
+_Static_assert(EPS_TELEMETRY_FIELD_COUNT <= 32, "field masks are 32 bits");
+
+#define EPS_TELEMETRY_FIELD_NAME_ENTRY(id, name) name,
+static const char *const eps_telemetry_field_names[EPS_TELEMETRY_FIELD_COUNT] = {
+	EPS_TELEMETRY_FIELDS(EPS_TELEMETRY_FIELD_NAME_ENTRY)
+};
+
+
+static uint16_t eps_telemetry_source_rx_len(uint8_t source_idx) {
+	return eps_cmd_table[eps_telemetry_sources[source_idx].cmd_id].rx_len;
+}
+
+static uint16_t eps_telemetry_naive_rx_bytes(uint32_t field_mask) {
+	// The smallest command for each field, each command counted once
+	uint32_t source_set = 0;
+	for (uint8_t field = 0; field < EPS_TELEMETRY_FIELD_COUNT; field++) {
+		if (!(field_mask & EPS_TELEMETRY_FIELD_BIT(field))) {
+			continue;
+		}
+		uint8_t best_source = 0xFF;
+		for (uint8_t source = 0; source < EPS_TELEMETRY_SOURCE_COUNT; source++) {
+			if ((eps_telemetry_sources[source].field_mask & EPS_TELEMETRY_FIELD_BIT(field))
+					&& (best_source == 0xFF || eps_telemetry_source_rx_len(source) < eps_telemetry_source_rx_len(best_source))) {
+				best_source = source;
+			}
+		}
+		source_set |= 1UL << best_source;
+	}
+
+	uint16_t rx_bytes = 0;
+	for (uint8_t source = 0; source < EPS_TELEMETRY_SOURCE_COUNT; source++) {
+		if (source_set & (1UL << source)) {
+			rx_bytes += eps_telemetry_source_rx_len(source);
+		}
+	}
+	return rx_bytes;
+}
+
+uint8_t eps_telemetry_plan(uint32_t field_mask, eps_telemetry_plan_t *plan_dest) {
+	if (field_mask == 0 || (field_mask & ~EPS_TELEMETRY_ALL_FIELDS) != 0 || plan_dest == NULL) {
+		return 1;
+	}
+
+	// Every subset of the sources: at most 2^EPS_TELEMETRY_MAX_PLAN_CMDS = 256 of them
+	uint32_t best_set = 0;
+	uint16_t best_rx_bytes = 0xFFFF;
+	uint8_t best_cmd_count = 0xFF;
+	for (uint32_t source_set = 1; source_set < (1UL << EPS_TELEMETRY_SOURCE_COUNT); source_set++) {
+		uint32_t covered_mask = 0;
+		uint16_t rx_bytes = 0;
+		uint8_t cmd_count = 0;
+		for (uint8_t source = 0; source < EPS_TELEMETRY_SOURCE_COUNT; source++) {
+			if (source_set & (1UL << source)) {
+				covered_mask |= eps_telemetry_sources[source].field_mask;
+				rx_bytes += eps_telemetry_source_rx_len(source);
+				cmd_count++;
+			}
+		}
+		if ((covered_mask & field_mask) != field_mask) {
+			continue;
+		}
+		// fewest bytes, then fewest commands
+		if (rx_bytes < best_rx_bytes || (rx_bytes == best_rx_bytes && cmd_count < best_cmd_count)) {
+			best_set = source_set;
+			best_rx_bytes = rx_bytes;
+			best_cmd_count = cmd_count;
+		}
+	}
+	if (best_set == 0) {
+		return 1; // unreachable while every field has a source
+	}
+
+	plan_dest->field_mask = field_mask;
+	plan_dest->cmd_count = 0;
+	for (uint8_t source = 0; source < EPS_TELEMETRY_SOURCE_COUNT; source++) {
+		if (best_set & (1UL << source)) {
+			plan_dest->cmd_ids[plan_dest->cmd_count++] = eps_telemetry_sources[source].cmd_id;
+		}
+	}
+	plan_dest->rx_bytes = best_rx_bytes;
+	plan_dest->naive_rx_bytes = eps_telemetry_naive_rx_bytes(field_mask);
+	return 0;
+}
+
+static const eps_telemetry_source_t* eps_telemetry_find_source(EPS_CMD_ID_enum_t cmd_id) {
+	for (uint8_t source = 0; source < EPS_TELEMETRY_SOURCE_COUNT; source++) {
+		if (eps_telemetry_sources[source].cmd_id == cmd_id) {
+			return &eps_telemetry_sources[source];
+		}
+	}
+	return NULL;
+}
+
+uint8_t eps_telemetry_execute(const eps_telemetry_plan_t *plan, eps_telemetry_snapshot_t *snapshot_dest) {
+	if (plan == NULL || snapshot_dest == NULL) {
+		return 1;
+	}
+	snapshot_dest->valid_field_mask = 0;
+
+	// Commands are in eps_telemetry_sources order, so the first source of each field fills it
+	uint32_t remaining_mask = plan->field_mask;
+	uint8_t first_error = 0;
+	eps_telemetry_result_t result;
+	for (uint8_t i = 0; i < plan->cmd_count; i++) {
+		const eps_telemetry_source_t *source = eps_telemetry_find_source(plan->cmd_ids[i]);
+		if (source == NULL) {
+			return 1;
+		}
+		const uint32_t fill_mask = source->field_mask & remaining_mask;
+		if (fill_mask == 0) {
+			continue;
+		}
+
+		const uint8_t cmd_result = eps_cmd_execute(source->cmd_id, 0, &result);
+		if (cmd_result != 0) {
+			if (first_error == 0) {
+				first_error = cmd_result;
+			}
+			continue; // a later command may still have these fields
+		}
+		source->fill(&result, fill_mask, snapshot_dest);
+		snapshot_dest->valid_field_mask |= fill_mask;
+		remaining_mask &= ~fill_mask;
+	}
+	return first_error;
+}
+
+uint8_t eps_telemetry_get(uint32_t field_mask, eps_telemetry_snapshot_t *snapshot_dest) {
+	eps_telemetry_plan_t plan;
+	const uint8_t plan_result = eps_telemetry_plan(field_mask, &plan);
+	if (plan_result != 0) {
+		return plan_result;
+	}
+	return eps_telemetry_execute(&plan, snapshot_dest);
+}
+
+const char* eps_telemetry_field_name(EPS_TELEMETRY_FIELD_enum_t field) {
+	return (field < EPS_TELEMETRY_FIELD_COUNT) ? eps_telemetry_field_names[field] : "?";
+}
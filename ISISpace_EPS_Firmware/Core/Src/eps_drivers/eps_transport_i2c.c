@@ -0,0 +1,83 @@
+#include "main.h"
+
+#include "debug_tools/debug_log.h"
+#include "eps_drivers/eps_i2c_poll_engine.h"
+#include "eps_drivers/eps_internal_drivers.h"
+#include "eps_drivers/eps_latency_model.h"
+#include "eps_drivers/eps_transport.h"
+#include "stm_drivers/timing_helpers.h"
+
+#include <stdint.h>
+
+// Thin wrapper around the I2C poll engine (see eps_i2c_poll_engine.h). The poll timing is picked
+// per command code by the latency model (see eps_latency_model.h), which learns from each response.
+
+static uint8_t eps_i2c_current_CC = 0;
+
+static uint8_t eps_i2c_send(const uint8_t cmd_buf[], uint8_t cmd_buf_len, uint8_t rx_buf[], uint16_t rx_buf_len) {
+	eps_i2c_current_CC = (cmd_buf_len > 2) ? cmd_buf[2] : 0;
+	eps_poll_timing_t timing;
+	eps_latency_model_get_timing(eps_i2c_current_CC, rx_buf_len, &timing);
+
+	if (eps_i2c_poll_engine_start(&hi2c1, cmd_buf, cmd_buf_len, rx_buf, rx_buf_len, &timing) != 0) {
+		DEBUG_LOG_ERROR(DEBUG_LOG_MODULE_TRANSPORT, DEBUG_LOG_ID_EPS_I2C_TX_START_FAILED);
+		return 2;
+	}
+	return 0;
+}
+
+static uint8_t eps_i2c_poll() {
+	return !eps_i2c_poll_engine_is_busy();
+}
+
+static uint8_t eps_i2c_receive() {
+	const eps_i2c_poll_engine_t *engine = eps_i2c_poll_engine_get();
+	if (engine->result_code == 2) {
+		DEBUG_LOG_ERROR(DEBUG_LOG_MODULE_TRANSPORT, DEBUG_LOG_ID_EPS_I2C_TX_FAILED, engine->hal_i2c_error);
+		return 2;
+	}
+	if (engine->result_code == 3) {
+		// this is a bad an unexpected error; return "there's a problem"
+		// TODO: consider making this a retry case as well, as it happens randomly sometimes
+		DEBUG_LOG_ERROR(DEBUG_LOG_MODULE_TRANSPORT, DEBUG_LOG_ID_EPS_I2C_RX_FAILED, engine->hal_i2c_error);
+		return 3;
+	}
+	if (engine->result_code == 4) {
+		eps_latency_model_record_timeout(eps_i2c_current_CC);
+		DEBUG_LOG_WARN(DEBUG_LOG_MODULE_TRANSPORT, DEBUG_LOG_ID_EPS_I2C_RX_TIMEOUT, engine->rx_retry_count);
+		return 4;
+	}
+
+	eps_latency_model_record_ready(eps_i2c_current_CC, engine->timing.first_poll_delay_ms,
+			engine->last_not_ready_ms, engine->ready_ms);
+	DEBUG_LOG_TRACE(DEBUG_LOG_MODULE_TRANSPORT, DEBUG_LOG_ID_EPS_I2C_RX_SUCCESS, engine->rx_retry_count);
+	return 0;
+}
+
+static void eps_i2c_wait_for_event() {
+	// Sleep until the next I2C/DMA interrupt, or until the poll engine's next poll (see
+	// eps_latency_model.h for the spacing), without the 1 ms SysTick wake-ups in between.
+	// Masked, so a callback that runs between eps_i2c_poll() and here can't leave the wake time stale.
+	__disable_irq();
+	low_power_wait_until_ms(eps_i2c_poll_engine_get_next_service_ms(), LOW_POWER_MODE_SLEEP_TICKLESS);
+	__enable_irq();
+}
+
+static uint16_t eps_i2c_get_retry_count() {
+	return eps_i2c_poll_engine_get()->rx_retry_count;
+}
+
+const eps_transport_t eps_transport_i2c = {
+	.name = "i2c",
+	.send = eps_i2c_send,
+	.poll = eps_i2c_poll,
+	.receive = eps_i2c_receive,
+	.now_ms = get_uptime_ms,
+	.wait_for_event = eps_i2c_wait_for_event,
+	.get_retry_count = eps_i2c_get_retry_count,
+};
+
+
+uint8_t eps_send_cmd_get_response_i2c(const uint8_t cmd_buf[], uint8_t cmd_buf_len, uint8_t rx_buf[], uint16_t rx_buf_len) {
+	return eps_send_cmd_get_response_via_transport(&eps_transport_i2c, cmd_buf, cmd_buf_len, rx_buf, rx_buf_len);
+}
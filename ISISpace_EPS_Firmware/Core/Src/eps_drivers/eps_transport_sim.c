@@ -0,0 +1,74 @@
+#include "eps_drivers/eps_internal_drivers.h"
+#include "eps_drivers/eps_sim.h"
+#include "eps_drivers/eps_transport.h"
+
+#ifdef EPS_HOST_BUILD
+#include <time.h>
+#else
+#include "stm_drivers/timing_helpers.h"
+#endif
+
+#include <stdint.h>
+
+// Transport that answers from the software EPS model (see eps_sim.h), with the latency and
+// errors set by eps_sim_configure().
+
+static uint32_t eps_sim_ready_time_ms = 0;
+static uint8_t eps_sim_result_code = 0;
+
+static uint32_t eps_sim_now_ms() {
+#ifdef EPS_HOST_BUILD
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint32_t)(ts.tv_sec * 1000) + (uint32_t)(ts.tv_nsec / 1000000);
+#else
+	return get_uptime_ms();
+#endif
+}
+
+static uint8_t eps_sim_send(const uint8_t cmd_buf[], uint8_t cmd_buf_len, uint8_t rx_buf[], uint16_t rx_buf_len) {
+	const uint32_t now_ms = eps_sim_now_ms();
+	const EPS_SIM_ERROR_enum_t injected_error = eps_sim_next_injected_error();
+
+	if (injected_error == EPS_SIM_ERROR_TX) {
+		return 2;
+	}
+
+	// The model answers right away; the response is only "seen" once the latency has passed.
+	eps_sim_process_cmd(cmd_buf, cmd_buf_len, rx_buf, rx_buf_len, now_ms);
+
+	const eps_sim_config_t *config = eps_sim_get_config();
+	eps_sim_ready_time_ms = now_ms + config->response_latency_ms
+			+ (config->per_byte_latency_us * rx_buf_len) / 1000;
+	eps_sim_result_code = 0;
+
+	if (injected_error == EPS_SIM_ERROR_RX) {
+		eps_sim_result_code = 3;
+	}
+	else if (injected_error == EPS_SIM_ERROR_TIMEOUT) {
+		// no response; fail once the driver would have given up
+		eps_sim_ready_time_ms = now_ms + EPS_MAX_RESPONSE_POLL_TIME_MS;
+		eps_sim_result_code = 4;
+	}
+	else if (injected_error == EPS_SIM_ERROR_STAT) {
+		rx_buf[4] = EPS_SIM_STAT_INTERNAL_ERROR;
+	}
+	return 0;
+}
+
+static uint8_t eps_sim_poll() {
+	return (int32_t)(eps_sim_now_ms() - eps_sim_ready_time_ms) >= 0;
+}
+
+static uint8_t eps_sim_receive() {
+	return eps_sim_result_code;
+}
+
+const eps_transport_t eps_transport_sim = {
+	.name = "sim",
+	.send = eps_sim_send,
+	.poll = eps_sim_poll,
+	.receive = eps_sim_receive,
+	.now_ms = eps_sim_now_ms,
+	.wait_for_event = NULL,
+};
@@ -0,0 +1,135 @@
+#include "main.h"
+
+#include "debug_tools/debug_log.h"
+#include "eps_drivers/eps_internal_drivers.h"
+#include "eps_drivers/eps_rsp_framer.h"
+#include "eps_drivers/eps_transport.h"
+#include "stm_drivers/timing_helpers.h"
+#include "stm_drivers/uart_rx_dma.h"
+
+#include <stdint.h>
+#include <string.h>
+
+// UART4 reception runs continuously into this circular buffer (see eps_start_uart_rx_dma).
+// Must be larger than the largest response with tags (274 + 11 bytes).
+static uint8_t eps_uart_rx_dma_buf[EPS_UART_RX_DMA_BUF_LEN];
+static uart_rx_dma_t eps_uart_rx_dma;
+static eps_rsp_framer_t eps_uart_rsp_framer;
+
+// "<cmd>ACTUAL COMMAND BYTES</cmd>"; static, as it's sent with HAL_UART_Transmit_IT
+static uint8_t eps_uart_cmd_buf_with_tags[EPS_UART_CMD_BUF_WITH_TAGS_MAX_LEN];
+
+static uint32_t eps_uart_start_rx_time_ms = 0;
+static volatile uint8_t eps_uart_is_waiting = 0; // between eps_uart_send() and the end of eps_uart_poll()
+static uint32_t eps_uart_dropped_byte_count_before = 0;
+static uint8_t eps_uart_result_code = 0;
+
+
+uint8_t eps_start_uart_rx_dma() {
+	eps_rsp_framer_init(&eps_uart_rsp_framer);
+	return uart_rx_dma_start(&eps_uart_rx_dma, &huart4, eps_uart_rx_dma_buf, EPS_UART_RX_DMA_BUF_LEN);
+}
+
+const eps_rsp_framer_t* eps_get_uart_rsp_framer() {
+	// for reading the framer counters (dropped bytes, malformed frames)
+	return &eps_uart_rsp_framer;
+}
+
+static uint8_t eps_uart_send(const uint8_t cmd_buf[], uint8_t cmd_buf_len, uint8_t rx_buf[], uint16_t rx_buf_len) {
+	// pack the eps_uart_cmd_buf_with_tags buffer
+	const uint8_t begin_tag_len = 5; // len of "<cmd>", without null terminator
+	const uint8_t cmd_buf_with_tags_len = cmd_buf_len + 11;
+	if (cmd_buf_with_tags_len > EPS_UART_CMD_BUF_WITH_TAGS_MAX_LEN) {
+		return 2;
+	}
+	memcpy(eps_uart_cmd_buf_with_tags, "<cmd>", begin_tag_len);
+	memcpy(&eps_uart_cmd_buf_with_tags[begin_tag_len], cmd_buf, cmd_buf_len);
+	memcpy(&eps_uart_cmd_buf_with_tags[begin_tag_len+cmd_buf_len], "</cmd>", 6);
+
+	DEBUG_LOG_TRACE_CC_HEX(DEBUG_LOG_MODULE_TRANSPORT, cmd_buf[2],
+			DEBUG_LOG_ID_EPS_UART_TX_HEX, eps_uart_cmd_buf_with_tags, cmd_buf_with_tags_len);
+
+	// drop any stale bytes (e.g., the tail of a previous response that timed out)
+	uart_rx_dma_flush(&eps_uart_rx_dma);
+	eps_rsp_framer_begin_frame(&eps_uart_rsp_framer, rx_buf, rx_buf_len);
+	eps_uart_dropped_byte_count_before = eps_uart_rsp_framer.dropped_byte_count;
+	eps_uart_result_code = 0;
+
+	// TX TO EPS
+	HAL_StatusTypeDef tx_status = HAL_UART_Transmit_IT(
+			&huart4, eps_uart_cmd_buf_with_tags, cmd_buf_with_tags_len);
+	if (tx_status != HAL_OK) {
+		DEBUG_LOG_ERROR(DEBUG_LOG_MODULE_TRANSPORT, DEBUG_LOG_ID_EPS_UART_TX_FAILED, tx_status);
+		return 2;
+	}
+
+	eps_uart_start_rx_time_ms = get_uptime_ms();
+	eps_uart_is_waiting = 1;
+	return 0;
+}
+
+static uint8_t eps_uart_poll() {
+	// RX FROM EPS
+	// The DMA fills the circular buffer in the background; the write index advances on each
+	// idle-line event (i.e., at the end of each burst from the EPS). Feed the new bytes through the
+	// framer, which writes the payload straight into rx_buf, and finish as soon as "</rsp>" arrives.
+	uint8_t rx_byte;
+	while (uart_rx_dma_read(&eps_uart_rx_dma, &rx_byte, 1) == 1) {
+		if (eps_rsp_framer_push_byte(&eps_uart_rsp_framer, rx_byte)) {
+			eps_uart_result_code = 0;
+			eps_uart_is_waiting = 0;
+			return 1;
+		}
+	}
+
+	if (get_uptime_ms() - eps_uart_start_rx_time_ms > EPS_MAX_RESPONSE_POLL_TIME_MS) {
+		eps_uart_result_code = 4;
+		eps_uart_is_waiting = 0;
+		return 1;
+	}
+	return 0;
+}
+
+static uint8_t eps_uart_receive() {
+	const uint32_t dropped_byte_count = eps_uart_rsp_framer.dropped_byte_count - eps_uart_dropped_byte_count_before;
+
+	if (eps_uart_result_code == 4) {
+		DEBUG_LOG_WARN(DEBUG_LOG_MODULE_TRANSPORT, DEBUG_LOG_ID_EPS_UART_RX_TIMEOUT,
+				eps_uart_rsp_framer.state,
+				eps_uart_rsp_framer.payload_received_len, eps_uart_rsp_framer.payload_len,
+				dropped_byte_count);
+		return 4;
+	}
+
+	if (dropped_byte_count > 0) {
+		DEBUG_LOG_WARN(DEBUG_LOG_MODULE_TRANSPORT, DEBUG_LOG_ID_EPS_UART_RX_DROPPED_BYTES, dropped_byte_count);
+	}
+	return 0;
+}
+
+static void eps_uart_wait_for_event() {
+	// Sleep until the next UART idle-line/DMA interrupt, or the response timeout, without the 1 ms
+	// SysTick wake-ups in between. Masked, so bytes that arrived since eps_uart_poll() are seen here.
+	__disable_irq();
+	if (eps_uart_is_waiting && uart_rx_dma_available(&eps_uart_rx_dma) == 0) {
+		low_power_wait_until_ms(eps_uart_start_rx_time_ms + EPS_MAX_RESPONSE_POLL_TIME_MS + 1,
+				LOW_POWER_MODE_SLEEP_TICKLESS);
+	}
+	__enable_irq();
+}
+
+const eps_transport_t eps_transport_uart = {
+	.name = "uart",
+	.send = eps_uart_send,
+	.poll = eps_uart_poll,
+	.receive = eps_uart_receive,
+	.now_ms = get_uptime_ms,
+	.wait_for_event = eps_uart_wait_for_event,
+};
+
+
+uint8_t eps_send_cmd_get_response_uart(
+		const uint8_t cmd_buf[], uint8_t cmd_buf_len,
+		uint8_t rx_buf[], uint16_t rx_buf_len) {
+	return eps_send_cmd_get_response_via_transport(&eps_transport_uart, cmd_buf, cmd_buf_len, rx_buf, rx_buf_len);
+}
@@ -1,334 +1,343 @@
 
 #include "eps_drivers/eps_types_to_json.h"
+#include "debug_tools/json_writer.h"
+#include "debug_tools/timing_probe.h"
 
-#include <stdio.h>
 #include <string.h>
 #include <stdint.h>
 
 
-/*
- ***** To create these eps_<type>_TO_json(...) functions, the following ChatGPT prompt was used: ***** 
+// #pragma region Complex_Datatypes
 
-=================================================================================================
-Write a C code function with a signature like: 
-uint8_t eps_<type>_TO_json(const eps_<type>_t *data, char json_output_str[], uint16_t json_output_str_len).
-
-This function should convert the following struct type to a JSON string. The JSON string should be
-written to the json_output_str buffer. The length of the JSON string should not exceed the
-json_output_str_len. The JSON string should be null-terminated. Use sprintf to write to the buffer.
-Do not include whitespaces in the JSON output. The function should return 1 on error.
-
-Assume that for any unknown types, a similar _TO_json function exists and can be used.
-
-typedef struct {
-	int16_t voltage_raw;
-	int16_t current_raw;
-	int16_t power_raw;
-} eps_vpid_raw_t;
-
-For the long array, use array_name[0], array_name[1], array_name[2], etc. verbosely instead of using iteration.
+void eps_vpid_raw_TO_json_writer(json_writer_t *writer, const char *key, const eps_vpid_raw_t *data) {
+	json_writer_begin_object(writer, key);
+	json_writer_int(writer, "voltage_raw", data->voltage_raw);
+	json_writer_int(writer, "current_raw", data->current_raw);
+	json_writer_int(writer, "power_raw", data->power_raw);
+	json_writer_end_object(writer);
+}
 
-=================================================================================================
+void eps_vpid_eng_TO_json_writer(json_writer_t *writer, const char *key, const eps_vpid_eng_t *data) {
+	json_writer_begin_object(writer, key);
+	json_writer_int(writer, "voltage_mV", data->voltage_mV);
+	json_writer_int(writer, "current_mA", data->current_mA);
+	json_writer_int(writer, "power_cW", data->power_cW);
+	json_writer_end_object(writer);
+}
 
-Note that modification are sometimes required, including:
-0. In the prompt, rx_buf[5] is sometimes rx_buf[6].
-1. Byte order check to be like the example given.
-2. Function name.
-3. Start/end conditions.
-4. Update any multiplier, because LLMs are bad at guessing in advance how many bytes-per-loop are used.
+void eps_battery_pack_datatype_raw_TO_json_writer(json_writer_t *writer, const char *key, const eps_battery_pack_datatype_raw_t *data) {
+	json_writer_begin_object(writer, key);
+	eps_vpid_raw_TO_json_writer(writer, "vip_bp_input_raw", &data->vip_bp_input_raw);
+	json_writer_uint(writer, "bp_status_bitfield", data->bp_status_bitfield);
+	json_writer_uint16_array(writer, "cell_voltage_each_cell_raw", data->cell_voltage_each_cell_raw, 4);
+	json_writer_uint16_array(writer, "battery_temperature_each_sensor_raw", data->battery_temperature_each_sensor_raw, 3);
+	json_writer_end_object(writer);
+}
 
-*/
+void eps_battery_pack_datatype_eng_TO_json_writer(json_writer_t *writer, const char *key, const eps_battery_pack_datatype_eng_t *data) {
+	// The array keys are kept as "..._eng" (not "_mV"/"_cC"), as in the original output
+	json_writer_begin_object(writer, key);
+	eps_vpid_eng_TO_json_writer(writer, "vip_bp_input", &data->vip_bp_input);
+	json_writer_uint(writer, "bp_status_bitfield", data->bp_status_bitfield);
+	json_writer_int16_array(writer, "cell_voltage_each_cell_eng", data->cell_voltage_each_cell_mV, 4);
+	json_writer_int16_array(writer, "battery_temperature_each_sensor_eng", data->battery_temperature_each_sensor_cC, 3);
+	json_writer_end_object(writer);
+}
 
-uint8_t eps_vpid_raw_TO_json(const eps_vpid_raw_t *data, char json_output_str[], uint16_t json_output_str_len) {
-    if (data == NULL || json_output_str == NULL || json_output_str_len < 10) {
-        return 1; // Error: Invalid input
-    }
+void eps_conditioning_channel_datatype_raw_TO_json_writer(json_writer_t *writer, const char *key, const eps_conditioning_channel_datatype_raw_t *data) {
+	json_writer_begin_object(writer, key);
+	eps_vpid_raw_TO_json_writer(writer, "vip_cc_output_raw", &data->vip_cc_output_raw);
+	json_writer_uint(writer, "volt_in_mppt_raw", data->volt_in_mppt_raw);
+	json_writer_uint(writer, "curr_in_mppt_raw", data->curr_in_mppt_raw);
+	json_writer_uint(writer, "volt_ou_mppt_raw", data->volt_ou_mppt_raw);
+	json_writer_uint(writer, "curr_ou_mppt_raw", data->curr_ou_mppt_raw);
+	json_writer_end_object(writer);
+}
 
-    int snprintf_ret = snprintf(
-        json_output_str, json_output_str_len,
-        "{\"voltage_raw\":%d,\"current_raw\":%d,\"power_raw\":%d}",
-        data->voltage_raw, data->current_raw, data->power_raw);
+void eps_conditioning_channel_datatype_eng_TO_json_writer(json_writer_t *writer, const char *key, const eps_conditioning_channel_datatype_eng_t *data) {
+	json_writer_begin_object(writer, key);
+	eps_vpid_eng_TO_json_writer(writer, "vip_cc_output", &data->vip_cc_output);
+	json_writer_int(writer, "volt_in_mppt_mV", data->volt_in_mppt_mV);
+	json_writer_int(writer, "curr_in_mppt_mA", data->curr_in_mppt_mA);
+	json_writer_int(writer, "volt_ou_mppt_mV", data->volt_ou_mppt_mV);
+	json_writer_int(writer, "curr_ou_mppt_mA", data->curr_ou_mppt_mA);
+	json_writer_end_object(writer);
+}
 
-    if (snprintf_ret < 0) {
-        return 2; // Error: snprintf encoding error
-    }
-    if (snprintf_ret >= json_output_str_len) {
-        return 3; // Error: string buffer too short
-    }
-    return 0; // Success
+void eps_conditioning_channel_short_datatype_raw_TO_json_writer(json_writer_t *writer, const char *key, const eps_conditioning_channel_short_datatype_raw_t *data) {
+	json_writer_begin_object(writer, key);
+	json_writer_uint(writer, "volt_in_mppt_raw", data->volt_in_mppt_raw);
+	json_writer_uint(writer, "curr_in_mppt_raw", data->curr_in_mppt_raw);
+	json_writer_uint(writer, "volt_ou_mppt_raw", data->volt_ou_mppt_raw);
+	json_writer_uint(writer, "curr_ou_mppt_raw", data->curr_ou_mppt_raw);
+	json_writer_end_object(writer);
 }
 
-uint8_t eps_vpid_eng_TO_json(const eps_vpid_eng_t *data, char json_output_str[], uint16_t json_output_str_len) {
-    if (data == NULL || json_output_str == NULL || json_output_str_len < 10) {
-        return 1; // Error: Invalid input
-    }
-
-    int snprintf_ret = snprintf(
-        json_output_str, json_output_str_len,
-        "{\"voltage_mV\":%d,\"current_mA\":%d,\"power_cW\":%d}",
-        data->voltage_mV, data->current_mA, data->power_cW);
-
-    if (snprintf_ret < 0) {
-        return 2; // Error: snprintf encoding error
-    }
-    if (snprintf_ret >= json_output_str_len) {
-        return 3; // Error: string buffer too short
-    }
-    return 0; // Success
+void eps_conditioning_channel_short_datatype_eng_TO_json_writer(json_writer_t *writer, const char *key, const eps_conditioning_channel_short_datatype_eng_t *data) {
+	json_writer_begin_object(writer, key);
+	json_writer_int(writer, "volt_in_mppt_mV", data->volt_in_mppt_mV);
+	json_writer_int(writer, "curr_in_mppt_mA", data->curr_in_mppt_mA);
+	json_writer_int(writer, "volt_ou_mppt_mV", data->volt_ou_mppt_mV);
+	json_writer_int(writer, "curr_ou_mppt_mA", data->curr_ou_mppt_mA);
+	json_writer_end_object(writer);
 }
 
-uint8_t eps_battery_pack_datatype_raw_TO_json(const eps_battery_pack_datatype_raw_t *data, char json_output_str[], uint16_t json_output_str_len) {
-    if (data == NULL || json_output_str == NULL || json_output_str_len < 10) {
-        return 1; // Error: Invalid input
-    }
-
-    char vip_bp_input_raw_json[100];
-    const uint8_t json_ret_code = eps_vpid_raw_TO_json(&(data->vip_bp_input_raw), vip_bp_input_raw_json, 100);
-    if (json_ret_code != 0) {
-        return json_ret_code; // Error: subfunction error
-    }
-
-    int snprintf_ret = snprintf(
-        json_output_str, json_output_str_len,
-        "{\"vip_bp_input_raw\":%s,\"bp_status_bitfield\":%d,\"cell_voltage_each_cell_raw\":[%d,%d,%d,%d],\"battery_temperature_each_sensor_raw\":[%d,%d,%d]}",
-        vip_bp_input_raw_json,
-        data->bp_status_bitfield,
-        data->cell_voltage_each_cell_raw[0],
-        data->cell_voltage_each_cell_raw[1],
-        data->cell_voltage_each_cell_raw[2],
-        data->cell_voltage_each_cell_raw[3],
-        data->battery_temperature_each_sensor_raw[0],
-        data->battery_temperature_each_sensor_raw[1],
-        data->battery_temperature_each_sensor_raw[2]);
-
-    if (snprintf_ret < 0) {
-        return 2; // Error: snprintf encoding error
-    }
-    if (snprintf_ret >= json_output_str_len) {
-        return 3; // Error: string buffer too short
-    }
-    return 0; // Success
+// #pragma endregion Complex_Datatypes
+
+
+// #pragma region Command_Responses
+
+void eps_result_system_status_TO_json_writer(json_writer_t *writer, const char *key, const eps_result_system_status_t *data) {
+	// TODO: add mode_str and reset_cause_str keys which decode the enum values to strings
+	json_writer_begin_object(writer, key);
+	json_writer_uint(writer, "mode", data->mode);
+	json_writer_uint(writer, "config_changed_since_boot", data->config_changed_since_boot);
+	json_writer_uint(writer, "reset_cause", data->reset_cause);
+	json_writer_uint(writer, "uptime_sec", data->uptime_sec);
+	json_writer_uint(writer, "error_code", data->error_code);
+	json_writer_uint(writer, "rst_cnt_pwron", data->rst_cnt_pwron);
+	json_writer_uint(writer, "rst_cnt_wdg", data->rst_cnt_wdg);
+	json_writer_uint(writer, "rst_cnt_cmd", data->rst_cnt_cmd);
+	json_writer_uint(writer, "rst_cnt_mcu", data->rst_cnt_mcu);
+	json_writer_uint(writer, "rst_cnt_emlopo", data->rst_cnt_emlopo);
+	json_writer_uint(writer, "time_since_prev_cmd_sec", data->time_since_prev_cmd_sec);
+	json_writer_uint(writer, "unix_time_sec", data->unix_time_sec);
+	json_writer_uint(writer, "calendar_years_since_2000", data->calendar_years_since_2000);
+	json_writer_uint(writer, "calendar_month", data->calendar_month);
+	json_writer_uint(writer, "calendar_day", data->calendar_day);
+	json_writer_uint(writer, "calendar_hour", data->calendar_hour);
+	json_writer_uint(writer, "calendar_minute", data->calendar_minute);
+	json_writer_uint(writer, "calendar_second", data->calendar_second);
+	json_writer_end_object(writer);
 }
 
-uint8_t eps_battery_pack_datatype_eng_TO_json(const eps_battery_pack_datatype_eng_t *data, char json_output_str[], uint16_t json_output_str_len) {
-    if (data == NULL || json_output_str == NULL || json_output_str_len < 10) {
-        return 1; // Error: Invalid input
-    }
-
-    char vip_bp_input_json[100];
-    const uint8_t json_ret_code = eps_vpid_eng_TO_json(&(data->vip_bp_input), vip_bp_input_json, 100);
-    if (json_ret_code != 0) {
-        return json_ret_code + 32; // Error: subfunction error
-    }
-
-    int snprintf_ret = snprintf(
-        json_output_str, json_output_str_len,
-        "{\"vip_bp_input\":%s,\"bp_status_bitfield\":%d,\"cell_voltage_each_cell_eng\":[%d,%d,%d,%d],\"battery_temperature_each_sensor_eng\":[%d,%d,%d]}",
-        vip_bp_input_json,
-        data->bp_status_bitfield,
-        data->cell_voltage_each_cell_mV[0],
-        data->cell_voltage_each_cell_mV[1],
-        data->cell_voltage_each_cell_mV[2],
-        data->cell_voltage_each_cell_mV[3],
-        data->battery_temperature_each_sensor_cC[0],
-        data->battery_temperature_each_sensor_cC[1],
-        data->battery_temperature_each_sensor_cC[2]);
-
-    if (snprintf_ret < 0) {
-        return 2; // Error: snprintf encoding error
-    }
-    if (snprintf_ret >= json_output_str_len) {
-        return 3; // Error: string buffer too short
-    }
-    return 0; // Success
+void eps_result_pdu_overcurrent_fault_state_TO_json_writer(json_writer_t *writer, const char *key, const eps_result_pdu_overcurrent_fault_state_t *data) {
+	json_writer_begin_object(writer, key);
+	json_writer_uint(writer, "stat_ch_on_bitfield", data->stat_ch_on_bitfield);
+	json_writer_uint(writer, "stat_ch_ext_on_bitfield", data->stat_ch_ext_on_bitfield);
+	json_writer_uint(writer, "stat_ch_overcurrent_fault_bitfield", data->stat_ch_overcurrent_fault_bitfield);
+	json_writer_uint(writer, "stat_ch_ext_overcurrent_fault_bitfield", data->stat_ch_ext_overcurrent_fault_bitfield);
+	json_writer_uint16_array(writer, "overcurrent_fault_count_each_channel", data->overcurrent_fault_count_each_channel, 32);
+	json_writer_end_object(writer);
 }
 
-uint8_t eps_conditioning_channel_datatype_raw_TO_json(const eps_conditioning_channel_datatype_raw_t *data, char json_output_str[], uint16_t json_output_str_len) {
-    if (data == NULL || json_output_str == NULL || json_output_str_len < 10) {
-        return 1; // Error: Invalid input
-    }
-
-    char vip_cc_output_raw_json[100];
-    const uint8_t json_ret_code = eps_vpid_raw_TO_json(&(data->vip_cc_output_raw), vip_cc_output_raw_json, 100);
-    if (json_ret_code != 0) {
-        return json_ret_code; // Error: subfunction error
-    }
-
-    int snprintf_ret = snprintf(
-        json_output_str, json_output_str_len,
-        "{\"vip_cc_output_raw\":%s,\"volt_in_mppt_raw\":%d,\"curr_in_mppt_raw\":%d,\"volt_ou_mppt_raw\":%d,\"curr_ou_mppt_raw\":%d}",
-        vip_cc_output_raw_json,
-        data->volt_in_mppt_raw,
-        data->curr_in_mppt_raw,
-        data->volt_ou_mppt_raw,
-        data->curr_ou_mppt_raw);
-
-    if (snprintf_ret < 0) {
-        return 2; // Error: snprintf encoding error
-    }
-    if (snprintf_ret >= json_output_str_len) {
-        return 3; // Error: string buffer too short
-    }
-    return 0; // Success
+void eps_result_pbu_abf_placed_state_TO_json_writer(json_writer_t *writer, const char *key, const eps_result_pbu_abf_placed_state_t *data) {
+	json_writer_begin_object(writer, key);
+	json_writer_uint(writer, "abf_placed_0", data->abf_placed_0);
+	json_writer_uint(writer, "abf_placed_1", data->abf_placed_1);
+	json_writer_str(writer, "abf_placed_0_str", (data->abf_placed_0 == EPS_ABF_PIN_APPLIED) ? "APPLIED" : "NOT_APPLIED");
+	json_writer_str(writer, "abf_placed_1_str", (data->abf_placed_1 == EPS_ABF_PIN_APPLIED) ? "APPLIED" : "NOT_APPLIED");
+	json_writer_end_object(writer);
 }
 
-uint8_t eps_conditioning_channel_datatype_eng_TO_json(const eps_conditioning_channel_datatype_eng_t *data, char json_output_str[], uint16_t json_output_str_len) {
-    if (data == NULL || json_output_str == NULL || json_output_str_len < 10) {
-        return 1; // Error: Invalid input
-    }
-
-    char vip_cc_output_json[100];
-    const uint8_t json_ret_code = eps_vpid_eng_TO_json(&(data->vip_cc_output), vip_cc_output_json, 100);
-    if (json_ret_code != 0) {
-        return json_ret_code; // Error: subfunction error
-    }
-
-    int snprintf_ret = snprintf(
-        json_output_str, json_output_str_len,
-        "{\"vip_cc_output\":%s,\"volt_in_mppt_mV\":%d,\"curr_in_mppt_mA\":%d,\"volt_ou_mppt_mV\":%d,\"curr_ou_mppt_mA\":%d}",
-        vip_cc_output_json,
-        data->volt_in_mppt_mV,
-        data->curr_in_mppt_mA,
-        data->volt_ou_mppt_mV,
-        data->curr_ou_mppt_mA);
-
-    if (snprintf_ret < 0) {
-        return 2; // Error: snprintf encoding error
-    }
-    if (snprintf_ret >= json_output_str_len) {
-        return 3; // Error: string buffer too short
-    }
-    return 0; // Success
+void eps_result_pdu_housekeeping_data_raw_TO_json_writer(json_writer_t *writer, const char *key, const eps_result_pdu_housekeeping_data_raw_t *data) {
+	json_writer_begin_object(writer, key);
+	json_writer_uint(writer, "voltage_internal_board_supply_raw", data->voltage_internal_board_supply_raw);
+	json_writer_uint(writer, "temperature_mcu_raw", data->temperature_mcu_raw);
+	eps_vpid_raw_TO_json_writer(writer, "vip_total_input_raw", &data->vip_total_input_raw);
+	json_writer_uint(writer, "stat_ch_on_bitfield", data->stat_ch_on_bitfield);
+	json_writer_uint(writer, "stat_ch_ext_on_bitfield", data->stat_ch_ext_on_bitfield);
+	json_writer_uint(writer, "stat_ch_overcurrent_fault_bitfield", data->stat_ch_overcurrent_fault_bitfield);
+	json_writer_uint(writer, "stat_ch_ext_overcurrent_fault_bitfield", data->stat_ch_ext_overcurrent_fault_bitfield);
+
+	json_writer_begin_array(writer, "vip_each_voltage_domain_raw");
+	for (uint8_t domain_num = 0; domain_num < 7; domain_num++) {
+		eps_vpid_raw_TO_json_writer(writer, NULL, &data->vip_each_voltage_domain_raw[domain_num]);
+	}
+	json_writer_end_array(writer);
+
+	json_writer_begin_array(writer, "vip_each_channel_raw");
+	for (uint8_t ch_num = 0; ch_num < 32; ch_num++) {
+		eps_vpid_raw_TO_json_writer(writer, NULL, &data->vip_each_channel_raw[ch_num]);
+	}
+	json_writer_end_array(writer);
+	json_writer_end_object(writer);
 }
 
-uint8_t eps_conditioning_channel_short_datatype_raw_TO_json(const eps_conditioning_channel_short_datatype_raw_t *data, char json_output_str[], uint16_t json_output_str_len) {
-    if (data == NULL || json_output_str == NULL || json_output_str_len < 10) {
-        return 1; // Error: Invalid input
-    }
-
-    int snprintf_ret = snprintf(
-        json_output_str, json_output_str_len,
-        "{\"volt_in_mppt_raw\":%d,\"curr_in_mppt_raw\":%d,\"volt_ou_mppt_raw\":%d,\"curr_ou_mppt_raw\":%d}",
-        data->volt_in_mppt_raw,
-        data->curr_in_mppt_raw,
-        data->volt_ou_mppt_raw,
-        data->curr_ou_mppt_raw);
-
-    if (snprintf_ret < 0) {
-        return 2; // Error: snprintf encoding error
-    }
-    if (snprintf_ret >= json_output_str_len) {
-        return 3; // Error: string buffer too short
-    }
-    return 0; // Success
+void eps_result_pdu_housekeeping_data_eng_TO_json_writer(json_writer_t *writer, const char *key, const eps_result_pdu_housekeeping_data_eng_t *data) {
+	json_writer_begin_object(writer, key);
+	json_writer_uint(writer, "voltage_internal_board_supply_mV", data->voltage_internal_board_supply_mV);
+	json_writer_uint(writer, "temperature_mcu_cC", data->temperature_mcu_cC);
+	eps_vpid_eng_TO_json_writer(writer, "vip_total_input", &data->vip_total_input);
+	json_writer_uint(writer, "stat_ch_on_bitfield", data->stat_ch_on_bitfield);
+	json_writer_uint(writer, "stat_ch_ext_on_bitfield", data->stat_ch_ext_on_bitfield);
+	json_writer_uint(writer, "stat_ch_overcurrent_fault_bitfield", data->stat_ch_overcurrent_fault_bitfield);
+	json_writer_uint(writer, "stat_ch_ext_overcurrent_fault_bitfield", data->stat_ch_ext_overcurrent_fault_bitfield);
+
+	json_writer_begin_array(writer, "vip_each_voltage_domain");
+	for (uint8_t domain_num = 0; domain_num < 7; domain_num++) {
+		eps_vpid_eng_TO_json_writer(writer, NULL, &data->vip_each_voltage_domain[domain_num]);
+	}
+	json_writer_end_array(writer);
+
+	json_writer_begin_array(writer, "vip_each_channel");
+	for (uint8_t ch_num = 0; ch_num < 32; ch_num++) {
+		eps_vpid_eng_TO_json_writer(writer, NULL, &data->vip_each_channel[ch_num]);
+	}
+	json_writer_end_array(writer);
+	json_writer_end_object(writer);
 }
 
-uint8_t eps_conditioning_channel_short_datatype_eng_TO_json(const eps_conditioning_channel_short_datatype_eng_t *data, char json_output_str[], uint16_t json_output_str_len) {
-    if (data == NULL || json_output_str == NULL || json_output_str_len < 10) {
-        return 1; // Error: Invalid input
-    }
-
-    int snprintf_ret = snprintf(
-        json_output_str, json_output_str_len,
-        "{\"volt_in_mppt_mV\":%d,\"curr_in_mppt_mA\":%d,\"volt_ou_mppt_mV\":%d,\"curr_ou_mppt_mA\":%d}",
-        data->volt_in_mppt_mV,
-        data->curr_in_mppt_mA,
-        data->volt_ou_mppt_mV,
-        data->curr_ou_mppt_mA);
-
-    if (snprintf_ret < 0) {
-        return 2; // Error: snprintf encoding error
-    }
-    if (snprintf_ret >= json_output_str_len) {
-        return 3; // Error: string buffer too short
-    }
-    return 0; // Success
+void eps_result_pbu_housekeeping_data_raw_TO_json_writer(json_writer_t *writer, const char *key, const eps_result_pbu_housekeeping_data_raw_t *data) {
+	json_writer_begin_object(writer, key);
+	json_writer_uint(writer, "voltage_internal_board_supply_raw", data->voltage_internal_board_supply_raw);
+	json_writer_uint(writer, "temperature_mcu_raw", data->temperature_mcu_raw);
+	eps_vpid_raw_TO_json_writer(writer, "vip_total_input_raw", &data->vip_total_input_raw);
+	json_writer_uint(writer, "battery_pack_status_bitfield", data->battery_pack_status_bitfield);
+
+	json_writer_begin_array(writer, "battery_pack_info_each_pack_raw");
+	for (uint8_t bp_num = 0; bp_num < 3; bp_num++) {
+		eps_battery_pack_datatype_raw_TO_json_writer(writer, NULL, &data->battery_pack_info_each_pack_raw[bp_num]);
+	}
+	json_writer_end_array(writer);
+	json_writer_end_object(writer);
 }
 
+void eps_result_pbu_housekeeping_data_eng_TO_json_writer(json_writer_t *writer, const char *key, const eps_result_pbu_housekeeping_data_eng_t *data) {
+	json_writer_begin_object(writer, key);
+	json_writer_uint(writer, "voltage_internal_board_supply_mV", data->voltage_internal_board_supply_mV);
+	json_writer_uint(writer, "temperature_mcu_cC", data->temperature_mcu_cC);
+	eps_vpid_eng_TO_json_writer(writer, "vip_total_input", &data->vip_total_input);
+	json_writer_uint(writer, "battery_pack_status_bitfield", data->battery_pack_status_bitfield);
+
+	json_writer_begin_array(writer, "battery_pack_info_each_pack");
+	for (uint8_t bp_num = 0; bp_num < 3; bp_num++) {
+		eps_battery_pack_datatype_eng_TO_json_writer(writer, NULL, &data->battery_pack_info_each_pack[bp_num]);
+	}
+	json_writer_end_array(writer);
+	json_writer_end_object(writer);
+}
 
-uint8_t eps_result_system_status_TO_json(const eps_result_system_status_t *data, char json_output_str[], uint16_t json_output_str_len) {
-    if (data == NULL || json_output_str == NULL || json_output_str_len < 10) {
-        return 1; // Error: Invalid input
-    }
-
-    // TODO: add mode_str and reset_cause_str keys which decode the enum values to strings
-    int snprintf_ret = snprintf(
-        json_output_str, json_output_str_len,
-        "{\"mode\":%d,\"config_changed_since_boot\":%d,\"reset_cause\":%d,\"uptime_sec\":%lu,\"error_code\":%u,\"rst_cnt_pwron\":%u,\"rst_cnt_wdg\":%u,\"rst_cnt_cmd\":%u,\"rst_cnt_mcu\":%u,\"rst_cnt_emlopo\":%u,\"time_since_prev_cmd_sec\":%u,\"unix_time_sec\":%lu,\"calendar_years_since_2000\":%u,\"calendar_month\":%u,\"calendar_day\":%u,\"calendar_hour\":%u,\"calendar_minute\":%u,\"calendar_second\":%u}",
-        data->mode, data->config_changed_since_boot, data->reset_cause, data->uptime_sec,
-        data->error_code, data->rst_cnt_pwron, data->rst_cnt_wdg, data->rst_cnt_cmd,
-        data->rst_cnt_mcu, data->rst_cnt_emlopo, data->time_since_prev_cmd_sec,
-        data->unix_time_sec, data->calendar_years_since_2000, data->calendar_month,
-        data->calendar_day, data->calendar_hour, data->calendar_minute, data->calendar_second);
-
-    if (snprintf_ret < 0) {
-        return 2; // Error: snprintf encoding error
-    }
-    if (snprintf_ret >= json_output_str_len) {
-        return 3; // Error: string buffer too short
-    }
-    return 0; // Success
+void eps_result_pcu_housekeeping_data_raw_TO_json_writer(json_writer_t *writer, const char *key, const eps_result_pcu_housekeeping_data_raw_t *data) {
+	json_writer_begin_object(writer, key);
+	json_writer_uint(writer, "voltage_internal_board_supply_raw", data->voltage_internal_board_supply_raw);
+	json_writer_uint(writer, "temperature_mcu_raw", data->temperature_mcu_raw);
+	eps_vpid_raw_TO_json_writer(writer, "vip_total_input_raw", &data->vip_total_input_raw);
+
+	json_writer_begin_array(writer, "conditioning_channel_info_each_channel_raw");
+	for (uint8_t ch_num = 0; ch_num < 4; ch_num++) {
+		eps_conditioning_channel_datatype_raw_TO_json_writer(writer, NULL, &data->conditioning_channel_info_each_channel_raw[ch_num]);
+	}
+	json_writer_end_array(writer);
+	json_writer_end_object(writer);
 }
 
+void eps_result_pcu_housekeeping_data_eng_TO_json_writer(json_writer_t *writer, const char *key, const eps_result_pcu_housekeeping_data_eng_t *data) {
+	json_writer_begin_object(writer, key);
+	json_writer_uint(writer, "voltage_internal_board_supply_mV", data->voltage_internal_board_supply_mV);
+	json_writer_uint(writer, "temperature_mcu_cC", data->temperature_mcu_cC);
+	eps_vpid_eng_TO_json_writer(writer, "vip_total_input", &data->vip_total_input);
+
+	json_writer_begin_array(writer, "conditioning_channel_info_each_channel");
+	for (uint8_t ch_num = 0; ch_num < 4; ch_num++) {
+		eps_conditioning_channel_datatype_eng_TO_json_writer(writer, NULL, &data->conditioning_channel_info_each_channel[ch_num]);
+	}
+	json_writer_end_array(writer);
+	json_writer_end_object(writer);
+}
 
-uint8_t eps_result_pdu_overcurrent_fault_state_TO_json(const eps_result_pdu_overcurrent_fault_state_t *data, char json_output_str[], uint16_t json_output_str_len) {
-    if (data == NULL || json_output_str == NULL || json_output_str_len < 10) {
-        return 1; // Error: Invalid input
-    }
-
-    // Write JSON string to buffer
-    int snprintf_ret = snprintf(
-        json_output_str, json_output_str_len,
-        "{\"stat_ch_on_bitfield\":%u,\"stat_ch_ext_on_bitfield\":%u,\"stat_ch_overcurrent_fault_bitfield\":%u,\"stat_ch_ext_overcurrent_fault_bitfield\":%u,\"overcurrent_fault_count_each_channel\":[%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u]}",
-        data->stat_ch_on_bitfield,
-        data->stat_ch_ext_on_bitfield,
-        data->stat_ch_overcurrent_fault_bitfield,
-        data->stat_ch_ext_overcurrent_fault_bitfield,
-        data->overcurrent_fault_count_each_channel[0], data->overcurrent_fault_count_each_channel[1],
-        data->overcurrent_fault_count_each_channel[2], data->overcurrent_fault_count_each_channel[3],
-        data->overcurrent_fault_count_each_channel[4], data->overcurrent_fault_count_each_channel[5],
-        data->overcurrent_fault_count_each_channel[6], data->overcurrent_fault_count_each_channel[7],
-        data->overcurrent_fault_count_each_channel[8], data->overcurrent_fault_count_each_channel[9],
-        data->overcurrent_fault_count_each_channel[10], data->overcurrent_fault_count_each_channel[11],
-        data->overcurrent_fault_count_each_channel[12], data->overcurrent_fault_count_each_channel[13],
-        data->overcurrent_fault_count_each_channel[14], data->overcurrent_fault_count_each_channel[15],
-        data->overcurrent_fault_count_each_channel[16], data->overcurrent_fault_count_each_channel[17],
-        data->overcurrent_fault_count_each_channel[18], data->overcurrent_fault_count_each_channel[19],
-        data->overcurrent_fault_count_each_channel[20], data->overcurrent_fault_count_each_channel[21],
-        data->overcurrent_fault_count_each_channel[22], data->overcurrent_fault_count_each_channel[23],
-        data->overcurrent_fault_count_each_channel[24], data->overcurrent_fault_count_each_channel[25],
-        data->overcurrent_fault_count_each_channel[26], data->overcurrent_fault_count_each_channel[27],
-        data->overcurrent_fault_count_each_channel[28], data->overcurrent_fault_count_each_channel[29],
-        data->overcurrent_fault_count_each_channel[30], data->overcurrent_fault_count_each_channel[31]);
-
-    if (snprintf_ret < 0) {
-        return 2; // Error: snprintf encoding error
-    }
-    if (snprintf_ret >= json_output_str_len) {
-        return 3; // Error: string buffer too short
-    }
-    return 0; // Success
+void eps_result_piu_housekeeping_data_raw_TO_json_writer(json_writer_t *writer, const char *key, const eps_result_piu_housekeeping_data_raw_t *data) {
+	json_writer_begin_object(writer, key);
+	json_writer_uint(writer, "voltage_internal_board_supply_raw", data->voltage_internal_board_supply_raw);
+	json_writer_uint(writer, "temperature_mcu_raw", data->temperature_mcu_raw);
+	eps_vpid_raw_TO_json_writer(writer, "vip_dist_input_raw", &data->vip_dist_input_raw);
+	eps_vpid_raw_TO_json_writer(writer, "vip_batt_input_raw", &data->vip_batt_input_raw);
+	json_writer_uint(writer, "stat_ch_on_bitfield", data->stat_ch_on_bitfield);
+	json_writer_uint(writer, "stat_ch_overcurrent_fault_bitfield", data->stat_ch_overcurrent_fault_bitfield);
+	json_writer_uint(writer, "battery_status_bitfield", data->battery_status_bitfield);
+	json_writer_uint(writer, "battery_temp2_raw", data->battery_temp2_raw);
+	json_writer_uint(writer, "battery_temp3_raw", data->battery_temp3_raw);
+	json_writer_uint(writer, "vd0_voltage_raw", data->vd0_voltage_raw);
+	json_writer_uint(writer, "vd1_voltage_raw", data->vd1_voltage_raw);
+	json_writer_uint(writer, "vd2_voltage_raw", data->vd2_voltage_raw);
+
+	json_writer_begin_array(writer, "vip_each_channel_raw");
+	for (uint8_t ch_num = 0; ch_num < 32; ch_num++) {
+		eps_vpid_raw_TO_json_writer(writer, NULL, &data->vip_each_channel_raw[ch_num]);
+	}
+	json_writer_end_array(writer);
+
+	json_writer_begin_array(writer, "conditioning_channel_info_each_channel_raw");
+	for (uint8_t cc_num = 0; cc_num < 5; cc_num++) {
+		eps_conditioning_channel_short_datatype_raw_TO_json_writer(writer, NULL, &data->conditioning_channel_info_each_channel_raw[cc_num]);
+	}
+	json_writer_end_array(writer);
+
+	json_writer_uint(writer, "stat_ch_ext_on_bitfield", data->stat_ch_ext_on_bitfield);
+	json_writer_uint(writer, "stat_ch_ext_overcurrent_fault_bitfield", data->stat_ch_ext_overcurrent_fault_bitfield);
+	json_writer_end_object(writer);
 }
 
-uint8_t eps_result_pbu_abf_placed_state_TO_json(const eps_result_pbu_abf_placed_state_t *data, char json_output_str[], uint16_t json_output_str_len) {
-    if (data == NULL || json_output_str == NULL || json_output_str_len < 10) {
-        return 1; // Error: Invalid input
-    }
-
-    // Write JSON string to buffer
-    int snprintf_ret = snprintf(
-        json_output_str, json_output_str_len,
-        "{\"abf_placed_0\":%u,\"abf_placed_1\":%u,\"abf_placed_0_str\":%s,\"abf_placed_1_str\":%s}",
-        data->abf_placed_0,
-        data->abf_placed_1,
-        (data->abf_placed_0 == EPS_ABF_PIN_APPLIED) ? "\"APPLIED\"" : "\"NOT_APPLIED\"",
-        (data->abf_placed_1 == EPS_ABF_PIN_APPLIED) ? "\"APPLIED\"" : "\"NOT_APPLIED\"");
-
-    if (snprintf_ret < 0) {
-        return 2; // Error: snprintf encoding error
-    }
-    if (snprintf_ret >= json_output_str_len) {
-        return 3; // Error: string buffer too short
-    }
-    return 0; // Success
+void eps_result_piu_housekeeping_data_eng_TO_json_writer(json_writer_t *writer, const char *key, const eps_result_piu_housekeeping_data_eng_t *data) {
+	json_writer_begin_object(writer, key);
+	json_writer_uint(writer, "voltage_internal_board_supply_mV", data->voltage_internal_board_supply_mV);
+	json_writer_uint(writer, "temperature_mcu_cC", data->temperature_mcu_cC);
+	eps_vpid_eng_TO_json_writer(writer, "vip_dist_input", &data->vip_dist_input);
+	eps_vpid_eng_TO_json_writer(writer, "vip_batt_input", &data->vip_batt_input);
+	json_writer_uint(writer, "stat_ch_on_bitfield", data->stat_ch_on_bitfield);
+	json_writer_uint(writer, "stat_ch_overcurrent_fault_bitfield", data->stat_ch_overcurrent_fault_bitfield);
+	json_writer_uint(writer, "battery_status_bitfield", data->battery_status_bitfield);
+	json_writer_uint(writer, "battery_temp2_cC", data->battery_temp2_cC);
+	json_writer_uint(writer, "battery_temp3_cC", data->battery_temp3_cC);
+	json_writer_uint(writer, "vd0_voltage_mV", data->vd0_voltage_mV);
+	json_writer_uint(writer, "vd1_voltage_mV", data->vd1_voltage_mV);
+	json_writer_uint(writer, "vd2_voltage_mV", data->vd2_voltage_mV);
+
+	json_writer_begin_array(writer, "vip_each_channel");
+	for (uint8_t ch_num = 0; ch_num < 32; ch_num++) {
+		eps_vpid_eng_TO_json_writer(writer, NULL, &data->vip_each_channel[ch_num]);
+	}
+	json_writer_end_array(writer);
+
+	json_writer_begin_array(writer, "conditioning_channel_info_each_channel");
+	for (uint8_t cc_num = 0; cc_num < 5; cc_num++) {
+		eps_conditioning_channel_short_datatype_eng_TO_json_writer(writer, NULL, &data->conditioning_channel_info_each_channel[cc_num]);
+	}
+	json_writer_end_array(writer);
+
+	json_writer_uint(writer, "stat_ch_ext_on_bitfield", data->stat_ch_ext_on_bitfield);
+	json_writer_uint(writer, "stat_ch_ext_overcurrent_fault_bitfield", data->stat_ch_ext_overcurrent_fault_bitfield);
+	json_writer_end_object(writer);
 }
+
+// #pragma endregion Command_Responses
+
+
+// #pragma region String_Wrappers
+
+// eps_<type>_TO_json(data, json_output_str, json_output_str_len): writes the whole object into
+// json_output_str, null-terminated. Returns 0 on success, 1 on invalid input, or 3 if the string
+// buffer is too short.
+#define EPS_TO_JSON_STR(type) \
+	uint8_t eps_##type##_TO_json(const eps_##type##_t *data, char json_output_str[], uint16_t json_output_str_len) { \
+		if (data == NULL || json_output_str == NULL || json_output_str_len < 10) { \
+			return 1; \
+		} \
+		TIMING_PROBE_SCOPE(TIMING_PROBE_ID_JSON); \
+		json_writer_t writer; \
+		json_writer_init(&writer, json_output_str, json_output_str_len, NULL, NULL); \
+		eps_##type##_TO_json_writer(&writer, NULL, data); \
+		return json_writer_finish(&writer); \
+	}
+
+EPS_TO_JSON_STR(vpid_raw)
+EPS_TO_JSON_STR(vpid_eng)
+EPS_TO_JSON_STR(battery_pack_datatype_raw)
+EPS_TO_JSON_STR(battery_pack_datatype_eng)
+EPS_TO_JSON_STR(conditioning_channel_datatype_raw)
+EPS_TO_JSON_STR(conditioning_channel_datatype_eng)
+EPS_TO_JSON_STR(conditioning_channel_short_datatype_raw)
+EPS_TO_JSON_STR(conditioning_channel_short_datatype_eng)
+EPS_TO_JSON_STR(result_system_status)
+EPS_TO_JSON_STR(result_pdu_overcurrent_fault_state)
+EPS_TO_JSON_STR(result_pbu_abf_placed_state)
+EPS_TO_JSON_STR(result_pdu_housekeeping_data_raw)
+EPS_TO_JSON_STR(result_pdu_housekeeping_data_eng)
+EPS_TO_JSON_STR(result_pbu_housekeeping_data_raw)
+EPS_TO_JSON_STR(result_pbu_housekeeping_data_eng)
+EPS_TO_JSON_STR(result_pcu_housekeeping_data_raw)
+EPS_TO_JSON_STR(result_pcu_housekeeping_data_eng)
+EPS_TO_JSON_STR(result_piu_housekeeping_data_raw)
+EPS_TO_JSON_STR(result_piu_housekeeping_data_eng)
+
+// #pragma endregion String_Wrappers
@@ -21,7 +21,14 @@
 
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
-
+#include "eps_drivers/eps_internal_drivers.h"
+#include "eps_drivers/eps_cmd_queue.h"
+#include "eps_drivers/eps_field_decoder.h"
+#include "eps_drivers/eps_hk_stats.h"
+#include "stm_drivers/scheduler.h"
+#include "stm_drivers/timing_helpers.h"
+#include "debug_tools/fmt_int.h"
+#include "debug_tools/timing_probe.h"
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -31,7 +38,11 @@
 
 /* Private define ------------------------------------------------------------*/
 /* USER CODE BEGIN PD */
-
+#define LED_PERIOD_MS 1000
+#define EPS_WATCHDOG_PERIOD_MS 5000
+#define EPS_SYSTEM_STATUS_PERIOD_MS 5000
+#define EPS_HK_STATS_PERIOD_MS 1000 // more than the housekeeping cache max age, so no response is counted twice
+#define STATS_PERIOD_MS 60000
 /* USER CODE END PD */
 
 /* Private macro -------------------------------------------------------------*/
@@ -45,6 +56,9 @@ I2C_HandleTypeDef hi2c1;
 UART_HandleTypeDef hlpuart1;
 UART_HandleTypeDef huart4;
 UART_HandleTypeDef huart3;
+DMA_HandleTypeDef hdma_uart4_rx;
+DMA_HandleTypeDef hdma_i2c1_rx;
+DMA_HandleTypeDef hdma_lpuart1_tx;
 
 /* USER CODE BEGIN PV */
 
@@ -54,6 +68,7 @@ UART_HandleTypeDef huart3;
 /* Private function prototypes -----------------------------------------------*/
 void SystemClock_Config(void);
 static void MX_GPIO_Init(void);
+static void MX_DMA_Init(void);
 static void MX_LPUART1_UART_Init(void);
 static void MX_USART3_UART_Init(void);
 static void MX_I2C1_Init(void);
@@ -65,6 +80,84 @@ static void MX_UART4_Init(void);
 /* Private user code ---------------------------------------------------------*/
 /* USER CODE BEGIN 0 */
 
+static const uint8_t eps_watchdog_cmd[4] = {EPS_COMMAND_STID, EPS_COMMAND_IVID, 0x06, EPS_COMMAND_BID};
+static uint8_t eps_watchdog_rx_buf[EPS_DEFAULT_RX_LEN_MIN];
+
+static void eps_watchdog_done(uint8_t result_code, const uint8_t rx_buf[], uint16_t rx_buf_len, void *context) {
+  if (result_code != 0) {
+    char msg[50];
+    char *end = fmt_int_append_str(msg, "ERROR: eps_watchdog failed (");
+    end = fmt_int_append_u32(end, result_code);
+    fmt_int_append_str(end, ")\n");
+    debug_uart_print_str(msg);
+  }
+}
+
+static const uint8_t eps_system_status_cmd[4] = {EPS_COMMAND_STID, EPS_COMMAND_IVID, 0x40, EPS_COMMAND_BID};
+static uint8_t eps_system_status_rx_buf[36];
+
+static void eps_system_status_done(uint8_t result_code, const uint8_t rx_buf[], uint16_t rx_buf_len, void *context) {
+  // Check STAT field (Table 3-11) - 0x00 and 0x80 mean success
+  if (result_code != 0 || (rx_buf[4] != 0x00 && rx_buf[4] != 0x80)) {
+    char msg[60];
+    char *end = fmt_int_append_str(msg, "ERROR: eps_system_status failed (");
+    end = fmt_int_append_u32(end, (result_code != 0) ? result_code : rx_buf[4]);
+    fmt_int_append_str(end, ")\n");
+    debug_uart_print_str(msg);
+    return;
+  }
+  eps_result_system_status_t system_status;
+  eps_decode_fields(&eps_field_table_system_status, rx_buf, &system_status);
+  debug_uart_print_str("System status info, no error!:\n");
+  eps_debug_uart_print_system_status(&system_status);
+}
+
+static void led_job(void *context) {
+  HAL_GPIO_TogglePin(GPIOB, GPIO_PIN_14);
+}
+
+static void eps_watchdog_job(void *context) {
+  // Queued without waiting; the pump (poll hook) sends it.
+  eps_cmd_queue_submit(eps_watchdog_cmd, sizeof(eps_watchdog_cmd),
+      eps_watchdog_rx_buf, sizeof(eps_watchdog_rx_buf), eps_watchdog_done, NULL);
+}
+
+static void eps_system_status_job(void *context) {
+  // Queued without waiting, like the watchdog; printed when the response comes.
+  debug_uart_print_str("Fetching system status info...\n");
+  if (eps_cmd_queue_submit(eps_system_status_cmd, sizeof(eps_system_status_cmd),
+      eps_system_status_rx_buf, sizeof(eps_system_status_rx_buf), eps_system_status_done, NULL) != 0) {
+    debug_uart_print_str("ERROR: eps_system_status not queued\n");
+  }
+}
+
+static void eps_hk_stats_job(void *context) {
+  // Queued without waiting; each board's statistics are updated when its response comes.
+  // A full queue skips that board until the next run.
+  for (uint8_t board = 0; board < EPS_BOARD_COUNT; board++) {
+    eps_hk_stats_request_sample(board);
+  }
+}
+
+static void stats_job(void *context) {
+  eps_debug_uart_print_cmd_queue_stats();
+  eps_debug_uart_print_link_stats_json();
+  eps_debug_uart_print_hk_cache_stats();
+  scheduler_debug_print_stats();
+  low_power_debug_print_stats();
+  TIMING_PROBE_PRINT_ALL();
+  low_power_measure_start();
+}
+
+static uint8_t stop2_veto(void) {
+  // Stop 2 halts the DMA channels: wait for the debug prints and any EPS transaction to finish
+  return !debug_uart_is_tx_idle() || !eps_cmd_queue_is_idle();
+}
+
+static uint8_t eps_cmd_queue_poll_hook(void) {
+  eps_cmd_queue_pump();
+  return !eps_cmd_queue_is_idle();
+}
 
 /* USER CODE END 0 */
 
@@ -97,54 +190,49 @@ int main(void)
 
   /* Initialize all configured peripherals */
   MX_GPIO_Init();
+  MX_DMA_Init();
   MX_LPUART1_UART_Init();
   MX_USART3_UART_Init();
   MX_I2C1_Init();
   MX_UART4_Init();
   /* USER CODE BEGIN 2 */
 
+  cycle_counter_init(); // for the timing probes
+  if (debug_uart_init() != 0) {
+    debug_uart_print_str("ERROR: failed to start debug UART TX DMA. Printing is blocking.\n");
+  }
   debug_uart_print_str("Done HAL init functions.\n");
 
+  // Talk to the EPS over UART4. Use &eps_transport_sim to run without the EPS connected.
+  eps_set_transport(&eps_transport_uart);
+  if (eps_start_uart_rx_dma() != 0) {
+    debug_uart_print_str("ERROR: failed to start EPS UART RX DMA.\n");
+  }
+
   /* USER CODE END 2 */
 
   /* Infinite loop */
   /* USER CODE BEGIN WHILE */
+  // Each task is a scheduler job at its own rate; the CPU sleeps in between (see scheduler.h).
+  scheduler_set_poll_hook(eps_cmd_queue_poll_hook);
+  low_power_init();
+  low_power_set_stop_veto(stop2_veto);
+  low_power_measure_start();
+  scheduler_set_idle_low_power_mode(LOW_POWER_MODE_STOP2);
+  scheduler_add_periodic("led", led_job, NULL, LED_PERIOD_MS, 0, 0, NULL);
+  scheduler_add_periodic("eps_watchdog", eps_watchdog_job, NULL, EPS_WATCHDOG_PERIOD_MS, 0, 0, NULL);
+  scheduler_add_periodic("eps_system_status", eps_system_status_job, NULL, EPS_SYSTEM_STATUS_PERIOD_MS, 100, 0, NULL);
+  scheduler_add_periodic("eps_hk_stats", eps_hk_stats_job, NULL, EPS_HK_STATS_PERIOD_MS, 200, 0, NULL);
+  scheduler_add_periodic("stats", stats_job, NULL, STATS_PERIOD_MS, STATS_PERIOD_MS, 0, NULL);
+
+  scheduler_run_forever();
+
   while (1)
   {
     /* USER CODE END WHILE */
 
     /* USER CODE BEGIN 3 */
-
-    // dump EPS system status
-    debug_uart_print_str("Start of while loop\n");
-
-    // blink LED
-    HAL_GPIO_TogglePin(GPIOB, GPIO_PIN_14);
-
-    // I2C scan
-//    debug_i2c_scan();
-
-
-    /////////////////////////////////////////////////////////
-    /////////////// SERVICE THE WATCHDOG ////////////////////
-    /////////////////////////////////////////////////////////
-    debug_uart_print_str("Executing eps_watchdog()...\n");
-    eps_watchdog();
-
-
-    /////////////////////////////////////////////////////////
-    /////////////// GET THE SYSTEM STATUS ///////////////////
-    /////////////////////////////////////////////////////////
-
-    eps_result_system_status_t system_status;
-    debug_uart_print_str("Fetching system status info...\n");
-    uint8_t system_status_err = eps_get_system_status(&system_status);
-
-    if (system_status_err == 0) {
-      debug_uart_print_str("System status info, no error!:\n");
-      eps_debug_uart_print_system_status(&system_status);
-    }
-
+    // not reached: scheduler_run_forever() doesn't return
 
     /////////////////////////////////////////////////////////
     /////////////// TOGGLE A BUS GROUP //////////////////////
@@ -174,10 +262,6 @@ int main(void)
 //    debug_uart_print_str("Executing eps_output_bus_group_off()...\n");
 //    HAL_GPIO_TogglePin(GPIOB, GPIO_PIN_14);
 //    eps_output_bus_group_off( CH_BF,  CH_EXT_BF);
-
-    debug_uart_print_str("End of while loop\n\n");
-
-    HAL_Delay(5000);
   }
   /* USER CODE END 3 */
 }
@@ -423,6 +507,29 @@ static void MX_USART3_UART_Init(void)
 
 }
 
+/**
+  * Enable DMA controller clock
+  */
+static void MX_DMA_Init(void)
+{
+
+  /* DMA controller clock enable */
+  __HAL_RCC_DMAMUX1_CLK_ENABLE();
+  __HAL_RCC_DMA1_CLK_ENABLE();
+
+  /* DMA interrupt init */
+  /* DMA1_Channel1_IRQn interrupt configuration */
+  HAL_NVIC_SetPriority(DMA1_Channel1_IRQn, 0, 0);
+  HAL_NVIC_EnableIRQ(DMA1_Channel1_IRQn);
+  /* DMA1_Channel2_IRQn interrupt configuration */
+  HAL_NVIC_SetPriority(DMA1_Channel2_IRQn, 0, 0);
+  HAL_NVIC_EnableIRQ(DMA1_Channel2_IRQn);
+  /* DMA1_Channel3_IRQn interrupt configuration */
+  HAL_NVIC_SetPriority(DMA1_Channel3_IRQn, 0, 0);
+  HAL_NVIC_EnableIRQ(DMA1_Channel3_IRQn);
+
+}
+
 /**
   * @brief GPIO Initialization Function
   * @param None
@@ -476,6 +583,7 @@ void Error_Handler(void)
   /* USER CODE BEGIN Error_Handler_Debug */
   /* User can add his own implementation to report the HAL error return state */
   __disable_irq();
+  debug_uart_flush_on_fault();
   while (1)
   {
   }
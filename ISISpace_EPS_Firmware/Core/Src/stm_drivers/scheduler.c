@@ -0,0 +1,232 @@
+#include "stm_drivers/scheduler.h"
+#include "debug_tools/debug_uart.h"
+#include "debug_tools/fmt_int.h"
+
+#ifdef EPS_HOST_BUILD
+#include <time.h>
+#else
+#include "stm_drivers/timing_helpers.h"
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+static scheduler_job_t scheduler_jobs[SCHEDULER_MAX_JOBS];
+static scheduler_poll_hook_t scheduler_poll_hook = NULL;
+static uint32_t scheduler_slept_ms = 0;
+#ifndef EPS_HOST_BUILD
+static LOW_POWER_MODE_enum_t scheduler_idle_low_power_mode = LOW_POWER_MODE_SLEEP_TICKLESS;
+#endif
+
+// Longest single sleep; the loop just goes around again after it
+#define SCHEDULER_MAX_SLEEP_MS 60000
+
+
+static uint32_t scheduler_now_ms() {
+#ifdef EPS_HOST_BUILD
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint32_t)(ts.tv_sec * 1000) + (uint32_t)(ts.tv_nsec / 1000000);
+#else
+	return get_uptime_ms();
+#endif
+}
+
+// is_idle: nothing in progress, so the idle low-power mode may be used. Otherwise a plain WFI.
+static void scheduler_sleep(uint32_t max_sleep_ms, uint8_t is_idle) {
+	if (max_sleep_ms > SCHEDULER_MAX_SLEEP_MS) {
+		max_sleep_ms = SCHEDULER_MAX_SLEEP_MS;
+	}
+#ifdef EPS_HOST_BUILD
+	const struct timespec ts = { .tv_sec = max_sleep_ms / 1000, .tv_nsec = (max_sleep_ms % 1000) * 1000000L };
+	nanosleep(&ts, NULL);
+	scheduler_slept_ms += max_sleep_ms;
+#else
+	const uint32_t start_ms = get_uptime_ms();
+	low_power_wait_until_ms(start_ms + max_sleep_ms,
+			is_idle ? scheduler_idle_low_power_mode : LOW_POWER_MODE_SLEEP);
+	scheduler_slept_ms += get_uptime_ms() - start_ms;
+#endif
+}
+
+static uint8_t scheduler_add_job(
+		const char *name, scheduler_job_callback_t callback, void *context,
+		uint32_t period_ms, uint32_t first_delay_ms, uint32_t deadline_ms, uint8_t *job_id_dest) {
+	if (callback == NULL) {
+		return 1;
+	}
+
+	for (uint8_t job_id = 0; job_id < SCHEDULER_MAX_JOBS; job_id++) {
+		scheduler_job_t *job = &scheduler_jobs[job_id];
+		if (job->is_active) {
+			continue;
+		}
+
+		*job = (scheduler_job_t) {
+			.name = name,
+			.callback = callback,
+			.context = context,
+			.period_ms = period_ms,
+			.deadline_ms = (deadline_ms != 0) ? deadline_ms : period_ms,
+			.next_due_ms = scheduler_now_ms() + first_delay_ms,
+			.is_active = 1,
+		};
+		if (job_id_dest != NULL) {
+			*job_id_dest = job_id;
+		}
+		return 0;
+	}
+	return 5;
+}
+
+uint8_t scheduler_add_periodic(
+		const char *name, scheduler_job_callback_t callback, void *context,
+		uint32_t period_ms, uint32_t first_delay_ms, uint32_t deadline_ms, uint8_t *job_id_dest) {
+	if (period_ms == 0) {
+		return 1;
+	}
+	return scheduler_add_job(name, callback, context, period_ms, first_delay_ms, deadline_ms, job_id_dest);
+}
+
+uint8_t scheduler_add_one_shot(
+		const char *name, scheduler_job_callback_t callback, void *context,
+		uint32_t delay_ms, uint32_t deadline_ms, uint8_t *job_id_dest) {
+	return scheduler_add_job(name, callback, context, 0, delay_ms, deadline_ms, job_id_dest);
+}
+
+uint8_t scheduler_cancel(uint8_t job_id) {
+	if (job_id >= SCHEDULER_MAX_JOBS || !scheduler_jobs[job_id].is_active) {
+		return 1;
+	}
+	scheduler_jobs[job_id].is_active = 0;
+	return 0;
+}
+
+void scheduler_set_poll_hook(scheduler_poll_hook_t poll_hook) {
+	scheduler_poll_hook = poll_hook;
+}
+
+void scheduler_set_idle_low_power_mode(uint8_t low_power_mode) {
+#ifndef EPS_HOST_BUILD
+	scheduler_idle_low_power_mode = (LOW_POWER_MODE_enum_t) low_power_mode;
+#endif
+}
+
+const scheduler_job_t* scheduler_get_job(uint8_t job_id) {
+	if (job_id >= SCHEDULER_MAX_JOBS || !scheduler_jobs[job_id].is_active) {
+		return NULL;
+	}
+	return &scheduler_jobs[job_id];
+}
+
+uint32_t scheduler_get_slept_ms(void) {
+	return scheduler_slept_ms;
+}
+
+static void scheduler_run_job(scheduler_job_t *job, uint32_t start_ms) {
+	const uint32_t due_ms = job->next_due_ms;
+	const uint32_t late_ms = start_ms - due_ms;
+	if (late_ms > job->max_late_ms) {
+		job->max_late_ms = late_ms;
+	}
+
+	// Reschedule first, so that the callback may cancel or re-add itself.
+	if (job->period_ms == 0) {
+		job->is_active = 0;
+	}
+	else {
+		job->next_due_ms = due_ms + job->period_ms;
+		if ((int32_t)(start_ms - job->next_due_ms) >= 0) {
+			// more than a period behind: stay in phase, and skip the missed runs
+			const uint32_t missed_count = (start_ms - job->next_due_ms) / job->period_ms + 1;
+			job->skipped_count += missed_count;
+			job->next_due_ms += missed_count * job->period_ms;
+		}
+	}
+
+	job->callback(job->context);
+
+	const uint32_t end_ms = scheduler_now_ms();
+	const uint32_t run_ms = end_ms - start_ms;
+	if (run_ms > job->max_run_ms) {
+		job->max_run_ms = run_ms;
+	}
+	job->run_count++;
+	if (job->deadline_ms != 0 && (end_ms - due_ms) > job->deadline_ms) {
+		job->overrun_count++;
+	}
+}
+
+uint32_t scheduler_run_due_jobs(void) {
+	while (1) {
+		// the most overdue job first
+		const uint32_t now_ms = scheduler_now_ms();
+		scheduler_job_t *next_job = NULL;
+		int32_t next_due_in_ms = 0;
+		for (uint8_t job_id = 0; job_id < SCHEDULER_MAX_JOBS; job_id++) {
+			scheduler_job_t *job = &scheduler_jobs[job_id];
+			if (!job->is_active) {
+				continue;
+			}
+			const int32_t due_in_ms = (int32_t)(job->next_due_ms - now_ms);
+			if (next_job == NULL || due_in_ms < next_due_in_ms) {
+				next_job = job;
+				next_due_in_ms = due_in_ms;
+			}
+		}
+
+		if (next_job == NULL) {
+			return SCHEDULER_NO_JOB_DUE;
+		}
+		if (next_due_in_ms > 0) {
+			return next_due_in_ms;
+		}
+		scheduler_run_job(next_job, now_ms);
+	}
+}
+
+void scheduler_run_forever(void) {
+	while (1) {
+		const uint32_t next_due_in_ms = scheduler_run_due_jobs();
+
+		if (scheduler_poll_hook != NULL && scheduler_poll_hook()) {
+			// keep the 1 ms tick: sleep until the next interrupt
+			scheduler_sleep(1, 0);
+			continue;
+		}
+		if (next_due_in_ms > 0) {
+			scheduler_sleep(next_due_in_ms, 1);
+		}
+	}
+}
+
+void scheduler_debug_print_stats(void) {
+	char msg[200];
+	for (uint8_t job_id = 0; job_id < SCHEDULER_MAX_JOBS; job_id++) {
+		const scheduler_job_t *job = &scheduler_jobs[job_id];
+		if (!job->is_active) {
+			continue;
+		}
+		char *end = fmt_int_append_str(msg, "Job ");
+		end = fmt_int_append_str(end, (job->name != NULL) ? job->name : "?");
+		end = fmt_int_append_str(end, ": runs=");
+		end = fmt_int_append_u32(end, job->run_count);
+		end = fmt_int_append_str(end, ", overruns=");
+		end = fmt_int_append_u32(end, job->overrun_count);
+		end = fmt_int_append_str(end, ", skipped=");
+		end = fmt_int_append_u32(end, job->skipped_count);
+		end = fmt_int_append_str(end, ", max_late_ms=");
+		end = fmt_int_append_u32(end, job->max_late_ms);
+		end = fmt_int_append_str(end, ", max_run_ms=");
+		end = fmt_int_append_u32(end, job->max_run_ms);
+		fmt_int_append_str(end, "\n");
+		debug_uart_print_str(msg);
+	}
+
+	char *end = fmt_int_append_str(msg, "Scheduler: slept ");
+	end = fmt_int_append_u32(end, scheduler_slept_ms);
+	end = fmt_int_append_str(end, " of ");
+	end = fmt_int_append_u32(end, scheduler_now_ms());
+	fmt_int_append_str(end, " ms\n");
+	debug_uart_print_str(msg);
+}
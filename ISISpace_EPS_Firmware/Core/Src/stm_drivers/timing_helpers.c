@@ -1,4 +1,10 @@
 #include "stm_drivers/timing_helpers.h"
+#include "debug_tools/debug_uart.h"
+#include "debug_tools/fmt_int.h"
+
+static low_power_stats_t low_power_stats = { .is_measuring = 0 };
+static low_power_stop_veto_t low_power_stop_veto = NULL;
+static uint8_t low_power_is_lptim_ready = 0;
 
 void delay_ms(uint32_t delay_time_ms) {
 	HAL_Delay(delay_time_ms);
@@ -7,3 +13,270 @@ void delay_ms(uint32_t delay_time_ms) {
 uint32_t get_uptime_ms() {
 	return HAL_GetTick();
 }
+
+uint32_t get_uptime_us() {
+	uint32_t ms;
+	uint32_t val;
+	do {
+		ms = uwTick;
+		val = SysTick->VAL;
+	} while (ms != uwTick); // a tick in between: read again
+	const uint32_t ticks_per_ms = SysTick->LOAD + 1;
+	return (ms * 1000) + (((ticks_per_ms - 1 - val) * 1000) / ticks_per_ms);
+}
+
+void cycle_counter_init() {
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CYCCNT = 0;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+uint32_t cycles_to_us(uint32_t cycles) {
+	return cycles / (SystemCoreClock / 1000000);
+}
+
+static void low_power_record_sleep(uint64_t cycles) {
+	if (low_power_stats.is_measuring) {
+		low_power_stats.wait_count++;
+		low_power_stats.sleep_cycles += cycles;
+	}
+}
+
+// One WFI with the normal 1 ms SysTick
+static void low_power_sleep_until_interrupt() {
+	if (!low_power_stats.is_measuring) {
+		__WFI();
+		return;
+	}
+
+	const uint32_t primask = __get_PRIMASK();
+	__disable_irq();
+	(void) SysTick->CTRL; // reading clears COUNTFLAG
+	const uint32_t val_before = SysTick->VAL;
+	__DSB();
+	__WFI();
+	__ISB();
+	const uint32_t val_after = SysTick->VAL;
+	if (SysTick->CTRL & SysTick_CTRL_COUNTFLAG_Msk) {
+		// woken by SysTick (or something else, after the reload): the counter went through 0 once
+		low_power_record_sleep(val_before + (SysTick->LOAD + 1 - val_after));
+	}
+	else {
+		low_power_record_sleep(val_before - val_after);
+	}
+	__set_PRIMASK(primask);
+}
+
+uint32_t sleep_tickless_ms(uint32_t max_sleep_ms) {
+	// SysTick normally interrupts every 1 ms. For the sleep, its reload value is stretched to cover
+	// the whole time (up to 2^24 core clocks), then the ms that passed are added to the HAL tick.
+	const uint32_t ticks_per_ms = SystemCoreClock / 1000;
+	const uint32_t max_ms = SysTick_LOAD_RELOAD_Msk / ticks_per_ms;
+	uint32_t sleep_ms = (max_sleep_ms > max_ms) ? max_ms : max_sleep_ms;
+	if (sleep_ms <= 1) {
+		// the next SysTick is at most 1 ms away anyway
+		low_power_sleep_until_interrupt();
+		return 0;
+	}
+
+	// With interrupts masked, an interrupt still ends the WFI, but is only handled after the tick
+	// has been fixed up.
+	const uint32_t primask = __get_PRIMASK();
+	__disable_irq();
+
+	SysTick->CTRL &= ~SysTick_CTRL_ENABLE_Msk;
+	const uint32_t reload = SysTick->VAL + ((sleep_ms - 1) * ticks_per_ms); // until the end of the current ms, plus the rest
+	SysTick->LOAD = reload;
+	SysTick->VAL = 0;
+	SysTick->CTRL |= SysTick_CTRL_ENABLE_Msk;
+
+	__DSB();
+	__WFI();
+	__ISB();
+
+	SysTick->CTRL &= ~SysTick_CTRL_ENABLE_Msk;
+	const uint32_t ctrl = SysTick->CTRL; // reading clears COUNTFLAG
+	const uint32_t val = SysTick->VAL;
+	uint32_t elapsed_ms;
+	uint32_t ticks_left_in_ms;
+	if (ctrl & SysTick_CTRL_COUNTFLAG_Msk) {
+		// Slept the whole time. The pending SysTick interrupt adds the last ms.
+		elapsed_ms = sleep_ms - 1;
+		const uint32_t overshoot = reload - val;
+		low_power_record_sleep((uint64_t) reload + 1 + overshoot);
+		ticks_left_in_ms = (overshoot < ticks_per_ms) ? (ticks_per_ms - 1 - overshoot) : 0;
+	}
+	else {
+		// Woken early by another interrupt. val counts down through (sleep_ms - 1) ms boundaries.
+		const uint32_t ms_left = val / ticks_per_ms;
+		elapsed_ms = (sleep_ms - 1) - ms_left;
+		low_power_record_sleep(reload - val);
+		ticks_left_in_ms = val - (ms_left * ticks_per_ms);
+	}
+
+	// Finish the current ms, then go back to the normal 1 ms period. The counter takes the first
+	// LOAD value when it restarts, and the second one at the next reload.
+	SysTick->LOAD = (ticks_left_in_ms > 0) ? ticks_left_in_ms : (ticks_per_ms - 1);
+	SysTick->VAL = 0;
+	SysTick->CTRL |= SysTick_CTRL_ENABLE_Msk;
+	uwTick += elapsed_ms;
+	SysTick->LOAD = ticks_per_ms - 1;
+
+	__set_PRIMASK(primask);
+	return elapsed_ms;
+}
+
+
+// #pragma region Low-power waits
+
+void low_power_init(void) {
+	// LSI keeps running in Stop 2. LPTIM1 counts it /32, i.e. 1 ms per count.
+	__HAL_RCC_LSI_ENABLE();
+	while (__HAL_RCC_GET_FLAG(RCC_FLAG_LSIRDY) == 0) {
+	}
+	__HAL_RCC_LPTIM1_CONFIG(RCC_LPTIM1CLKSOURCE_LSI);
+	__HAL_RCC_LPTIM1_CLK_ENABLE();
+
+	// CFGR and IER can only be written while LPTIM1 is disabled
+	LPTIM1->CR = 0;
+	LPTIM1->CFGR = LPTIM_CFGR_PRESC_2 | LPTIM_CFGR_PRESC_0; // /32, internal clock
+	LPTIM1->IER = LPTIM_IER_ARRMIE;
+
+	// LPTIM1 wakes the CPU through EXTI line 32. Wake up on HSI16, the PLL source, so the PLL
+	// relocks without waiting for another oscillator.
+	EXTI->IMR2 |= EXTI_IMR2_IM32;
+	__HAL_RCC_WAKEUPSTOP_CLK_CONFIG(RCC_STOP_WAKEUPCLOCK_HSI);
+	HAL_NVIC_SetPriority(LPTIM1_IRQn, 0, 0);
+	HAL_NVIC_EnableIRQ(LPTIM1_IRQn);
+
+	low_power_is_lptim_ready = 1;
+}
+
+void low_power_set_stop_veto(low_power_stop_veto_t veto) {
+	low_power_stop_veto = veto;
+}
+
+void low_power_lptim_irq_handler(void) {
+	// Normally already handled by low_power_stop2(); this only catches a late match.
+	LPTIM1->ICR = LPTIM_ICR_ARRMCF;
+}
+
+static uint32_t low_power_read_lptim_count() {
+	// LPTIM1 counts on the LSI, asynchronously to the bus, so the count is read until two reads agree
+	uint32_t count;
+	do {
+		count = LPTIM1->CNT;
+	} while (count != LPTIM1->CNT);
+	return count;
+}
+
+// Returns 0 if it slept in Stop 2, or 1 if it couldn't (vetoed).
+static uint8_t low_power_stop2(uint32_t sleep_ms) {
+	const uint32_t primask = __get_PRIMASK();
+	__disable_irq();
+	if (low_power_stop_veto != NULL && low_power_stop_veto()) {
+		__set_PRIMASK(primask);
+		return 1;
+	}
+
+	// ARR can only be written while enabled, and the write takes a few LSI cycles to land
+	LPTIM1->CR = LPTIM_CR_ENABLE;
+	LPTIM1->ICR = LPTIM_ICR_ARROKCF | LPTIM_ICR_ARRMCF;
+	LPTIM1->ARR = sleep_ms;
+	while ((LPTIM1->ISR & LPTIM_ISR_ARROK) == 0) {
+	}
+	LPTIM1->CR |= LPTIM_CR_SNGSTRT;
+
+	HAL_SuspendTick();
+	HAL_PWREx_EnterSTOP2Mode(PWR_STOPENTRY_WFI);
+
+	// Running on HSI16 now: bring the PLL back. This also restarts SysTick at 1 ms.
+	SystemClock_Config();
+
+	const uint32_t elapsed_ms = (LPTIM1->ISR & LPTIM_ISR_ARRM) ? sleep_ms : low_power_read_lptim_count();
+	LPTIM1->ICR = LPTIM_ICR_ARRMCF;
+	LPTIM1->CR = 0; // stopped; counts from 0 again next time
+	NVIC_ClearPendingIRQ(LPTIM1_IRQn);
+
+	uwTick += elapsed_ms;
+	HAL_ResumeTick();
+	if (low_power_stats.is_measuring) {
+		low_power_stats.stop2_count++;
+		low_power_record_sleep((uint64_t) elapsed_ms * (SystemCoreClock / 1000));
+	}
+
+	__set_PRIMASK(primask);
+	return 0;
+}
+
+void low_power_wait_until_ms(uint32_t wake_time_ms, LOW_POWER_MODE_enum_t max_mode) {
+	const int32_t wait_ms = (int32_t)(wake_time_ms - get_uptime_ms());
+	if (wait_ms <= 0) {
+		return;
+	}
+
+	if (max_mode >= LOW_POWER_MODE_STOP2 && low_power_is_lptim_ready && wait_ms >= LOW_POWER_STOP2_MIN_MS) {
+		const uint32_t stop_ms = (wait_ms > LOW_POWER_STOP2_MAX_MS) ? LOW_POWER_STOP2_MAX_MS : wait_ms;
+		if (low_power_stop2(stop_ms) == 0) {
+			return;
+		}
+	}
+	if (max_mode >= LOW_POWER_MODE_SLEEP_TICKLESS) {
+		sleep_tickless_ms(wait_ms);
+		return;
+	}
+	low_power_sleep_until_interrupt();
+}
+
+void low_power_measure_start(void) {
+	low_power_stats.wait_count = 0;
+	low_power_stats.stop2_count = 0;
+	low_power_stats.sleep_cycles = 0;
+	low_power_stats.start_ms = get_uptime_ms();
+	low_power_stats.is_measuring = 1;
+}
+
+void low_power_measure_stop(void) {
+	low_power_stats.is_measuring = 0;
+}
+
+const low_power_stats_t* low_power_get_stats(void) {
+	return &low_power_stats;
+}
+
+static uint64_t low_power_get_elapsed_cycles() {
+	return (uint64_t)(get_uptime_ms() - low_power_stats.start_ms) * (SystemCoreClock / 1000);
+}
+
+uint64_t low_power_get_active_cycles(void) {
+	// Sleep is measured in cycles but the elapsed time in ms, so this can dip below 0 briefly
+	const uint64_t elapsed_cycles = low_power_get_elapsed_cycles();
+	return (elapsed_cycles > low_power_stats.sleep_cycles) ? (elapsed_cycles - low_power_stats.sleep_cycles) : 0;
+}
+
+void low_power_debug_print_stats(void) {
+	const uint64_t elapsed_cycles = low_power_get_elapsed_cycles();
+	const uint64_t active_cycles = low_power_get_active_cycles();
+	const uint32_t active_permille = (elapsed_cycles > 0) ? (uint32_t)((active_cycles * 1000) / elapsed_cycles) : 0;
+	const uint32_t cycles_per_ms = SystemCoreClock / 1000;
+
+	char msg[120];
+	char *end = fmt_int_append_str(msg, "Low-power: active ");
+	end = fmt_int_append_u32(end, (uint32_t)(active_cycles / 1000));
+	end = fmt_int_append_str(end, " kcycles (");
+	end = fmt_int_append_u32(end, active_permille / 10);
+	end = fmt_int_append_str(end, ".");
+	end = fmt_int_append_u32(end, active_permille % 10);
+	end = fmt_int_append_str(end, "%), asleep ");
+	end = fmt_int_append_u32(end, (uint32_t)(low_power_stats.sleep_cycles / cycles_per_ms));
+	end = fmt_int_append_str(end, " of ");
+	end = fmt_int_append_u32(end, (uint32_t)(elapsed_cycles / cycles_per_ms));
+	end = fmt_int_append_str(end, " ms, ");
+	end = fmt_int_append_u32(end, low_power_stats.wait_count);
+	end = fmt_int_append_str(end, " waits (");
+	end = fmt_int_append_u32(end, low_power_stats.stop2_count);
+	end = fmt_int_append_str(end, " in Stop 2)\n");
+	debug_uart_print_str(msg);
+}
+
+// #pragma endregion Low-power waits
@@ -0,0 +1,109 @@
+#include "main.h"
+
+#include "stm_drivers/uart_rx_dma.h"
+
+#include <stdint.h>
+
+// The HAL callbacks below are global, so keep track of which uart_rx_dma_t belongs to which UART.
+static uart_rx_dma_t *uart_rx_dma_instances[UART_RX_DMA_MAX_INSTANCES] = {0};
+
+
+static uart_rx_dma_t* uart_rx_dma_find_instance(const UART_HandleTypeDef *huart) {
+	for (uint8_t i = 0; i < UART_RX_DMA_MAX_INSTANCES; i++) {
+		if (uart_rx_dma_instances[i] != NULL && uart_rx_dma_instances[i]->huart == huart) {
+			return uart_rx_dma_instances[i];
+		}
+	}
+	return NULL;
+}
+
+static uint8_t uart_rx_dma_begin_reception(uart_rx_dma_t *rx) {
+	rx->write_idx = 0;
+	rx->read_idx = 0;
+	if (HAL_UARTEx_ReceiveToIdle_DMA(rx->huart, rx->buf, rx->buf_len) != HAL_OK) {
+		return 2;
+	}
+	return 0;
+}
+
+uint8_t uart_rx_dma_start(uart_rx_dma_t *rx, UART_HandleTypeDef *huart, uint8_t buf[], uint16_t buf_len) {
+	// The DMA must be linked to the UART (__HAL_LINKDMA in HAL_UART_MspInit) and be circular.
+	if (huart->hdmarx == NULL || huart->hdmarx->Init.Mode != DMA_CIRCULAR) {
+		return 1;
+	}
+
+	rx->huart = huart;
+	rx->buf = buf;
+	rx->buf_len = buf_len;
+	rx->rx_event_count = 0;
+	rx->restart_count = 0;
+
+	// register the instance (re-use the slot if this UART was started before)
+	uint8_t registered = 0;
+	for (uint8_t i = 0; i < UART_RX_DMA_MAX_INSTANCES; i++) {
+		if (uart_rx_dma_instances[i] == NULL || uart_rx_dma_instances[i]->huart == huart) {
+			uart_rx_dma_instances[i] = rx;
+			registered = 1;
+			break;
+		}
+	}
+	if (!registered) {
+		return 3;
+	}
+
+	return uart_rx_dma_begin_reception(rx);
+}
+
+uint16_t uart_rx_dma_available(const uart_rx_dma_t *rx) {
+	const uint16_t write_idx = rx->write_idx;
+	if (write_idx >= rx->read_idx) {
+		return write_idx - rx->read_idx;
+	}
+	return rx->buf_len - rx->read_idx + write_idx;
+}
+
+uint16_t uart_rx_dma_read(uart_rx_dma_t *rx, uint8_t dest[], uint16_t dest_len) {
+	uint16_t read_count = 0;
+	const uint16_t write_idx = rx->write_idx; // snapshot; the ISR may advance it while we copy
+
+	while (rx->read_idx != write_idx && read_count < dest_len) {
+		dest[read_count++] = rx->buf[rx->read_idx];
+		rx->read_idx++;
+		if (rx->read_idx >= rx->buf_len) {
+			rx->read_idx = 0;
+		}
+	}
+	return read_count;
+}
+
+void uart_rx_dma_flush(uart_rx_dma_t *rx) {
+	// Discard anything already received (e.g., a late response to a previous command).
+	// Also pick up bytes that the DMA has written, but that haven't triggered an RxEvent yet.
+	const uint16_t dma_pos = rx->buf_len - __HAL_DMA_GET_COUNTER(rx->huart->hdmarx);
+	rx->write_idx = (dma_pos >= rx->buf_len) ? 0 : dma_pos;
+	rx->read_idx = rx->write_idx;
+}
+
+
+// Called by the HAL on idle-line, half-transfer, and transfer-complete events.
+// In circular mode, `Size` is the DMA write position within the buffer.
+void HAL_UARTEx_RxEventCallback(UART_HandleTypeDef *huart, uint16_t Size) {
+	uart_rx_dma_t *rx = uart_rx_dma_find_instance(huart);
+	if (rx == NULL) {
+		return;
+	}
+
+	rx->write_idx = (Size >= rx->buf_len) ? 0 : Size;
+	rx->rx_event_count++;
+}
+
+// The HAL aborts the DMA reception on errors like overrun/noise/framing. Start it again.
+void HAL_UART_ErrorCallback(UART_HandleTypeDef *huart) {
+	uart_rx_dma_t *rx = uart_rx_dma_find_instance(huart);
+	if (rx == NULL) {
+		return;
+	}
+
+	rx->restart_count++;
+	uart_rx_dma_begin_reception(rx);
+}
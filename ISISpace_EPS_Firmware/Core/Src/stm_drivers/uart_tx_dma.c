@@ -0,0 +1,170 @@
+#include "main.h"
+
+#include "stm_drivers/uart_tx_dma.h"
+
+#include <stdint.h>
+#include <string.h>
+
+// HAL_UART_TxCpltCallback is global, so keep track of which uart_tx_dma_t belongs to which UART.
+static uart_tx_dma_t *uart_tx_dma_instances[UART_TX_DMA_MAX_INSTANCES] = {0};
+
+
+static uart_tx_dma_t* uart_tx_dma_find_instance(const UART_HandleTypeDef *huart) {
+	for (uint8_t i = 0; i < UART_TX_DMA_MAX_INSTANCES; i++) {
+		if (uart_tx_dma_instances[i] != NULL && uart_tx_dma_instances[i]->huart == huart) {
+			return uart_tx_dma_instances[i];
+		}
+	}
+	return NULL;
+}
+
+// Starts a DMA transfer of the contiguous bytes from read_idx (up to the write index or the end of the buffer).
+// Must only be called while the DMA is idle, with the TxCplt interrupt unable to run.
+static void uart_tx_dma_start_next(uart_tx_dma_t *tx) {
+	const uint16_t write_idx = tx->write_idx;
+	const uint16_t read_idx = tx->read_idx;
+	if (write_idx == read_idx) {
+		tx->in_flight_len = 0;
+		return;
+	}
+
+	const uint16_t chunk_len = (write_idx > read_idx) ? (write_idx - read_idx) : (tx->buf_len - read_idx);
+	tx->in_flight_len = chunk_len;
+	if (HAL_UART_Transmit_DMA(tx->huart, &tx->buf[read_idx], chunk_len) != HAL_OK) {
+		// Leave the bytes queued; the next write tries again.
+		tx->in_flight_len = 0;
+	}
+}
+
+uint8_t uart_tx_dma_init(uart_tx_dma_t *tx, UART_HandleTypeDef *huart, uint8_t buf[], uint16_t buf_len) {
+	// The DMA must be linked to the UART (__HAL_LINKDMA in HAL_UART_MspInit) and not be circular.
+	if (huart->hdmatx == NULL || huart->hdmatx->Init.Mode != DMA_NORMAL || buf_len < 2) {
+		return 1;
+	}
+
+	tx->huart = huart;
+	tx->buf = buf;
+	tx->buf_len = buf_len;
+	tx->write_idx = 0;
+	tx->read_idx = 0;
+	tx->in_flight_len = 0;
+	tx->dropped_msg_count = 0;
+	tx->dropped_byte_count = 0;
+
+	// register the instance (re-use the slot if this UART was initialized before)
+	for (uint8_t i = 0; i < UART_TX_DMA_MAX_INSTANCES; i++) {
+		if (uart_tx_dma_instances[i] == NULL || uart_tx_dma_instances[i]->huart == huart) {
+			uart_tx_dma_instances[i] = tx;
+			return 0;
+		}
+	}
+	return 3;
+}
+
+uint16_t uart_tx_dma_pending(const uart_tx_dma_t *tx) {
+	const uint16_t write_idx = tx->write_idx;
+	const uint16_t read_idx = tx->read_idx;
+	if (write_idx >= read_idx) {
+		return write_idx - read_idx;
+	}
+	return tx->buf_len - read_idx + write_idx;
+}
+
+uint16_t uart_tx_dma_free(const uart_tx_dma_t *tx) {
+	// One slot stays empty, so that write_idx == read_idx always means "empty".
+	return tx->buf_len - 1 - uart_tx_dma_pending(tx);
+}
+
+void uart_tx_dma_count_drop(uart_tx_dma_t *tx, uint32_t len) {
+	tx->dropped_msg_count++;
+	tx->dropped_byte_count += len;
+}
+
+uint8_t uart_tx_dma_write(uart_tx_dma_t *tx, const uint8_t data[], uint16_t len) {
+	if (len == 0) {
+		return 0;
+	}
+
+	if (len > uart_tx_dma_free(tx)) {
+		uart_tx_dma_count_drop(tx, len);
+		return 1;
+	}
+
+	// Copy in at most 2 pieces (before and after the wrap).
+	const uint16_t write_idx = tx->write_idx;
+	uint16_t first_len = tx->buf_len - write_idx;
+	if (first_len > len) {
+		first_len = len;
+	}
+	memcpy(&tx->buf[write_idx], data, first_len);
+	memcpy(&tx->buf[0], &data[first_len], len - first_len);
+
+	// Publish the bytes only once they're in the buffer.
+	__DMB();
+	const uint16_t new_write_idx = write_idx + len;
+	tx->write_idx = (new_write_idx >= tx->buf_len) ? (new_write_idx - tx->buf_len) : new_write_idx;
+
+	// Kick the DMA if it's idle. Masked so the TxCplt callback can't start a transfer at the same time.
+	if (tx->in_flight_len == 0) {
+		const uint32_t primask = __get_PRIMASK();
+		__disable_irq();
+		if (tx->in_flight_len == 0) {
+			uart_tx_dma_start_next(tx);
+		}
+		__set_PRIMASK(primask);
+	}
+	return 0;
+}
+
+void uart_tx_dma_transmit_polling(uart_tx_dma_t *tx, const uint8_t data[], uint16_t len) {
+	// Register access only: no HAL lock or tick, which may be unusable in a fault handler.
+	USART_TypeDef *uart = tx->huart->Instance;
+	for (uint16_t i = 0; i < len; i++) {
+		while (!READ_BIT(uart->ISR, USART_ISR_TXE_TXFNF)) {
+		}
+		uart->TDR = data[i];
+	}
+	while (!READ_BIT(uart->ISR, USART_ISR_TC)) {
+	}
+}
+
+void uart_tx_dma_flush_blocking(uart_tx_dma_t *tx) {
+	USART_TypeDef *uart = tx->huart->Instance;
+
+	// Stop the DMA, and find how far it got.
+	CLEAR_BIT(uart->CR3, USART_CR3_DMAT);
+	uint16_t read_idx = tx->read_idx;
+	if (tx->in_flight_len > 0) {
+		const uint16_t sent_len = tx->in_flight_len - __HAL_DMA_GET_COUNTER(tx->huart->hdmatx);
+		__HAL_DMA_DISABLE(tx->huart->hdmatx);
+		read_idx += sent_len;
+		if (read_idx >= tx->buf_len) {
+			read_idx -= tx->buf_len;
+		}
+	}
+
+	const uint16_t write_idx = tx->write_idx;
+	if (write_idx < read_idx) {
+		uart_tx_dma_transmit_polling(tx, &tx->buf[read_idx], tx->buf_len - read_idx);
+		read_idx = 0;
+	}
+	uart_tx_dma_transmit_polling(tx, &tx->buf[read_idx], write_idx - read_idx);
+
+	tx->read_idx = write_idx;
+	tx->in_flight_len = 0;
+	tx->huart->gState = HAL_UART_STATE_READY;
+}
+
+
+// Called by the HAL when a DMA transfer has been sent. Continue with the next queued bytes.
+void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart) {
+	uart_tx_dma_t *tx = uart_tx_dma_find_instance(huart);
+	if (tx == NULL) {
+		return;
+	}
+
+	const uint16_t new_read_idx = tx->read_idx + tx->in_flight_len;
+	tx->read_idx = (new_read_idx >= tx->buf_len) ? (new_read_idx - tx->buf_len) : new_read_idx;
+	tx->in_flight_len = 0;
+	uart_tx_dma_start_next(tx);
+}
@@ -0,0 +1,246 @@
+// channel_telemetry_check.c
+// Host tool: checks that the Cortex-M4 SIMD kernels of eps_channel_telemetry.c (SMLAD, SSUB16+SEL,
+// QSUB16) give the same results as the portable loops, over random and edge-case columns. The SIMD
+// kernels are built into this file against emulated CMSIS intrinsics (renamed simd_*), and the
+// portable ones come from the normal host build of eps_channel_telemetry.c.
+// Also checks that the column decode (eps_get_pdu/piu_channel_telemetry()) matches the AoS decode
+// (eps_get_pdu/piu_housekeeping_data_eng()) on the simulated EPS.
+// Built with every host-buildable driver file (see eps_sim.h):
+//   cd Tools; S=$(ls ../Core/Src/eps_drivers/*.c ../Core/Src/debug_tools/*.c | grep -v -e _i2c -e transport_uart)
+//   gcc -O2 -DEPS_HOST_BUILD -I../Core/Inc -o channel_telemetry_check channel_telemetry_check.c $S
+// Usage: ./channel_telemetry_check [random column count, default 200000]
+// Exits with 0 if both kernel paths match.
+
+#include "eps_drivers/eps_channel_telemetry.h"
+#include "eps_drivers/eps_commands.h"
+#include "eps_drivers/eps_hk_cache.h"
+#include "eps_drivers/eps_internal_drivers.h"
+#include "eps_drivers/eps_sim.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define CHANNEL_COUNT EPS_CHANNEL_TELEMETRY_CHANNEL_COUNT
+#define SIM_RESPONSE_COUNT 20
+
+static uint32_t fail_count = 0;
+
+#define CHECK(condition) do { \
+		if (!(condition)) { \
+			printf("FAIL line %d: %s\n", __LINE__, #condition); \
+			fail_count++; \
+		} \
+	} while (0)
+
+static uint32_t random_state = 1;
+
+// xorshift32
+static uint32_t get_random() {
+	random_state ^= random_state << 13;
+	random_state ^= random_state >> 17;
+	random_state ^= random_state << 5;
+	return random_state;
+}
+
+
+// #pragma region Emulated intrinsics
+// As in the ARMv7-M architecture manual: each 32-bit word holds two int16 lanes, and SSUB16 sets
+// the GE flags of each lane (all of its bytes) where a - b >= 0, which SEL then reads.
+
+static uint8_t emulated_ge_low = 0;
+static uint8_t emulated_ge_high = 0;
+
+static int32_t lane(uint32_t pair, uint8_t high) {
+	return (int16_t)(high ? (pair >> 16) : pair);
+}
+
+static uint32_t make_pair(int32_t low, int32_t high) {
+	return (uint16_t) low | ((uint32_t)(uint16_t) high << 16);
+}
+
+static int32_t saturate_int16(int32_t value) {
+	return (value > INT16_MAX) ? INT16_MAX : (value < INT16_MIN) ? INT16_MIN : value;
+}
+
+static uint32_t emulated_SMLAD(uint32_t x, uint32_t y, uint32_t sum) {
+	return sum + (uint32_t)(lane(x, 0) * lane(y, 0)) + (uint32_t)(lane(x, 1) * lane(y, 1));
+}
+
+static uint32_t emulated_SSUB16(uint32_t a, uint32_t b) {
+	const int32_t diff_low = lane(a, 0) - lane(b, 0);
+	const int32_t diff_high = lane(a, 1) - lane(b, 1);
+	emulated_ge_low = (diff_low >= 0);
+	emulated_ge_high = (diff_high >= 0);
+	return make_pair(diff_low, diff_high); // wraps
+}
+
+static uint32_t emulated_SEL(uint32_t a, uint32_t b) {
+	return make_pair(lane(emulated_ge_low ? a : b, 0), lane(emulated_ge_high ? a : b, 1));
+}
+
+static uint32_t emulated_QSUB16(uint32_t a, uint32_t b) {
+	return make_pair(saturate_int16(lane(a, 0) - lane(b, 0)), saturate_int16(lane(a, 1) - lane(b, 1)));
+}
+
+// #pragma endregion Emulated intrinsics
+
+
+// #pragma region SIMD kernels
+// The firmware file with the SIMD path forced on, and its public functions renamed so that they
+// don't clash with the portable ones linked in.
+
+#define __SMLAD emulated_SMLAD
+#define __SSUB16 emulated_SSUB16
+#define __SEL emulated_SEL
+#define __QSUB16 emulated_QSUB16
+#define EPS_CHANNEL_TELEMETRY_USE_SIMD 1
+#define eps_get_pdu_channel_telemetry simd_eps_get_pdu_channel_telemetry
+#define eps_get_piu_channel_telemetry simd_eps_get_piu_channel_telemetry
+#define eps_channel_telemetry_on_mask simd_eps_channel_telemetry_on_mask
+#define eps_channel_telemetry_overcurrent_fault_mask simd_eps_channel_telemetry_overcurrent_fault_mask
+#define eps_channel_sum simd_eps_channel_sum
+#define eps_channel_min_max simd_eps_channel_min_max
+#define eps_channel_threshold_mask simd_eps_channel_threshold_mask
+#define eps_channel_delta simd_eps_channel_delta
+
+#include "../Core/Src/eps_drivers/eps_channel_telemetry.c"
+
+#undef eps_get_pdu_channel_telemetry
+#undef eps_get_piu_channel_telemetry
+#undef eps_channel_telemetry_on_mask
+#undef eps_channel_telemetry_overcurrent_fault_mask
+#undef eps_channel_sum
+#undef eps_channel_min_max
+#undef eps_channel_threshold_mask
+#undef eps_channel_delta
+
+// #pragma endregion SIMD kernels
+
+
+// #pragma region Kernel parity
+
+static void check_column(const int16_t column[], const int16_t previous[]) {
+	CHECK(simd_eps_channel_sum(column) == eps_channel_sum(column));
+
+	eps_channel_min_max_t simd_min_max, portable_min_max;
+	simd_eps_channel_min_max(column, &simd_min_max);
+	eps_channel_min_max(column, &portable_min_max);
+	CHECK(memcmp(&simd_min_max, &portable_min_max, sizeof(eps_channel_min_max_t)) == 0);
+
+	const int16_t thresholds[] = { INT16_MIN, -1, 0, 1, INT16_MAX - 1, INT16_MAX, column[0], column[CHANNEL_COUNT - 1], (int16_t) get_random() };
+	for (uint8_t threshold_num = 0; threshold_num < sizeof(thresholds) / sizeof(int16_t); threshold_num++) {
+		CHECK(simd_eps_channel_threshold_mask(column, thresholds[threshold_num]) == eps_channel_threshold_mask(column, thresholds[threshold_num]));
+	}
+
+	int16_t simd_delta[CHANNEL_COUNT], portable_delta[CHANNEL_COUNT];
+	simd_eps_channel_delta(column, previous, simd_delta);
+	eps_channel_delta(column, previous, portable_delta);
+	CHECK(memcmp(simd_delta, portable_delta, sizeof(simd_delta)) == 0);
+}
+
+// A value from a small set (so that there are ties for min/max), the int16 extremes, or anything
+static int16_t get_random_value() {
+	const uint32_t random = get_random();
+	switch (random % 4) {
+		case 0: return (int16_t)((random >> 8) % 8) - 4;
+		case 1: return (random & 0x100) ? INT16_MAX : INT16_MIN;
+		default: return (int16_t)(random >> 8);
+	}
+}
+
+static void check_kernels(uint32_t column_count) {
+	int16_t column[CHANNEL_COUNT], previous[CHANNEL_COUNT];
+
+	// Edge cases: all equal, and the extremes side by side (sum, saturating delta, lane order)
+	const int16_t fill_values[] = { 0, -1, INT16_MIN, INT16_MAX };
+	for (uint8_t fill_num = 0; fill_num < sizeof(fill_values) / sizeof(int16_t); fill_num++) {
+		for (uint8_t i = 0; i < CHANNEL_COUNT; i++) {
+			column[i] = fill_values[fill_num];
+			previous[i] = fill_values[sizeof(fill_values) / sizeof(int16_t) - 1 - fill_num];
+		}
+		check_column(column, previous);
+	}
+	for (uint8_t i = 0; i < CHANNEL_COUNT; i++) {
+		column[i] = (i % 2) ? INT16_MAX : INT16_MIN;
+		previous[i] = (i % 2) ? INT16_MIN : INT16_MAX;
+	}
+	check_column(column, previous);
+	check_column(previous, column);
+
+	for (uint32_t column_num = 0; column_num < column_count; column_num++) {
+		for (uint8_t i = 0; i < CHANNEL_COUNT; i++) {
+			column[i] = get_random_value();
+			previous[i] = get_random_value();
+		}
+		check_column(column, previous);
+	}
+}
+
+// #pragma endregion Kernel parity
+
+
+// #pragma region Column vs AoS decode
+
+static void check_columns_match(const eps_channel_telemetry_t *telemetry, const eps_vpid_eng_t vip_each_channel[]) {
+	for (uint8_t ch_num = 0; ch_num < CHANNEL_COUNT; ch_num++) {
+		CHECK(telemetry->voltage_mV[ch_num] == vip_each_channel[ch_num].voltage_mV);
+		CHECK(telemetry->current_mA[ch_num] == vip_each_channel[ch_num].current_mA);
+		CHECK(telemetry->power_cW[ch_num] == vip_each_channel[ch_num].power_cW);
+	}
+}
+
+static void check_decode() {
+	static eps_result_pdu_housekeeping_data_eng_t pdu;
+	static eps_result_piu_housekeeping_data_eng_t piu;
+	eps_channel_telemetry_t pdu_telemetry, piu_telemetry;
+
+	for (uint8_t response_num = 0; response_num < SIM_RESPONSE_COUNT; response_num++) {
+		const uint32_t channels = get_random();
+		eps_output_bus_group_off(0xFFFF, 0xFFFF);
+		eps_output_bus_group_on(channels & 0xFFFF, channels >> 16);
+		eps_hk_cache_invalidate_all();
+
+		CHECK(eps_get_pdu_housekeeping_data_eng(&pdu) == 0);
+		CHECK(eps_get_pdu_channel_telemetry(&pdu_telemetry) == 0);
+		check_columns_match(&pdu_telemetry, pdu.vip_each_channel);
+		CHECK(pdu_telemetry.stat_ch_on_bitfield == pdu.stat_ch_on_bitfield);
+		CHECK(pdu_telemetry.stat_ch_ext_on_bitfield == pdu.stat_ch_ext_on_bitfield);
+		CHECK(pdu_telemetry.stat_ch_overcurrent_fault_bitfield == pdu.stat_ch_overcurrent_fault_bitfield);
+		CHECK(pdu_telemetry.stat_ch_ext_overcurrent_fault_bitfield == pdu.stat_ch_ext_overcurrent_fault_bitfield);
+		CHECK(eps_channel_telemetry_on_mask(&pdu_telemetry) == channels);
+
+		CHECK(eps_get_piu_housekeeping_data_eng(&piu) == 0);
+		CHECK(eps_get_piu_channel_telemetry(&piu_telemetry) == 0);
+		check_columns_match(&piu_telemetry, piu.vip_each_channel);
+		CHECK(piu_telemetry.stat_ch_on_bitfield == piu.stat_ch_on_bitfield);
+		CHECK(piu_telemetry.stat_ch_ext_on_bitfield == piu.stat_ch_ext_on_bitfield);
+		CHECK(piu_telemetry.stat_ch_overcurrent_fault_bitfield == piu.stat_ch_overcurrent_fault_bitfield);
+		CHECK(piu_telemetry.stat_ch_ext_overcurrent_fault_bitfield == piu.stat_ch_ext_overcurrent_fault_bitfield);
+
+		// Real data through both kernel paths
+		check_column(pdu_telemetry.current_mA, piu_telemetry.current_mA);
+		check_column(pdu_telemetry.power_cW, pdu_telemetry.voltage_mV);
+	}
+}
+
+// #pragma endregion Column vs AoS decode
+
+
+int main(int argc, char *argv[]) {
+	const uint32_t column_count = (argc > 1) ? (uint32_t) strtoul(argv[1], NULL, 0) : 200000;
+
+	check_kernels(column_count);
+
+	eps_set_transport(&eps_transport_sim);
+	check_decode();
+
+	if (fail_count != 0) {
+		printf("FAIL: %lu checks\n", (unsigned long) fail_count);
+		return 1;
+	}
+	printf("%lu random columns and %u sim responses match\n", (unsigned long) column_count, SIM_RESPONSE_COUNT);
+	puts("OK");
+	return 0;
+}
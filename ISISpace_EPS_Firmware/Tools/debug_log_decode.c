@@ -0,0 +1,142 @@
+// debug_log_decode.c
+// Host tool: turns the Debug UART stream from DEBUG_LOG_MODE_TOKENIZED (see debug_log.h) back into
+// text. Plain text in the stream (debug_uart_print_str) is passed through. Decoded records are
+// prefixed with their timestamp in seconds; "[+...]" until the first absolute timestamp is seen.
+//
+// The format table is compiled in from Core/Inc/debug_tools/debug_log_formats.h, so build this from
+// the same revision as the firmware:
+//   cd Tools; S=../Core/Src/debug_tools
+//   gcc -O2 -DEPS_HOST_BUILD -I../Core/Inc -o debug_log_decode debug_log_decode.c $S/debug_log.c $S/debug_uart.c $S/fmt_int.c $S/hex_dump.c
+// Usage (-x: print hex dumps like xxd):
+//   stty -F /dev/ttyACM0 115200 raw && ./debug_log_decode < /dev/ttyACM0
+//   ./debug_log_decode [-x] capture.bin
+
+#include "debug_tools/debug_log.h"
+#include "debug_tools/hex_dump.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+static FILE *in_file;
+static uint8_t hex_style_xxd = 0;
+static uint8_t has_abs_time = 0;
+static uint32_t time_ms = 0;
+
+// Returns 0 on success, 1 at the end of the input.
+static uint8_t read_varint(uint32_t *value_dest) {
+	uint32_t value = 0;
+	for (uint8_t shift = 0; shift < 35; shift += 7) {
+		const int c = fgetc(in_file);
+		if (c == EOF) {
+			return 1;
+		}
+		value |= (uint32_t)(c & 0x7F) << shift;
+		if ((c & 0x80) == 0) {
+			break;
+		}
+	}
+	*value_dest = value;
+	return 0;
+}
+
+static void print_timestamp() {
+	if (has_abs_time) {
+		printf("[%6lu.%03lu] ", (unsigned long)(time_ms / 1000), (unsigned long)(time_ms % 1000));
+	}
+	else {
+		printf("[+%5lu.%03lu] ", (unsigned long)(time_ms / 1000), (unsigned long)(time_ms % 1000));
+	}
+}
+
+// Returns 0 on success, 1 at the end of the input, 2 for an unknown format ID.
+static uint8_t decode_record(uint8_t sync) {
+	uint32_t id;
+	uint32_t timestamp;
+	if (read_varint(&id) != 0 || read_varint(&timestamp) != 0) {
+		return 1;
+	}
+	const char *format = debug_log_get_format(id);
+	if (format == NULL) {
+		printf("<unknown log format ID %lu; is the decoder from the same build as the firmware?>\n", (unsigned long)id);
+		return 2;
+	}
+
+	if (sync & DEBUG_LOG_SYNC_FLAG_ABS_TIME) {
+		time_ms = timestamp;
+		has_abs_time = 1;
+	}
+	else {
+		time_ms += timestamp;
+	}
+	print_timestamp();
+
+	if (sync & DEBUG_LOG_SYNC_FLAG_HEX) {
+		uint32_t len;
+		if (read_varint(&len) != 0) {
+			return 1;
+		}
+		fputs(format, stdout);
+		if (hex_style_xxd) {
+			fputs("\n", stdout);
+		}
+		for (uint32_t offset = 0; offset < len; offset += HEX_DUMP_LINE_BYTES) {
+			uint8_t data[HEX_DUMP_LINE_BYTES];
+			const size_t chunk_len = (len - offset < HEX_DUMP_LINE_BYTES) ? (len - offset) : HEX_DUMP_LINE_BYTES;
+			if (fread(data, 1, chunk_len, in_file) != chunk_len) {
+				return 1;
+			}
+			char text[HEX_DUMP_LINE_BYTES * HEX_DUMP_BYTES_CHARS_PER_BYTE]; // fits a line in either style
+			const size_t text_len = hex_style_xxd ?
+					hex_dump_encode_line(text, offset, data, chunk_len) : hex_dump_encode_bytes(text, data, chunk_len);
+			fwrite(text, 1, text_len, stdout);
+		}
+		if (!hex_style_xxd) {
+			fputs("\n", stdout);
+		}
+		return 0;
+	}
+
+	uint32_t args[DEBUG_LOG_MAX_ARGS];
+	const uint8_t arg_count = debug_log_count_args(format);
+	for (uint8_t i = 0; i < arg_count && i < DEBUG_LOG_MAX_ARGS; i++) {
+		if (read_varint(&args[i]) != 0) {
+			return 1;
+		}
+	}
+	char text[DEBUG_LOG_MAX_TEXT_LEN];
+	debug_log_format(text, sizeof(text), format, args, arg_count);
+	fputs(text, stdout);
+	return 0;
+}
+
+int main(int argc, char *argv[]) {
+	in_file = stdin;
+	int arg_num = 1;
+	if (arg_num < argc && strcmp(argv[arg_num], "-x") == 0) {
+		hex_style_xxd = 1;
+		arg_num++;
+	}
+	if (arg_num < argc) {
+		in_file = fopen(argv[arg_num], "rb");
+		if (in_file == NULL) {
+			perror(argv[arg_num]);
+			return 1;
+		}
+	}
+	setvbuf(stdout, NULL, _IOLBF, 0);
+
+	int c;
+	while ((c = fgetc(in_file)) != EOF) {
+		if ((c & DEBUG_LOG_SYNC_MASK) == DEBUG_LOG_SYNC_BASE) {
+			if (decode_record((uint8_t)c) == 1) {
+				break;
+			}
+		}
+		else if (c < 0x80) {
+			fputc(c, stdout);
+		}
+		// other bytes >= 0x80: line noise or the middle of a cut record; skip until the next sync byte
+	}
+	return 0;
+}
@@ -0,0 +1,169 @@
+// fmt_int_bench.c
+// Compares fmt_int with the snprintf formats it replaced: the same text for random and edge values,
+// and the time per call. Timed with timing_probe_now(), so the same code gives DWT cycles on the
+// target and ns on the host.
+// On the host (main() below), built with the files it uses:
+//   cd Tools; S=../Core/Src/debug_tools
+//   gcc -O2 -DEPS_HOST_BUILD -I../Core/Inc -o fmt_int_bench fmt_int_bench.c $S/fmt_int.c $S/timing_probe.c $S/debug_uart.c $S/hex_dump.c
+//   ./fmt_int_bench (exits with 0 if every value matches)
+// On the target: add this file to the build, then after cycle_counter_init() and debug_uart_init(),
+// call fmt_int_bench_run(); the results go to the Debug UART. Its snprintf calls pull in newlib's
+// printf, so don't leave it in a flight build.
+
+#include "debug_tools/debug_uart.h"
+#include "debug_tools/fmt_int.h"
+#include "debug_tools/timing_probe.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define FMT_INT_BENCH_VALUE_COUNT 256 // power of 2
+#define FMT_INT_BENCH_CALLS 10000
+#define FMT_INT_BENCH_CHECK_ROUNDS 1000 // times through the values (with new ones each time)
+
+static int32_t fmt_int_bench_values[FMT_INT_BENCH_VALUE_COUNT];
+static uint32_t fmt_int_bench_random_state = 1;
+
+static const int32_t fmt_int_bench_edge_values[] = {
+	0, 1, -1, 9, 10, 99, 100, 101, 999, 1000, 65535, -32768, 1000000000, -1000000000, INT32_MAX, INT32_MIN,
+};
+
+// xorshift32, so the host and target use the same values
+static uint32_t fmt_int_bench_random() {
+	uint32_t x = fmt_int_bench_random_state;
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	fmt_int_bench_random_state = x;
+	return x;
+}
+
+// Every digit count, and the edge values at the start
+static void fmt_int_bench_fill_values() {
+	for (uint16_t i = 0; i < FMT_INT_BENCH_VALUE_COUNT; i++) {
+		const uint32_t random = fmt_int_bench_random();
+		fmt_int_bench_values[i] = (int32_t) random >> (random % 31);
+	}
+	memcpy(fmt_int_bench_values, fmt_int_bench_edge_values, sizeof(fmt_int_bench_edge_values));
+}
+
+
+// #pragma region Check
+
+// Returns 1 (and prints both) if they differ. fmt_len chars of fmt_text, no terminator.
+static uint8_t fmt_int_bench_compare(const char *name, const char *fmt_text, uint8_t fmt_len, const char *snprintf_text) {
+	if (strlen(snprintf_text) == fmt_len && memcmp(fmt_text, snprintf_text, fmt_len) == 0) {
+		return 0;
+	}
+	char line[80];
+	snprintf(line, sizeof(line), "%s: \"%.*s\" vs snprintf \"%s\"\n", name, fmt_len, fmt_text, snprintf_text);
+	debug_uart_print_str(line);
+	return 1;
+}
+
+static uint32_t fmt_int_bench_check_value(int32_t value) {
+	char fmt_text[24];
+	char snprintf_text[24];
+	uint32_t mismatch_count = 0;
+
+	snprintf(snprintf_text, sizeof(snprintf_text), "%ld", (long) value);
+	mismatch_count += fmt_int_bench_compare("i32", fmt_text, fmt_int_i32(fmt_text, value), snprintf_text);
+
+	snprintf(snprintf_text, sizeof(snprintf_text), "%lu", (unsigned long)(uint32_t) value);
+	mismatch_count += fmt_int_bench_compare("u32", fmt_text, fmt_int_u32(fmt_text, (uint32_t) value), snprintf_text);
+
+	snprintf(snprintf_text, sizeof(snprintf_text), "%08lx", (unsigned long)(uint32_t) value);
+	mismatch_count += fmt_int_bench_compare("hex", fmt_text, fmt_int_hex(fmt_text, (uint32_t) value, 8), snprintf_text);
+
+	snprintf(snprintf_text, sizeof(snprintf_text), "%05u", (unsigned)(uint16_t) value);
+	mismatch_count += fmt_int_bench_compare("u32_width", fmt_text, fmt_int_u32_width(fmt_text, (uint16_t) value, 5, '0'), snprintf_text);
+
+	const int16_t value_cC = (int16_t) value;
+	snprintf(snprintf_text, sizeof(snprintf_text), "%s%d.%02d", (value_cC < 0) ? "-" : "", abs(value_cC) / 100, abs(value_cC) % 100);
+	mismatch_count += fmt_int_bench_compare("fixed", fmt_text, fmt_int_fixed(fmt_text, value_cC, 2), snprintf_text);
+	return mismatch_count;
+}
+
+// Returns the number of mismatches
+uint32_t fmt_int_bench_check() {
+	uint32_t mismatch_count = 0;
+	for (uint16_t round = 0; round < FMT_INT_BENCH_CHECK_ROUNDS; round++) {
+		fmt_int_bench_fill_values();
+		for (uint16_t i = 0; i < FMT_INT_BENCH_VALUE_COUNT; i++) {
+			mismatch_count += fmt_int_bench_check_value(fmt_int_bench_values[i]);
+		}
+	}
+	return mismatch_count;
+}
+
+// #pragma endregion Check
+
+
+// #pragma region Time
+
+static volatile uint32_t fmt_int_bench_sink;
+
+// "snprintf %ld: 222.5 cycles per call"
+static void fmt_int_bench_print_time(const char *name, uint32_t elapsed) {
+	char line[80];
+	char *end = fmt_int_append_str(line, name);
+	end = fmt_int_append_str(end, ": ");
+	end += fmt_int_fixed(end, (int32_t)(((uint64_t) elapsed * 10) / FMT_INT_BENCH_CALLS), 1);
+#ifdef EPS_HOST_BUILD
+	fmt_int_append_str(end, " ns per call\n");
+#else
+	fmt_int_append_str(end, " cycles per call\n");
+#endif
+	debug_uart_print_str(line);
+}
+
+// Times FMT_INT_BENCH_CALLS of `call`, with `value` set from the values each time
+#define FMT_INT_BENCH_TIME(name, call) do { \
+		const uint32_t start = timing_probe_now(); \
+		for (uint16_t call_num = 0; call_num < FMT_INT_BENCH_CALLS; call_num++) { \
+			const int32_t value = fmt_int_bench_values[call_num & (FMT_INT_BENCH_VALUE_COUNT - 1)]; \
+			fmt_int_bench_sink += (call); \
+		} \
+		fmt_int_bench_print_time((name), timing_probe_now() - start); \
+	} while (0)
+
+void fmt_int_bench_time() {
+	char text[24];
+	fmt_int_bench_fill_values();
+
+	FMT_INT_BENCH_TIME("snprintf %ld", snprintf(text, sizeof(text), "%ld", (long) value));
+	FMT_INT_BENCH_TIME("fmt_int_i32", fmt_int_i32(text, value));
+	FMT_INT_BENCH_TIME("snprintf %lu", snprintf(text, sizeof(text), "%lu", (unsigned long)(uint32_t) value));
+	FMT_INT_BENCH_TIME("fmt_int_u32", fmt_int_u32(text, (uint32_t) value));
+	// debug_uart_print_array_hex(), per byte
+	FMT_INT_BENCH_TIME("snprintf 0x%02x", snprintf(text, sizeof(text), "0x%02x ", (unsigned)(value & 0xFF)));
+	FMT_INT_BENCH_TIME("fmt_int_hex(2)", fmt_int_hex(&text[2], (uint32_t) value & 0xFF, 2));
+	FMT_INT_BENCH_TIME("snprintf %05u", snprintf(text, sizeof(text), "%05u", (unsigned)(uint16_t) value));
+	FMT_INT_BENCH_TIME("fmt_int_u32_width(5)", fmt_int_u32_width(text, (uint16_t) value, 5, '0'));
+	FMT_INT_BENCH_TIME("snprintf %d.%02d", snprintf(text, sizeof(text), "%d.%02d", (int16_t) value / 100, abs((int16_t) value % 100)));
+	FMT_INT_BENCH_TIME("fmt_int_fixed(2)", fmt_int_fixed(text, (int16_t) value, 2));
+}
+
+// #pragma endregion Time
+
+
+// Returns the number of mismatches
+uint32_t fmt_int_bench_run() {
+	const uint32_t mismatch_count = fmt_int_bench_check();
+	char line[64];
+	char *end = fmt_int_append_str(line, "fmt_int vs snprintf: ");
+	end = fmt_int_append_u32(end, mismatch_count);
+	fmt_int_append_str(end, " mismatches\n");
+	debug_uart_print_str(line);
+
+	fmt_int_bench_time();
+	return mismatch_count;
+}
+
+#ifdef EPS_HOST_BUILD
+int main() {
+	return (fmt_int_bench_run() == 0) ? 0 : 1;
+}
+#endif
@@ -0,0 +1,327 @@
+// hk_cache_check.c
+// Host tool: runs eps_hk_cache against the simulated EPS (eps_transport_sim, 20 ms latency) and
+// checks, from the sim's command count, the callbacks and the cache stats:
+// - single flight: requests for a command already on the bus join its transaction (one command,
+//   every waiter gets the same response), up to EPS_HK_CACHE_MAX_WAITERS;
+// - stale-while-revalidate: a too-old response is returned at once with
+//   EPS_HK_CACHE_MODE_ALLOW_STALE, the refresh goes out once, and the old response stays readable
+//   (the entry's other buffer) until the refresh is in;
+// - LRU: a fifth command reuses the least recently used entry, never one that's in flight;
+// - a response with an error STAT is passed on but not cached, and leaves the previous one.
+// The responses are told apart by the PDU's channel-on bitfield, switched between fetches.
+// Built with every host-buildable driver file (see eps_sim.h):
+//   cd Tools; S=$(ls ../Core/Src/eps_drivers/*.c ../Core/Src/debug_tools/*.c | grep -v -e _i2c -e transport_uart)
+//   gcc -O2 -DEPS_HOST_BUILD -I../Core/Inc -o hk_cache_check hk_cache_check.c $S
+// Usage: ./hk_cache_check
+// Exits with 0 if every check passes.
+
+#include "eps_drivers/eps_cmd_queue.h"
+#include "eps_drivers/eps_cmd_table.h"
+#include "eps_drivers/eps_commands.h"
+#include "eps_drivers/eps_hk_cache.h"
+#include "eps_drivers/eps_internal_drivers.h"
+#include "eps_drivers/eps_rsp_view.h"
+#include "eps_drivers/eps_sim.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#define SIM_LATENCY_MS 20
+#define PDU_HK EPS_CMD_ID_GET_PDU_HOUSEKEEPING_DATA_ENG
+
+static uint32_t fail_count = 0;
+
+#define CHECK(condition) do { \
+		if (!(condition)) { \
+			printf("FAIL line %d: %s\n", __LINE__, #condition); \
+			fail_count++; \
+		} \
+	} while (0)
+
+typedef struct {
+	uint8_t call_count;
+	uint8_t result_code;
+	uint8_t rx_buf[EPS_CMD_MAX_RX_LEN];
+	uint16_t rx_buf_len;
+} response_t;
+
+static void record_response(uint8_t result_code, const uint8_t rx_buf[], uint16_t rx_buf_len, void *context) {
+	response_t *response = (response_t*) context;
+	response->call_count++;
+	response->result_code = result_code;
+	memcpy(response->rx_buf, rx_buf, rx_buf_len);
+	response->rx_buf_len = rx_buf_len;
+}
+
+static uint16_t get_ch_on_bitfield(const response_t *response) {
+	eps_pdu_view_t view;
+	CHECK(eps_pdu_view_init(&view, response->rx_buf, response->rx_buf_len) == 0);
+	return eps_pdu_view_stat_ch_on_bitfield(&view);
+}
+
+static uint8_t is_stat_ok(const response_t *response) {
+	return response->rx_buf[4] == 0x00 || response->rx_buf[4] == 0x80;
+}
+
+static void sleep_ms(uint32_t duration_ms) {
+	const struct timespec ts = { .tv_sec = duration_ms / 1000, .tv_nsec = (duration_ms % 1000) * 1000000L };
+	nanosleep(&ts, NULL);
+}
+
+static void pump_until_idle() {
+	while (!eps_cmd_queue_is_idle()) {
+		eps_cmd_queue_pump();
+	}
+}
+
+static uint32_t get_cmd_count() {
+	return eps_sim_get_state()->cmd_count;
+}
+
+// The only channel on is ch_num
+static void set_only_channel_on(uint8_t ch_num) {
+	eps_output_bus_group_off(0xFFFF, 0xFFFF);
+	CHECK(eps_output_bus_channel_on(ch_num) == 0);
+}
+
+static void reset_cache(uint32_t max_age_ms) {
+	pump_until_idle();
+	eps_hk_cache_invalidate_all();
+	for (uint8_t cmd_id = 0; cmd_id < EPS_CMD_ID_COUNT; cmd_id++) {
+		if (eps_hk_cache_get_max_age_ms(cmd_id) != 0) {
+			eps_hk_cache_set_max_age_ms(cmd_id, max_age_ms);
+		}
+	}
+}
+
+
+// #pragma region Single flight
+
+static void check_single_flight() {
+	puts("single flight");
+	reset_cache(1000);
+	set_only_channel_on(1);
+	const eps_hk_cache_stats_t stats_before = *eps_hk_cache_get_stats();
+	const uint32_t cmd_count_before = get_cmd_count();
+
+	// One transaction, the other requests wait for it; one more than the waiter slots is rejected
+	static response_t responses[EPS_HK_CACHE_MAX_WAITERS + 1];
+	memset(responses, 0, sizeof(responses));
+	for (uint8_t request_num = 0; request_num < EPS_HK_CACHE_MAX_WAITERS; request_num++) {
+		CHECK(eps_hk_cache_request(PDU_HK, EPS_HK_CACHE_MODE_FRESH, record_response, &responses[request_num]) == 0);
+	}
+	CHECK(eps_hk_cache_request(PDU_HK, EPS_HK_CACHE_MODE_FRESH, record_response,
+			&responses[EPS_HK_CACHE_MAX_WAITERS]) == EPS_CMD_QUEUE_FULL);
+	CHECK(responses[0].call_count == 0); // still on the bus
+	pump_until_idle();
+
+	const eps_hk_cache_stats_t *stats = eps_hk_cache_get_stats();
+	CHECK(get_cmd_count() - cmd_count_before == 1);
+	CHECK(stats->fetch_count - stats_before.fetch_count == 1);
+	CHECK(stats->miss_count - stats_before.miss_count == EPS_HK_CACHE_MAX_WAITERS);
+	CHECK(stats->coalesced_count - stats_before.coalesced_count == EPS_HK_CACHE_MAX_WAITERS - 1);
+	CHECK(stats->rejected_count - stats_before.rejected_count == 1);
+	for (uint8_t request_num = 0; request_num < EPS_HK_CACHE_MAX_WAITERS; request_num++) {
+		CHECK(responses[request_num].call_count == 1);
+		CHECK(responses[request_num].result_code == 0);
+		CHECK(get_ch_on_bitfield(&responses[request_num]) == (1 << 1));
+		CHECK(memcmp(responses[request_num].rx_buf, responses[0].rx_buf, responses[0].rx_buf_len) == 0);
+	}
+	CHECK(responses[EPS_HK_CACHE_MAX_WAITERS].call_count == 0);
+
+	// Then a hit: answered before the request returns, no command
+	response_t hit_response = { 0 };
+	CHECK(eps_hk_cache_request(PDU_HK, EPS_HK_CACHE_MODE_FRESH, record_response, &hit_response) == 0);
+	CHECK(hit_response.call_count == 1);
+	CHECK(memcmp(hit_response.rx_buf, responses[0].rx_buf, responses[0].rx_buf_len) == 0);
+	CHECK(stats->hit_count - stats_before.hit_count == 1);
+	CHECK(get_cmd_count() - cmd_count_before == 1);
+}
+
+// #pragma endregion Single flight
+
+
+// #pragma region Stale-while-revalidate
+
+static void check_stale_while_revalidate() {
+	puts("stale-while-revalidate");
+	reset_cache(50);
+	set_only_channel_on(2);
+	response_t old_response = { 0 };
+	CHECK(eps_hk_cache_read(PDU_HK, EPS_HK_CACHE_MODE_FRESH, old_response.rx_buf) == 0);
+	old_response.rx_buf_len = eps_cmd_table[PDU_HK].rx_len;
+	CHECK(get_ch_on_bitfield(&old_response) == (1 << 2));
+
+	set_only_channel_on(3);
+	sleep_ms(60); // older than the max age
+	const eps_hk_cache_stats_t stats_before = *eps_hk_cache_get_stats();
+	const uint32_t cmd_count_before = get_cmd_count();
+
+	// The old response at once, and one refresh on the bus for both stale requests
+	response_t stale_responses[2] = { 0 };
+	for (uint8_t request_num = 0; request_num < 2; request_num++) {
+		CHECK(eps_hk_cache_request(PDU_HK, EPS_HK_CACHE_MODE_ALLOW_STALE, record_response, &stale_responses[request_num]) == 0);
+		CHECK(stale_responses[request_num].call_count == 1);
+		CHECK(memcmp(stale_responses[request_num].rx_buf, old_response.rx_buf, old_response.rx_buf_len) == 0);
+	}
+	// A fresh reader joins the refresh
+	response_t fresh_response = { 0 };
+	CHECK(eps_hk_cache_request(PDU_HK, EPS_HK_CACHE_MODE_FRESH, record_response, &fresh_response) == 0);
+	CHECK(fresh_response.call_count == 0);
+
+	// The refresh fills the other buffer: the old response is still the one served until it's in
+	response_t in_flight_response = { 0 };
+	CHECK(eps_hk_cache_request(PDU_HK, EPS_HK_CACHE_MODE_ALLOW_STALE, record_response, &in_flight_response) == 0);
+	CHECK(get_ch_on_bitfield(&in_flight_response) == (1 << 2));
+	pump_until_idle();
+
+	const eps_hk_cache_stats_t *stats = eps_hk_cache_get_stats();
+	CHECK(get_cmd_count() - cmd_count_before == 1);
+	CHECK(stats->fetch_count - stats_before.fetch_count == 1);
+	CHECK(stats->stale_count - stats_before.stale_count == 3);
+	CHECK(stats->coalesced_count - stats_before.coalesced_count == 1);
+	CHECK(fresh_response.call_count == 1);
+	CHECK(get_ch_on_bitfield(&fresh_response) == (1 << 3));
+
+	// Now fresh for everyone
+	response_t hit_response = { 0 };
+	CHECK(eps_hk_cache_request(PDU_HK, EPS_HK_CACHE_MODE_ALLOW_STALE, record_response, &hit_response) == 0);
+	CHECK(get_ch_on_bitfield(&hit_response) == (1 << 3));
+	CHECK(stats->hit_count - stats_before.hit_count == 1);
+	CHECK(get_cmd_count() - cmd_count_before == 1);
+}
+
+// #pragma endregion Stale-while-revalidate
+
+
+// #pragma region LRU
+
+// One more cacheable command than there are entries
+static const EPS_CMD_ID_enum_t lru_cmd_ids[EPS_HK_CACHE_ENTRY_COUNT + 1] = {
+	EPS_CMD_ID_GET_PDU_HOUSEKEEPING_DATA_ENG, EPS_CMD_ID_GET_PBU_HOUSEKEEPING_DATA_ENG,
+	EPS_CMD_ID_GET_PCU_HOUSEKEEPING_DATA_ENG, EPS_CMD_ID_GET_PIU_HOUSEKEEPING_DATA_ENG,
+	EPS_CMD_ID_GET_PDU_HOUSEKEEPING_DATA_RAW,
+};
+
+// 1 if the request was answered from the cache (checked by the sim's command count)
+static uint8_t is_cached(EPS_CMD_ID_enum_t cmd_id) {
+	static uint8_t rx_buf[EPS_CMD_MAX_RX_LEN];
+	const uint32_t cmd_count_before = get_cmd_count();
+	CHECK(eps_hk_cache_read(cmd_id, EPS_HK_CACHE_MODE_FRESH, rx_buf) == 0);
+	return get_cmd_count() == cmd_count_before;
+}
+
+static void check_lru() {
+	puts("LRU eviction");
+	reset_cache(10000);
+
+	// Fill all the entries (2 ms apart, so the use times differ), then use the first one again
+	for (uint8_t cmd_num = 0; cmd_num < EPS_HK_CACHE_ENTRY_COUNT; cmd_num++) {
+		CHECK(!is_cached(lru_cmd_ids[cmd_num]));
+		sleep_ms(2);
+	}
+	CHECK(is_cached(lru_cmd_ids[0]));
+	sleep_ms(2);
+
+	// The fifth takes the least recently used one's entry (the second); the rest stay cached
+	CHECK(!is_cached(lru_cmd_ids[4]));
+	sleep_ms(2);
+	CHECK(is_cached(lru_cmd_ids[0]));
+	CHECK(is_cached(lru_cmd_ids[2]));
+	CHECK(is_cached(lru_cmd_ids[3]));
+	CHECK(is_cached(lru_cmd_ids[4]));
+	CHECK(!is_cached(lru_cmd_ids[1]));
+
+	// Entries in flight are never reused: with all four refreshing, a fifth command is rejected
+	eps_hk_cache_invalidate_all();
+	static response_t responses[EPS_HK_CACHE_ENTRY_COUNT + 1];
+	memset(responses, 0, sizeof(responses));
+	const uint32_t rejected_before = eps_hk_cache_get_stats()->rejected_count;
+	for (uint8_t cmd_num = 0; cmd_num < EPS_HK_CACHE_ENTRY_COUNT; cmd_num++) {
+		// the evicted second command is the one that's no longer in an entry
+		const EPS_CMD_ID_enum_t cmd_id = lru_cmd_ids[(cmd_num == 1) ? 4 : cmd_num];
+		CHECK(eps_hk_cache_request(cmd_id, EPS_HK_CACHE_MODE_FRESH, record_response, &responses[cmd_num]) == 0);
+	}
+	CHECK(eps_hk_cache_request(lru_cmd_ids[1], EPS_HK_CACHE_MODE_FRESH, record_response,
+			&responses[EPS_HK_CACHE_ENTRY_COUNT]) == EPS_CMD_QUEUE_FULL);
+	CHECK(eps_hk_cache_get_stats()->rejected_count - rejected_before == 1);
+	pump_until_idle();
+	for (uint8_t cmd_num = 0; cmd_num < EPS_HK_CACHE_ENTRY_COUNT; cmd_num++) {
+		CHECK(responses[cmd_num].call_count == 1 && responses[cmd_num].result_code == 0);
+	}
+	CHECK(responses[EPS_HK_CACHE_ENTRY_COUNT].call_count == 0);
+
+	// ... and fits once they're done
+	CHECK(!is_cached(lru_cmd_ids[1]));
+	CHECK(is_cached(lru_cmd_ids[1]));
+}
+
+// #pragma endregion LRU
+
+
+// #pragma region Error STAT
+
+static void check_error_stat() {
+	puts("error STAT not cached");
+	reset_cache(50);
+	set_only_channel_on(4);
+	response_t good_response = { 0 };
+	CHECK(eps_hk_cache_request(PDU_HK, EPS_HK_CACHE_MODE_FRESH, record_response, &good_response) == 0);
+	pump_until_idle();
+	CHECK(good_response.call_count == 1 && is_stat_ok(&good_response));
+	sleep_ms(60); // older than the max age
+
+	// The error STAT goes to the waiter; the failed fetch is counted
+	eps_sim_configure(&(eps_sim_config_t) {
+		.response_latency_ms = SIM_LATENCY_MS, .inject_error = EPS_SIM_ERROR_STAT, .inject_error_every_n_cmds = 1 });
+	const eps_hk_cache_stats_t stats_before = *eps_hk_cache_get_stats();
+	const uint32_t cmd_count_before = get_cmd_count();
+	response_t error_response = { 0 };
+	CHECK(eps_hk_cache_request(PDU_HK, EPS_HK_CACHE_MODE_FRESH, record_response, &error_response) == 0);
+	pump_until_idle();
+	CHECK(error_response.call_count == 1);
+	CHECK(error_response.result_code == 0); // the transaction itself worked
+	CHECK(error_response.rx_buf[4] == EPS_SIM_STAT_INTERNAL_ERROR);
+	const eps_hk_cache_stats_t *stats = eps_hk_cache_get_stats();
+	CHECK(stats->fetch_failed_count - stats_before.fetch_failed_count == 1);
+
+	// The previous response is still the cached one, for readers that take it stale
+	response_t stale_response = { 0 };
+	CHECK(eps_hk_cache_request(PDU_HK, EPS_HK_CACHE_MODE_ALLOW_STALE, record_response, &stale_response) == 0);
+	CHECK(stale_response.call_count == 1);
+	CHECK(memcmp(stale_response.rx_buf, good_response.rx_buf, good_response.rx_buf_len) == 0);
+	pump_until_idle(); // its refresh fails too
+	CHECK(stats->fetch_failed_count - stats_before.fetch_failed_count == 2);
+
+	// A fresh reader goes to the bus again, and gets the good response once the EPS recovers
+	eps_sim_configure(&(eps_sim_config_t) { .response_latency_ms = SIM_LATENCY_MS });
+	response_t fresh_response = { 0 };
+	CHECK(eps_hk_cache_request(PDU_HK, EPS_HK_CACHE_MODE_FRESH, record_response, &fresh_response) == 0);
+	CHECK(fresh_response.call_count == 0);
+	pump_until_idle();
+	CHECK(fresh_response.call_count == 1 && is_stat_ok(&fresh_response));
+	CHECK(get_ch_on_bitfield(&fresh_response) == (1 << 4));
+	CHECK(get_cmd_count() - cmd_count_before == 3);
+	CHECK(stats->hit_count == stats_before.hit_count);
+}
+
+// #pragma endregion Error STAT
+
+
+int main() {
+	eps_set_transport(&eps_transport_sim);
+	eps_sim_configure(&(eps_sim_config_t) { .response_latency_ms = SIM_LATENCY_MS });
+	check_single_flight();
+	check_stale_while_revalidate();
+	check_lru();
+	check_error_stat();
+
+	if (fail_count != 0) {
+		printf("FAIL: %lu checks\n", (unsigned long) fail_count);
+		return 1;
+	}
+	puts("OK");
+	return 0;
+}
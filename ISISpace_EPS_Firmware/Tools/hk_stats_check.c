@@ -0,0 +1,257 @@
+// hk_stats_check.c
+// Host tool: checks eps_stats (window mean, EWMA, min/max, variance) against a floating-point
+// reference, after every sample of random series, for several window lengths and EWMA shifts.
+// Then feeds eps_hk_stats from the simulated EPS with eps_hk_stats_request_sample() (as the
+// scheduler job does), switching channels between samples, and checks the PDU and PIU running
+// averages and EWMAs against the same reference over the snapshots, and that a failed read
+// isn't counted as a sample.
+// Built with every host-buildable driver file (see eps_sim.h):
+//   cd Tools; S=$(ls ../Core/Src/eps_drivers/*.c ../Core/Src/debug_tools/*.c | grep -v -e _i2c -e transport_uart)
+//   gcc -O2 -DEPS_HOST_BUILD -I../Core/Inc -o hk_stats_check hk_stats_check.c $S -lm
+// Usage: ./hk_stats_check
+// Exits with 0 if every check passes.
+
+#include "eps_drivers/eps_cmd_queue.h"
+#include "eps_drivers/eps_commands.h"
+#include "eps_drivers/eps_hk_cache.h"
+#include "eps_drivers/eps_hk_stats.h"
+#include "eps_drivers/eps_internal_drivers.h"
+#include "eps_drivers/eps_raw_to_eng.h"
+#include "eps_drivers/eps_sim.h"
+#include "eps_drivers/eps_stats.h"
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#define SERIES_COUNT 8
+#define MAX_WINDOW_LEN 16
+#define SAMPLE_COUNT 100
+#define SIM_SAMPLE_COUNT 40
+#define MAX_SERIES (sizeof(eps_result_piu_housekeeping_data_eng_t) / 2)
+
+// Integer rounding (mean, EWMA) and the truncated Q8 EWMA steps are within a unit of the exact value
+#define MEAN_TOLERANCE 0.5
+#define EWMA_TOLERANCE 1.0
+#define VARIANCE_TOLERANCE 1.0 // truncated
+
+static uint32_t fail_count = 0;
+
+#define CHECK(condition) do { \
+		if (!(condition)) { \
+			printf("FAIL line %d: %s\n", __LINE__, #condition); \
+			fail_count++; \
+		} \
+	} while (0)
+
+
+// #pragma region Reference
+
+typedef struct {
+	uint16_t series_count;
+	uint8_t window_len;
+	double alpha;
+	uint32_t sample_count;
+	double window[MAX_WINDOW_LEN][MAX_SERIES]; // window[0] is the newest
+	double ewma[MAX_SERIES];
+} reference_stats_t;
+
+static void reference_init(reference_stats_t *reference, uint16_t series_count, uint8_t window_len, uint8_t ewma_shift) {
+	memset(reference, 0, sizeof(reference_stats_t));
+	reference->series_count = series_count;
+	reference->window_len = window_len;
+	reference->alpha = 1.0 / (1 << ewma_shift);
+}
+
+static void reference_update(reference_stats_t *reference, const int16_t sample[]) {
+	memmove(&reference->window[1], &reference->window[0], (MAX_WINDOW_LEN - 1) * sizeof(reference->window[0]));
+	for (uint16_t i = 0; i < reference->series_count; i++) {
+		reference->window[0][i] = sample[i];
+		reference->ewma[i] = (reference->sample_count == 0) ? sample[i]
+				: reference->ewma[i] + reference->alpha * (sample[i] - reference->ewma[i]);
+	}
+	reference->sample_count++;
+}
+
+static uint8_t reference_fill(const reference_stats_t *reference) {
+	return (reference->sample_count < reference->window_len) ? reference->sample_count : reference->window_len;
+}
+
+static double reference_mean(const reference_stats_t *reference, uint16_t series) {
+	double sum = 0;
+	for (uint8_t row = 0; row < reference_fill(reference); row++) {
+		sum += reference->window[row][series];
+	}
+	return sum / reference_fill(reference);
+}
+
+// #pragma endregion Reference
+
+
+// #pragma region eps_stats
+
+EPS_STATS_DEFINE(stats, SERIES_COUNT, MAX_WINDOW_LEN);
+
+static uint32_t random_state = 1;
+
+// xorshift32
+static uint32_t get_random() {
+	random_state ^= random_state << 13;
+	random_state ^= random_state >> 17;
+	random_state ^= random_state << 5;
+	return random_state;
+}
+
+static void check_stats_against_reference(const reference_stats_t *reference) {
+	int16_t mean[SERIES_COUNT], ewma[SERIES_COUNT], min[SERIES_COUNT], max[SERIES_COUNT];
+	uint32_t variance[SERIES_COUNT];
+	eps_stats_get_mean(&stats, mean);
+	eps_stats_get_ewma(&stats, ewma);
+	eps_stats_get_min_max(&stats, min, max);
+	eps_stats_get_variance(&stats, variance);
+
+	const uint8_t fill = reference_fill(reference);
+	for (uint16_t i = 0; i < SERIES_COUNT; i++) {
+		double ref_min = reference->window[0][i], ref_max = ref_min, sum_squared_deviation = 0;
+		const double ref_mean = reference_mean(reference, i);
+		for (uint8_t row = 0; row < fill; row++) {
+			const double value = reference->window[row][i];
+			ref_min = (value < ref_min) ? value : ref_min;
+			ref_max = (value > ref_max) ? value : ref_max;
+			sum_squared_deviation += (value - ref_mean) * (value - ref_mean);
+		}
+		CHECK(fabs(mean[i] - ref_mean) <= MEAN_TOLERANCE);
+		CHECK(fabs(ewma[i] - reference->ewma[i]) <= EWMA_TOLERANCE);
+		CHECK(min[i] == ref_min && max[i] == ref_max);
+		CHECK(fabs(variance[i] - (sum_squared_deviation / fill)) <= VARIANCE_TOLERANCE);
+		CHECK(eps_stats_get_latest(&stats)[i] == reference->window[0][i]);
+	}
+}
+
+static void check_stats(uint8_t window_len, uint8_t ewma_shift, int16_t amplitude) {
+	printf("eps_stats: window %u, EWMA shift %u, values up to +-%d\n", window_len, ewma_shift, amplitude);
+	static reference_stats_t reference;
+	CHECK(eps_stats_init(&stats, window_len, ewma_shift) == 0);
+	reference_init(&reference, SERIES_COUNT, window_len, ewma_shift);
+	CHECK(eps_stats_get_latest(&stats) == NULL);
+
+	for (uint16_t sample_num = 0; sample_num < SAMPLE_COUNT; sample_num++) {
+		int16_t sample[SERIES_COUNT];
+		for (uint16_t i = 0; i < SERIES_COUNT; i++) {
+			// Series 0 is constant, series 1 a ramp, the rest random
+			const int32_t random = (int32_t)(get_random() % (2 * (uint32_t) amplitude + 1)) - amplitude;
+			sample[i] = (i == 0) ? amplitude : (i == 1) ? (int16_t)(sample_num * 7 - 300) : (int16_t) random;
+		}
+		eps_stats_update(&stats, sample);
+		reference_update(&reference, sample);
+		check_stats_against_reference(&reference);
+	}
+	CHECK(stats.sample_count == SAMPLE_COUNT);
+}
+
+// #pragma endregion eps_stats
+
+
+// #pragma region eps_hk_stats
+
+static void pump_until_idle() {
+	while (!eps_cmd_queue_is_idle()) {
+		eps_cmd_queue_pump();
+	}
+}
+
+// The non-bitfield words of the board's struct against the reference; bitfields are the latest value
+static void check_hk_words(EPS_BOARD_enum_t board, const reference_stats_t *reference, const int16_t words[], uint8_t is_ewma) {
+	for (uint16_t word = 0; word < reference->series_count; word++) {
+		if (eps_raw_to_eng_is_bitfield_word(board, word)) {
+			CHECK(words[word] == reference->window[0][word]);
+		}
+		else if (is_ewma) {
+			CHECK(fabs(words[word] - reference->ewma[word]) <= EWMA_TOLERANCE);
+		}
+		else {
+			CHECK(fabs(words[word] - reference_mean(reference, word)) <= MEAN_TOLERANCE);
+		}
+	}
+}
+
+static void check_hk_stats() {
+	puts("eps_hk_stats: PDU and PIU sampled from the sim");
+	static reference_stats_t pdu_reference, piu_reference;
+	reference_init(&pdu_reference, sizeof(eps_result_pdu_housekeeping_data_eng_t) / 2,
+			EPS_HK_STATS_DEFAULT_WINDOW_LEN, EPS_HK_STATS_DEFAULT_EWMA_SHIFT);
+	reference_init(&piu_reference, sizeof(eps_result_piu_housekeeping_data_eng_t) / 2,
+			EPS_HK_STATS_DEFAULT_WINDOW_LEN, EPS_HK_STATS_DEFAULT_EWMA_SHIFT);
+	eps_hk_stats_reset_all();
+
+	static eps_result_pdu_housekeeping_data_eng_t pdu, pdu_result;
+	static eps_result_piu_housekeeping_data_eng_t piu, piu_result;
+	CHECK(eps_hk_stats_get_pdu_running_average(&pdu_result) == 1); // no samples yet
+	CHECK(eps_hk_stats_request_sample(EPS_BOARD_COUNT) == 1);
+
+	for (uint16_t sample_num = 0; sample_num < SIM_SAMPLE_COUNT; sample_num++) {
+		// A different set of channels on each time, so the currents and bitfields change
+		const uint32_t channels = get_random();
+		eps_output_bus_group_off(0xFFFF, 0xFFFF);
+		eps_output_bus_group_on(channels & 0xFFFF, channels >> 16);
+
+		eps_hk_cache_invalidate_all();
+		CHECK(eps_hk_stats_request_sample(EPS_BOARD_PDU) == 0);
+		CHECK(eps_hk_stats_request_sample(EPS_BOARD_PIU) == 0);
+		pump_until_idle();
+
+		// The same responses, from the cache
+		CHECK(eps_get_pdu_housekeeping_data_eng(&pdu) == 0);
+		CHECK(eps_get_piu_housekeeping_data_eng(&piu) == 0);
+		reference_update(&pdu_reference, (const int16_t*) &pdu);
+		reference_update(&piu_reference, (const int16_t*) &piu);
+	}
+	CHECK(eps_hk_stats_get(EPS_BOARD_PDU)->sample_count == SIM_SAMPLE_COUNT);
+	CHECK(eps_hk_stats_get(EPS_BOARD_PIU)->sample_count == SIM_SAMPLE_COUNT);
+	CHECK(eps_hk_stats_get(EPS_BOARD_PBU)->sample_count == 0);
+
+	CHECK(eps_hk_stats_get_pdu_running_average(&pdu_result) == 0);
+	check_hk_words(EPS_BOARD_PDU, &pdu_reference, (const int16_t*) &pdu_result, 0);
+	CHECK(eps_hk_stats_get_pdu_ewma(&pdu_result) == 0);
+	check_hk_words(EPS_BOARD_PDU, &pdu_reference, (const int16_t*) &pdu_result, 1);
+	CHECK(eps_hk_stats_get_piu_running_average(&piu_result) == 0);
+	check_hk_words(EPS_BOARD_PIU, &piu_reference, (const int16_t*) &piu_result, 0);
+	CHECK(eps_hk_stats_get_piu_ewma(&piu_result) == 0);
+	check_hk_words(EPS_BOARD_PIU, &piu_reference, (const int16_t*) &piu_result, 1);
+
+	// An error STAT is counted as failed, not as a sample
+	const eps_sim_config_t error_config = { .inject_error = EPS_SIM_ERROR_STAT, .inject_error_every_n_cmds = 1 };
+	eps_sim_configure(&error_config);
+	eps_hk_cache_invalidate_all();
+	CHECK(eps_hk_stats_request_sample(EPS_BOARD_PDU) == 0);
+	pump_until_idle();
+	CHECK(eps_hk_stats_get_failed_sample_count() == 1);
+	CHECK(eps_hk_stats_get(EPS_BOARD_PDU)->sample_count == SIM_SAMPLE_COUNT);
+	const eps_sim_config_t no_error_config = { 0 };
+	eps_sim_configure(&no_error_config);
+}
+
+// #pragma endregion eps_hk_stats
+
+
+int main() {
+	check_stats(1, 0, 1000);
+	check_stats(5, 3, 1000);
+	check_stats(8, 3, 32767);
+	check_stats(16, 5, 32767);
+	check_stats(16, 15, 500);
+	CHECK(eps_stats_init(&stats, 0, 3) == 1);
+	CHECK(eps_stats_init(&stats, MAX_WINDOW_LEN + 1, 3) == 1);
+	CHECK(eps_stats_init(&stats, 8, 16) == 1);
+
+	eps_set_transport(&eps_transport_sim);
+	check_hk_stats();
+
+	if (fail_count != 0) {
+		printf("FAIL: %lu checks\n", (unsigned long) fail_count);
+		return 1;
+	}
+	puts("OK");
+	return 0;
+}
@@ -0,0 +1,458 @@
+// json_writer_bench.c
+// Host tool: compares the json_writer-based eps_*_TO_json() functions with reference copies of the
+// snprintf-based functions they replaced, and times both.
+// - Output: for each type that had an old function, the strings must be identical (on random
+//   structs), and a too-short buffer must give the same error.
+// - Time: per call, for the PDU eng housekeeping (old: the strlen-appending
+//   eps_result_pdu_housekeeping_data_eng_to_json() from eps_debug_tools.c, whose output wasn't valid
+//   JSON, so only its time is compared) and for a battery pack.
+// Built with every host-buildable driver file (see eps_sim.h):
+//   cd Tools; S=$(ls ../Core/Src/eps_drivers/*.c ../Core/Src/debug_tools/*.c | grep -v -e _i2c -e transport_uart)
+//   gcc -O2 -DEPS_HOST_BUILD -DTIMING_PROBES_ENABLED=0 -I../Core/Inc -o json_writer_bench json_writer_bench.c $S
+// (without the probes, which would add two clock_gettime() calls to each timed call)
+// Usage: ./json_writer_bench [PDU call count, default 20000]
+// Exits with 0 if every output matches.
+
+#include "eps_drivers/eps_types.h"
+#include "eps_drivers/eps_types_to_json.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define JSON_BUF_LEN 4096
+
+
+// #pragma region Reference functions
+// The eps_*_TO_json() functions and eps_result_pdu_housekeeping_data_eng_to_json() as they were
+// before json_writer, unchanged apart from the names.
+
+static uint8_t reference_eps_vpid_raw_TO_json(const eps_vpid_raw_t *data, char json_output_str[], uint16_t json_output_str_len) {
+    if (data == NULL || json_output_str == NULL || json_output_str_len < 10) {
+        return 1; // Error: Invalid input
+    }
+
+    int snprintf_ret = snprintf(
+        json_output_str, json_output_str_len,
+        "{\"voltage_raw\":%d,\"current_raw\":%d,\"power_raw\":%d}",
+        data->voltage_raw, data->current_raw, data->power_raw);
+
+    if (snprintf_ret < 0) {
+        return 2; // Error: snprintf encoding error
+    }
+    if (snprintf_ret >= json_output_str_len) {
+        return 3; // Error: string buffer too short
+    }
+    return 0; // Success
+}
+
+static uint8_t reference_eps_vpid_eng_TO_json(const eps_vpid_eng_t *data, char json_output_str[], uint16_t json_output_str_len) {
+    if (data == NULL || json_output_str == NULL || json_output_str_len < 10) {
+        return 1; // Error: Invalid input
+    }
+
+    int snprintf_ret = snprintf(
+        json_output_str, json_output_str_len,
+        "{\"voltage_mV\":%d,\"current_mA\":%d,\"power_cW\":%d}",
+        data->voltage_mV, data->current_mA, data->power_cW);
+
+    if (snprintf_ret < 0) {
+        return 2; // Error: snprintf encoding error
+    }
+    if (snprintf_ret >= json_output_str_len) {
+        return 3; // Error: string buffer too short
+    }
+    return 0; // Success
+}
+
+static uint8_t reference_eps_battery_pack_datatype_raw_TO_json(const eps_battery_pack_datatype_raw_t *data, char json_output_str[], uint16_t json_output_str_len) {
+    if (data == NULL || json_output_str == NULL || json_output_str_len < 10) {
+        return 1; // Error: Invalid input
+    }
+
+    char vip_bp_input_raw_json[100];
+    const uint8_t json_ret_code = reference_eps_vpid_raw_TO_json(&(data->vip_bp_input_raw), vip_bp_input_raw_json, 100);
+    if (json_ret_code != 0) {
+        return json_ret_code; // Error: subfunction error
+    }
+
+    int snprintf_ret = snprintf(
+        json_output_str, json_output_str_len,
+        "{\"vip_bp_input_raw\":%s,\"bp_status_bitfield\":%d,\"cell_voltage_each_cell_raw\":[%d,%d,%d,%d],\"battery_temperature_each_sensor_raw\":[%d,%d,%d]}",
+        vip_bp_input_raw_json,
+        data->bp_status_bitfield,
+        data->cell_voltage_each_cell_raw[0],
+        data->cell_voltage_each_cell_raw[1],
+        data->cell_voltage_each_cell_raw[2],
+        data->cell_voltage_each_cell_raw[3],
+        data->battery_temperature_each_sensor_raw[0],
+        data->battery_temperature_each_sensor_raw[1],
+        data->battery_temperature_each_sensor_raw[2]);
+
+    if (snprintf_ret < 0) {
+        return 2; // Error: snprintf encoding error
+    }
+    if (snprintf_ret >= json_output_str_len) {
+        return 3; // Error: string buffer too short
+    }
+    return 0; // Success
+}
+
+static uint8_t reference_eps_battery_pack_datatype_eng_TO_json(const eps_battery_pack_datatype_eng_t *data, char json_output_str[], uint16_t json_output_str_len) {
+    if (data == NULL || json_output_str == NULL || json_output_str_len < 10) {
+        return 1; // Error: Invalid input
+    }
+
+    char vip_bp_input_json[100];
+    const uint8_t json_ret_code = reference_eps_vpid_eng_TO_json(&(data->vip_bp_input), vip_bp_input_json, 100);
+    if (json_ret_code != 0) {
+        return json_ret_code + 32; // Error: subfunction error
+    }
+
+    int snprintf_ret = snprintf(
+        json_output_str, json_output_str_len,
+        "{\"vip_bp_input\":%s,\"bp_status_bitfield\":%d,\"cell_voltage_each_cell_eng\":[%d,%d,%d,%d],\"battery_temperature_each_sensor_eng\":[%d,%d,%d]}",
+        vip_bp_input_json,
+        data->bp_status_bitfield,
+        data->cell_voltage_each_cell_mV[0],
+        data->cell_voltage_each_cell_mV[1],
+        data->cell_voltage_each_cell_mV[2],
+        data->cell_voltage_each_cell_mV[3],
+        data->battery_temperature_each_sensor_cC[0],
+        data->battery_temperature_each_sensor_cC[1],
+        data->battery_temperature_each_sensor_cC[2]);
+
+    if (snprintf_ret < 0) {
+        return 2; // Error: snprintf encoding error
+    }
+    if (snprintf_ret >= json_output_str_len) {
+        return 3; // Error: string buffer too short
+    }
+    return 0; // Success
+}
+
+static uint8_t reference_eps_conditioning_channel_datatype_raw_TO_json(const eps_conditioning_channel_datatype_raw_t *data, char json_output_str[], uint16_t json_output_str_len) {
+    if (data == NULL || json_output_str == NULL || json_output_str_len < 10) {
+        return 1; // Error: Invalid input
+    }
+
+    char vip_cc_output_raw_json[100];
+    const uint8_t json_ret_code = reference_eps_vpid_raw_TO_json(&(data->vip_cc_output_raw), vip_cc_output_raw_json, 100);
+    if (json_ret_code != 0) {
+        return json_ret_code; // Error: subfunction error
+    }
+
+    int snprintf_ret = snprintf(
+        json_output_str, json_output_str_len,
+        "{\"vip_cc_output_raw\":%s,\"volt_in_mppt_raw\":%d,\"curr_in_mppt_raw\":%d,\"volt_ou_mppt_raw\":%d,\"curr_ou_mppt_raw\":%d}",
+        vip_cc_output_raw_json,
+        data->volt_in_mppt_raw,
+        data->curr_in_mppt_raw,
+        data->volt_ou_mppt_raw,
+        data->curr_ou_mppt_raw);
+
+    if (snprintf_ret < 0) {
+        return 2; // Error: snprintf encoding error
+    }
+    if (snprintf_ret >= json_output_str_len) {
+        return 3; // Error: string buffer too short
+    }
+    return 0; // Success
+}
+
+static uint8_t reference_eps_conditioning_channel_datatype_eng_TO_json(const eps_conditioning_channel_datatype_eng_t *data, char json_output_str[], uint16_t json_output_str_len) {
+    if (data == NULL || json_output_str == NULL || json_output_str_len < 10) {
+        return 1; // Error: Invalid input
+    }
+
+    char vip_cc_output_json[100];
+    const uint8_t json_ret_code = reference_eps_vpid_eng_TO_json(&(data->vip_cc_output), vip_cc_output_json, 100);
+    if (json_ret_code != 0) {
+        return json_ret_code; // Error: subfunction error
+    }
+
+    int snprintf_ret = snprintf(
+        json_output_str, json_output_str_len,
+        "{\"vip_cc_output\":%s,\"volt_in_mppt_mV\":%d,\"curr_in_mppt_mA\":%d,\"volt_ou_mppt_mV\":%d,\"curr_ou_mppt_mA\":%d}",
+        vip_cc_output_json,
+        data->volt_in_mppt_mV,
+        data->curr_in_mppt_mA,
+        data->volt_ou_mppt_mV,
+        data->curr_ou_mppt_mA);
+
+    if (snprintf_ret < 0) {
+        return 2; // Error: snprintf encoding error
+    }
+    if (snprintf_ret >= json_output_str_len) {
+        return 3; // Error: string buffer too short
+    }
+    return 0; // Success
+}
+
+static uint8_t reference_eps_conditioning_channel_short_datatype_raw_TO_json(const eps_conditioning_channel_short_datatype_raw_t *data, char json_output_str[], uint16_t json_output_str_len) {
+    if (data == NULL || json_output_str == NULL || json_output_str_len < 10) {
+        return 1; // Error: Invalid input
+    }
+
+    int snprintf_ret = snprintf(
+        json_output_str, json_output_str_len,
+        "{\"volt_in_mppt_raw\":%d,\"curr_in_mppt_raw\":%d,\"volt_ou_mppt_raw\":%d,\"curr_ou_mppt_raw\":%d}",
+        data->volt_in_mppt_raw,
+        data->curr_in_mppt_raw,
+        data->volt_ou_mppt_raw,
+        data->curr_ou_mppt_raw);
+
+    if (snprintf_ret < 0) {
+        return 2; // Error: snprintf encoding error
+    }
+    if (snprintf_ret >= json_output_str_len) {
+        return 3; // Error: string buffer too short
+    }
+    return 0; // Success
+}
+
+static uint8_t reference_eps_conditioning_channel_short_datatype_eng_TO_json(const eps_conditioning_channel_short_datatype_eng_t *data, char json_output_str[], uint16_t json_output_str_len) {
+    if (data == NULL || json_output_str == NULL || json_output_str_len < 10) {
+        return 1; // Error: Invalid input
+    }
+
+    int snprintf_ret = snprintf(
+        json_output_str, json_output_str_len,
+        "{\"volt_in_mppt_mV\":%d,\"curr_in_mppt_mA\":%d,\"volt_ou_mppt_mV\":%d,\"curr_ou_mppt_mA\":%d}",
+        data->volt_in_mppt_mV,
+        data->curr_in_mppt_mA,
+        data->volt_ou_mppt_mV,
+        data->curr_ou_mppt_mA);
+
+    if (snprintf_ret < 0) {
+        return 2; // Error: snprintf encoding error
+    }
+    if (snprintf_ret >= json_output_str_len) {
+        return 3; // Error: string buffer too short
+    }
+    return 0; // Success
+}
+
+
+static uint8_t reference_eps_result_system_status_TO_json(const eps_result_system_status_t *data, char json_output_str[], uint16_t json_output_str_len) {
+    if (data == NULL || json_output_str == NULL || json_output_str_len < 10) {
+        return 1; // Error: Invalid input
+    }
+
+    // TODO: add mode_str and reset_cause_str keys which decode the enum values to strings
+    int snprintf_ret = snprintf(
+        json_output_str, json_output_str_len,
+        "{\"mode\":%d,\"config_changed_since_boot\":%d,\"reset_cause\":%d,\"uptime_sec\":%lu,\"error_code\":%u,\"rst_cnt_pwron\":%u,\"rst_cnt_wdg\":%u,\"rst_cnt_cmd\":%u,\"rst_cnt_mcu\":%u,\"rst_cnt_emlopo\":%u,\"time_since_prev_cmd_sec\":%u,\"unix_time_sec\":%lu,\"calendar_years_since_2000\":%u,\"calendar_month\":%u,\"calendar_day\":%u,\"calendar_hour\":%u,\"calendar_minute\":%u,\"calendar_second\":%u}",
+        data->mode, data->config_changed_since_boot, data->reset_cause, data->uptime_sec,
+        data->error_code, data->rst_cnt_pwron, data->rst_cnt_wdg, data->rst_cnt_cmd,
+        data->rst_cnt_mcu, data->rst_cnt_emlopo, data->time_since_prev_cmd_sec,
+        data->unix_time_sec, data->calendar_years_since_2000, data->calendar_month,
+        data->calendar_day, data->calendar_hour, data->calendar_minute, data->calendar_second);
+
+    if (snprintf_ret < 0) {
+        return 2; // Error: snprintf encoding error
+    }
+    if (snprintf_ret >= json_output_str_len) {
+        return 3; // Error: string buffer too short
+    }
+    return 0; // Success
+}
+
+
+static uint8_t reference_eps_result_pdu_overcurrent_fault_state_TO_json(const eps_result_pdu_overcurrent_fault_state_t *data, char json_output_str[], uint16_t json_output_str_len) {
+    if (data == NULL || json_output_str == NULL || json_output_str_len < 10) {
+        return 1; // Error: Invalid input
+    }
+
+    // Write JSON string to buffer
+    int snprintf_ret = snprintf(
+        json_output_str, json_output_str_len,
+        "{\"stat_ch_on_bitfield\":%u,\"stat_ch_ext_on_bitfield\":%u,\"stat_ch_overcurrent_fault_bitfield\":%u,\"stat_ch_ext_overcurrent_fault_bitfield\":%u,\"overcurrent_fault_count_each_channel\":[%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u]}",
+        data->stat_ch_on_bitfield,
+        data->stat_ch_ext_on_bitfield,
+        data->stat_ch_overcurrent_fault_bitfield,
+        data->stat_ch_ext_overcurrent_fault_bitfield,
+        data->overcurrent_fault_count_each_channel[0], data->overcurrent_fault_count_each_channel[1],
+        data->overcurrent_fault_count_each_channel[2], data->overcurrent_fault_count_each_channel[3],
+        data->overcurrent_fault_count_each_channel[4], data->overcurrent_fault_count_each_channel[5],
+        data->overcurrent_fault_count_each_channel[6], data->overcurrent_fault_count_each_channel[7],
+        data->overcurrent_fault_count_each_channel[8], data->overcurrent_fault_count_each_channel[9],
+        data->overcurrent_fault_count_each_channel[10], data->overcurrent_fault_count_each_channel[11],
+        data->overcurrent_fault_count_each_channel[12], data->overcurrent_fault_count_each_channel[13],
+        data->overcurrent_fault_count_each_channel[14], data->overcurrent_fault_count_each_channel[15],
+        data->overcurrent_fault_count_each_channel[16], data->overcurrent_fault_count_each_channel[17],
+        data->overcurrent_fault_count_each_channel[18], data->overcurrent_fault_count_each_channel[19],
+        data->overcurrent_fault_count_each_channel[20], data->overcurrent_fault_count_each_channel[21],
+        data->overcurrent_fault_count_each_channel[22], data->overcurrent_fault_count_each_channel[23],
+        data->overcurrent_fault_count_each_channel[24], data->overcurrent_fault_count_each_channel[25],
+        data->overcurrent_fault_count_each_channel[26], data->overcurrent_fault_count_each_channel[27],
+        data->overcurrent_fault_count_each_channel[28], data->overcurrent_fault_count_each_channel[29],
+        data->overcurrent_fault_count_each_channel[30], data->overcurrent_fault_count_each_channel[31]);
+
+    if (snprintf_ret < 0) {
+        return 2; // Error: snprintf encoding error
+    }
+    if (snprintf_ret >= json_output_str_len) {
+        return 3; // Error: string buffer too short
+    }
+    return 0; // Success
+}
+
+static uint8_t reference_eps_result_pbu_abf_placed_state_TO_json(const eps_result_pbu_abf_placed_state_t *data, char json_output_str[], uint16_t json_output_str_len) {
+    if (data == NULL || json_output_str == NULL || json_output_str_len < 10) {
+        return 1; // Error: Invalid input
+    }
+
+    // Write JSON string to buffer
+    int snprintf_ret = snprintf(
+        json_output_str, json_output_str_len,
+        "{\"abf_placed_0\":%u,\"abf_placed_1\":%u,\"abf_placed_0_str\":%s,\"abf_placed_1_str\":%s}",
+        data->abf_placed_0,
+        data->abf_placed_1,
+        (data->abf_placed_0 == EPS_ABF_PIN_APPLIED) ? "\"APPLIED\"" : "\"NOT_APPLIED\"",
+        (data->abf_placed_1 == EPS_ABF_PIN_APPLIED) ? "\"APPLIED\"" : "\"NOT_APPLIED\"");
+
+    if (snprintf_ret < 0) {
+        return 2; // Error: snprintf encoding error
+    }
+    if (snprintf_ret >= json_output_str_len) {
+        return 3; // Error: string buffer too short
+    }
+    return 0; // Success
+}
+
+static void reference_eps_result_pdu_housekeeping_data_eng_to_json(const eps_result_pdu_housekeeping_data_eng_t *data, char json_output_str[]) {
+    // json_output_str must be >= 4096 bytes
+
+    sprintf(json_output_str, "{\n");
+    sprintf(json_output_str + strlen(json_output_str), "    voltage_internal_board_supply_mV: %u,\n", data->voltage_internal_board_supply_mV);
+    sprintf(json_output_str + strlen(json_output_str), "    temperature_mcu_cC: %u,\n", data->temperature_mcu_cC);
+    sprintf(json_output_str + strlen(json_output_str), "    vip_total_input: { voltage_mV: %d, current_mA: %d, power_cW: %d },\n", 
+            data->vip_total_input.voltage_mV, data->vip_total_input.current_mA, data->vip_total_input.power_cW);
+    sprintf(json_output_str + strlen(json_output_str), "    stat_ch_on_bitfield: %u,\n", data->stat_ch_on_bitfield);
+    sprintf(json_output_str + strlen(json_output_str), "    stat_ch_ext_on_bitfield: %u,\n", data->stat_ch_ext_on_bitfield);
+    sprintf(json_output_str + strlen(json_output_str), "    stat_ch_overcurrent_fault_bitfield: %u,\n", data->stat_ch_overcurrent_fault_bitfield);
+    sprintf(json_output_str + strlen(json_output_str), "    stat_ch_ext_overcurrent_fault_bitfield: %u,\n", data->stat_ch_ext_overcurrent_fault_bitfield);
+
+    sprintf(json_output_str + strlen(json_output_str), "    vip_each_voltage_domain: [\n");
+    for (int i = 0; i < 7; i++) {
+        sprintf(json_output_str + strlen(json_output_str), "        { voltage_mV: %d, current_mA: %d, power_cW: %d },\n", 
+                data->vip_each_voltage_domain[i].voltage_mV,
+                data->vip_each_voltage_domain[i].current_mA, 
+                data->vip_each_voltage_domain[i].power_cW);
+    }
+    sprintf(json_output_str + strlen(json_output_str), "    ],\n");
+
+    sprintf(json_output_str + strlen(json_output_str), "    vip_each_channel: [\n");
+    for (int i = 0; i < 32; i++) {
+        sprintf(json_output_str + strlen(json_output_str), "        { voltage_mV: %d, current_mA: %d, power_cW: %d },\n", 
+                data->vip_each_channel[i].voltage_mV,
+                data->vip_each_channel[i].current_mA, 
+                data->vip_each_channel[i].power_cW);
+    }
+    sprintf(json_output_str + strlen(json_output_str), "    ],\n");
+    sprintf(json_output_str + strlen(json_output_str), "    json_output_str_length_approx: %d\n", strlen(json_output_str)+40);
+    sprintf(json_output_str + strlen(json_output_str), "}\n");
+}
+
+// #pragma endregion Reference functions
+
+
+static uint32_t mismatch_count = 0;
+
+static void fill_random(void *data, size_t len) {
+	uint8_t *bytes = data;
+	for (size_t i = 0; i < len; i++) {
+		bytes[i] = (uint8_t) rand();
+	}
+}
+
+// Same return value and, on success, the same string, on a random struct and with a buffer
+// `buf_len` long
+#define CHECK_TYPE(type, name, buf_len) do { \
+		type data; \
+		fill_random(&data, sizeof(type)); \
+		static char new_json[JSON_BUF_LEN], reference_json[JSON_BUF_LEN]; \
+		const uint8_t new_result = eps_##name##_TO_json(&data, new_json, (buf_len)); \
+		const uint8_t reference_result = reference_eps_##name##_TO_json(&data, reference_json, (buf_len)); \
+		if (new_result != reference_result || (new_result == 0 && strcmp(new_json, reference_json) != 0)) { \
+			printf("%s (buffer %u): returned %u, reference %u\n  %s\n  %s\n", #name, (unsigned)(buf_len), \
+					new_result, reference_result, new_json, reference_json); \
+			mismatch_count++; \
+		} \
+	} while (0)
+
+#define CHECK_ALL_TYPES(buf_len) do { \
+		CHECK_TYPE(eps_vpid_raw_t, vpid_raw, buf_len); \
+		CHECK_TYPE(eps_vpid_eng_t, vpid_eng, buf_len); \
+		CHECK_TYPE(eps_battery_pack_datatype_raw_t, battery_pack_datatype_raw, buf_len); \
+		CHECK_TYPE(eps_battery_pack_datatype_eng_t, battery_pack_datatype_eng, buf_len); \
+		CHECK_TYPE(eps_conditioning_channel_datatype_raw_t, conditioning_channel_datatype_raw, buf_len); \
+		CHECK_TYPE(eps_conditioning_channel_datatype_eng_t, conditioning_channel_datatype_eng, buf_len); \
+		CHECK_TYPE(eps_conditioning_channel_short_datatype_raw_t, conditioning_channel_short_datatype_raw, buf_len); \
+		CHECK_TYPE(eps_conditioning_channel_short_datatype_eng_t, conditioning_channel_short_datatype_eng, buf_len); \
+		CHECK_TYPE(eps_result_system_status_t, result_system_status, buf_len); \
+		CHECK_TYPE(eps_result_pdu_overcurrent_fault_state_t, result_pdu_overcurrent_fault_state, buf_len); \
+		CHECK_TYPE(eps_result_pbu_abf_placed_state_t, result_pbu_abf_placed_state, buf_len); \
+	} while (0)
+
+static double get_time_ns() {
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (now.tv_sec * 1e9) + now.tv_nsec;
+}
+
+int main(int argc, char *argv[]) {
+	const uint32_t call_count = (argc > 1) ? (uint32_t) strtoul(argv[1], NULL, 0) : 20000;
+	srand(1);
+
+	for (uint16_t i = 0; i < 1000 && mismatch_count < 10; i++) {
+		CHECK_ALL_TYPES(JSON_BUF_LEN);
+	}
+	CHECK_ALL_TYPES(40); // too short for all but the smallest
+	if (mismatch_count != 0) {
+		puts("FAIL");
+		return 1;
+	}
+	puts("11 types give the same JSON as the reference functions");
+
+	static char new_json[JSON_BUF_LEN], reference_json[JSON_BUF_LEN];
+	eps_result_pdu_housekeeping_data_eng_t pdu;
+	fill_random(&pdu, sizeof(pdu));
+	const double pdu_start_ns = get_time_ns();
+	for (uint32_t i = 0; i < call_count; i++) {
+		pdu.temperature_mcu_cC = (int16_t) i;
+		reference_eps_result_pdu_housekeeping_data_eng_to_json(&pdu, reference_json);
+	}
+	const double pdu_reference_end_ns = get_time_ns();
+	for (uint32_t i = 0; i < call_count; i++) {
+		pdu.temperature_mcu_cC = (int16_t) i;
+		eps_result_pdu_housekeeping_data_eng_TO_json(&pdu, new_json, sizeof(new_json));
+	}
+	const double pdu_new_end_ns = get_time_ns();
+	printf("PDU eng: reference %.2f us (%zu bytes), json_writer %.2f us (%zu bytes)\n",
+			(pdu_reference_end_ns - pdu_start_ns) / call_count / 1e3, strlen(reference_json),
+			(pdu_new_end_ns - pdu_reference_end_ns) / call_count / 1e3, strlen(new_json));
+
+	eps_battery_pack_datatype_eng_t battery_pack;
+	fill_random(&battery_pack, sizeof(battery_pack));
+	const uint32_t battery_pack_call_count = call_count * 10;
+	const double bp_start_ns = get_time_ns();
+	for (uint32_t i = 0; i < battery_pack_call_count; i++) {
+		battery_pack.bp_status_bitfield = (uint16_t) i;
+		reference_eps_battery_pack_datatype_eng_TO_json(&battery_pack, reference_json, sizeof(reference_json));
+	}
+	const double bp_reference_end_ns = get_time_ns();
+	for (uint32_t i = 0; i < battery_pack_call_count; i++) {
+		battery_pack.bp_status_bitfield = (uint16_t) i;
+		eps_battery_pack_datatype_eng_TO_json(&battery_pack, new_json, sizeof(new_json));
+	}
+	const double bp_new_end_ns = get_time_ns();
+	printf("Battery pack eng: reference %.2f us, json_writer %.2f us\n",
+			(bp_reference_end_ns - bp_start_ns) / battery_pack_call_count / 1e3,
+			(bp_new_end_ns - bp_reference_end_ns) / battery_pack_call_count / 1e3);
+	puts("OK");
+	return 0;
+}
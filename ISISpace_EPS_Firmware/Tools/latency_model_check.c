@@ -0,0 +1,228 @@
+// latency_model_check.c
+// Host tool: runs eps_latency_model against a simulated poll schedule (the same one as
+// eps_i2c_poll_engine.c: the first poll at first_poll_delay_ms after the command, then every
+// poll_interval_ms; "ready" once the EPS's latency has passed) and checks the polls per command and
+// the lag from the response being ready to the poll that finds it, for latencies of 5-100 ms, with
+// and without jitter, and with the latency halved mid-run. Also checks the rules one by one: the
+// defaults until EPS_LATENCY_MODEL_MIN_SAMPLES, the first poll at mean + deviation, the timeout
+// backoff, and a ready delayed first poll not being a sample.
+// Built with every host-buildable driver file (see eps_sim.h):
+//   cd Tools; S=$(ls ../Core/Src/eps_drivers/*.c ../Core/Src/debug_tools/*.c | grep -v -e _i2c -e transport_uart)
+//   gcc -O2 -DEPS_HOST_BUILD -I../Core/Inc -o latency_model_check latency_model_check.c $S
+// Usage: ./latency_model_check
+// Exits with 0 if every check passes.
+
+#include "eps_drivers/eps_internal_drivers.h"
+#include "eps_drivers/eps_latency_model.h"
+
+#include <stdint.h>
+#include <stdio.h>
+
+#define CC 0x40 // any command code in eps_cmd_table
+#define RX_LEN 36
+#define WARM_UP_CMD_COUNT 1000
+#define MEASURED_CMD_COUNT 2000
+// After the latency is halved, the first polls are late until the mean has crept down (by 1/256
+// per ready delayed first poll: about 180 commands to halve it). Not measured.
+#define HALVED_SETTLE_CMD_COUNT 500
+
+static uint32_t fail_count = 0;
+
+#define CHECK(condition) do { \
+		if (!(condition)) { \
+			printf("FAIL line %d: %s\n", __LINE__, #condition); \
+			fail_count++; \
+		} \
+	} while (0)
+
+static uint32_t random_state = 1;
+
+// xorshift32
+static uint32_t get_random() {
+	random_state ^= random_state << 13;
+	random_state ^= random_state >> 17;
+	random_state ^= random_state << 5;
+	return random_state;
+}
+
+typedef struct {
+	uint32_t poll_count;
+	double lag_ms; // from the response being ready to the ready poll
+	uint8_t timed_out;
+} transaction_t;
+
+// One command whose response is ready latency_ms after the end of the command
+static transaction_t run_transaction(double latency_ms) {
+	eps_poll_timing_t timing;
+	eps_latency_model_get_timing(CC, RX_LEN, &timing);
+
+	transaction_t transaction = { 0 };
+	uint32_t poll_ms = timing.first_poll_delay_ms;
+	uint32_t last_not_ready_ms = 0;
+	while (1) {
+		transaction.poll_count++;
+		if (poll_ms >= latency_ms) {
+			break;
+		}
+		last_not_ready_ms = poll_ms;
+		if (poll_ms >= timing.timeout_ms) {
+			eps_latency_model_record_timeout(CC);
+			transaction.timed_out = 1;
+			return transaction;
+		}
+		poll_ms += timing.poll_interval_ms;
+	}
+	eps_latency_model_record_ready(CC, timing.first_poll_delay_ms, last_not_ready_ms, poll_ms);
+	transaction.lag_ms = poll_ms - latency_ms;
+	return transaction;
+}
+
+
+// #pragma region Rules
+
+static void check_rules() {
+	eps_poll_timing_t timing;
+	eps_latency_model_reset();
+
+	// Defaults until EPS_LATENCY_MODEL_MIN_SAMPLES samples; a timeout doesn't back anything off yet
+	eps_latency_model_record_timeout(CC);
+	for (uint8_t sample_num = 0; sample_num < EPS_LATENCY_MODEL_MIN_SAMPLES; sample_num++) {
+		eps_latency_model_get_timing(CC, RX_LEN, &timing);
+		CHECK(timing.first_poll_delay_ms == 0);
+		CHECK(timing.poll_interval_ms == EPS_LATENCY_MODEL_DEFAULT_POLL_INTERVAL_MS);
+		CHECK(timing.timeout_ms == EPS_MAX_RESPONSE_POLL_TIME_MS);
+		// not ready at 15, ready at 20: a sample of 17.5 ms
+		eps_latency_model_record_ready(CC, 0, 15, 20);
+	}
+	const eps_latency_model_t *model = eps_latency_model_get(CC);
+	CHECK(model->sample_count == EPS_LATENCY_MODEL_MIN_SAMPLES);
+	CHECK(model->timeout_count == 1);
+	CHECK(model->mean_q3 == 140); // 17.5 ms
+
+	// First poll at mean + deviation, rounded up
+	eps_latency_model_get_timing(CC, RX_LEN, &timing);
+	CHECK(timing.first_poll_delay_ms == (model->mean_q3 + model->deviation_q3 + 7) / 8);
+	CHECK(timing.first_poll_delay_ms > 17);
+
+	// Timeout backoff: the deviation doubles (+ 1 ms), so the timeout grows, up to the max
+	uint32_t timeout_before_ms = timing.timeout_ms;
+	const uint32_t deviation_before_q3 = model->deviation_q3;
+	eps_latency_model_record_timeout(CC);
+	CHECK(model->deviation_q3 == deviation_before_q3 * 2 + 8);
+	CHECK(model->timeout_count == 2);
+	eps_latency_model_get_timing(CC, RX_LEN, &timing);
+	CHECK(timing.timeout_ms > timeout_before_ms);
+	CHECK(timing.poll_interval_ms <= EPS_LATENCY_MODEL_DEFAULT_POLL_INTERVAL_MS);
+	for (uint8_t timeout_num = 0; timeout_num < 20; timeout_num++) {
+		eps_latency_model_record_timeout(CC);
+	}
+	eps_latency_model_get_timing(CC, RX_LEN, &timing);
+	CHECK(timing.timeout_ms == EPS_LATENCY_MODEL_MAX_TIMEOUT_MS);
+	CHECK(model->deviation_q3 == EPS_LATENCY_MODEL_MAX_TIMEOUT_MS << EPS_LATENCY_MODEL_FRAC_BITS);
+
+	// A ready delayed first poll isn't a sample: the deviation shrinks by 1/4, the mean by 1/256
+	eps_latency_model_get_timing(CC, RX_LEN, &timing);
+	const uint32_t mean_before_q3 = model->mean_q3;
+	const uint32_t deviation_q3 = model->deviation_q3;
+	eps_latency_model_record_ready(CC, timing.first_poll_delay_ms, 0, timing.first_poll_delay_ms);
+	CHECK(model->sample_count == EPS_LATENCY_MODEL_MIN_SAMPLES);
+	CHECK(model->early_count == 1);
+	CHECK(model->deviation_q3 == deviation_q3 - deviation_q3 / 4);
+	CHECK(model->mean_q3 == mean_before_q3 - (mean_before_q3 + 255) / 256);
+
+	// ... but one after a "not ready" poll is
+	eps_latency_model_record_ready(CC, timing.first_poll_delay_ms, timing.first_poll_delay_ms, timing.first_poll_delay_ms + 1);
+	CHECK(model->sample_count == EPS_LATENCY_MODEL_MIN_SAMPLES + 1);
+
+	// Unknown command codes always get the defaults
+	CHECK(eps_latency_model_get(0xFF) == NULL);
+	eps_latency_model_get_timing(0xFF, RX_LEN, &timing);
+	CHECK(timing.first_poll_delay_ms == 0);
+}
+
+// #pragma endregion Rules
+
+
+// #pragma region Simulation
+
+typedef struct {
+	double latency_ms;
+	double jitter_ms; // latency is uniform in latency_ms +/- jitter_ms
+	uint8_t halve_latency; // after the warm-up: measures how fast the model follows
+} latency_case_t;
+
+static const latency_case_t latency_cases[] = {
+	{ 5, 0, 0 }, { 10, 0, 0 }, { 10.4, 0, 0 }, { 30.7, 0, 0 }, { 100, 0, 0 },
+	{ 5, 2, 0 }, { 10, 2, 0 }, { 30, 2, 0 }, { 100, 2, 0 },
+	{ 10, 0, 1 }, { 30, 2, 1 }, { 100, 0, 1 },
+};
+
+static void check_latency_case(const latency_case_t *latency_case) {
+	eps_latency_model_reset();
+	random_state = 1;
+
+	double latency_ms = latency_case->latency_ms;
+	const uint32_t measure_from_cmd_num = WARM_UP_CMD_COUNT + (latency_case->halve_latency ? HALVED_SETTLE_CMD_COUNT : 0);
+	uint32_t poll_count = 0, timeout_count = 0, settle_cmd_count = 0;
+	double lag_ms = 0, max_lag_ms = 0;
+	for (uint32_t cmd_num = 0; cmd_num < measure_from_cmd_num + MEASURED_CMD_COUNT; cmd_num++) {
+		if (cmd_num == WARM_UP_CMD_COUNT && latency_case->halve_latency) {
+			latency_ms /= 2;
+		}
+		const double jitter_ms = latency_case->jitter_ms * (((get_random() % 2001) / 1000.0) - 1);
+		const transaction_t transaction = run_transaction(latency_ms + jitter_ms);
+		if (cmd_num >= WARM_UP_CMD_COUNT && settle_cmd_count == 0 && transaction.poll_count > 1) {
+			settle_cmd_count = cmd_num - WARM_UP_CMD_COUNT + 1; // the first poll is early enough again
+		}
+		if (cmd_num < measure_from_cmd_num) {
+			continue;
+		}
+		// Warm-up timeouts are fine: over 100 ms, the defaults time out until the backoff catches up
+		timeout_count += transaction.timed_out;
+		poll_count += transaction.poll_count;
+		lag_ms += transaction.lag_ms;
+		max_lag_ms = (transaction.lag_ms > max_lag_ms) ? transaction.lag_ms : max_lag_ms;
+	}
+
+	const eps_latency_model_t *model = eps_latency_model_get(CC);
+	const double polls_per_cmd = (double) poll_count / MEASURED_CMD_COUNT;
+	const double mean_lag_ms = lag_ms / MEASURED_CMD_COUNT;
+	printf("%5.1f ms +/- %.0f%s: mean %6.2f ms, deviation %5.2f ms, %.2f polls/cmd, ready-to-poll lag %.2f ms (max %.1f)",
+			latency_case->latency_ms, latency_case->jitter_ms, latency_case->halve_latency ? ", halved" : "        ",
+			model->mean_q3 / 8.0, model->deviation_q3 / 8.0, polls_per_cmd, mean_lag_ms, max_lag_ms);
+	if (latency_case->halve_latency) {
+		printf(", settled after %lu cmds", (unsigned long) settle_cmd_count);
+	}
+	printf("\n");
+
+	CHECK(timeout_count == 0);
+	// Usually one poll, sometimes a "not ready" one first: never the default 5 ms polling from 0
+	CHECK(polls_per_cmd >= 1.0 && polls_per_cmd <= 2.2);
+	// The response is picked up within about a ms of being ready
+	CHECK(mean_lag_ms <= 1.0);
+	CHECK(max_lag_ms <= 2 * latency_case->jitter_ms + 3);
+	// The mean tracks the (current) latency, a little low as it's probed from below
+	CHECK(model->mean_q3 / 8.0 <= latency_ms + 1);
+	CHECK(model->mean_q3 / 8.0 >= latency_ms * 0.95 - latency_case->jitter_ms - 2);
+	if (latency_case->halve_latency) {
+		// ln(2) / ln(256 / 255) = 177 ready delayed first polls halve the mean
+		CHECK(settle_cmd_count > 0 && settle_cmd_count <= 256);
+	}
+}
+
+// #pragma endregion Simulation
+
+
+int main() {
+	check_rules();
+	for (uint8_t case_num = 0; case_num < sizeof(latency_cases) / sizeof(latency_case_t); case_num++) {
+		check_latency_case(&latency_cases[case_num]);
+	}
+
+	if (fail_count != 0) {
+		printf("FAIL: %lu checks\n", (unsigned long) fail_count);
+		return 1;
+	}
+	puts("OK");
+	return 0;
+}
@@ -0,0 +1,138 @@
+// raw_to_eng_check.c
+// Host tool: checks the OBC's raw-to-engineering conversion (eps_raw_to_eng) against the simulated
+// EPS, and times it per housekeeping frame.
+// The sim writes its raw responses with its own fixed ADC scaling (eps_sim_get_adc_scale()). This
+// tool turns that scaling into an eps_raw_to_eng calibration, the way a unit's ICD values would be
+// entered, then checks each board's raw_and_eng result against the sim's eng response, to within
+// half a raw count plus rounding. It also checks that an uncalibrated board returns 1.
+// Built with every host-buildable driver file (see eps_sim.h):
+//   cd Tools; S=$(ls ../Core/Src/eps_drivers/*.c ../Core/Src/debug_tools/*.c | grep -v -e _i2c -e transport_uart)
+//   gcc -O2 -DEPS_HOST_BUILD -DTIMING_PROBES_ENABLED=0 -I../Core/Inc -o raw_to_eng_check raw_to_eng_check.c $S
+// (without the probes, which would add two clock_gettime() calls to each timed call)
+// Usage: ./raw_to_eng_check [frame count for the benchmark, default 200000]
+// Exits with 0 if every board matches.
+
+#include "eps_drivers/eps_commands.h"
+#include "eps_drivers/eps_hk_cache.h"
+#include "eps_drivers/eps_internal_drivers.h"
+#include "eps_drivers/eps_raw_to_eng.h"
+#include "eps_drivers/eps_sim.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+static int32_t max_error = 0;
+static uint32_t word_count = 0;
+
+static void set_calibration_from_sim() {
+	eps_raw_to_eng_calibration_t calibration;
+	for (uint8_t quantity = 0; quantity < EPS_RAW_TO_ENG_QUANTITY_COUNT; quantity++) {
+		const eps_sim_adc_scale_t *scale = eps_sim_get_adc_scale(quantity);
+		const int64_t num_q16 = (int64_t) scale->eng_per_count_num << 16;
+		calibration.each_quantity[quantity].gain_q16 = (int32_t)((num_q16 + scale->eng_per_count_den / 2) / scale->eng_per_count_den);
+		calibration.each_quantity[quantity].offset = scale->eng_offset;
+	}
+	for (uint8_t board = 0; board < EPS_BOARD_COUNT; board++) {
+		eps_raw_to_eng_set_calibration(board, &calibration);
+	}
+}
+
+// The sim rounds to the nearest count, so the OBC's value is off by up to half a count (in eng
+// units), plus 1 for the OBC's own rounding.
+static int32_t get_tolerance() {
+	int32_t tolerance = 0;
+	for (uint8_t quantity = 0; quantity < EPS_RAW_TO_ENG_QUANTITY_COUNT; quantity++) {
+		const eps_sim_adc_scale_t *scale = eps_sim_get_adc_scale(quantity);
+		const int32_t half_count = (scale->eng_per_count_num + (2 * scale->eng_per_count_den) - 1) / (2 * scale->eng_per_count_den);
+		tolerance = (half_count > tolerance) ? half_count : tolerance;
+	}
+	return tolerance + 1;
+}
+
+// Returns 0 if every word of `converted` is within `tolerance` of `expected`
+static uint8_t compare_words(const char *name, const void *converted, const void *expected, size_t len, int32_t tolerance) {
+	const int16_t *converted_words = converted;
+	const int16_t *expected_words = expected;
+	for (size_t word = 0; word < len / 2; word++) {
+		const int32_t error = abs(converted_words[word] - expected_words[word]);
+		word_count++;
+		max_error = (error > max_error) ? error : max_error;
+		if (error > tolerance) {
+			printf("%s word %zu: converted %d, sim eng %d\n", name, word, converted_words[word], expected_words[word]);
+			return 1;
+		}
+	}
+	return 0;
+}
+
+static double get_time_ns() {
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (now.tv_sec * 1e9) + now.tv_nsec;
+}
+
+int main(int argc, char *argv[]) {
+	const uint32_t frame_count = (argc > 1) ? (uint32_t) strtoul(argv[1], NULL, 0) : 200000;
+
+	eps_set_transport(&eps_transport_sim);
+	for (uint8_t cmd_id = 0; cmd_id < EPS_CMD_ID_COUNT; cmd_id++) {
+		eps_hk_cache_set_max_age_ms(cmd_id, 0); // raw and eng must come from separate fetches
+	}
+	eps_output_bus_group_on(0xFFFF, 0xFFFF); // non-zero channel currents
+
+	static eps_result_pdu_housekeeping_data_raw_t pdu_raw;
+	static eps_result_pdu_housekeeping_data_eng_t pdu_eng, pdu_converted;
+	static eps_result_pbu_housekeeping_data_raw_t pbu_raw;
+	static eps_result_pbu_housekeeping_data_eng_t pbu_eng, pbu_converted;
+	static eps_result_pcu_housekeeping_data_raw_t pcu_raw;
+	static eps_result_pcu_housekeeping_data_eng_t pcu_eng, pcu_converted;
+	static eps_result_piu_housekeeping_data_raw_t piu_raw;
+	static eps_result_piu_housekeeping_data_eng_t piu_eng, piu_converted;
+
+	if (eps_get_pdu_housekeeping_data_raw_and_eng(&pdu_raw, &pdu_converted) != 1
+			|| eps_result_piu_housekeeping_data_raw_TO_eng(&piu_raw, &piu_converted) != 1) {
+		puts("FAIL: an uncalibrated board converted");
+		return 1;
+	}
+
+	set_calibration_from_sim();
+	const int32_t tolerance = get_tolerance();
+	uint8_t fail = 0;
+	fail |= eps_get_pdu_housekeeping_data_eng(&pdu_eng) || eps_get_pdu_housekeeping_data_raw_and_eng(&pdu_raw, &pdu_converted)
+			|| compare_words("pdu", &pdu_converted, &pdu_eng, sizeof(pdu_eng), tolerance);
+	fail |= eps_get_pbu_housekeeping_data_eng(&pbu_eng) || eps_get_pbu_housekeeping_data_raw_and_eng(&pbu_raw, &pbu_converted)
+			|| compare_words("pbu", &pbu_converted, &pbu_eng, sizeof(pbu_eng), tolerance);
+	fail |= eps_get_pcu_housekeeping_data_eng(&pcu_eng) || eps_get_pcu_housekeeping_data_raw_and_eng(&pcu_raw, &pcu_converted)
+			|| compare_words("pcu", &pcu_converted, &pcu_eng, sizeof(pcu_eng), tolerance);
+	fail |= eps_get_piu_housekeeping_data_eng(&piu_eng) || eps_get_piu_housekeeping_data_raw_and_eng(&piu_raw, &piu_converted)
+			|| compare_words("piu", &piu_converted, &piu_eng, sizeof(piu_eng), tolerance);
+	if (fail) {
+		puts("FAIL");
+		return 1;
+	}
+	printf("all boards match the sim: %lu words, max error %ld (tolerance %ld)\n",
+			(unsigned long) word_count, (long) max_error, (long) tolerance);
+
+	// Per-frame conversion time (flipping a bit each time so the loop isn't optimised away)
+	volatile int32_t sink = 0;
+	const double start_ns = get_time_ns();
+	for (uint32_t frame = 0; frame < frame_count; frame++) {
+		eps_result_pdu_housekeeping_data_raw_TO_eng(&pdu_raw, &pdu_converted);
+		sink += pdu_converted.vip_each_channel[1].current_mA;
+		pdu_raw.temperature_mcu_raw ^= 1;
+	}
+	const double pdu_end_ns = get_time_ns();
+	for (uint32_t frame = 0; frame < frame_count; frame++) {
+		eps_result_piu_housekeeping_data_raw_TO_eng(&piu_raw, &piu_converted);
+		sink += piu_converted.vip_each_channel[1].current_mA;
+		piu_raw.temperature_mcu_raw ^= 1;
+	}
+	const double piu_end_ns = get_time_ns();
+	printf("PDU frame (%zu words): %.0f ns; PIU frame (%zu words): %.0f ns\n",
+			sizeof(pdu_raw) / 2, (pdu_end_ns - start_ns) / frame_count,
+			sizeof(piu_raw) / 2, (piu_end_ns - pdu_end_ns) / frame_count);
+	puts("OK");
+	return 0;
+}
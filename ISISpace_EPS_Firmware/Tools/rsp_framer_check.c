@@ -0,0 +1,140 @@
+// rsp_framer_check.c
+// Host tool: feeds byte streams through eps_rsp_framer and checks the payload, whether the frame
+// completed, and the frame/dropped/malformed counters: leading garbage, a start tag split across
+// pushes, a bad end tag that resyncs onto an inner "<rsp>", an oversize payload, a partial "<rs"
+// at the end of a re-scan, and a frame that fails inside a re-scan.
+// Built on its own (the framer has no other dependencies):
+//   cd Tools; gcc -O2 -I../Core/Inc -o rsp_framer_check rsp_framer_check.c ../Core/Src/eps_drivers/eps_rsp_framer.c
+// Usage: ./rsp_framer_check
+// Exits with 0 if every check passes.
+
+#include "eps_drivers/eps_rsp_framer.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#define PAYLOAD_BUF_LEN 16
+
+static uint32_t fail_count = 0;
+
+#define CHECK(condition) do { \
+		if (!(condition)) { \
+			printf("FAIL line %d: %s\n", __LINE__, #condition); \
+			fail_count++; \
+		} \
+	} while (0)
+
+static eps_rsp_framer_t framer;
+static uint8_t payload_buf[PAYLOAD_BUF_LEN];
+
+static void begin(const char *name, uint16_t payload_len) {
+	printf("%s\n", name);
+	eps_rsp_framer_init(&framer);
+	memset(payload_buf, 0, sizeof(payload_buf));
+	eps_rsp_framer_begin_frame(&framer, payload_buf, payload_len);
+}
+
+// Returns the number of bytes consumed
+static uint16_t push(const char *text) {
+	return eps_rsp_framer_push_bytes(&framer, (const uint8_t *) text, (uint16_t) strlen(text));
+}
+
+static void check_frame(const char *payload, uint32_t frame_count, uint32_t dropped_byte_count, uint32_t malformed_frame_count) {
+	CHECK(eps_rsp_framer_is_frame_complete(&framer));
+	CHECK(memcmp(payload_buf, payload, strlen(payload)) == 0);
+	CHECK(framer.frame_count == frame_count);
+	CHECK(framer.dropped_byte_count == dropped_byte_count);
+	CHECK(framer.malformed_frame_count == malformed_frame_count);
+}
+
+
+static void check_leading_garbage() {
+	begin("leading garbage", 4);
+	// "xx" and the "<r" that the second "<" breaks off are dropped
+	CHECK(push("xx<r<rsp>ABCD</rsp>") == 19);
+	check_frame("ABCD", 1, 4, 0);
+}
+
+static void check_split_start_tag() {
+	begin("start tag split across pushes", 4);
+	CHECK(eps_rsp_framer_push_byte(&framer, '<') == 0);
+	CHECK(push("r") == 1);
+	CHECK(push("sp>AB") == 5);
+	CHECK(push("CD</r") == 5);
+	CHECK(!eps_rsp_framer_is_frame_complete(&framer));
+	CHECK(framer.dropped_byte_count == 0);
+	// Stops after the end tag, leaving the caller the rest
+	CHECK(push("sp>next") == 3);
+	check_frame("ABCD", 1, 0, 0);
+
+	// Bytes pushed after a complete frame are dropped until the next begin_frame()
+	CHECK(eps_rsp_framer_push_byte(&framer, 'x') == 1);
+	CHECK(framer.dropped_byte_count == 1);
+	eps_rsp_framer_begin_frame(&framer, payload_buf, 2);
+	CHECK(push("<rsp>EF</rsp>") == 13);
+	check_frame("EF", 2, 1, 0);
+}
+
+static void check_resync_onto_inner_start_tag() {
+	begin("bad end tag, resync onto the inner <rsp>", 4);
+	// The first "<rsp>" takes "<rsp" as its payload, then ">" fails its end tag. Re-scanning
+	// "<rsp" + ">" finds the real start tag, so only the first "<rsp>" is dropped.
+	CHECK(push("<rsp><rsp>ABCD</rsp>") == 20);
+	check_frame("ABCD", 1, 5, 1);
+}
+
+static void check_oversize_payload() {
+	begin("oversize payload", 4);
+	// "E" fails the end tag: "<rsp>" and the re-scanned "ABCD" + "E" are dropped, then "F</rsp>"
+	// while hunting
+	CHECK(push("<rsp>ABCDEF</rsp>") == 17);
+	CHECK(!eps_rsp_framer_is_frame_complete(&framer));
+	CHECK(framer.malformed_frame_count == 1);
+	CHECK(framer.dropped_byte_count == 5 + 5 + 7);
+	CHECK(push("<rsp>WXYZ</rsp>") == 15);
+	check_frame("WXYZ", 1, 17, 1);
+}
+
+static void check_partial_start_tag_after_rescan() {
+	begin("partial <rs at the end of a re-scan", 4);
+	// "s" fails the end tag. Re-scanning "AB<r" + "s" drops "AB" and leaves "<rs" matched, which
+	// the next push completes.
+	CHECK(push("<rsp>AB<rs") == 10);
+	CHECK(!eps_rsp_framer_is_frame_complete(&framer));
+	CHECK(framer.malformed_frame_count == 1);
+	CHECK(framer.dropped_byte_count == 5 + 2);
+	CHECK(framer.tag_match_len == 3);
+	CHECK(push("p>WXYZ</rsp>") == 12);
+	check_frame("WXYZ", 1, 7, 1);
+}
+
+static void check_frame_failing_inside_rescan() {
+	begin("frame failing inside a re-scan", 6);
+	// The outer frame's payload "<rsp>Z" and end tag "</rsp" + "Y" fail. Re-scanning them finds an
+	// inner "<rsp>" with the payload "Z</rsp", which "Y" also fails; that one isn't re-scanned.
+	CHECK(push("<rsp><rsp>Z</rspY") == 17);
+	CHECK(!eps_rsp_framer_is_frame_complete(&framer));
+	CHECK(framer.malformed_frame_count == 2);
+	CHECK(framer.dropped_byte_count == 5 + 5 + 6 + 1);
+	CHECK(framer.tag_match_len == 0);
+	CHECK(push("<rsp>UVWXYZ</rsp>") == 17);
+	check_frame("UVWXYZ", 1, 17, 2);
+}
+
+
+int main() {
+	check_leading_garbage();
+	check_split_start_tag();
+	check_resync_onto_inner_start_tag();
+	check_oversize_payload();
+	check_partial_start_tag_after_rescan();
+	check_frame_failing_inside_rescan();
+
+	if (fail_count != 0) {
+		printf("FAIL: %lu checks\n", (unsigned long) fail_count);
+		return 1;
+	}
+	puts("OK");
+	return 0;
+}
@@ -0,0 +1,187 @@
+// rsp_view_check.c
+// Host tool: checks every eps_pdu_view_*/eps_piu_view_* accessor, and eps_rsp_view_get() for each
+// 16-bit word of the struct, against eps_decode_fields() of the same buffer: PDU and PIU eng
+// housekeeping responses from the simulated EPS (read with eps_hk_cache_read(), with a different
+// set of channels on each time), then random buffers. Also times reading channel currents through
+// a view against decoding the whole response.
+// Built with every host-buildable driver file (see eps_sim.h):
+//   cd Tools; S=$(ls ../Core/Src/eps_drivers/*.c ../Core/Src/debug_tools/*.c | grep -v -e _i2c -e transport_uart)
+//   gcc -O2 -DEPS_HOST_BUILD -DTIMING_PROBES_ENABLED=0 -I../Core/Inc -o rsp_view_check rsp_view_check.c $S
+// (without the probes, which would add two clock_gettime() calls to each timed call)
+// Usage: ./rsp_view_check [random buffer count, default 20000]
+// Exits with 0 if every accessor matches.
+
+#include "eps_drivers/eps_cmd_table.h"
+#include "eps_drivers/eps_commands.h"
+#include "eps_drivers/eps_field_decoder.h"
+#include "eps_drivers/eps_hk_cache.h"
+#include "eps_drivers/eps_internal_drivers.h"
+#include "eps_drivers/eps_rsp_view.h"
+#include "eps_drivers/eps_sim.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define CHANNEL_COUNT 32
+#define SIM_RESPONSE_COUNT 20
+#define TIMING_LOOPS 200000
+
+static uint32_t fail_count = 0;
+
+#define CHECK(condition) do { \
+		if (!(condition)) { \
+			printf("FAIL line %d: %s\n", __LINE__, #condition); \
+			fail_count++; \
+		} \
+	} while (0)
+
+static uint32_t random_state = 1;
+
+// xorshift32
+static uint32_t get_random() {
+	random_state ^= random_state << 13;
+	random_state ^= random_state >> 17;
+	random_state ^= random_state << 5;
+	return random_state;
+}
+
+// eps_rsp_view_get() for every word of the struct
+static void check_view_get(const eps_rsp_view_t *view, const void *decoded, size_t len) {
+	const uint8_t *decoded_bytes = decoded;
+	for (uint16_t offset = 0; offset < len; offset += 2) {
+		uint16_t word;
+		memcpy(&word, &decoded_bytes[offset], 2);
+		CHECK((uint16_t) eps_rsp_view_get(view, offset) == word);
+	}
+}
+
+static void check_piu(const uint8_t rx_buf[]) {
+	static eps_result_piu_housekeeping_data_eng_t decoded;
+	eps_decode_fields(&eps_field_table_piu_housekeeping_data_eng, rx_buf, &decoded);
+	eps_piu_view_t view;
+	CHECK(eps_piu_view_init(&view, rx_buf, EPS_CMD_MAX_RX_LEN) == 0);
+
+	for (uint8_t ch_num = 0; ch_num < CHANNEL_COUNT; ch_num++) {
+		CHECK(eps_piu_view_channel_voltage_mV(&view, ch_num) == decoded.vip_each_channel[ch_num].voltage_mV);
+		CHECK(eps_piu_view_channel_current_mA(&view, ch_num) == decoded.vip_each_channel[ch_num].current_mA);
+		CHECK(eps_piu_view_channel_power_cW(&view, ch_num) == decoded.vip_each_channel[ch_num].power_cW);
+	}
+	CHECK(eps_piu_view_stat_ch_on_bitfield(&view) == decoded.stat_ch_on_bitfield);
+	CHECK(eps_piu_view_stat_ch_overcurrent_fault_bitfield(&view) == decoded.stat_ch_overcurrent_fault_bitfield);
+	CHECK(eps_piu_view_stat_ch_ext_on_bitfield(&view) == decoded.stat_ch_ext_on_bitfield);
+	CHECK(eps_piu_view_stat_ch_ext_overcurrent_fault_bitfield(&view) == decoded.stat_ch_ext_overcurrent_fault_bitfield);
+	check_view_get(&view.rsp, &decoded, sizeof(decoded));
+}
+
+static void check_pdu(const uint8_t rx_buf[]) {
+	static eps_result_pdu_housekeeping_data_eng_t decoded;
+	eps_decode_fields(&eps_field_table_pdu_housekeeping_data_eng, rx_buf, &decoded);
+	eps_pdu_view_t view;
+	CHECK(eps_pdu_view_init(&view, rx_buf, EPS_CMD_MAX_RX_LEN) == 0);
+
+	for (uint8_t ch_num = 0; ch_num < CHANNEL_COUNT; ch_num++) {
+		CHECK(eps_pdu_view_channel_voltage_mV(&view, ch_num) == decoded.vip_each_channel[ch_num].voltage_mV);
+		CHECK(eps_pdu_view_channel_current_mA(&view, ch_num) == decoded.vip_each_channel[ch_num].current_mA);
+		CHECK(eps_pdu_view_channel_power_cW(&view, ch_num) == decoded.vip_each_channel[ch_num].power_cW);
+	}
+	CHECK(eps_pdu_view_stat_ch_on_bitfield(&view) == decoded.stat_ch_on_bitfield);
+	CHECK(eps_pdu_view_stat_ch_overcurrent_fault_bitfield(&view) == decoded.stat_ch_overcurrent_fault_bitfield);
+	CHECK(eps_pdu_view_stat_ch_ext_on_bitfield(&view) == decoded.stat_ch_ext_on_bitfield);
+	CHECK(eps_pdu_view_stat_ch_ext_overcurrent_fault_bitfield(&view) == decoded.stat_ch_ext_overcurrent_fault_bitfield);
+	check_view_get(&view.rsp, &decoded, sizeof(decoded));
+}
+
+static void check_sim_responses() {
+	static uint8_t pdu_rx_buf[EPS_CMD_MAX_RX_LEN];
+	static uint8_t piu_rx_buf[EPS_CMD_MAX_RX_LEN];
+	for (uint8_t response_num = 0; response_num < SIM_RESPONSE_COUNT; response_num++) {
+		const uint32_t channels = get_random();
+		eps_output_bus_group_off(0xFFFF, 0xFFFF);
+		eps_output_bus_group_on(channels & 0xFFFF, channels >> 16);
+		eps_hk_cache_invalidate_all();
+		CHECK(eps_hk_cache_read(EPS_CMD_ID_GET_PDU_HOUSEKEEPING_DATA_ENG, EPS_HK_CACHE_MODE_FRESH, pdu_rx_buf) == 0);
+		CHECK(eps_hk_cache_read(EPS_CMD_ID_GET_PIU_HOUSEKEEPING_DATA_ENG, EPS_HK_CACHE_MODE_FRESH, piu_rx_buf) == 0);
+
+		eps_pdu_view_t pdu_view;
+		eps_piu_view_t piu_view;
+		CHECK(eps_pdu_view_init(&pdu_view, pdu_rx_buf, eps_cmd_table[EPS_CMD_ID_GET_PDU_HOUSEKEEPING_DATA_ENG].rx_len) == 0);
+		CHECK(eps_piu_view_init(&piu_view, piu_rx_buf, eps_cmd_table[EPS_CMD_ID_GET_PIU_HOUSEKEEPING_DATA_ENG].rx_len) == 0);
+		CHECK(eps_pdu_view_stat_ch_on_bitfield(&pdu_view) == (channels & 0xFFFF));
+		CHECK(eps_pdu_view_stat_ch_ext_on_bitfield(&pdu_view) == (channels >> 16));
+		check_pdu(pdu_rx_buf);
+		check_piu(piu_rx_buf);
+	}
+}
+
+static double get_time_ns() {
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (now.tv_sec * 1e9) + now.tv_nsec;
+}
+
+// The first channel_count channel currents through the view, and from a full decode
+static void time_piu_channel_currents(uint8_t rx_buf[], uint8_t channel_count) {
+	static eps_result_piu_housekeeping_data_eng_t decoded;
+	volatile int32_t sink = 0;
+	eps_piu_view_t view;
+	eps_piu_view_init(&view, rx_buf, EPS_CMD_MAX_RX_LEN);
+
+	const double start_ns = get_time_ns();
+	for (uint32_t loop = 0; loop < TIMING_LOOPS; loop++) {
+		int32_t total_mA = 0;
+		for (uint8_t ch_num = 0; ch_num < channel_count; ch_num++) {
+			total_mA += eps_piu_view_channel_current_mA(&view, ch_num);
+		}
+		sink += total_mA;
+		rx_buf[40] ^= 1; // so the loop isn't optimised away
+	}
+	const double view_end_ns = get_time_ns();
+	for (uint32_t loop = 0; loop < TIMING_LOOPS; loop++) {
+		eps_decode_fields(&eps_field_table_piu_housekeeping_data_eng, rx_buf, &decoded);
+		int32_t total_mA = 0;
+		for (uint8_t ch_num = 0; ch_num < channel_count; ch_num++) {
+			total_mA += decoded.vip_each_channel[ch_num].current_mA;
+		}
+		sink += total_mA;
+		rx_buf[40] ^= 1;
+	}
+	const double decode_end_ns = get_time_ns();
+	printf("PIU, %2u channel currents: view %.0f ns, decode %.0f ns\n", channel_count,
+			(view_end_ns - start_ns) / TIMING_LOOPS, (decode_end_ns - view_end_ns) / TIMING_LOOPS);
+}
+
+int main(int argc, char *argv[]) {
+	const uint32_t buffer_count = (argc > 1) ? (uint32_t) strtoul(argv[1], NULL, 0) : 20000;
+
+	eps_set_transport(&eps_transport_sim);
+	check_sim_responses();
+
+	static uint8_t rx_buf[EPS_CMD_MAX_RX_LEN];
+	for (uint32_t buffer_num = 0; buffer_num < buffer_count; buffer_num++) {
+		for (uint16_t i = 0; i < sizeof(rx_buf); i++) {
+			rx_buf[i] = (uint8_t) get_random();
+		}
+		check_pdu(rx_buf);
+		check_piu(rx_buf);
+	}
+
+	eps_piu_view_t view;
+	CHECK(eps_piu_view_init(&view, rx_buf, 273) == 1);
+	CHECK(eps_piu_view_init(&view, rx_buf, sizeof(rx_buf)) == 0);
+	CHECK(eps_piu_view_channel_current_mA(&view, CHANNEL_COUNT) == 0);
+	CHECK(eps_rsp_view_get(&view.rsp, sizeof(eps_result_piu_housekeeping_data_eng_t)) == 0);
+
+	if (fail_count != 0) {
+		printf("FAIL: %lu checks\n", (unsigned long) fail_count);
+		return 1;
+	}
+	printf("%u sim responses and %lu random buffers match\n", SIM_RESPONSE_COUNT, (unsigned long) buffer_count);
+	time_piu_channel_currents(rx_buf, 1);
+	time_piu_channel_currents(rx_buf, 4);
+	time_piu_channel_currents(rx_buf, CHANNEL_COUNT);
+	puts("OK");
+	return 0;
+}
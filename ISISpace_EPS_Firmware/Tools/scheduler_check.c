@@ -0,0 +1,262 @@
+// scheduler_check.c
+// Host tool: runs scheduler jobs in real time (the host build of scheduler.c uses CLOCK_MONOTONIC
+// and nanosleep()) and checks the run count of a periodic job, the skipped runs of a job that falls
+// more than a period behind, deadline overruns, one-shot jobs, cancelling, most-overdue-first
+// order, and the bad-args/full returns. Then checks, on the simulated EPS with a 30 ms latency,
+// that a job submitting its command through eps_cmd_queue returns at once, where one calling the
+// blocking eps_get_system_status() overruns (see eps_system_status_job() in main.c).
+// Built with every host-buildable driver file (see eps_sim.h) and the scheduler:
+//   cd Tools; S=$(ls ../Core/Src/eps_drivers/*.c ../Core/Src/debug_tools/*.c | grep -v -e _i2c -e transport_uart)
+//   gcc -O2 -DEPS_HOST_BUILD -I../Core/Inc -o scheduler_check scheduler_check.c ../Core/Src/stm_drivers/scheduler.c $S
+// Usage: ./scheduler_check
+// Exits with 0 if every check passes. Host sleeps can overshoot by 10 ms or more, so the timing
+// checks only rely on differences larger than that (e.g., a job starting a whole period late).
+
+#include "eps_drivers/eps_cmd_queue.h"
+#include "eps_drivers/eps_commands.h"
+#include "eps_drivers/eps_hk_cache.h"
+#include "eps_drivers/eps_internal_drivers.h"
+#include "eps_drivers/eps_sim.h"
+#include "stm_drivers/scheduler.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+static uint32_t fail_count = 0;
+
+#define CHECK(condition) do { \
+		if (!(condition)) { \
+			printf("FAIL line %d: %s\n", __LINE__, #condition); \
+			fail_count++; \
+		} \
+	} while (0)
+
+static uint32_t get_now_ms() {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint32_t)(ts.tv_sec * 1000) + (uint32_t)(ts.tv_nsec / 1000000);
+}
+
+static void sleep_ms(uint32_t duration_ms) {
+	const struct timespec ts = { .tv_sec = duration_ms / 1000, .tv_nsec = (duration_ms % 1000) * 1000000L };
+	nanosleep(&ts, NULL);
+}
+
+// scheduler_run_forever() with the main.c poll hook, for duration_ms
+static void run_for_ms(uint32_t duration_ms) {
+	const uint32_t end_ms = get_now_ms() + duration_ms;
+	while ((int32_t)(get_now_ms() - end_ms) < 0) {
+		scheduler_run_due_jobs();
+		eps_cmd_queue_pump();
+		sleep_ms(1);
+	}
+}
+
+static void cancel_all_jobs() {
+	for (uint8_t job_id = 0; job_id < SCHEDULER_MAX_JOBS; job_id++) {
+		scheduler_cancel(job_id);
+	}
+}
+
+static void print_job(const scheduler_job_t *job) {
+	printf("  %-16s runs=%lu overruns=%lu skipped=%lu max_late_ms=%lu max_run_ms=%lu\n", job->name,
+			(unsigned long) job->run_count, (unsigned long) job->overrun_count, (unsigned long) job->skipped_count,
+			(unsigned long) job->max_late_ms, (unsigned long) job->max_run_ms);
+}
+
+
+// #pragma region Scheduling
+
+static void count_job(void *context) {
+	(*(uint32_t*) context)++;
+}
+
+// Sleeps for the first run's context value (ms), then returns at once
+static void sleep_once_job(void *context) {
+	uint32_t *sleep_ms_once = context;
+	sleep_ms(*sleep_ms_once);
+	*sleep_ms_once = 0;
+}
+
+static void sleep_10_ms_job(void *context) {
+	(void) context;
+	sleep_ms(10);
+}
+
+static void check_periodic() {
+	puts("periodic");
+	uint32_t count = 0;
+	uint8_t job_id;
+	CHECK(scheduler_add_periodic("every_20_ms", count_job, &count, 20, 0, 0, &job_id) == 0);
+	run_for_ms(205); // due at 0, 20, ... 200 ms
+	const scheduler_job_t *job = scheduler_get_job(job_id);
+	print_job(job);
+	CHECK(count == 11 || count == 10);
+	CHECK(job->run_count == count);
+	CHECK(job->skipped_count == 0);
+	CHECK(job->overrun_count == 0);
+	CHECK(job->max_late_ms < 20); // never a period late
+	cancel_all_jobs();
+}
+
+static void check_skip() {
+	puts("more than a period behind");
+	// The first run (due at 0) takes 50 ms; the runs due at 20 and 40 ms are behind it. At 50 ms
+	// it runs the one due at 20 (30 ms late, so an overrun too), skips 40, and is back in phase at
+	// 60. A host that oversleeps by 10 ms or more skips one more, so the check is that every period
+	// was either run or skipped, with no back-to-back catch-up runs.
+	uint32_t first_run_sleep_ms = 50;
+	uint8_t job_id;
+	CHECK(scheduler_add_periodic("slow_first_run", sleep_once_job, &first_run_sleep_ms, 20, 0, 0, &job_id) == 0);
+	run_for_ms(150);
+	const scheduler_job_t *job = scheduler_get_job(job_id);
+	print_job(job);
+	CHECK(job->skipped_count >= 1);
+	CHECK(job->overrun_count == 2); // deadline 20 ms: the first run and the late one both end at 50
+	CHECK(job->max_late_ms >= 30);
+	CHECK(job->max_run_ms >= 50);
+	CHECK(job->run_count + job->skipped_count == 8); // due at 0, 20, ... 140 ms
+	cancel_all_jobs();
+}
+
+static void check_deadline() {
+	puts("deadline");
+	uint8_t job_id;
+	CHECK(scheduler_add_periodic("deadline_5_ms", sleep_10_ms_job, NULL, 40, 0, 5, &job_id) == 0);
+	run_for_ms(100);
+	const scheduler_job_t *job = scheduler_get_job(job_id);
+	print_job(job);
+	CHECK(job->run_count == 3);
+	CHECK(job->overrun_count == job->run_count);
+	CHECK(job->skipped_count == 0);
+	cancel_all_jobs();
+}
+
+static char run_order[8];
+static uint8_t run_order_len = 0;
+
+static void record_job(void *context) {
+	run_order[run_order_len++] = *(const char*) context;
+}
+
+static void check_one_shot_and_order() {
+	puts("one-shot, cancel, order");
+	uint8_t a_id, b_id, c_id;
+	run_order_len = 0;
+	CHECK(scheduler_add_one_shot("a", record_job, "a", 6, 0, &a_id) == 0);
+	CHECK(scheduler_add_one_shot("b", record_job, "b", 2, 0, &b_id) == 0);
+	CHECK(scheduler_add_one_shot("c", record_job, "c", 4, 0, &c_id) == 0);
+	CHECK(scheduler_cancel(c_id) == 0);
+	CHECK(scheduler_cancel(c_id) == 1);
+
+	// Both overdue by the time the scheduler runs: the most overdue first
+	sleep_ms(10);
+	CHECK(scheduler_run_due_jobs() == SCHEDULER_NO_JOB_DUE);
+	CHECK(run_order_len == 2 && memcmp(run_order, "ba", 2) == 0);
+	CHECK(scheduler_get_job(a_id) == NULL);
+	CHECK(scheduler_get_job(b_id) == NULL);
+
+	// Not due yet: returns the time until it is
+	CHECK(scheduler_add_one_shot("later", record_job, "l", 50, 0, NULL) == 0);
+	const uint32_t due_in_ms = scheduler_run_due_jobs();
+	CHECK(due_in_ms >= 48 && due_in_ms <= 50);
+	CHECK(run_order_len == 2);
+	cancel_all_jobs();
+}
+
+static void check_args() {
+	puts("bad args, full");
+	uint32_t count = 0;
+	CHECK(scheduler_add_periodic("no_callback", NULL, NULL, 10, 0, 0, NULL) == 1);
+	CHECK(scheduler_add_periodic("no_period", count_job, &count, 0, 0, 0, NULL) == 1);
+	for (uint8_t job_num = 0; job_num < SCHEDULER_MAX_JOBS; job_num++) {
+		CHECK(scheduler_add_periodic("filler", count_job, &count, 1000, 1000, 0, NULL) == 0);
+	}
+	CHECK(scheduler_add_one_shot("one_too_many", count_job, &count, 0, 0, NULL) == 5);
+	CHECK(scheduler_cancel(SCHEDULER_MAX_JOBS) == 1);
+	cancel_all_jobs();
+}
+
+// #pragma endregion Scheduling
+
+
+// #pragma region EPS jobs
+
+#define SIM_LATENCY_MS 30
+
+static void blocking_system_status_job(void *context) {
+	eps_result_system_status_t system_status;
+	if (eps_get_system_status(&system_status) == 0) {
+		(*(uint32_t*) context)++;
+	}
+}
+
+static const uint8_t system_status_cmd[4] = { EPS_COMMAND_STID, EPS_COMMAND_IVID, 0x40, EPS_COMMAND_BID };
+static uint8_t system_status_rx_buf[36];
+
+static void system_status_done(uint8_t result_code, const uint8_t rx_buf[], uint16_t rx_buf_len, void *context) {
+	(void) rx_buf_len;
+	if (result_code == 0 && (rx_buf[4] == 0x00 || rx_buf[4] == 0x80)) {
+		(*(uint32_t*) context)++;
+	}
+}
+
+static void queued_system_status_job(void *context) {
+	eps_cmd_queue_submit(system_status_cmd, sizeof(system_status_cmd),
+			system_status_rx_buf, sizeof(system_status_rx_buf), system_status_done, context);
+}
+
+static void check_eps_jobs() {
+	puts("blocking vs queued EPS command");
+	eps_set_transport(&eps_transport_sim);
+	eps_hk_cache_set_max_age_ms(EPS_CMD_ID_GET_SYSTEM_STATUS, 0);
+	eps_sim_configure(&(eps_sim_config_t) { .response_latency_ms = SIM_LATENCY_MS });
+
+	// Same period and deadline for both; the LED-like job shares the loop with them
+	uint32_t blocking_count = 0, queued_count = 0, led_count = 0;
+	uint8_t blocking_id, queued_id, led_id;
+	CHECK(scheduler_add_periodic("blocking", blocking_system_status_job, &blocking_count, 100, 0, 10, &blocking_id) == 0);
+	run_for_ms(250);
+	const scheduler_job_t *blocking_job = scheduler_get_job(blocking_id);
+	print_job(blocking_job);
+	CHECK(blocking_count == blocking_job->run_count);
+	CHECK(blocking_job->max_run_ms >= SIM_LATENCY_MS);
+	CHECK(blocking_job->overrun_count == blocking_job->run_count);
+	cancel_all_jobs();
+
+	CHECK(scheduler_add_periodic("queued", queued_system_status_job, &queued_count, 100, 0, 10, &queued_id) == 0);
+	CHECK(scheduler_add_periodic("led", count_job, &led_count, 50, 0, 0, &led_id) == 0);
+	run_for_ms(250);
+	const scheduler_job_t *queued_job = scheduler_get_job(queued_id);
+	const scheduler_job_t *led_job = scheduler_get_job(led_id);
+	print_job(queued_job);
+	print_job(led_job);
+	CHECK(queued_job->run_count == 3);
+	CHECK(queued_count == queued_job->run_count); // every response came while the loop ran on
+	CHECK(queued_job->max_run_ms <= 1);
+	CHECK(queued_job->overrun_count == 0);
+	CHECK(led_job->max_late_ms < SIM_LATENCY_MS); // never held up by a whole EPS transaction
+	CHECK(led_job->skipped_count == 0);
+	cancel_all_jobs();
+}
+
+// #pragma endregion EPS jobs
+
+
+int main() {
+	check_periodic();
+	check_skip();
+	check_deadline();
+	check_one_shot_and_order();
+	check_args();
+	check_eps_jobs();
+
+	if (fail_count != 0) {
+		printf("FAIL: %lu checks\n", (unsigned long) fail_count);
+		return 1;
+	}
+	puts("OK");
+	return 0;
+}
@@ -0,0 +1,396 @@
+// sim_commands_check.c
+// Host tool: regression check of every eps_* command in eps_commands.c against the simulated EPS
+// (eps_transport_sim): each eps_get_* is decoded and its values checked against what the sim
+// puts in the response (including its state: mode, channels, reset counters, time, configuration
+// parameters), and each action command against the sim state it changes. Raw housekeeping values
+// are checked against the eng values through the sim's own ADC scaling.
+// Also checks that eps_sim_process_cmd() zeroes the bytes of rx_buf past the response.
+// Built with every host-buildable driver file (see eps_sim.h):
+//   cd Tools; S=$(ls ../Core/Src/eps_drivers/*.c ../Core/Src/debug_tools/*.c | grep -v -e _i2c -e transport_uart)
+//   gcc -O2 -DEPS_HOST_BUILD -I../Core/Inc -o sim_commands_check sim_commands_check.c $S
+// Usage: ./sim_commands_check
+// Exits with 0 if every check passes.
+
+#include "eps_drivers/eps_cmd_table.h"
+#include "eps_drivers/eps_commands.h"
+#include "eps_drivers/eps_hk_cache.h"
+#include "eps_drivers/eps_internal_drivers.h"
+#include "eps_drivers/eps_sim.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SIM_UNIX_TIME_AT_POWER_ON_SEC 1704067200 // see eps_sim.c
+
+// Channels on during the housekeeping checks: 0, 3, 15, 16 and 31
+#define CH_BF 0x8009
+#define CH_EXT_BF 0x8001
+
+static uint32_t fail_count = 0;
+
+#define CHECK(condition) do { \
+		if (!(condition)) { \
+			printf("FAIL line %d: %s\n", __LINE__, #condition); \
+			fail_count++; \
+		} \
+	} while (0)
+
+static uint8_t is_channel_on(uint8_t ch_num) {
+	return (ch_num < 16) ? ((CH_BF >> ch_num) & 1) : ((CH_EXT_BF >> (ch_num - 16)) & 1);
+}
+
+// The sim's channel VIPD: on channels draw 100 + 10 * channel mA at 5 V
+static void check_channel_vip(const eps_vpid_eng_t *vip, uint8_t ch_num) {
+	const int16_t current_mA = is_channel_on(ch_num) ? (100 + 10 * ch_num) : 0;
+	CHECK(vip->voltage_mV == (is_channel_on(ch_num) ? 5000 : 0));
+	CHECK(vip->current_mA == current_mA);
+	CHECK(vip->power_cW == (is_channel_on(ch_num) ? (5000 * current_mA) / 10000 : 0));
+}
+
+static void check_vip(const eps_vpid_eng_t *vip, int16_t voltage_mV, int16_t current_mA) {
+	CHECK(vip->voltage_mV == voltage_mV);
+	CHECK(vip->current_mA == current_mA);
+	CHECK(vip->power_cW == ((int32_t) voltage_mV * current_mA) / 10000);
+}
+
+static void check_mppt(const eps_conditioning_channel_short_datatype_eng_t *mppt) {
+	CHECK(mppt->volt_in_mppt_mV == 20000);
+	CHECK(mppt->curr_in_mppt_mA == 160);
+	CHECK(mppt->volt_ou_mppt_mV == 16000);
+	CHECK(mppt->curr_ou_mppt_mA == 200);
+}
+
+static int32_t total_channel_current_mA() {
+	int32_t total_mA = 0;
+	for (uint8_t ch_num = 0; ch_num < 32; ch_num++) {
+		total_mA += is_channel_on(ch_num) ? (100 + 10 * ch_num) : 0;
+	}
+	return total_mA;
+}
+
+// A raw value through the sim's ADC scaling is within one count of the eng value
+static void check_raw(int32_t raw, int32_t eng, EPS_RAW_TO_ENG_QUANTITY_enum_t quantity) {
+	const eps_sim_adc_scale_t *scale = eps_sim_get_adc_scale(quantity);
+	const int32_t scaled = (int32_t)(((int64_t) raw * scale->eng_per_count_num) / scale->eng_per_count_den) + scale->eng_offset;
+	const int32_t tolerance = (scale->eng_per_count_num + scale->eng_per_count_den - 1) / scale->eng_per_count_den;
+	if (abs(scaled - eng) > tolerance) {
+		printf("  raw %ld -> %ld, eng %ld\n", (long) raw, (long) scaled, (long) eng);
+	}
+	CHECK(abs(scaled - eng) <= tolerance);
+}
+
+static void check_raw_vip(const eps_vpid_raw_t *raw, const eps_vpid_eng_t *eng) {
+	check_raw(raw->voltage_raw, eng->voltage_mV, EPS_RAW_TO_ENG_QUANTITY_VOLTAGE);
+	check_raw(raw->current_raw, eng->current_mA, EPS_RAW_TO_ENG_QUANTITY_CURRENT);
+	check_raw(raw->power_raw, eng->power_cW, EPS_RAW_TO_ENG_QUANTITY_POWER);
+}
+
+
+// #pragma region Actions and status
+
+static void check_system_status() {
+	eps_result_system_status_t status;
+	CHECK(eps_get_system_status(&status) == 0);
+	CHECK(status.mode == 1);
+	CHECK(status.reset_cause == 0);
+	CHECK(status.rst_cnt_pwron == 1);
+	CHECK(status.rst_cnt_cmd == 0);
+	CHECK(status.error_code == 0);
+	CHECK(status.unix_time_sec >= SIM_UNIX_TIME_AT_POWER_ON_SEC && status.unix_time_sec < SIM_UNIX_TIME_AT_POWER_ON_SEC + 60);
+
+	CHECK(eps_switch_to_safety_mode() == 0);
+	CHECK(eps_get_system_status(&status) == 0);
+	CHECK(status.mode == 2);
+	CHECK(eps_switch_to_nominal_mode() == 0);
+	CHECK(eps_get_system_status(&status) == 0);
+	CHECK(status.mode == 1);
+
+	const uint32_t unix_time_before_sec = status.unix_time_sec;
+	CHECK(eps_correct_time(3600) == 0);
+	CHECK(eps_get_system_status(&status) == 0);
+	CHECK(status.unix_time_sec - unix_time_before_sec >= 3600 && status.unix_time_sec - unix_time_before_sec <= 3601);
+
+	// Commanded reset: counted, and the channels are off after it
+	CHECK(eps_output_bus_group_on(CH_BF, CH_EXT_BF) == 0);
+	CHECK(eps_system_reset() == 0);
+	CHECK(eps_get_system_status(&status) == 0);
+	CHECK(status.reset_cause == 2);
+	CHECK(status.rst_cnt_cmd == 1);
+	CHECK(eps_sim_get_state()->stat_ch_on_bitfield == 0);
+
+	CHECK(eps_zero_reset_cause_counters() == 0);
+	CHECK(eps_get_system_status(&status) == 0);
+	CHECK(status.rst_cnt_pwron == 0);
+	CHECK(status.rst_cnt_cmd == 0);
+}
+
+static void check_actions() {
+	CHECK(eps_no_operation() == 0);
+	CHECK(eps_cancel_oper() == 0);
+
+	const uint32_t kick_count_before = eps_sim_get_state()->watchdog_kick_count;
+	CHECK(eps_watchdog() == 0);
+	CHECK(eps_sim_get_state()->watchdog_kick_count == kick_count_before + 1);
+
+	eps_result_pdu_overcurrent_fault_state_t ocf;
+	CHECK(eps_output_bus_group_state(0x00FF, 0x0001) == 0);
+	CHECK(eps_output_bus_group_off(0x000F, 0) == 0);
+	CHECK(eps_output_bus_channel_on(1) == 0);
+	CHECK(eps_output_bus_channel_on(20) == 0);
+	CHECK(eps_output_bus_channel_off(7) == 0);
+	// The sim answers PARAM_INVALID and changes nothing; eps_cmd_execute() doesn't check STAT, so this returns 0
+	CHECK(eps_output_bus_channel_on(32) == 0);
+	CHECK(eps_get_pdu_overcurrent_fault_state(&ocf) == 0);
+	CHECK(ocf.stat_ch_on_bitfield == 0x0072);
+	CHECK(ocf.stat_ch_ext_on_bitfield == 0x0011);
+	CHECK(ocf.stat_ch_overcurrent_fault_bitfield == 0);
+	CHECK(ocf.stat_ch_ext_overcurrent_fault_bitfield == 0);
+	CHECK(ocf.overcurrent_fault_count_each_channel[0] == 0);
+
+	eps_result_pbu_abf_placed_state_t abf = { EPS_ABF_PIN_NOT_APPLIED, EPS_ABF_PIN_NOT_APPLIED };
+	CHECK(eps_get_pbu_abf_placed_state(&abf) == 0);
+	CHECK(abf.abf_placed_0 == EPS_ABF_PIN_APPLIED);
+	CHECK(abf.abf_placed_1 == EPS_ABF_PIN_APPLIED);
+}
+
+static void check_configuration() {
+	uint8_t value[8];
+	memset(value, 0xEE, sizeof(value));
+	CHECK(eps_get_configuration_parameter(0x1234, value) == 0);
+	for (uint8_t i = 0; i < sizeof(value); i++) {
+		CHECK(value[i] == 0);
+	}
+	CHECK(eps_sim_get_state()->config_param_count == 1);
+
+	CHECK(eps_reset_configuration_parameter(0x1234) == 0);
+	CHECK(eps_sim_get_state()->config_changed_since_boot == 1);
+	CHECK(eps_set_configuration_parameter(0x1234, 1) == 100); // not implemented yet
+
+	CHECK(eps_save_configuration() == 0);
+	CHECK(eps_load_configuration() == 0);
+	CHECK(eps_sim_get_state()->config_changed_since_boot == 0);
+	CHECK(eps_reset_configuration() == 0);
+	CHECK(eps_sim_get_state()->config_param_count == 0);
+}
+
+// #pragma endregion Actions and status
+
+
+// #pragma region Housekeeping
+
+static void check_pdu_eng(const eps_result_pdu_housekeeping_data_eng_t *pdu) {
+	CHECK(pdu->voltage_internal_board_supply_mV == 3300);
+	CHECK(pdu->temperature_mcu_cC == 2500);
+	check_vip(&pdu->vip_total_input, 8000, (int16_t) total_channel_current_mA());
+	CHECK(pdu->stat_ch_on_bitfield == CH_BF);
+	CHECK(pdu->stat_ch_ext_on_bitfield == CH_EXT_BF);
+	for (uint8_t domain_num = 0; domain_num < 7; domain_num++) {
+		check_vip(&pdu->vip_each_voltage_domain[domain_num], 3300, 50);
+	}
+	for (uint8_t ch_num = 0; ch_num < 32; ch_num++) {
+		check_channel_vip(&pdu->vip_each_channel[ch_num], ch_num);
+	}
+}
+
+static void check_pdu() {
+	static eps_result_pdu_housekeeping_data_eng_t pdu;
+	static eps_result_pdu_housekeeping_data_raw_t pdu_raw;
+	CHECK(eps_get_pdu_housekeeping_data_eng(&pdu) == 0);
+	check_pdu_eng(&pdu);
+	memset(&pdu, 0, sizeof(pdu));
+	CHECK(eps_cmd_execute(EPS_CMD_ID_GET_PDU_HOUSEKEEPING_DATA_RUNNING_AVERAGE, 0, &pdu) == 0);
+	check_pdu_eng(&pdu);
+
+	CHECK(eps_get_pdu_housekeeping_data_raw(&pdu_raw) == 0);
+	check_raw(pdu_raw.voltage_internal_board_supply_raw, pdu.voltage_internal_board_supply_mV, EPS_RAW_TO_ENG_QUANTITY_VOLTAGE);
+	check_raw(pdu_raw.temperature_mcu_raw, pdu.temperature_mcu_cC, EPS_RAW_TO_ENG_QUANTITY_TEMPERATURE);
+	check_raw_vip(&pdu_raw.vip_total_input_raw, &pdu.vip_total_input);
+	CHECK(pdu_raw.stat_ch_on_bitfield == CH_BF);
+	CHECK(pdu_raw.stat_ch_ext_on_bitfield == CH_EXT_BF);
+	for (uint8_t ch_num = 0; ch_num < 32; ch_num++) {
+		check_raw_vip(&pdu_raw.vip_each_channel_raw[ch_num], &pdu.vip_each_channel[ch_num]);
+	}
+}
+
+static void check_pbu_eng(const eps_result_pbu_housekeeping_data_eng_t *pbu) {
+	CHECK(pbu->voltage_internal_board_supply_mV == 3300);
+	CHECK(pbu->temperature_mcu_cC == 2500);
+	check_vip(&pbu->vip_total_input, 8000, 500);
+	for (uint8_t bp_num = 0; bp_num < 3; bp_num++) {
+		const eps_battery_pack_datatype_eng_t *bp = &pbu->battery_pack_info_each_pack[bp_num];
+		check_vip(&bp->vip_bp_input, 16000, 150);
+		for (uint8_t cell_num = 0; cell_num < 4; cell_num++) {
+			CHECK(bp->cell_voltage_each_cell_mV[cell_num] == 4000);
+		}
+		for (uint8_t sensor_num = 0; sensor_num < 3; sensor_num++) {
+			CHECK(bp->battery_temperature_each_sensor_cC[sensor_num] == 2000);
+		}
+	}
+}
+
+static void check_pbu() {
+	static eps_result_pbu_housekeeping_data_eng_t pbu;
+	static eps_result_pbu_housekeeping_data_raw_t pbu_raw;
+	CHECK(eps_get_pbu_housekeeping_data_eng(&pbu) == 0);
+	check_pbu_eng(&pbu);
+	memset(&pbu, 0, sizeof(pbu));
+	CHECK(eps_cmd_execute(EPS_CMD_ID_GET_PBU_HOUSEKEEPING_DATA_RUNNING_AVERAGE, 0, &pbu) == 0);
+	check_pbu_eng(&pbu);
+
+	CHECK(eps_get_pbu_housekeeping_data_raw(&pbu_raw) == 0);
+	check_raw(pbu_raw.voltage_internal_board_supply_raw, pbu.voltage_internal_board_supply_mV, EPS_RAW_TO_ENG_QUANTITY_VOLTAGE);
+	check_raw(pbu_raw.temperature_mcu_raw, pbu.temperature_mcu_cC, EPS_RAW_TO_ENG_QUANTITY_TEMPERATURE);
+	check_raw_vip(&pbu_raw.vip_total_input_raw, &pbu.vip_total_input);
+	for (uint8_t bp_num = 0; bp_num < 3; bp_num++) {
+		const eps_battery_pack_datatype_raw_t *bp_raw = &pbu_raw.battery_pack_info_each_pack_raw[bp_num];
+		const eps_battery_pack_datatype_eng_t *bp = &pbu.battery_pack_info_each_pack[bp_num];
+		check_raw_vip(&bp_raw->vip_bp_input_raw, &bp->vip_bp_input);
+		for (uint8_t cell_num = 0; cell_num < 4; cell_num++) {
+			check_raw(bp_raw->cell_voltage_each_cell_raw[cell_num], bp->cell_voltage_each_cell_mV[cell_num], EPS_RAW_TO_ENG_QUANTITY_VOLTAGE);
+		}
+		for (uint8_t sensor_num = 0; sensor_num < 3; sensor_num++) {
+			check_raw(bp_raw->battery_temperature_each_sensor_raw[sensor_num], bp->battery_temperature_each_sensor_cC[sensor_num],
+					EPS_RAW_TO_ENG_QUANTITY_TEMPERATURE);
+		}
+	}
+}
+
+static void check_pcu_eng(const eps_result_pcu_housekeeping_data_eng_t *pcu) {
+	CHECK(pcu->voltage_internal_board_supply_mV == 3300);
+	CHECK(pcu->temperature_mcu_cC == 2500);
+	check_vip(&pcu->vip_total_input, 16000, 800);
+	for (uint8_t cc_num = 0; cc_num < 4; cc_num++) {
+		const eps_conditioning_channel_datatype_eng_t *cc = &pcu->conditioning_channel_info_each_channel[cc_num];
+		check_vip(&cc->vip_cc_output, 16000, 200);
+		const eps_conditioning_channel_short_datatype_eng_t mppt = {
+			cc->volt_in_mppt_mV, cc->curr_in_mppt_mA, cc->volt_ou_mppt_mV, cc->curr_ou_mppt_mA
+		};
+		check_mppt(&mppt);
+	}
+}
+
+static void check_pcu() {
+	static eps_result_pcu_housekeeping_data_eng_t pcu;
+	static eps_result_pcu_housekeeping_data_raw_t pcu_raw;
+	CHECK(eps_get_pcu_housekeeping_data_eng(&pcu) == 0);
+	check_pcu_eng(&pcu);
+	memset(&pcu, 0, sizeof(pcu));
+	CHECK(eps_cmd_execute(EPS_CMD_ID_GET_PCU_HOUSEKEEPING_DATA_RUNNING_AVERAGE, 0, &pcu) == 0);
+	check_pcu_eng(&pcu);
+
+	CHECK(eps_get_pcu_housekeeping_data_raw(&pcu_raw) == 0);
+	check_raw(pcu_raw.voltage_internal_board_supply_raw, pcu.voltage_internal_board_supply_mV, EPS_RAW_TO_ENG_QUANTITY_VOLTAGE);
+	check_raw(pcu_raw.temperature_mcu_raw, pcu.temperature_mcu_cC, EPS_RAW_TO_ENG_QUANTITY_TEMPERATURE);
+	check_raw_vip(&pcu_raw.vip_total_input_raw, &pcu.vip_total_input);
+	for (uint8_t cc_num = 0; cc_num < 4; cc_num++) {
+		const eps_conditioning_channel_datatype_raw_t *cc_raw = &pcu_raw.conditioning_channel_info_each_channel_raw[cc_num];
+		const eps_conditioning_channel_datatype_eng_t *cc = &pcu.conditioning_channel_info_each_channel[cc_num];
+		check_raw_vip(&cc_raw->vip_cc_output_raw, &cc->vip_cc_output);
+		check_raw(cc_raw->volt_in_mppt_raw, cc->volt_in_mppt_mV, EPS_RAW_TO_ENG_QUANTITY_VOLTAGE);
+		check_raw(cc_raw->curr_in_mppt_raw, cc->curr_in_mppt_mA, EPS_RAW_TO_ENG_QUANTITY_CURRENT);
+		check_raw(cc_raw->volt_ou_mppt_raw, cc->volt_ou_mppt_mV, EPS_RAW_TO_ENG_QUANTITY_VOLTAGE);
+		check_raw(cc_raw->curr_ou_mppt_raw, cc->curr_ou_mppt_mA, EPS_RAW_TO_ENG_QUANTITY_CURRENT);
+	}
+}
+
+static void check_piu_eng(const eps_result_piu_housekeeping_data_eng_t *piu) {
+	CHECK(piu->voltage_internal_board_supply_mV == 3300);
+	CHECK(piu->temperature_mcu_cC == 2500);
+	check_vip(&piu->vip_dist_input, 8000, (int16_t) total_channel_current_mA());
+	check_vip(&piu->vip_batt_input, 16000, 300);
+	CHECK(piu->stat_ch_on_bitfield == CH_BF);
+	CHECK(piu->stat_ch_ext_on_bitfield == CH_EXT_BF);
+	CHECK(piu->battery_temp2_cC == 2000);
+	CHECK(piu->battery_temp3_cC == 2000);
+	CHECK(piu->vd0_voltage_mV == 3300);
+	CHECK(piu->vd1_voltage_mV == 5000);
+	CHECK(piu->vd2_voltage_mV == 12000);
+	for (uint8_t ch_num = 0; ch_num < 32; ch_num++) {
+		check_channel_vip(&piu->vip_each_channel[ch_num], ch_num);
+	}
+	for (uint8_t cc_num = 0; cc_num < 5; cc_num++) {
+		check_mppt(&piu->conditioning_channel_info_each_channel[cc_num]);
+	}
+}
+
+static void check_piu() {
+	static eps_result_piu_housekeeping_data_eng_t piu;
+	static eps_result_piu_housekeeping_data_raw_t piu_raw;
+	CHECK(eps_get_piu_housekeeping_data_eng(&piu) == 0);
+	check_piu_eng(&piu);
+	memset(&piu, 0, sizeof(piu));
+	CHECK(eps_cmd_execute(EPS_CMD_ID_GET_PIU_HOUSEKEEPING_DATA_RUNNING_AVERAGE, 0, &piu) == 0);
+	check_piu_eng(&piu);
+
+	CHECK(eps_get_piu_housekeeping_data_raw(&piu_raw) == 0);
+	check_raw(piu_raw.voltage_internal_board_supply_raw, piu.voltage_internal_board_supply_mV, EPS_RAW_TO_ENG_QUANTITY_VOLTAGE);
+	check_raw(piu_raw.temperature_mcu_raw, piu.temperature_mcu_cC, EPS_RAW_TO_ENG_QUANTITY_TEMPERATURE);
+	check_raw_vip(&piu_raw.vip_dist_input_raw, &piu.vip_dist_input);
+	check_raw_vip(&piu_raw.vip_batt_input_raw, &piu.vip_batt_input);
+	CHECK(piu_raw.stat_ch_on_bitfield == CH_BF);
+	CHECK(piu_raw.stat_ch_ext_on_bitfield == CH_EXT_BF);
+	check_raw(piu_raw.battery_temp2_raw, (int16_t) piu.battery_temp2_cC, EPS_RAW_TO_ENG_QUANTITY_TEMPERATURE);
+	check_raw(piu_raw.battery_temp3_raw, (int16_t) piu.battery_temp3_cC, EPS_RAW_TO_ENG_QUANTITY_TEMPERATURE);
+	check_raw(piu_raw.vd2_voltage_raw, piu.vd2_voltage_mV, EPS_RAW_TO_ENG_QUANTITY_VOLTAGE);
+	for (uint8_t ch_num = 0; ch_num < 32; ch_num++) {
+		check_raw_vip(&piu_raw.vip_each_channel_raw[ch_num], &piu.vip_each_channel[ch_num]);
+	}
+	for (uint8_t cc_num = 0; cc_num < 5; cc_num++) {
+		const eps_conditioning_channel_short_datatype_raw_t *cc_raw = &piu_raw.conditioning_channel_info_each_channel_raw[cc_num];
+		const eps_conditioning_channel_short_datatype_eng_t *cc = &piu.conditioning_channel_info_each_channel[cc_num];
+		check_raw(cc_raw->volt_in_mppt_raw, cc->volt_in_mppt_mV, EPS_RAW_TO_ENG_QUANTITY_VOLTAGE);
+		check_raw(cc_raw->curr_ou_mppt_raw, cc->curr_ou_mppt_mA, EPS_RAW_TO_ENG_QUANTITY_CURRENT);
+	}
+}
+
+// #pragma endregion Housekeeping
+
+
+// rx_buf past the response is zeroed, whatever was in it before
+static void check_rx_buf_tail() {
+	static uint8_t rx_buf[300];
+	const uint8_t no_operation_cmd[4] = { EPS_COMMAND_STID, EPS_COMMAND_IVID, 0x02, EPS_COMMAND_BID };
+	memset(rx_buf, 0xEE, sizeof(rx_buf));
+	CHECK(eps_sim_process_cmd(no_operation_cmd, sizeof(no_operation_cmd), rx_buf, 40, 0) == EPS_SIM_STAT_ACCEPTED);
+	for (uint16_t i = 5; i < 40; i++) {
+		CHECK(rx_buf[i] == 0);
+	}
+	CHECK(rx_buf[40] == 0xEE);
+
+	const uint8_t piu_cmd[4] = { EPS_COMMAND_STID, EPS_COMMAND_IVID, 0xA2, EPS_COMMAND_BID };
+	memset(rx_buf, 0xEE, sizeof(rx_buf));
+	CHECK(eps_sim_process_cmd(piu_cmd, sizeof(piu_cmd), rx_buf, sizeof(rx_buf), 0) == EPS_SIM_STAT_ACCEPTED);
+	for (uint16_t i = 274; i < sizeof(rx_buf); i++) {
+		CHECK(rx_buf[i] == 0);
+	}
+}
+
+
+int main() {
+	eps_set_transport(&eps_transport_sim);
+	for (uint8_t cmd_id = 0; cmd_id < EPS_CMD_ID_COUNT; cmd_id++) {
+		eps_hk_cache_set_max_age_ms(cmd_id, 0); // every command reaches the sim
+	}
+
+	check_system_status();
+	check_actions();
+	check_configuration();
+
+	CHECK(eps_output_bus_group_state(CH_BF, CH_EXT_BF) == 0);
+	check_pdu();
+	check_pbu();
+	check_pcu();
+	check_piu();
+
+	check_rx_buf_tail();
+
+	if (fail_count != 0) {
+		printf("FAIL: %lu checks\n", (unsigned long) fail_count);
+		return 1;
+	}
+	printf("%lu commands sent to the sim\n", (unsigned long) eps_sim_get_state()->cmd_count);
+	puts("OK");
+	return 0;
+}
@@ -0,0 +1,177 @@
+// telemetry_planner_check.c
+// Host tool: checks eps_telemetry_plan() (which commands, and the response bytes against picking
+// the smallest command per field) for a few field sets, then runs eps_telemetry_execute() against
+// the simulated EPS and checks the snapshot against direct fetches of the same commands.
+// Built with every host-buildable driver file (see eps_sim.h):
+//   cd Tools; S=$(ls ../Core/Src/eps_drivers/*.c ../Core/Src/debug_tools/*.c | grep -v -e _i2c -e transport_uart)
+//   gcc -O2 -DEPS_HOST_BUILD -I../Core/Inc -o telemetry_planner_check telemetry_planner_check.c $S
+// Usage: ./telemetry_planner_check
+// Exits with 0 if every check passes.
+
+#include "eps_drivers/eps_cmd_table.h"
+#include "eps_drivers/eps_commands.h"
+#include "eps_drivers/eps_hk_cache.h"
+#include "eps_drivers/eps_internal_drivers.h"
+#include "eps_drivers/eps_sim.h"
+#include "eps_drivers/eps_telemetry_planner.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#define FIELD(name) EPS_TELEMETRY_FIELD_BIT(EPS_TELEMETRY_FIELD_##name)
+
+static uint32_t fail_count = 0;
+
+#define CHECK(condition) do { \
+		if (!(condition)) { \
+			printf("FAIL line %d: %s\n", __LINE__, #condition); \
+			fail_count++; \
+		} \
+	} while (0)
+
+
+// #pragma region Plans
+
+typedef struct {
+	const char *name;
+	uint32_t field_mask;
+	uint8_t cmd_count;
+	EPS_CMD_ID_enum_t cmd_ids[EPS_TELEMETRY_MAX_PLAN_CMDS]; // in the planner's order
+	uint16_t rx_bytes;
+	uint16_t naive_rx_bytes;
+} plan_case_t;
+
+static const plan_case_t plan_cases[] = {
+	// PIU housekeeping has both, instead of PDU (258) + PCU (72) housekeeping
+	{ "channel VIPD + CC MPPT", FIELD(CH_VIPD) | FIELD(CC_MPPT),
+		1, { EPS_CMD_ID_GET_PIU_HOUSEKEEPING_DATA_ENG }, 274, 258 + 72 },
+	// No command has them all: PDU housekeeping also covers the channel bitfields, PCU the CC MPPT
+	{ "all fields", EPS_TELEMETRY_ALL_FIELDS,
+		4, { EPS_CMD_ID_GET_SYSTEM_STATUS, EPS_CMD_ID_GET_PDU_HOUSEKEEPING_DATA_ENG,
+			EPS_CMD_ID_GET_PBU_HOUSEKEEPING_DATA_ENG, EPS_CMD_ID_GET_PCU_HOUSEKEEPING_DATA_ENG },
+		36 + 258 + 84 + 72, 36 + 78 + 258 + 84 + 72 },
+	{ "channel VIPD + battery packs + CC MPPT", FIELD(CH_VIPD) | FIELD(BATTERY_PACKS) | FIELD(CC_MPPT),
+		2, { EPS_CMD_ID_GET_PBU_HOUSEKEEPING_DATA_ENG, EPS_CMD_ID_GET_PIU_HOUSEKEEPING_DATA_ENG },
+		84 + 274, 258 + 84 + 72 },
+	// Battery temperatures alone: PBU housekeeping is the smaller source
+	{ "battery temps", FIELD(BATTERY_TEMPS),
+		1, { EPS_CMD_ID_GET_PBU_HOUSEKEEPING_DATA_ENG }, 84, 84 },
+	// ... but with the channel VIPD and CC MPPT, the PIU's two battery temperatures come for free
+	{ "channel VIPD + CC MPPT + battery temps", FIELD(CH_VIPD) | FIELD(CC_MPPT) | FIELD(BATTERY_TEMPS),
+		1, { EPS_CMD_ID_GET_PIU_HOUSEKEEPING_DATA_ENG }, 274, 258 + 72 + 84 },
+	// Only one source is this small: no saving
+	{ "channel on", FIELD(CH_ON),
+		1, { EPS_CMD_ID_GET_PDU_OVERCURRENT_FAULT_STATE }, 78, 78 },
+};
+
+static void print_plan(const char *name, const eps_telemetry_plan_t *plan) {
+	printf("%-40s:", name);
+	for (uint8_t cmd_num = 0; cmd_num < plan->cmd_count; cmd_num++) {
+		printf(" 0x%02X", eps_cmd_table[plan->cmd_ids[cmd_num]].CC);
+	}
+	printf("  %u bytes (naive %u)\n", plan->rx_bytes, plan->naive_rx_bytes);
+}
+
+static void check_plans() {
+	eps_telemetry_plan_t plan;
+	CHECK(eps_telemetry_plan(0, &plan) == 1);
+	CHECK(eps_telemetry_plan(EPS_TELEMETRY_FIELD_BIT(EPS_TELEMETRY_FIELD_COUNT), &plan) == 1);
+
+	for (uint8_t case_num = 0; case_num < sizeof(plan_cases) / sizeof(plan_case_t); case_num++) {
+		const plan_case_t *plan_case = &plan_cases[case_num];
+		CHECK(eps_telemetry_plan(plan_case->field_mask, &plan) == 0);
+		print_plan(plan_case->name, &plan);
+		CHECK(plan.field_mask == plan_case->field_mask);
+		CHECK(plan.cmd_count == plan_case->cmd_count);
+		CHECK(memcmp(plan.cmd_ids, plan_case->cmd_ids, plan_case->cmd_count * sizeof(EPS_CMD_ID_enum_t)) == 0);
+		CHECK(plan.rx_bytes == plan_case->rx_bytes);
+		CHECK(plan.naive_rx_bytes == plan_case->naive_rx_bytes);
+	}
+}
+
+// #pragma endregion Plans
+
+
+// #pragma region Execute
+
+// Runs the plan and checks that the sim got exactly the plan's commands
+static void execute_plan(uint32_t field_mask, eps_telemetry_snapshot_t *snapshot) {
+	eps_telemetry_plan_t plan;
+	CHECK(eps_telemetry_plan(field_mask, &plan) == 0);
+	const uint32_t cmd_count_before = eps_sim_get_state()->cmd_count;
+	CHECK(eps_telemetry_execute(&plan, snapshot) == 0);
+	CHECK(eps_sim_get_state()->cmd_count - cmd_count_before == plan.cmd_count);
+	CHECK(snapshot->valid_field_mask == field_mask);
+}
+
+static void check_execute_piu() {
+	static eps_telemetry_snapshot_t snapshot;
+	execute_plan(FIELD(CH_VIPD) | FIELD(CC_MPPT) | FIELD(BATTERY_TEMPS), &snapshot);
+
+	static eps_result_piu_housekeeping_data_eng_t piu;
+	CHECK(eps_get_piu_housekeeping_data_eng(&piu) == 0);
+	CHECK(memcmp(snapshot.vip_each_channel, piu.vip_each_channel, sizeof(snapshot.vip_each_channel)) == 0);
+	CHECK(snapshot.cc_count == 5);
+	CHECK(memcmp(snapshot.cc_mppt_each_channel, piu.conditioning_channel_info_each_channel,
+			sizeof(snapshot.cc_mppt_each_channel)) == 0);
+	CHECK(snapshot.battery_temp_count == 2);
+	CHECK(snapshot.battery_temp_each_sensor_cC[0] == (int16_t) piu.battery_temp2_cC);
+	CHECK(snapshot.battery_temp_each_sensor_cC[1] == (int16_t) piu.battery_temp3_cC);
+	CHECK(snapshot.battery_temp_each_sensor_cC[0] == 2000); // the sim's value
+}
+
+static void check_execute_all() {
+	static eps_telemetry_snapshot_t snapshot;
+	execute_plan(EPS_TELEMETRY_ALL_FIELDS, &snapshot);
+
+	eps_result_system_status_t system_status;
+	static eps_result_pdu_housekeeping_data_eng_t pdu;
+	static eps_result_pbu_housekeeping_data_eng_t pbu;
+	static eps_result_pcu_housekeeping_data_eng_t pcu;
+	CHECK(eps_get_system_status(&system_status) == 0);
+	CHECK(eps_get_pdu_housekeeping_data_eng(&pdu) == 0);
+	CHECK(eps_get_pbu_housekeeping_data_eng(&pbu) == 0);
+	CHECK(eps_get_pcu_housekeeping_data_eng(&pcu) == 0);
+
+	CHECK(snapshot.system_status.mode == system_status.mode);
+	CHECK(snapshot.stat_ch_on_bitfield == pdu.stat_ch_on_bitfield);
+	CHECK(snapshot.stat_ch_ext_on_bitfield == pdu.stat_ch_ext_on_bitfield);
+	CHECK(memcmp(snapshot.vip_each_channel, pdu.vip_each_channel, sizeof(snapshot.vip_each_channel)) == 0);
+	CHECK(memcmp(snapshot.battery_pack_info_each_pack, pbu.battery_pack_info_each_pack,
+			sizeof(snapshot.battery_pack_info_each_pack)) == 0);
+	CHECK(snapshot.battery_temp_count == 9);
+	for (uint8_t sensor_num = 0; sensor_num < 9; sensor_num++) {
+		CHECK(snapshot.battery_temp_each_sensor_cC[sensor_num]
+				== pbu.battery_pack_info_each_pack[sensor_num / 3].battery_temperature_each_sensor_cC[sensor_num % 3]);
+	}
+	CHECK(snapshot.cc_count == 4);
+	for (uint8_t cc_num = 0; cc_num < 4; cc_num++) {
+		const eps_conditioning_channel_datatype_eng_t *cc = &pcu.conditioning_channel_info_each_channel[cc_num];
+		CHECK(snapshot.cc_mppt_each_channel[cc_num].volt_in_mppt_mV == cc->volt_in_mppt_mV);
+		CHECK(snapshot.cc_mppt_each_channel[cc_num].curr_ou_mppt_mA == cc->curr_ou_mppt_mA);
+		CHECK(memcmp(&snapshot.vip_cc_output_each_channel[cc_num], &cc->vip_cc_output, sizeof(eps_vpid_eng_t)) == 0);
+	}
+}
+
+// #pragma endregion Execute
+
+
+int main() {
+	check_plans();
+
+	eps_set_transport(&eps_transport_sim);
+	for (uint8_t cmd_id = 0; cmd_id < EPS_CMD_ID_COUNT; cmd_id++) {
+		eps_hk_cache_set_max_age_ms(cmd_id, 0); // every command reaches the sim
+	}
+	eps_output_bus_group_on(0xFFFF, 0xFFFF); // non-zero channel currents
+	check_execute_piu();
+	check_execute_all();
+
+	if (fail_count != 0) {
+		printf("FAIL: %lu checks\n", (unsigned long) fail_count);
+		return 1;
+	}
+	puts("OK");
+	return 0;
+}